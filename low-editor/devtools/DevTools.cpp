@@ -146,6 +146,10 @@
 
 #include "DevTools.h"
 
+#include <algorithm>
+
+#include "profiling/Profiler.h"
+
 namespace LowEngine {
     sf::Texture DevTools::playTexture;
     sf::Texture DevTools::pauseTexture;
@@ -190,6 +194,7 @@ namespace LowEngine {
         auto scene = game.Scenes.GetCurrentScene();
         DisplayWorldOutliner(scene, 10, 30, 250, displaySize.y - 40);
         DisplayProperties(scene, displaySize.x - 260, 30, 250, displaySize.y - 40);
+        DisplayComponentPools(scene, 270, displaySize.y - 250, displaySize.x - 540, 240);
     }
 
     void DevTools::Render(sf::RenderWindow& window) {
@@ -228,6 +233,17 @@ namespace LowEngine {
 
                 ImGui::EndMenu();
             }
+            if (ImGui::BeginMenu("Profiler")) {
+                bool capturing = Profiling::Profiler::IsCapturePending();
+                if (ImGui::MenuItem("Capture 60 frames", nullptr, false, !capturing)) {
+                    Profiling::Profiler::BeginCapture(60, "profile.json");
+                }
+                if (ImGui::MenuItem("Capture 600 frames", nullptr, false, !capturing)) {
+                    Profiling::Profiler::BeginCapture(600, "profile.json");
+                }
+
+                ImGui::EndMenu();
+            }
 
             ImGui::EndMainMenuBar();
         }
@@ -300,6 +316,14 @@ namespace LowEngine {
         ImGui::SetNextWindowSize(ImVec2(width, height));
         ImGui::Begin(std::format("Scene: '{}'", scene->Name).c_str());
 
+        ImGui::Text("Texture switches: %zu", scene->GetTextureSwitchCount());
+        ImGui::Text("Draw calls: %zu", scene->GetDrawCallCount());
+        bool batching = scene->IsSpriteBatchingEnabled();
+        if (ImGui::Checkbox("Batch sprites", &batching)) {
+            scene->SetSpriteBatching(batching);
+        }
+        ImGui::Separator();
+
         auto entities = scene->GetEntities();
         for (auto& entity: *entities) {
             std::string label = std::format("[{}] {}", entity.get()->Id, entity.get()->Name);
@@ -313,6 +337,88 @@ namespace LowEngine {
         ImGui::End();
     }
 
+    void DevTools::DisplayComponentPools(Scene* scene, int posX, int posY, int width, int height) {
+        ImGui::SetNextWindowPos(ImVec2(posX, posY));
+        ImGui::SetNextWindowSize(ImVec2(width, height));
+        ImGui::Begin("Component pools");
+
+        if (ImGui::Button("Reset")) {
+            scene->ResetPoolStatistics();
+        }
+
+        auto statistics = scene->GetPoolStatistics();
+
+        ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg |
+                                ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("##ComponentPools", 8, flags)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("Capacity", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("Memory KB", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("Reallocations", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("Update ms", ImGuiTableColumnFlags_PreferSortDescending | ImGuiTableColumnFlags_DefaultSort);
+            ImGui::TableSetupColumn("Collect ms", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("Lookups", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableHeadersRow();
+
+            // statistics are rebuilt every frame - sort them every frame as well
+            const ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+            if (sortSpecs != nullptr && sortSpecs->SpecsCount > 0) {
+                int column = sortSpecs->Specs[0].ColumnIndex;
+                bool ascending = sortSpecs->Specs[0].SortDirection == ImGuiSortDirection_Ascending;
+
+                auto value = [column](const Memory::PoolStatistics& pool) -> double {
+                    switch (column) {
+                        case 1: return static_cast<double>(pool.Count);
+                        case 2: return static_cast<double>(pool.Capacity);
+                        case 3: return static_cast<double>(pool.Bytes);
+                        case 4: return static_cast<double>(pool.Reallocations);
+                        case 5: return pool.UpdateMs;
+                        case 6: return pool.CollectMs;
+                        case 7: return static_cast<double>(pool.Lookups);
+                        default: return 0.0;
+                    }
+                };
+
+                std::sort(statistics.begin(), statistics.end(), [&](const Memory::PoolStatistics& a, const Memory::PoolStatistics& b) {
+                    if (column == 0) return ascending ? a.Name < b.Name : a.Name > b.Name;
+                    return ascending ? value(a) < value(b) : value(a) > value(b);
+                });
+            }
+
+            for (auto& pool: statistics) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(pool.Name.c_str());
+                if (pool.Pending) {
+                    ImGui::TableNextColumn();
+                    ImGui::TextDisabled("in save file");
+                    continue;
+                }
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", pool.Count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", pool.Capacity);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", static_cast<double>(pool.Bytes) / 1024.0);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", pool.Reallocations);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", pool.UpdateMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", pool.CollectMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(pool.Lookups));
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+
     void DevTools::DisplayProperties(Scene* scene, int posX, int posY, int width, int height) {
         ImGui::SetNextWindowPos(ImVec2(posX, posY));
         ImGui::SetNextWindowSize(ImVec2(width, height));
@@ -332,6 +438,7 @@ namespace LowEngine {
             DisplayTransformComponentProperties(*scene);
             DisplayAnimatedSpriteComponentProperties(*scene);
             DisplayCameraComponentProperties(*scene);
+            DisplayTileMapComponentProperties(*scene);
         } else {
             ImGui::Begin("Properties:");
         }
@@ -427,6 +534,34 @@ namespace LowEngine {
         }
     }
 
+    void DevTools::DisplayTileMapComponentProperties(Scene& scene) {
+        auto entity = scene.GetEntity(_selectedEntityId);
+
+        auto tmc = scene.GetComponent<ECS::TileMapComponent>(entity->Id);
+        if (tmc == nullptr) return;
+
+        if (ImGui::CollapsingHeader("Tile Map", ImGuiTreeNodeFlags_DefaultOpen)) {
+            auto& navGrid = Assets::GetTileMap(tmc->GetMapId()).NavGrid;
+            ImGui::Text("Navigation grid: %zux%zu", navGrid.Width, navGrid.Height);
+            ImGui::Text("Navigation memory: %.1f KB", static_cast<double>(navGrid.GetMemorySize()) / 1024.0);
+
+            ImGui::Separator();
+            auto& pathCache = navGrid.GetPathCache();
+            auto& stats = pathCache.GetStats();
+            size_t lookups = stats.Hits + stats.SuffixHits + stats.Misses;
+            ImGui::Text("Cached paths: %zu / %zu", pathCache.GetSize(), pathCache.GetCapacity());
+            ImGui::Text("Hits: %zu", stats.Hits);
+            ImGui::Text("Suffix hits: %zu", stats.SuffixHits);
+            ImGui::Text("Misses: %zu", stats.Misses);
+            ImGui::Text("Hit rate: %.1f%%", lookups == 0 ? 0.0 : static_cast<double>(stats.Hits + stats.SuffixHits) * 100.0 / static_cast<double>(lookups));
+            ImGui::Text("Evictions: %zu", stats.Evictions);
+            ImGui::Text("Invalidations: %zu", stats.Invalidations);
+            if (ImGui::Button("Reset##PathCache")) {
+                pathCache.ResetStats();
+            }
+        }
+    }
+
     std::string DevTools::InsertSpaces(const std::string& str) {
         std::string result;
         for (std::size_t i = 0; i < str.size(); ++i) {
@@ -79,12 +79,16 @@ namespace LowEngine {
 
         static void DisplayProperties(Scene* scene, int posX, int posY, int width, int height);
 
+        static void DisplayComponentPools(Scene* scene, int posX, int posY, int width, int height);
+
         static void DisplayTransformComponentProperties(Scene& scene);
 
         static void DisplayAnimatedSpriteComponentProperties(Scene& scene);
 
         static void DisplayCameraComponentProperties(Scene& scene);
 
+        static void DisplayTileMapComponentProperties(Scene& scene);
+
         static std::string InsertSpaces(const std::string& str);
 
         static sf::Texture playTexture;
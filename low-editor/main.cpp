@@ -1,9 +1,18 @@
+#include <charconv>
+#include <cstring>
+#include <string>
+
 #include "Game.h"
+#include "assets/terrain/MapGenerator.h"
+#include "assets/terrain/TileMap.h"
+#include "assets/terrain/navigation/NavigationPath.h"
 #include "devtools/DevTools.h"
 
+using LowEngine::operator""_sid;
+
 sf::Vector2f StartPosition(4 * 16.f + 4.f, 7 * 16.f + 4.f);
 sf::Vector2f EndPosition(8 * 16.f + 4.f, 4 * 16.f + 4.f);
-std::vector<sf::Vector2f> CurrentPath;
+LowEngine::Terrain::Navigation::NavigationPath CurrentPath;
 
 void DebugDraw(sf::RenderWindow& window) {
     sf::RectangleShape startShape(sf::Vector2f(8.f, 8.f));
@@ -17,13 +26,12 @@ void DebugDraw(sf::RenderWindow& window) {
     window.draw(startShape);
     window.draw(endShape);
 
-    if (!CurrentPath.empty()) {
-        for (auto& point: CurrentPath) {
-            sf::RectangleShape pathPoint(sf::Vector2f(4.f, 4.f));
-            pathPoint.setFillColor(sf::Color::Magenta);
-            pathPoint.setPosition({point.x + 6.f, point.y + 6.f});
-            window.draw(pathPoint);
-        }
+    for (size_t i = 0; i < CurrentPath.GetSize(); i++) {
+        auto point = CurrentPath.GetPoint(i);
+        sf::RectangleShape pathPoint(sf::Vector2f(4.f, 4.f));
+        pathPoint.setFillColor(sf::Color::Magenta);
+        pathPoint.setPosition({point.x + 6.f, point.y + 6.f});
+        window.draw(pathPoint);
     }
 }
 
@@ -32,50 +40,92 @@ void FindPathBetweenPositions(LowEngine::Game& game) {
     if (currentMapEntity) {
         auto tileMap = currentMapEntity->GetComponent<LowEngine::ECS::TileMapComponent>();
         if (tileMap) {
-            auto path = tileMap->FindPath(StartPosition, EndPosition, LowEngine::Terrain::Navigation::MovementType::Walk);
-
-            if (!path.empty()) {
-                CurrentPath.clear();
-                for (const auto& point: path) {
-                    CurrentPath.emplace_back(point.x, point.y);
-                }
-            } else {
-                CurrentPath.clear();
-            }
+            tileMap->FindPath(StartPosition, EndPosition, LowEngine::Terrain::Navigation::MovementType::Walk, CurrentPath);
         }
     }
 }
 
-int main() {
+/**
+ * Parse whole argument as unsigned number. Returns false if it's not a number or doesn't fit into value.
+ */
+template<typename T>
+bool ParseNumber(const char* text, T& value) {
+    const char* end = text + std::strlen(text);
+    auto [position, error] = std::from_chars(text, end, value);
+    return error == std::errc() && position == end;
+}
+
+/**
+ * Usage: LowEditor [--generate-map <size> [seed]]
+ *   --generate-map  Instead of BasicMap, open a generated map of size x size cells.
+ *                   The map is also saved as generated_<size>_<seed>.ldtkl in the working directory.
+ */
+int main(int argc, char* argv[]) {
+    size_t generatedMapSize = 0;
+    uint32_t generatedMapSeed = 1;
+    if (argc >= 3 && std::string(argv[1]) == "--generate-map") {
+        bool valid = ParseNumber(argv[2], generatedMapSize) &&
+                     generatedMapSize > 0 && generatedMapSize <= LowEngine::Terrain::Navigation::NavigationPath::MAX_GRID_SIZE;
+        if (argc >= 4) valid = valid && ParseNumber(argv[3], generatedMapSeed);
+        if (!valid) {
+            LowEngine::_log->error("Invalid map size or seed - size must be between 1 and {}",
+                                   LowEngine::Terrain::Navigation::NavigationPath::MAX_GRID_SIZE);
+            LowEngine::_log->error("Usage: LowEditor [--generate-map <size> [seed]]");
+            return 1;
+        }
+    }
+
     // initialize the game engine
     LowEngine::Game game;
 
-    // load assets
-    LowEngine::Assets::LoadTextureWithSpriteSheet("assets/textures/terrain/green_terrain.png", "green_terrain", 16, 16, 3, 2);
+    // load assets - files are decoded in parallel on loader threads, batch waits for all of them
+    LowEngine::AssetBatch assets;
+    auto greenTerrainId = assets.LoadTextureWithSpriteSheet("assets/textures/terrain/green_terrain.png", "green_terrain", 16, 16, 3, 2);
     LowEngine::Assets::AddAnimationClip("green_terrain", "water", 3, 3, 0.5f);
 
-    LowEngine::Assets::LoadTextureWithSpriteSheet("assets/textures/terrain/green_features.png", "green_features", 16, 16, 4, 2);
+    auto greenFeaturesId = assets.LoadTextureWithSpriteSheet("assets/textures/terrain/green_features.png", "green_features", 16, 16, 4, 2);
     LowEngine::Assets::AddAnimationClip("green_features", "forest1", 0, 2, 0.20f);
     LowEngine::Assets::AddAnimationClip("green_features", "forest2", 2, 2, 0.20f);
 
-    LowEngine::Assets::LoadTileMap("assets/maps/terrain_map_01/BasicMap.ldtkl", "BasicMap", std::vector<LowEngine::Terrain::LayerDefinition>{
-                                       {
-                                           LowEngine::Terrain::LayerType::Terrain,
-                                           LowEngine::Assets::GetTextureId("green_terrain"),
-                                           std::unordered_map<unsigned, LowEngine::Terrain::CellDefinition>{
-                                               {0, {true, false, true, 1.0f, {}}},
-                                               {1, {false, true, true, 1.0f, {"water"}}},
-                                           }
-                                       },
-                                       {
-                                           LowEngine::Terrain::LayerType::Features,
-                                           LowEngine::Assets::GetTextureId("green_features"),
-                                           std::unordered_map<unsigned, LowEngine::Terrain::CellDefinition>{
-                                               {0, {true, false, true, 1.0f, {"forest1", "forest2"}}},
-                                               {1, {false, false, true, 1.0f, {}}}
-                                           }
-                                       }
-                                   });
+    std::vector<LowEngine::Terrain::LayerDefinition> mapDefinitions{
+        {
+            LowEngine::Terrain::LayerType::Terrain,
+            greenTerrainId,
+            std::unordered_map<unsigned, LowEngine::Terrain::CellDefinition>{
+                {0, {true, false, true, 1.0f, {}}},
+                {1, {false, true, true, 1.0f, {"water"}}},
+            }
+        },
+        {
+            LowEngine::Terrain::LayerType::Features,
+            greenFeaturesId,
+            std::unordered_map<unsigned, LowEngine::Terrain::CellDefinition>{
+                {0, {true, false, true, 1.0f, {"forest1", "forest2"}}},
+                {1, {false, false, true, 1.0f, {}}}
+            }
+        }
+    };
+
+    std::string mapPath = "assets/maps/terrain_map_01/BasicMap.ldtkl";
+    if (generatedMapSize > 0) {
+        // generated map goes through the same loading path as maps made in LDTk
+        LowEngine::Terrain::MapGeneratorSettings settings;
+        settings.Width = generatedMapSize;
+        settings.Height = generatedMapSize;
+        settings.Seed = generatedMapSeed;
+
+        LowEngine::Terrain::TileMap generatedMap(LowEngine::Assets::GetDefaultTexture());
+        mapPath = "generated_" + std::to_string(generatedMapSize) + "_" + std::to_string(generatedMapSeed) + ".ldtkl";
+        if (!LowEngine::Terrain::MapGenerator::Generate(settings, mapDefinitions, generatedMap) ||
+            !LowEngine::Terrain::MapGenerator::SaveAsLDTk(generatedMap, mapPath)) {
+            return 1;
+        }
+    }
+
+    assets.LoadTileMap(mapPath, "BasicMap", mapDefinitions);
+
+    if (!assets.Wait()) return 1;
+    LowEngine::Assets::LogCacheReport();
 
     // create scene
     auto mainScene = game.Scenes.CreateScene("new scene");
@@ -133,7 +183,7 @@ int main() {
         // LowEngine::DevTools::Update(game); // TGUI
 
         // update
-        if (game.Input.GetAction("SetStartPosition")->Started) {
+        if (game.Input.GetAction("SetStartPosition"_sid)->Started) {
             auto mouseWorldPosition = game.Window.mapPixelToCoords(game.Input.GetMousePosition());
 
             int cellX = static_cast<int>(std::floor(mouseWorldPosition.x / 16));
@@ -144,7 +194,7 @@ int main() {
 
             FindPathBetweenPositions(game);
         }
-        if (game.Input.GetAction("SetEndPosition")->Started) {
+        if (game.Input.GetAction("SetEndPosition"_sid)->Started) {
             auto mouseWorldPosition = game.Window.mapPixelToCoords(game.Input.GetMousePosition());
 
             int cellX = static_cast<int>(std::floor(mouseWorldPosition.x / 16));
@@ -155,7 +205,7 @@ int main() {
 
             FindPathBetweenPositions(game);
         }
-        if (game.Input.GetAction("FindPath")->Started) {
+        if (game.Input.GetAction("FindPath"_sid)->Started) {
             FindPathBetweenPositions(game);
         }
 
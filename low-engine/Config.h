@@ -2,6 +2,8 @@
 
 #include <limits>
 
+#include <spdlog/common.h>
+
 namespace LowEngine {
     /* * Config class
      * This class contains the configuration settings for the LowEngine.
@@ -17,9 +19,87 @@ namespace LowEngine {
         inline static const std::size_t DEFAULT_COMPONENT_POOL_SIZE = 1000;
 
         /**
-         * @brief Name of the logger used in the engine.
+         * @brief Time per frame, in milliseconds, that game loop spends on finishing assets loaded in the background.
+         *
+         * Uploads that don't fit are continued in the next frame.
+         */
+        inline static const unsigned int ASSET_UPLOAD_BUDGET_MS = 4;
+
+        /**
+         * @brief Default width and height of a texture atlas page, in pixels.
+         *
+         * 2048 is supported by practically every GPU. Pages are trimmed to the height they use.
+         */
+        inline static const unsigned int ATLAS_PAGE_SIZE = 2048;
+
+        /**
+         * @brief Empty pixels between textures packed into an atlas, so neighbours don't bleed into each other.
+         */
+        inline static const unsigned int ATLAS_PADDING = 1;
+
+        /**
+         * @brief Default distance, in Units, from the focus point to a level at which World Streamer starts loading it.
+         */
+        inline static const float WORLD_LOAD_DISTANCE = 512.0f;
+
+        /**
+         * @brief Default distance, in Units, from the focus point to a level at which World Streamer evicts it.
+         *
+         * Kept larger than WORLD_LOAD_DISTANCE, so levels on the border are not reloaded back and forth.
+         */
+        inline static const float WORLD_UNLOAD_DISTANCE = 1024.0f;
+
+        /**
+         * @brief Default memory, in bytes, for textures that can be evicted when not referenced by any Asset Handle.
+         *
+         * Textures loaded by APIs returning raw IDs are never evicted, but still count towards the budget.
+         */
+        inline static const std::size_t TEXTURE_MEMORY_BUDGET = 512 * 1024 * 1024;
+
+        /**
+         * @brief Default memory, in bytes, for sound buffers. Works the same as TEXTURE_MEMORY_BUDGET.
+         */
+        inline static const std::size_t SOUND_MEMORY_BUDGET = 128 * 1024 * 1024;
+
+        /**
+         * @brief Default memory, in bytes, for tile maps. Works the same as TEXTURE_MEMORY_BUDGET.
+         */
+        inline static const std::size_t MAP_MEMORY_BUDGET = 256 * 1024 * 1024;
+
+        /**
+         * @brief Name of the logger used in the engine. Subsystem loggers (see Log.h) are named after their subsystem.
+         */
+        inline static const char* LOGGER_NAME = "engine";
+
+        /**
+         * @brief Write log file on a background thread.
+         *
+         * Logging threads only copy messages into a queue. Disable to write and flush synchronously,
+         * e.g. when hunting a crash that takes the last messages with it.
+         */
+        inline static const bool LOG_ASYNC = true;
+
+        /**
+         * @brief Maximum number of log messages waiting for the background writer. Logging waits when it's full.
+         */
+        inline static const std::size_t LOG_QUEUE_SIZE = 8192;
+
+        /**
+         * @brief Messages of this level and above are flushed to the file immediately.
+         */
+        inline static const spdlog::level::level_enum LOG_FLUSH_LEVEL = spdlog::level::warn;
+
+        /**
+         * @brief Time, in milliseconds, between periodic flushes of the log file.
+         *
+         * Synchronous logging rounds it down to whole seconds; 0 disables periodic flushes there.
+         */
+        inline static const unsigned int LOG_FLUSH_INTERVAL_MS = 1000;
+
+        /**
+         * @brief Number of profiler zones each thread can record per frame. Zones over it are dropped from the capture.
          */
-        inline static const char* LOGGER_NAME = "low_engine_spdlog_logger_name";
+        inline static const std::size_t PROFILER_ZONE_BUFFER_SIZE = 16384;
 
         /**
          * @brief Maximum value for size_t.
@@ -1,34 +1,144 @@
 #include "Game.h"
 
+#include "SFML/System/Sleep.hpp"
+
+#include "profiling/Profiler.h"
+#include "threading/AsyncLogSink.h"
+
 namespace LowEngine {
     void Game::StartLog() {
-        _log = spdlog::basic_logger_mt(Config::LOGGER_NAME, "engine.log", true);
+        auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("engine.log", true);
+        auto flushInterval = std::chrono::milliseconds(Config::LOG_FLUSH_INTERVAL_MS);
+
+        if (Config::LOG_ASYNC) {
+            // formatting and writing happen on the sink's own thread, which also flushes periodically
+            auto asyncSink = std::make_shared<Threading::AsyncLogSink>(fileSink, Config::LOG_QUEUE_SIZE, flushInterval);
+            _log = std::make_shared<spdlog::logger>(Config::LOGGER_NAME, asyncSink);
+        } else {
+            _log = std::make_shared<spdlog::logger>(Config::LOGGER_NAME, fileSink);
+            // spdlog's periodic flusher works in whole seconds
+            spdlog::flush_every(std::chrono::duration_cast<std::chrono::seconds>(flushInterval));
+        }
+
+        spdlog::register_logger(_log);
         _log->set_level(spdlog::level::debug);
-        _log->set_pattern("[%Y-%m-%d %H:%M:%S] [%l] %v");
-        _log->flush_on(spdlog::level::trace);
+        _log->set_pattern("[%Y-%m-%d %H:%M:%S] [%l] [%n] %v");
+        _log->flush_on(Config::LOG_FLUSH_LEVEL);
+        AttachSubsystemLoggers(_log);
         _log->info("LowEngine started");
     }
 
     void Game::StopLog() {
         _log->info("LowEngine stopped");
+        _log->flush();
+        DetachSubsystemLoggers();
         spdlog::drop(Config::LOGGER_NAME);
     }
 
     void Game::OnWindowClosed() {
-        Scenes.DestroyAll();
-        Assets::UnloadAll();
-        Window.close();
+        Shutdown();
     }
 
     bool Game::OpenWindow(const sf::String& title, unsigned int width, unsigned int height, unsigned int framerateLimit) {
         Window.create(sf::VideoMode({width, height}), title);
         Window.setFramerateLimit(framerateLimit);
         Window.setKeyRepeatEnabled(false); // leave Input system to trace state of Actions
+        Profiling::Profiler::SetThreadName("Main");
 
-        return Window.isOpen();
+        _running = Window.isOpen();
+        _headless = false;
+        return _running;
+    }
+
+    bool Game::StartHeadless(sf::Vector2u offscreenSize) {
+        if (offscreenSize.x > 0 && offscreenSize.y > 0) {
+            auto target = std::make_unique<sf::RenderTexture>();
+            if (!target->resize(offscreenSize)) {
+                _log->error("Failed to create off-screen render target of size {}x{}", offscreenSize.x, offscreenSize.y);
+                return false;
+            }
+            _offscreenTarget = std::move(target);
+        }
+
+        _headless = true;
+        _running = true;
+        Profiling::Profiler::SetThreadName("Main");
+        _clock.restart();
+
+        _log->info("Game started in headless mode ({})", _offscreenTarget ? "off-screen drawing" : "drawing disabled");
+        return true;
+    }
+
+    void Game::Tick(sf::Time deltaTime) {
+        if (!_running) {
+            _log->warn("Tick called on a game that is not running");
+            return;
+        }
+
+        Profiling::Profiler::MarkFrame();
+        LOW_PROFILE_ZONE("Game::Tick");
+
+        DeltaTime = deltaTime;
+        WindowEvents.clear();
+        Input.ClearActionState();
+
+        Assets::SetRenderFrames(_renderThread.GetNextFrameIndex(), _renderThread.GetRetiredFrameIndex());
+        Assets::ProcessPendingUploads(sf::milliseconds(Config::ASSET_UPLOAD_BUDGET_MS));
+
+        Simulate();
+    }
+
+    bool Game::StartRenderThread() {
+        if (_headless || !Window.isOpen()) {
+            _log->error("Render thread requires an open window");
+            return false;
+        }
+
+        return _renderThread.Start(Window);
+    }
+
+    void Game::StopRenderThread() {
+        _renderThread.Stop();
+        Assets::SetRenderFrames(_renderThread.GetNextFrameIndex(), _renderThread.GetRetiredFrameIndex());
+    }
+
+    void Game::PublishRenderSnapshot() {
+        auto& snapshot = _renderThread.BeginSnapshot();
+        Scenes.GetCurrentScene()->BuildRenderSnapshot(snapshot, Window.getSize());
+        snapshot.Alpha = _interpolationAlpha;
+        snapshot.StepSeconds = _timestepMode == TimestepMode::Fixed ? _fixedTimestep.asSeconds() : 0.0f;
+        _renderThread.PublishSnapshot();
+
+        if (_timestepMode == TimestepMode::Fixed) {
+            // presenting is paced by render thread - there's nothing to do until next step is due
+            sf::Time untilNextStep = _fixedTimestep - _accumulator - _clock.getElapsedTime();
+            if (untilNextStep > sf::Time::Zero) {
+                sf::sleep(untilNextStep);
+            }
+        }
+    }
+
+    void Game::Shutdown() {
+        if (!_running) return;
+        _running = false;
+
+        StopRenderThread();
+        Autosave.Wait();
+        Scenes.DestroyAll();
+        Assets::UnloadAll();
+        _offscreenTarget.reset();
+        if (Window.isOpen()) {
+            Window.close();
+        }
+
+        _log->info("Game shut down");
     }
 
     bool Game::IsWindowOpen() {
+        // frame ends when the game loop comes back for the next one
+        Profiling::Profiler::MarkFrame();
+        LOW_PROFILE_ZONE("Game::IsWindowOpen");
+
         DeltaTime = _clock.restart(); // time elapsed since last loop iteration
 
         WindowEvents.clear();
@@ -54,12 +164,65 @@ namespace LowEngine {
 
         if (!isScenePaused) Input.Update();
 
-        Update(DeltaTime.asSeconds());
+        Assets::SetRenderFrames(_renderThread.GetNextFrameIndex(), _renderThread.GetRetiredFrameIndex());
+        Assets::ProcessPendingUploads(sf::milliseconds(Config::ASSET_UPLOAD_BUDGET_MS));
+
+        Simulate();
 
         return Window.isOpen();
     }
 
+    void Game::SetFixedTimestep(float ticksPerSecond, unsigned int maxTicksPerFrame) {
+        if (ticksPerSecond <= 0.0f || maxTicksPerFrame == 0) {
+            _log->error("Invalid fixed timestep: {} Hz, {} ticks per frame", ticksPerSecond, maxTicksPerFrame);
+            return;
+        }
+
+        _timestepMode = TimestepMode::Fixed;
+        _fixedTimestep = sf::seconds(1.0f / ticksPerSecond);
+        _maxTicksPerFrame = maxTicksPerFrame;
+        _accumulator = sf::Time::Zero;
+
+        _log->info("Fixed timestep set to {} Hz, up to {} ticks per frame", ticksPerSecond, maxTicksPerFrame);
+    }
+
+    void Game::SetVariableTimestep() {
+        _timestepMode = TimestepMode::Variable;
+        _accumulator = sf::Time::Zero;
+        _interpolationAlpha = 1.0f;
+
+        _log->info("Variable timestep set");
+    }
+
+    void Game::Simulate() {
+        LOW_PROFILE_ZONE("Game::Simulate");
+
+        if (_timestepMode == TimestepMode::Variable) {
+            Update(DeltaTime.asSeconds());
+            _ticksThisFrame = 1;
+            _interpolationAlpha = 1.0f;
+            return;
+        }
+
+        _accumulator += DeltaTime;
+        _ticksThisFrame = 0;
+        while (_accumulator >= _fixedTimestep && _ticksThisFrame < _maxTicksPerFrame) {
+            Update(_fixedTimestep.asSeconds());
+            _accumulator -= _fixedTimestep;
+            _ticksThisFrame++;
+        }
+
+        if (_accumulator >= _fixedTimestep) {
+            _log->debug("Simulation can't keep up: dropping {:.2f} ms", (_accumulator - _fixedTimestep).asSeconds() * 1000.0f);
+            _accumulator = _accumulator % _fixedTimestep;
+        }
+
+        _interpolationAlpha = _accumulator / _fixedTimestep;
+    }
+
     void Game::Update(float deltaTime) {
+        Input.BeginStep();
+
         if (!Scenes.GetCurrentScene()->IsPaused) {
             Scenes.GetCurrentScene()->Update(deltaTime);
         }
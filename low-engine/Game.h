@@ -1,10 +1,18 @@
 #pragma once
 
+#include <memory>
+
+#include "SFML/Graphics/RenderTexture.hpp"
+#include "SFML/Graphics/RenderWindow.hpp"
+
 #include "Config.h"
 #include "Log.h"
+#include "assets/AssetBatch.h"
 #include "assets/Assets.h"
 
 #include "ecs/ECSHeaders.h"
+#include "graphics/RenderThread.h"
+#include "scene/AutosaveManager.h"
 #include "scene/SceneManager.h"
 #include "input/InputManager.h"
 
@@ -13,9 +21,25 @@ namespace LowEngine {
      * @brief The main class of the game engine.
      *
      * This class is responsible for creating the window, managing the game loop, scenes and handling input.
+     * Game can also run headless (without a window), i.e. for server-side simulation or benchmarks.
+     * In that case loop is driven by Tick() and ended by Shutdown().
      */
     class Game {
     public:
+        /**
+         * @brief Defines how game loop advances the simulation.
+         */
+        enum class TimestepMode {
+            /**
+             * @brief Scene is updated once per frame with the frame's duration.
+             */
+            Variable,
+            /**
+             * @brief Scene is updated in fixed steps. Number of steps per frame depends on frame's duration.
+             */
+            Fixed
+        };
+
         /**
          * @brief The main window of the game.
          *
@@ -50,9 +74,19 @@ namespace LowEngine {
          * This is a wrapper around SFML's input system, which allows for more flexible and reusable input handling.
          * Interaction is done through defining new Actions and binding them to specific keys or buttons.
          * Then Action can be retrieved and checked for state (started, ended, active).
+         * Started/Ended are tied to simulation steps - in Fixed timestep mode read them from scene's Update, as code
+         * running once per frame may see an edge on several frames, or not at all.
          */
         Input::InputManager Input;
 
+        /**
+         * @brief Background saving of scenes.
+         *
+         * Call Autosave.Save() when game state is consistent (i.e. at the end of a turn). The scene is serialized on
+         * the calling thread into a reused buffer - compression and disk I/O never block the game loop.
+         */
+        AutosaveManager Autosave;
+
         Game() : DeltaTime(sf::Time::Zero) {
             StartLog();
         }
@@ -84,20 +118,144 @@ namespace LowEngine {
          */
         bool IsWindowOpen();
 
+        /**
+         * @brief Start the game without a window.
+         *
+         * Scenes can then be advanced with Tick(). Draw() is skipped, unless off-screen target size is provided -
+         * then scenes are rendered into off-screen texture (requires OpenGL context to be available).
+         * @param offscreenSize Size of the off-screen render target. Zero size disables drawing.
+         * @return True if successful. False if off-screen target could not be created.
+         */
+        bool StartHeadless(sf::Vector2u offscreenSize = {0, 0});
+
+        /**
+         * @brief Advance the game by provided time, without polling window events.
+         *
+         * Programmatic alternative to IsWindowOpen(), used in headless mode.
+         * Simulation follows current timestep mode, so Fixed mode executes as many steps as fit in deltaTime.
+         * @param deltaTime Time to advance the game by.
+         */
+        void Tick(sf::Time deltaTime);
+
+        /**
+         * @brief Is the game running? Game is running from opening the window or starting headless until Shutdown().
+         */
+        [[nodiscard]] bool IsRunning() const { return _running; }
+
+        /**
+         * @brief Is the game running without a window?
+         */
+        [[nodiscard]] bool IsHeadless() const { return _headless; }
+
+        /**
+         * @brief Retrieve off-screen render target used in headless mode.
+         * @return Pointer to off-screen texture. Returns nullptr if headless drawing is disabled.
+         */
+        sf::RenderTexture* GetOffscreenTarget() { return _offscreenTarget.get(); }
+
+        /**
+         * @brief Draw on a dedicated render thread.
+         *
+         * Draw() then only publishes a snapshot of the current scene - render thread draws latest snapshot
+         * and presents the window at its own pace, so long simulation frames don't freeze the screen.
+         * Draw callbacks are not executed in this mode. Fixed timestep is recommended - game loop then sleeps
+         * until next simulation step is due, instead of publishing snapshots nobody will see.
+         * Textures evicted or packed into an atlas meanwhile are released only once no published snapshot refers to them.
+         * @return True if render thread was started.
+         */
+        bool StartRenderThread();
+
+        /**
+         * @brief Stop render thread and go back to drawing in Draw().
+         */
+        void StopRenderThread();
+
+        /**
+         * @brief Is render thread running?
+         */
+        [[nodiscard]] bool IsRenderThreadRunning() const { return _renderThread.IsRunning(); }
+
+        /**
+         * @brief Retrieve frame pacing statistics of the render thread.
+         */
+        [[nodiscard]] RenderThreadStats GetRenderThreadStats() const { return _renderThread.GetStats(); }
+
+        /**
+         * @brief Stop the game: wait for autosave, destroy all scenes, unload assets and close the window, if open.
+         *
+         * Called automatically when window is closed.
+         */
+        void Shutdown();
+
+        /**
+         * @brief Run simulation at fixed rate, independent of frame rate.
+         *
+         * Frame time is accumulated and consumed in fixed steps. If a frame is so long that more than
+         * maxTicksPerFrame steps are due, the remaining time is dropped - simulation slows down instead of spiralling.
+         * @param ticksPerSecond Simulation rate, in Hz.
+         * @param maxTicksPerFrame Maximum number of simulation steps executed in a single frame.
+         */
+        void SetFixedTimestep(float ticksPerSecond, unsigned int maxTicksPerFrame = 5);
+
+        /**
+         * @brief Update simulation once per frame with the frame's duration. This is the default.
+         */
+        void SetVariableTimestep();
+
+        /**
+         * @brief Retrieve current timestep mode.
+         */
+        [[nodiscard]] TimestepMode GetTimestepMode() const { return _timestepMode; }
+
+        /**
+         * @brief Retrieve duration of a single simulation step in Fixed mode.
+         */
+        [[nodiscard]] sf::Time GetFixedTimestep() const { return _fixedTimestep; }
+
+        /**
+         * @brief Retrieve number of simulation steps executed in the current frame.
+         */
+        [[nodiscard]] unsigned int GetTicksThisFrame() const { return _ticksThisFrame; }
+
+        /**
+         * @brief Retrieve interpolation factor for the current frame.
+         *
+         * Fraction of a step that has accumulated, but wasn't simulated yet. Used to blend sprites between
+         * previous and current simulation state. Always 1 in Variable mode.
+         */
+        [[nodiscard]] float GetInterpolationAlpha() const { return _interpolationAlpha; }
+
         /**
          * @brief Draws the game.
          *
          * This function clears the window, draws the current scene on the Window.
          * It can also take additional callback functions to be executed after drawing the scene.
+         * In headless mode scene is drawn into off-screen target, if there's one. Only callbacks accepting
+         * sf::RenderTarget& are then executed - callbacks that require the window are skipped.
          *
          * @tparam Extras The types of the additional callback functions.
          * @param callbackChain The additional callback functions to be executed after scene is prepared but before displaying.
          */
         template<typename... Extras>
-            requires (std::is_invocable_r_v<void, Extras, sf::RenderWindow&> && ...)
+            requires ((std::is_invocable_r_v<void, Extras, sf::RenderWindow&> || std::is_invocable_r_v<void, Extras, sf::RenderTarget&>) && ...)
         void Draw(Extras&&... callbackChain) {
+            if (_renderThread.IsRunning()) {
+                PublishRenderSnapshot();
+                return;
+            }
+
+            if (_headless) {
+                if (_offscreenTarget == nullptr) return;
+
+                _offscreenTarget->clear();
+                Scenes.GetCurrentScene()->Draw(*_offscreenTarget, _interpolationAlpha);
+                (DrawOffscreen(std::forward<Extras>(callbackChain)), ...);
+                _offscreenTarget->display();
+                return;
+            }
+
             Window.clear();
-            Scenes.GetCurrentScene()->Draw(Window);
+            Scenes.GetCurrentScene()->Draw(Window, _interpolationAlpha);
             (std::forward<Extras>(callbackChain)(Window), ...);
             Window.display();
         }
@@ -105,6 +263,18 @@ namespace LowEngine {
     protected:
         sf::Clock _clock;
 
+        bool _running = false;
+        bool _headless = false;
+        std::unique_ptr<sf::RenderTexture> _offscreenTarget;
+        RenderThread _renderThread;
+
+        TimestepMode _timestepMode = TimestepMode::Variable;
+        sf::Time _fixedTimestep = sf::seconds(1.0f / 30.0f);
+        unsigned int _maxTicksPerFrame = 5;
+        sf::Time _accumulator = sf::Time::Zero;
+        unsigned int _ticksThisFrame = 0;
+        float _interpolationAlpha = 1.0f;
+
         /**
          * @brief Updates the game state.
          *
@@ -115,10 +285,27 @@ namespace LowEngine {
          */
         void Update(float deltaTime);
 
+        /**
+         * @brief Advance simulation by the time of current frame, according to timestep mode.
+         */
+        void Simulate();
+
         void StartLog();
 
         void StopLog();
 
         void OnWindowClosed();
+
+        /**
+         * @brief Publish snapshot of current scene to render thread and wait for next simulation step, if it's not due yet.
+         */
+        void PublishRenderSnapshot();
+
+        template<typename Extra>
+        void DrawOffscreen(Extra&& extra) {
+            if constexpr (std::is_invocable_r_v<void, Extra, sf::RenderTarget&>) {
+                std::forward<Extra>(extra)(*_offscreenTarget);
+            }
+        }
     };
 }
@@ -4,6 +4,27 @@ namespace LowEngine {
     // Define the static shared pointer. Instance created in Game's constructor
     std::shared_ptr<spdlog::logger> _log = nullptr;
 
+    // subsystem loggers exist from the start without sinks, so engine parts used before Game (or without it) can log
+    std::shared_ptr<spdlog::logger> _logEcs = std::make_shared<spdlog::logger>("ecs");
+    std::shared_ptr<spdlog::logger> _logAssets = std::make_shared<spdlog::logger>("assets");
+    std::shared_ptr<spdlog::logger> _logNav = std::make_shared<spdlog::logger>("nav");
+    std::shared_ptr<spdlog::logger> _logInput = std::make_shared<spdlog::logger>("input");
+
+    void AttachSubsystemLoggers(const std::shared_ptr<spdlog::logger>& parent) {
+        for (auto* logger: {&_logEcs, &_logAssets, &_logNav, &_logInput}) {
+            auto attached = std::make_shared<spdlog::logger>((*logger)->name(), parent->sinks().begin(), parent->sinks().end());
+            attached->set_level(parent->level());
+            attached->flush_on(parent->flush_level());
+            *logger = attached;
+        }
+    }
+
+    void DetachSubsystemLoggers() {
+        for (auto* logger: {&_logEcs, &_logAssets, &_logNav, &_logInput}) {
+            *logger = std::make_shared<spdlog::logger>((*logger)->name());
+        }
+    }
+
     const char* DemangledTypeName(const std::type_index& type) {
         const char* typeName = type.name(); // MSVC name is demangled by default
 #if defined(__GNUC__) || defined(__clang__) || defined(__MINGW32__) || defined(__MINGW64__)
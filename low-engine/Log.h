@@ -18,12 +18,90 @@
 #include <cxxabi.h>
 #endif
 
+/*
+ * Compile-time thresholds of subsystem loggers. Debug and trace calls made with LOW_LOG_DEBUG / LOW_LOG_TRACE below
+ * the threshold are removed by the compiler - arguments are not even evaluated. Each subsystem defaults to
+ * SPDLOG_ACTIVE_LEVEL (set by LOW_ENGINE_LOG_LEVEL in CMake) and can be overridden with its own definition,
+ * e.g. -DLOWENGINE_LOG_LEVEL_ECS=SPDLOG_LEVEL_INFO.
+ */
+#ifndef LOWENGINE_LOG_LEVEL_ECS
+	#define LOWENGINE_LOG_LEVEL_ECS SPDLOG_ACTIVE_LEVEL
+#endif
+#ifndef LOWENGINE_LOG_LEVEL_ASSETS
+	#define LOWENGINE_LOG_LEVEL_ASSETS SPDLOG_ACTIVE_LEVEL
+#endif
+#ifndef LOWENGINE_LOG_LEVEL_NAV
+	#define LOWENGINE_LOG_LEVEL_NAV SPDLOG_ACTIVE_LEVEL
+#endif
+#ifndef LOWENGINE_LOG_LEVEL_INPUT
+	#define LOWENGINE_LOG_LEVEL_INPUT SPDLOG_ACTIVE_LEVEL
+#endif
+
+/**
+ * @brief Log with a subsystem logger, if level is not compiled out for that subsystem.
+ * @param subsystem One of: Ecs, Assets, Nav, Input.
+ * @param severity spdlog level name in capitals, e.g. DEBUG.
+ */
+#define LOW_LOG(subsystem, severity, ...) \
+	do { \
+		if constexpr (SPDLOG_LEVEL_##severity >= LowEngine::LogThreshold::subsystem) { \
+			LowEngine::_log##subsystem->log(static_cast<spdlog::level::level_enum>(SPDLOG_LEVEL_##severity), __VA_ARGS__); \
+		} \
+	} while (false)
+
+#define LOW_LOG_TRACE(subsystem, ...) LOW_LOG(subsystem, TRACE, __VA_ARGS__)
+#define LOW_LOG_DEBUG(subsystem, ...) LOW_LOG(subsystem, DEBUG, __VA_ARGS__)
+
 namespace LowEngine {
     /**
      * @brief Logger instance for the engine.
      */
     extern LOWENGINE_API std::shared_ptr<spdlog::logger> _log;
 
+    /**
+     * @brief Logger for entities, components and their memory. Busiest one - called for every spawned entity.
+     */
+    extern LOWENGINE_API std::shared_ptr<spdlog::logger> _logEcs;
+
+    /**
+     * @brief Logger for loading, caching and evicting assets.
+     */
+    extern LOWENGINE_API std::shared_ptr<spdlog::logger> _logAssets;
+
+    /**
+     * @brief Logger for navigation grids and path finding.
+     */
+    extern LOWENGINE_API std::shared_ptr<spdlog::logger> _logNav;
+
+    /**
+     * @brief Logger for input actions and bindings.
+     */
+    extern LOWENGINE_API std::shared_ptr<spdlog::logger> _logInput;
+
+    /**
+     * @brief Compile-time thresholds of subsystem loggers, used by LOW_LOG.
+     */
+    namespace LogThreshold {
+        inline constexpr int Ecs = LOWENGINE_LOG_LEVEL_ECS;
+        inline constexpr int Assets = LOWENGINE_LOG_LEVEL_ASSETS;
+        inline constexpr int Nav = LOWENGINE_LOG_LEVEL_NAV;
+        inline constexpr int Input = LOWENGINE_LOG_LEVEL_INPUT;
+    }
+
+    /**
+     * @brief Make subsystem loggers write to the same sinks as the engine logger, starting with its levels.
+     *
+     * Until called, subsystem loggers discard everything. Game does it on start - tools creating _log themselves
+     * should call it afterwards. Levels of subsystem loggers can be changed separately later on.
+     * @param parent Engine logger.
+     */
+    void AttachSubsystemLoggers(const std::shared_ptr<spdlog::logger>& parent);
+
+    /**
+     * @brief Make subsystem loggers discard everything again, releasing sinks shared with the engine logger.
+     */
+    void DetachSubsystemLoggers();
+
     /**
      * @brief Helper function to make type names readable.
      * @param type The type index of the type to demangle.
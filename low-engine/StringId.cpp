@@ -0,0 +1,57 @@
+#include "StringId.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "Log.h"
+
+namespace LowEngine {
+    namespace {
+        /**
+         * @brief Global table of interned strings. Read much more often than written.
+         */
+        struct StringTable {
+            std::shared_mutex Mutex;
+            std::unordered_map<uint32_t, std::string> Strings;
+        };
+
+        StringTable& GetTable() {
+            static StringTable table;
+            return table;
+        }
+    }
+
+    StringId StringId::Intern(std::string_view text) {
+        StringId id(text);
+        auto& table = GetTable();
+
+        {
+            std::shared_lock lock(table.Mutex);
+            auto it = table.Strings.find(id._value);
+            if (it != table.Strings.end()) {
+                if (it->second != text && _log) {
+                    _log->error("String '{}' has the same id {:08x} as '{}'", text, id._value, it->second);
+                }
+                return id;
+            }
+        }
+
+        std::unique_lock lock(table.Mutex);
+        table.Strings.try_emplace(id._value, text);
+        return id;
+    }
+
+    std::string StringId::GetString() const {
+        auto& table = GetTable();
+
+        std::shared_lock lock(table.Mutex);
+        auto it = table.Strings.find(_value);
+        if (it != table.Strings.end()) {
+            return it->second;
+        }
+        return fmt::format("#{:08x}", _value);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace LowEngine {
+    /**
+     * @brief 32-bit identifier of a string, used as a key instead of the string itself.
+     *
+     * Value is FNV-1a hash of the string, so it can be computed at compile time from literals (see operator""_sid)
+     * and compared, or hashed, as a plain integer. Strings are registered in a global table by Intern(),
+     * so the text can be recovered for logs, saves and tooling. Collisions are detected and reported when interning.
+     */
+    class StringId {
+    public:
+        constexpr StringId() = default;
+
+        /**
+         * @brief Hash the string. Text is not registered - use Intern() for strings that need to be read back.
+         */
+        constexpr explicit StringId(std::string_view text) : _value(Hash(text)) {
+        }
+
+        /**
+         * @brief Hash the string and register its text in the global table. Thread-safe.
+         */
+        static StringId Intern(std::string_view text);
+
+        /**
+         * @brief 32-bit FNV-1a hash.
+         */
+        static constexpr uint32_t Hash(std::string_view text) {
+            uint32_t hash = 2166136261u;
+            for (char c: text) {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        [[nodiscard]] constexpr uint32_t GetValue() const { return _value; }
+
+        /**
+         * @brief Check if identifier was created from a string. Default constructed identifier is invalid.
+         */
+        [[nodiscard]] constexpr bool IsValid() const { return _value != 0; }
+
+        /**
+         * @brief Retrieve interned text of this identifier. Thread-safe.
+         * @return Text of the string. If it was never interned, hexadecimal value of the identifier.
+         */
+        [[nodiscard]] std::string GetString() const;
+
+        constexpr bool operator==(const StringId& other) const = default;
+
+    protected:
+        uint32_t _value = 0;
+    };
+
+    /**
+     * @brief Identifier of a string literal, computed at compile time: `"FindPath"_sid`.
+     */
+    consteval StringId operator""_sid(const char* text, size_t length) {
+        return StringId(std::string_view(text, length));
+    }
+}
+
+namespace std {
+    /**
+     * @brief Hash specialization for StringId, required by unordered_map. Value already is a hash.
+     */
+    template<>
+    struct hash<LowEngine::StringId> {
+        std::size_t operator()(const LowEngine::StringId& id) const noexcept {
+            return id.GetValue();
+        }
+    };
+}
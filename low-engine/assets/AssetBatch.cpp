@@ -0,0 +1,71 @@
+#include "AssetBatch.h"
+
+#include <algorithm>
+
+#include "Assets.h"
+
+namespace LowEngine {
+    size_t AssetBatch::LoadTexture(const std::string& path, const std::string& alias) {
+        Add(Assets::LoadTextureAsync(path, alias));
+        return _requests.back().Id;
+    }
+
+    size_t AssetBatch::LoadTextureWithSpriteSheet(const std::string& path, const std::string& alias,
+                                                  size_t frameWidth, size_t frameHeight,
+                                                  size_t frameCountX, size_t frameCountY) {
+        size_t textureId = LoadTexture(path, alias);
+        Assets::AddSpriteSheet(textureId, frameWidth, frameHeight, frameCountX, frameCountY);
+
+        return textureId;
+    }
+
+    size_t AssetBatch::LoadSound(const std::string& path, const std::string& alias) {
+        Add(Assets::LoadSoundAsync(path, alias));
+        return _requests.back().Id;
+    }
+
+    size_t AssetBatch::LoadTileMap(const std::string& path, const std::string& alias,
+                                   const std::vector<Terrain::LayerDefinition>& definitions) {
+        Add(Assets::LoadTileMapAsync(path, alias, definitions));
+        return _requests.back().Id;
+    }
+
+    void AssetBatch::Add(const AssetRequest& request) {
+        if (_requests.empty()) {
+            _clock.restart();
+        }
+        _requests.push_back(request);
+    }
+
+    bool AssetBatch::Wait() {
+        while (!IsReady()) {
+            if (Assets::ProcessPendingUploads() == 0 && !IsReady()) {
+                Assets::WaitForPendingUploads(sf::milliseconds(10));
+            }
+        }
+
+        size_t failed = GetFailedCount();
+        _log->info("Asset batch of {} assets loaded in {:.2f} ms ({} failed)",
+                   _requests.size(), _clock.getElapsedTime().asSeconds() * 1000.0f, failed);
+
+        return failed == 0;
+    }
+
+    bool AssetBatch::IsReady() const {
+        return std::ranges::all_of(_requests, [](const AssetRequest& request) { return request.IsReady(); });
+    }
+
+    float AssetBatch::GetProgress() const {
+        if (_requests.empty()) return 1.0f;
+
+        auto ready = std::ranges::count_if(_requests, [](const AssetRequest& request) { return request.IsReady(); });
+        return static_cast<float>(ready) / static_cast<float>(_requests.size());
+    }
+
+    size_t AssetBatch::GetFailedCount() const {
+        auto failed = std::ranges::count_if(_requests, [](const AssetRequest& request) {
+            return request.IsReady() && !request.Loaded.get();
+        });
+        return static_cast<size_t>(failed);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SFML/System/Clock.hpp"
+
+#include "AssetRequest.h"
+#include "terrain/LayerDefinition.h"
+
+namespace LowEngine {
+    /**
+     * @brief Group of assets loaded in the background, that can be waited on as a whole.
+     *
+     * All loads are started right away and run in parallel on loader threads. Methods return reserved IDs,
+     * so the rest of setup (sprite sheets, animation clips, layer definitions) can be done before assets are ready.
+     * Must be used on the main thread.
+     */
+    class AssetBatch {
+    public:
+        AssetBatch() = default;
+
+        /**
+         * @brief Load texture with alias.
+         * @param path Path to the texture file
+         * @param alias Alias that will be used to access the texture. Empty for none.
+         * @return Reserved texture ID
+         */
+        size_t LoadTexture(const std::string& path, const std::string& alias = "");
+
+        /**
+         * @brief Load texture with alias and create animation sheet for it.
+         * @param path Path to the texture file
+         * @param alias Alias that will be used to access the texture
+         * @param frameWidth Width of a single frame in pixels
+         * @param frameHeight Height of a single frame in pixels
+         * @param frameCountX Number of frames in X direction
+         * @param frameCountY Number of frames in Y direction
+         * @return Reserved texture ID
+         */
+        size_t LoadTextureWithSpriteSheet(const std::string& path, const std::string& alias,
+                                          size_t frameWidth, size_t frameHeight,
+                                          size_t frameCountX, size_t frameCountY);
+
+        /**
+         * @brief Load sound with alias.
+         * @param path Path to the sound file
+         * @param alias Alias that will be used to access the sound. Empty for none.
+         * @return Reserved sound ID
+         */
+        size_t LoadSound(const std::string& path, const std::string& alias = "");
+
+        /**
+         * @brief Load tile map with alias. Textures used by definitions can be part of the same batch.
+         * @param path Path to the map file (*.ldtkl)
+         * @param alias Alias that will be used to access the map. Empty for none.
+         * @param definitions Vector for each layer to map texture and Animations Clips.
+         * @return Reserved map ID
+         */
+        size_t LoadTileMap(const std::string& path, const std::string& alias, const std::vector<Terrain::LayerDefinition>& definitions);
+
+        /**
+         * @brief Add request made directly through Assets.
+         */
+        void Add(const AssetRequest& request);
+
+        /**
+         * @brief Finish uploads until all assets in the batch are loaded.
+         * @return True if all assets were loaded successfully.
+         */
+        bool Wait();
+
+        /**
+         * @brief Are all assets in the batch finished, either successfully or not?
+         */
+        [[nodiscard]] bool IsReady() const;
+
+        /**
+         * @brief Retrieve fraction of finished requests, from 0 to 1. Useful for loading screens.
+         */
+        [[nodiscard]] float GetProgress() const;
+
+        /**
+         * @brief Retrieve number of requests that finished with an error.
+         */
+        [[nodiscard]] size_t GetFailedCount() const;
+
+        /**
+         * @brief Retrieve all requests in the batch.
+         */
+        [[nodiscard]] const std::vector<AssetRequest>& GetRequests() const { return _requests; }
+
+    protected:
+        std::vector<AssetRequest> _requests;
+
+        /**
+         * @brief Measures time since the first request was added.
+         */
+        sf::Clock _clock;
+    };
+}
@@ -0,0 +1,266 @@
+#include "AssetCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
+
+#include "serialization/MappedFile.h"
+
+namespace LowEngine {
+    namespace {
+        constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ull;
+
+        uint64_t Mix(uint64_t hash) {
+            hash ^= hash >> 32;
+            hash *= HASH_MULTIPLIER;
+            hash ^= hash >> 29;
+            return hash;
+        }
+    }
+
+    std::string AssetCache::CanonicalPath(const std::string& path) {
+        std::error_code error;
+        auto canonical = std::filesystem::weakly_canonical(path, error);
+        if (error) {
+            return std::filesystem::path(path).lexically_normal().generic_string();
+        }
+        return canonical.generic_string();
+    }
+
+    bool AssetCache::HashFile(const std::string& path, uint64_t& hash) {
+        Serialization::MappedFile file;
+        if (!file.Open(path)) return false;
+
+        // word at a time - files are hashed on every first load, so this needs to keep up with disk reads
+        auto data = file.Data();
+        hash = Mix(data.size() ^ HASH_MULTIPLIER);
+
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data.data() + i, sizeof(word));
+            hash = Combine(hash, word);
+        }
+
+        uint64_t tail = 0;
+        std::memcpy(&tail, data.data() + i, data.size() - i);
+        hash = Combine(hash, tail);
+        return true;
+    }
+
+    uint64_t AssetCache::Combine(uint64_t hash, uint64_t value) {
+        return Mix(hash ^ (value + HASH_MULTIPLIER + (hash << 6) + (hash >> 2)));
+    }
+
+    size_t AssetCache::FindPath(const std::string& key) const {
+        auto it = _paths.find(key);
+        return it == _paths.end() ? Config::MAX_SIZE : it->second;
+    }
+
+    size_t AssetCache::FindContent(uint64_t hash) const {
+        auto it = _contents.find(hash);
+        return it == _contents.end() ? Config::MAX_SIZE : it->second;
+    }
+
+    void AssetCache::AddPath(const std::string& key, size_t id, std::shared_future<bool> loaded) {
+        _paths[key] = id;
+        if (loaded.valid()) {
+            _loaded[id] = std::move(loaded);
+        }
+    }
+
+    void AssetCache::AddContent(uint64_t hash, size_t id) {
+        _contents[hash] = id;
+    }
+
+    void AssetCache::Track(size_t id, const std::string& path, size_t bytes) {
+        Entry& entry = _entries[id];
+        if (entry.Resident) {
+            _stats.ResidentBytes -= entry.Bytes;
+        }
+
+        entry.Path = path;
+        entry.Bytes = bytes;
+        entry.Resident = true;
+        _stats.ResidentBytes += bytes;
+        UpdateEvictable(id, entry);
+    }
+
+    std::string AssetCache::GetPath(size_t id) const {
+        auto it = _entries.find(id);
+        return it == _entries.end() ? std::string() : it->second.Path;
+    }
+
+    bool AssetCache::Touch(size_t id) {
+        auto it = _entries.find(id);
+        if (it == _entries.end()) return true;
+
+        // pinned or referenced before its async load finished - there's nothing to load again yet
+        Entry& entry = it->second;
+        if (!entry.Resident && entry.Path.empty()) return true;
+
+        if (!entry.Resident) {
+            _stats.Misses++;
+            return false;
+        }
+
+        _stats.Hits++;
+        if (entry.InLru) {
+            _leastRecentlyUsed.splice(_leastRecentlyUsed.end(), _leastRecentlyUsed, entry.LruPosition);
+        }
+        return true;
+    }
+
+    void AssetCache::MarkResident(size_t id, size_t bytes) {
+        auto it = _entries.find(id);
+        if (it == _entries.end() || it->second.Resident) return;
+
+        it->second.Bytes = bytes;
+        it->second.Resident = true;
+        _stats.ResidentBytes += bytes;
+        UpdateEvictable(id, it->second);
+    }
+
+    void AssetCache::Pin(size_t id) {
+        Entry& entry = _entries[Resolve(id)];
+        entry.Pinned = true;
+        UpdateEvictable(Resolve(id), entry);
+    }
+
+    std::vector<size_t> AssetCache::CollectEvictions(size_t keep) {
+        std::vector<size_t> evicted;
+
+        auto it = _leastRecentlyUsed.begin();
+        while (_stats.ResidentBytes > _budget && it != _leastRecentlyUsed.end()) {
+            size_t id = *it;
+            if (id == keep) {
+                ++it;
+                continue;
+            }
+
+            Entry& entry = _entries[id];
+            it = _leastRecentlyUsed.erase(it);
+            entry.InLru = false;
+            entry.Resident = false;
+            _stats.ResidentBytes -= entry.Bytes;
+            _stats.Evictions++;
+            evicted.push_back(id);
+        }
+
+        return evicted;
+    }
+
+    void AssetCache::Redirect(size_t id, size_t target) {
+        target = Resolve(target);
+        _redirects[id] = target;
+
+        // Resolve() follows a single redirect - IDs already redirected to id move on to target
+        for (auto& [source, redirect]: _redirects) {
+            if (redirect == id) redirect = target;
+        }
+
+        // references and pin of the reserved ID now belong to the target's storage
+        auto it = _entries.find(id);
+        if (it != _entries.end()) {
+            Entry& entry = _entries[target];
+            entry.References += it->second.References;
+            entry.Pinned = entry.Pinned || it->second.Pinned;
+            if (it->second.InLru) {
+                _leastRecentlyUsed.erase(it->second.LruPosition);
+            }
+            if (it->second.Resident) {
+                _stats.ResidentBytes -= it->second.Bytes;
+            }
+            _entries.erase(id);
+            UpdateEvictable(target, entry);
+        }
+    }
+
+    std::vector<size_t> AssetCache::GetRedirectsTo(size_t target) const {
+        std::vector<size_t> ids;
+        for (auto& [source, redirect]: _redirects) {
+            if (redirect == target) ids.push_back(source);
+        }
+        return ids;
+    }
+
+    std::shared_future<bool> AssetCache::GetLoaded(size_t id) const {
+        auto it = _loaded.find(id);
+        return it == _loaded.end() ? std::shared_future<bool>() : it->second;
+    }
+
+    void AssetCache::RecordHit(size_t id, bool byContent) {
+        if (byContent) {
+            _stats.ContentHits++;
+        } else {
+            _stats.PathHits++;
+        }
+
+        auto entry = _entries.find(Resolve(id));
+        if (entry != _entries.end()) {
+            _stats.BytesSaved += entry->second.Bytes;
+        }
+    }
+
+    void AssetCache::Acquire(size_t id) {
+        size_t storageId = Resolve(id);
+        Entry& entry = _entries[storageId];
+        entry.References++;
+        UpdateEvictable(storageId, entry);
+    }
+
+    size_t AssetCache::Release(size_t id) {
+        size_t storageId = Resolve(id);
+        auto it = _entries.find(storageId);
+        if (it == _entries.end() || it->second.References == 0) return 0;
+
+        it->second.References--;
+        UpdateEvictable(storageId, it->second);
+        return it->second.References;
+    }
+
+    void AssetCache::Remove(size_t id) {
+        std::unordered_set<size_t> removed = {id};
+        for (auto& [from, to]: _redirects) {
+            if (to == id) removed.insert(from);
+        }
+
+        std::erase_if(_paths, [&removed](const auto& entry) { return removed.contains(entry.second); });
+        std::erase_if(_contents, [&removed](const auto& entry) { return removed.contains(entry.second); });
+        for (size_t removedId: removed) {
+            _redirects.erase(removedId);
+            _loaded.erase(removedId);
+
+            auto entry = _entries.find(removedId);
+            if (entry == _entries.end()) continue;
+            if (entry->second.InLru) {
+                _leastRecentlyUsed.erase(entry->second.LruPosition);
+            }
+            if (entry->second.Resident) {
+                _stats.ResidentBytes -= entry->second.Bytes;
+            }
+            _entries.erase(entry);
+        }
+    }
+
+    void AssetCache::Clear() {
+        _paths.clear();
+        _contents.clear();
+        _redirects.clear();
+        _loaded.clear();
+        _entries.clear();
+        _leastRecentlyUsed.clear();
+        _stats = AssetCacheStats();
+    }
+
+    void AssetCache::UpdateEvictable(size_t id, Entry& entry) {
+        bool evictable = entry.Resident && !entry.Pinned && entry.References == 0;
+        if (evictable && !entry.InLru) {
+            entry.LruPosition = _leastRecentlyUsed.insert(_leastRecentlyUsed.end(), id);
+            entry.InLru = true;
+        } else if (!evictable && entry.InLru) {
+            _leastRecentlyUsed.erase(entry.LruPosition);
+            entry.InLru = false;
+        }
+    }
+}
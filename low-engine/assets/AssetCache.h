@@ -0,0 +1,256 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Config.h"
+
+namespace LowEngine {
+    /**
+     * @brief Counters of a single asset cache.
+     */
+    struct AssetCacheStats {
+        /**
+         * @brief Number of files that were actually decoded.
+         */
+        size_t Loads = 0;
+        /**
+         * @brief Number of loads answered with an asset already loaded from the same path.
+         */
+        size_t PathHits = 0;
+        /**
+         * @brief Number of loads answered with an asset loaded from a different path with identical content.
+         */
+        size_t ContentHits = 0;
+        /**
+         * @brief Memory that duplicates would have taken, in bytes.
+         */
+        size_t BytesSaved = 0;
+        /**
+         * @brief Memory taken by assets that are currently loaded, in bytes.
+         */
+        size_t ResidentBytes = 0;
+        /**
+         * @brief Number of accesses to assets that were loaded.
+         */
+        size_t Hits = 0;
+        /**
+         * @brief Number of accesses to evicted assets, that had to be loaded again.
+         */
+        size_t Misses = 0;
+        /**
+         * @brief Number of assets evicted to stay within memory budget.
+         */
+        size_t Evictions = 0;
+    };
+
+    /**
+     * @brief Deduplication cache that sits in front of a single asset category in Assets.
+     *
+     * Assets are found by canonical path first, and by hash of file's content second - so the same file
+     * loaded twice, or copied under a different name, is stored only once.
+     *
+     * Async loads reserve their ID before content is known. If content turns out to be a duplicate, reserved ID is
+     * redirected to the existing asset - Resolve() returns ID of the storage that holds the data.
+     *
+     * Cache also tracks residency of every loaded asset. Assets that are not pinned and have no references are kept
+     * in least-recently-used order, and are the ones chosen for eviction once resident memory exceeds the budget.
+     * Evicted assets stay known by path and content, so they can be loaded again on next access.
+     *
+     * Not thread-safe. Used only on the main thread.
+     */
+    class AssetCache {
+    public:
+        /**
+         * @brief Normalize path, so different spellings of the same file produce the same key.
+         */
+        static std::string CanonicalPath(const std::string& path);
+
+        /**
+         * @brief Hash content of a file. Safe to call from loader threads.
+         * @param path Path to the file.
+         * @param[out] hash Hash of file's content.
+         * @return True if successful. False if file could not be read.
+         */
+        static bool HashFile(const std::string& path, uint64_t& hash);
+
+        /**
+         * @brief Mix value into a hash, i.e. to make cache keys depend on load parameters.
+         */
+        static uint64_t Combine(uint64_t hash, uint64_t value);
+
+        /**
+         * @brief Find asset loaded from provided path.
+         * @param key Canonical path, possibly extended with load parameters.
+         * @return ID of the asset. Config::MAX_SIZE if not found.
+         */
+        [[nodiscard]] size_t FindPath(const std::string& key) const;
+
+        /**
+         * @brief Find asset with provided content hash.
+         * @return ID of the asset. Config::MAX_SIZE if not found.
+         */
+        [[nodiscard]] size_t FindContent(uint64_t hash) const;
+
+        /**
+         * @brief Register path of a loaded, or reserved, asset.
+         * @param key Canonical path, possibly extended with load parameters.
+         * @param id ID of the asset.
+         * @param loaded Becomes ready once the asset is loaded. Returned to repeated async requests.
+         */
+        void AddPath(const std::string& key, size_t id, std::shared_future<bool> loaded);
+
+        /**
+         * @brief Register content of a loaded asset.
+         */
+        void AddContent(uint64_t hash, size_t id);
+
+        /**
+         * @brief Register asset that was loaded into its storage.
+         * @param id ID of the storage.
+         * @param path Path the asset was loaded from. Used to load it again after eviction.
+         * @param bytes Memory taken by the asset.
+         */
+        void Track(size_t id, const std::string& path, size_t bytes);
+
+        /**
+         * @brief Path the asset was loaded from. Empty if asset is not tracked.
+         */
+        [[nodiscard]] std::string GetPath(size_t id) const;
+
+        /**
+         * @brief Count an access to the asset and mark it as recently used.
+         * @return False if asset was evicted and has to be loaded again.
+         */
+        bool Touch(size_t id);
+
+        /**
+         * @brief Mark evicted asset as loaded again.
+         */
+        void MarkResident(size_t id, size_t bytes);
+
+        /**
+         * @brief Protect asset from eviction, i.e. when it was loaded by API that returns raw IDs.
+         */
+        void Pin(size_t id);
+
+        /**
+         * @brief Choose least recently used assets to evict, until resident memory fits the budget.
+         *
+         * Chosen assets are marked as evicted - caller must release their storage.
+         * @param keep ID of an asset that must not be evicted, i.e. the one just loaded.
+         * @return IDs of storage to release.
+         */
+        std::vector<size_t> CollectEvictions(size_t keep = Config::MAX_SIZE);
+
+        /**
+         * @brief Maximum memory taken by assets of this category, in bytes. Pinned and referenced assets can exceed it.
+         */
+        void SetBudget(size_t bytes) { _budget = bytes; }
+
+        [[nodiscard]] size_t GetBudget() const { return _budget; }
+
+        /**
+         * @brief Make ID share storage of another asset, i.e. reserved ID of a duplicate or texture packed into an atlas.
+         */
+        void Redirect(size_t id, size_t target);
+
+        /**
+         * @brief Retrieve IDs redirected to provided storage, i.e. reserved IDs of its duplicates.
+         */
+        [[nodiscard]] std::vector<size_t> GetRedirectsTo(size_t target) const;
+
+        /**
+         * @brief Retrieve ID of the storage that holds asset's data.
+         */
+        [[nodiscard]] size_t Resolve(size_t id) const {
+            if (_redirects.empty()) return id;
+
+            auto it = _redirects.find(id);
+            return it == _redirects.end() ? id : it->second;
+        }
+
+        /**
+         * @brief Retrieve future of the load that produced the asset. Invalid if asset is not in the cache.
+         */
+        [[nodiscard]] std::shared_future<bool> GetLoaded(size_t id) const;
+
+        /**
+         * @brief Count a load that was answered from the cache.
+         * @param id ID of the cached asset.
+         * @param byContent True if asset was found by content, false if by path.
+         */
+        void RecordHit(size_t id, bool byContent);
+
+        /**
+         * @brief Count a load that decoded a file.
+         */
+        void RecordLoad() { _stats.Loads++; }
+
+        /**
+         * @brief Add a reference to the asset. Referenced assets are never evicted.
+         */
+        void Acquire(size_t id);
+
+        /**
+         * @brief Drop a reference to the asset. Unpinned asset without references becomes a candidate for eviction.
+         * @return Number of references left.
+         */
+        size_t Release(size_t id);
+
+        /**
+         * @brief Forget an asset, i.e. when it's unloaded or failed to load.
+         *
+         * Paths, content and redirects of IDs that share its storage are forgotten too.
+         */
+        void Remove(size_t id);
+
+        /**
+         * @brief Forget everything and reset counters. Budget is kept.
+         */
+        void Clear();
+
+        [[nodiscard]] const AssetCacheStats& GetStats() const { return _stats; }
+
+    protected:
+        /**
+         * @brief Residency of a single asset storage.
+         */
+        struct Entry {
+            std::string Path;
+            size_t Bytes = 0;
+            size_t References = 0;
+            bool Pinned = false;
+            bool Resident = false;
+            /**
+             * @brief Position in _leastRecentlyUsed. Valid only if InLru is set.
+             */
+            std::list<size_t>::iterator LruPosition;
+            bool InLru = false;
+        };
+
+        std::unordered_map<std::string, size_t> _paths;
+        std::unordered_map<uint64_t, size_t> _contents;
+        std::unordered_map<size_t, size_t> _redirects;
+        std::unordered_map<size_t, std::shared_future<bool>> _loaded;
+        std::unordered_map<size_t, Entry> _entries;
+
+        /**
+         * @brief Resident assets that can be evicted, least recently used first.
+         */
+        std::list<size_t> _leastRecentlyUsed;
+        size_t _budget = std::numeric_limits<size_t>::max();
+
+        AssetCacheStats _stats;
+
+        /**
+         * @brief Add or remove asset from eviction candidates, depending on its state.
+         */
+        void UpdateEvictable(size_t id, Entry& entry);
+    };
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <utility>
+
+#include "Config.h"
+#include "AssetRequest.h"
+
+namespace sf {
+    class Texture;
+    class SoundBuffer;
+}
+
+namespace LowEngine {
+    namespace Terrain {
+        class TileMap;
+    }
+
+    /**
+     * @brief Category of assets stored as type T.
+     */
+    template<typename T>
+    struct AssetTypeOf;
+
+    template<>
+    struct AssetTypeOf<sf::Texture> {
+        static constexpr AssetType Value = AssetType::Texture;
+    };
+
+    template<>
+    struct AssetTypeOf<sf::SoundBuffer> {
+        static constexpr AssetType Value = AssetType::Sound;
+    };
+
+    template<>
+    struct AssetTypeOf<Terrain::TileMap> {
+        static constexpr AssetType Value = AssetType::TileMap;
+    };
+
+    /**
+     * @brief Reference counted handle to an asset, returned by Assets::AcquireTexture() and similar.
+     *
+     * Asset is kept in memory as long as any handle refers to it. Afterwards it can be evicted when its category
+     * exceeds memory budget - and it's loaded again on next access, so IDs taken from handles stay valid.
+     *
+     * Handles must be created, copied and destroyed on the main thread.
+     */
+    template<typename T>
+    class AssetHandle {
+    public:
+        AssetHandle() = default;
+
+        AssetHandle(const AssetHandle& other);
+
+        AssetHandle(AssetHandle&& other) noexcept : _id(std::exchange(other._id, Config::MAX_SIZE)) {
+        }
+
+        AssetHandle& operator=(AssetHandle other) noexcept {
+            std::swap(_id, other._id);
+            return *this;
+        }
+
+        ~AssetHandle() {
+            Reset();
+        }
+
+        /**
+         * @brief Drop the reference. Handle becomes empty.
+         */
+        void Reset();
+
+        [[nodiscard]] bool IsValid() const { return _id != Config::MAX_SIZE; }
+
+        /**
+         * @brief ID of the asset, usable with Assets getters and Components.
+         */
+        [[nodiscard]] size_t GetId() const { return _id; }
+
+        /**
+         * @brief Retrieve the asset, loading it again if it was evicted. Throws if handle is empty.
+         */
+        T& Get() const;
+
+        T& operator*() const { return Get(); }
+
+        T* operator->() const { return &Get(); }
+
+    protected:
+        friend class Assets;
+
+        /**
+         * @brief Create handle and add a reference to the asset.
+         */
+        explicit AssetHandle(size_t id);
+
+        size_t _id = Config::MAX_SIZE;
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <string>
+
+#include "Config.h"
+
+namespace LowEngine {
+    /**
+     * @brief Type of asset loaded asynchronously.
+     */
+    enum class AssetType {
+        Texture,
+        Sound,
+        TileMap
+    };
+
+    /**
+     * @brief Handle to an asset that is being loaded in the background.
+     *
+     * Asset's ID (and alias) is reserved when the request is made, so it can be used right away - i.e. to add
+     * sprite sheets and animation clips or to reference texture in a LayerDefinition. Asset itself stays empty
+     * until it's uploaded on the main thread by Assets::ProcessPendingUploads().
+     */
+    struct AssetRequest {
+        /**
+         * @brief Type of requested asset.
+         */
+        AssetType Type = AssetType::Texture;
+
+        /**
+         * @brief Reserved ID of the asset. Config::MAX_SIZE if request could not be made.
+         */
+        size_t Id = Config::MAX_SIZE;
+
+        /**
+         * @brief Path of the file being loaded.
+         */
+        std::string Path;
+
+        /**
+         * @brief Becomes ready after asset was uploaded on the main thread. Holds true if asset was loaded successfully.
+         *
+         * Don't block on it on the main thread - uploads happen there, so it would never become ready.
+         * Use AssetBatch::Wait() instead.
+         */
+        std::shared_future<bool> Loaded;
+
+        /**
+         * @brief Is loading finished, either successfully or not?
+         */
+        [[nodiscard]] bool IsReady() const {
+            return Loaded.valid() && Loaded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        /**
+         * @brief Is loading finished and was the asset loaded successfully?
+         */
+        [[nodiscard]] bool Succeeded() const {
+            return IsReady() && Loaded.get();
+        }
+    };
+}
@@ -2,7 +2,49 @@
 
 #include "Config.h"
 
+#include "SFML/Audio/InputSoundFile.hpp"
+#include "SFML/System/Clock.hpp"
+#include "atlas/SkylinePacker.h"
+#include "terrain/CookedMap.h"
+
 namespace LowEngine {
+    namespace {
+        std::shared_future<bool> ReadyFuture(bool value) {
+            std::promise<bool> promise;
+            promise.set_value(value);
+            return promise.get_future().share();
+        }
+
+        /**
+         * @brief Request for an asset that was found in the cache - it shares state of the original load.
+         */
+        AssetRequest CachedRequest(AssetType type, size_t id, const std::string& path, std::shared_future<bool> loaded) {
+            AssetRequest request;
+            request.Type = type;
+            request.Id = id;
+            request.Path = path;
+            request.Loaded = loaded.valid() ? std::move(loaded) : ReadyFuture(true);
+            return request;
+        }
+
+        /**
+         * @brief Cache key of a map - the same file loaded with different definitions is a different map.
+         */
+        uint64_t HashMapDefinitions(const std::vector<Terrain::LayerDefinition>& definitions) {
+            uint64_t hash = 0;
+            for (auto& definition: definitions) {
+                hash = AssetCache::Combine(hash, Terrain::CookedMap::HashDefinition(definition));
+                hash = AssetCache::Combine(hash, definition.TextureId);
+            }
+            return hash;
+        }
+
+        size_t EstimateMapBytes(const Terrain::TileMap& map) {
+            return (map.TerrainLayer.Cells.size() + map.FeaturesLayer.Cells.size()) * 2 * sizeof(size_t) +
+                   map.NavGrid.GetMemorySize();
+        }
+    }
+
     Assets::Assets() {
         // create default texture
         sf::Image defaultImage;
@@ -13,9 +55,9 @@ namespace LowEngine {
             throw std::runtime_error("Failed to load default texture!");
         }
         _textures.emplace_back(std::move(defaultTexture));
-        _textureAliases["default"] = 0;
+        _textureAliases[StringId::Intern("default")] = 0;
 
-        _log->debug("Generated default texture with id {}", 0);
+        LOW_LOG_DEBUG(Assets, "Generated default texture with id {}", 0);
 
         // create default sound
         sf::SoundBuffer defaultSound;
@@ -40,9 +82,9 @@ namespace LowEngine {
             throw std::runtime_error("Failed to load default sound!");
         }
         _sounds.emplace_back(std::move(defaultSound));
-        _soundAliases["default"] = 0;
+        _soundAliases[StringId::Intern("default")] = 0;
 
-        _log->debug("Generated default sound with id {}", 0);
+        LOW_LOG_DEBUG(Assets, "Generated default sound with id {}", 0);
 
         // create default font
         sf::Font defaultFont;
@@ -52,16 +94,63 @@ namespace LowEngine {
         }
         _fonts.emplace_back(std::move(defaultFont));
 
-        _log->debug("Generated default font with id {}", _fonts.size() - 1);
+        LOW_LOG_DEBUG(Assets, "Generated default font with id {}", _fonts.size() - 1);
+
+        _textureCache.SetBudget(Config::TEXTURE_MEMORY_BUDGET);
+        _soundCache.SetBudget(Config::SOUND_MEMORY_BUDGET);
+        _mapCache.SetBudget(Config::MAP_MEMORY_BUDGET);
     }
 
     size_t Assets::LoadTexture(const std::string& path) {
+        auto assets = GetInstance();
+        size_t id = assets->LoadTextureData(path);
+        if (id != Config::MAX_SIZE) {
+            // raw IDs are not reference counted - such textures are never evicted
+            assets->_textureCache.Pin(id);
+            assets->EnforceBudget(AssetType::Texture, id);
+        }
+        return id;
+    }
+
+    size_t Assets::LoadTextureData(const std::string& path) {
+        auto assets = GetInstance();
+        auto key = AssetCache::CanonicalPath(path);
+
+        size_t cached = assets->_textureCache.FindPath(key);
+        if (cached != Config::MAX_SIZE) {
+            assets->_textureCache.RecordHit(cached, false);
+            assets->EnsureResident(AssetType::Texture, cached);
+            LOW_LOG_DEBUG(Assets, "Texture {} already loaded with id {}", path, cached);
+            return cached;
+        }
+
+        uint64_t hash = 0;
+        bool hashed = AssetCache::HashFile(path, hash);
+        if (hashed) {
+            cached = assets->_textureCache.FindContent(hash);
+            if (cached != Config::MAX_SIZE) {
+                assets->_textureCache.AddPath(key, cached, {});
+                assets->_textureCache.RecordHit(cached, true);
+                assets->EnsureResident(AssetType::Texture, cached);
+                LOW_LOG_DEBUG(Assets, "Texture {} has the same content as texture with id {}", path, cached);
+                return cached;
+            }
+        }
+
         try {
             sf::Texture texture(path);
-            GetInstance()->_textures.emplace_back(std::move(texture));
-            size_t index = static_cast<int>(GetInstance()->_textures.size() - 1);
+            size_t bytes = static_cast<size_t>(texture.getSize().x) * texture.getSize().y * 4;
+            assets->_textures.emplace_back(std::move(texture));
+            size_t index = assets->_textures.size() - 1;
+
+            assets->_textureCache.RecordLoad();
+            assets->_textureCache.AddPath(key, index, ReadyFuture(true));
+            assets->_textureCache.Track(index, path, bytes);
+            if (hashed) {
+                assets->_textureCache.AddContent(hash, index);
+            }
 
-            _log->debug("New texture loaded: {} with id {}", path, index);
+            LOW_LOG_DEBUG(Assets, "New texture loaded: {} with id {}", path, index);
 
             return index;
         } catch (sf::Exception& ex) {
@@ -74,10 +163,10 @@ namespace LowEngine {
     size_t Assets::LoadTexture(const std::string& path, const std::string& alias) {
         size_t index = LoadTexture(path);
         if (index != Config::MAX_SIZE) {
-            GetInstance()->_textureAliases[alias] = index;
+            SetAlias(GetInstance()->_textureAliases, alias, index, "Texture");
         }
 
-        _log->debug("Texture with id {} loaded with alias '{}'", index, alias);
+        LOW_LOG_DEBUG(Assets, "Texture with id {} loaded with alias '{}'", index, alias);
 
         return index;
     }
@@ -114,8 +203,12 @@ namespace LowEngine {
             sheet.FrameSize = sf::Vector2(frameWidth, frameHeight);
             sheet.FrameCount = sf::Vector2(frameCountX, frameCountY);
 
-            _log->debug("Animation sheet added for texture id: {} with frame size: {}x{} and frame count: {}x{}",
+            LOW_LOG_DEBUG(Assets, "Animation sheet added for texture id: {} with frame size: {}x{} and frame count: {}x{}",
                         textureId, frameWidth, frameHeight, frameCountX, frameCountY);
+        } else if (it->second.FrameSize == sf::Vector2(frameWidth, frameHeight) &&
+                   it->second.FrameCount == sf::Vector2(frameCountX, frameCountY)) {
+            // texture returned from cache by a repeated load - the same sheet is already there
+            LOW_LOG_DEBUG(Assets, "Texture with id: {} already has the same animation sheet.", textureId);
         } else {
             _log->error("Texture with id: {} already has an animation sheet.", textureId);
         }
@@ -123,13 +216,7 @@ namespace LowEngine {
 
     void Assets::AddSpriteSheet(const std::string& textureAlias, size_t frameWidth, size_t frameHeight,
                                 size_t frameCountX, size_t frameCountY) {
-        if (GetInstance()->_textureAliases.find(textureAlias) == GetInstance()->_textureAliases.end()) {
-            _log->error("Texture alias {} does not exist", textureAlias);
-            throw std::runtime_error("Texture alias does not exist");
-        }
-
-        AddSpriteSheet(GetInstance()->_textureAliases[textureAlias], frameWidth, frameHeight, frameCountX,
-                       frameCountY);
+        AddSpriteSheet(GetTextureId(textureAlias), frameWidth, frameHeight, frameCountX, frameCountY);
     }
 
     void Assets::AddAnimationClip(size_t textureId, const std::string& name, size_t firstFrameIndex,
@@ -144,104 +231,173 @@ namespace LowEngine {
         firstFrameOrigin.y = firstFrameIndex / animSheet->second.FrameCount.x * animSheet->second.FrameSize.y;
         GetInstance()->_animationSheets[textureId].AddAnimationClip(name, firstFrameIndex, frameCount, frameDuration, firstFrameOrigin);
 
-        _log->debug("Animation clip added for texture id: {} with name: '{}' and frame count: {}",
+        LOW_LOG_DEBUG(Assets, "Animation clip added for texture id: {} with name: '{}' and frame count: {}",
                     textureId, name, frameCount);
     }
 
     void Assets::AddAnimationClip(const std::string& textureAlias, const std::string& name,
                                   size_t firstFrameIndex,
                                   size_t frameCount, float frameDuration) {
-        if (GetInstance()->_textureAliases.find(textureAlias) == GetInstance()->_textureAliases.end()) {
-            _log->error("Texture alias {} does not exist", textureAlias);
-            throw std::runtime_error("Texture alias does not exist");
-        }
-
-        AddAnimationClip(GetInstance()->_textureAliases[textureAlias], name, firstFrameIndex, frameCount,
-                         frameDuration);
+        AddAnimationClip(GetTextureId(textureAlias), name, firstFrameIndex, frameCount, frameDuration);
     }
 
     size_t Assets::LoadTileMap(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions) {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            _log->error("Failed to load terrain file: {}", path);
-            throw std::runtime_error("Failed to load terrain");
-        }
+        auto assets = GetInstance();
+        size_t id = assets->LoadTileMapData(path, definitions);
 
-        // get layer definitions
-        const Terrain::LayerDefinition* terrainLayerDefinition = nullptr;
-        const Terrain::LayerDefinition* featuresLayerDefinition = nullptr;
+        // every load is a user of the map, until UnloadTileMap()
+        assets->_mapCache.Acquire(id);
+        assets->EnforceBudget(AssetType::TileMap, id);
+        return id;
+    }
 
-        for (auto& definition: definitions) {
-            switch (definition.Type) {
-                case Terrain::Terrain:
-                    terrainLayerDefinition = &definition;
-                    break;
-                case Terrain::Features:
-                    featuresLayerDefinition = &definition;
-                    break;
-                default:
-                    _log->error("Invalid layer definition type: '{}'", LayerTypeToString(definition.Type));
-                    throw std::runtime_error("Invalid layer definition type");
-            }
+    size_t Assets::LoadTileMapData(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions) {
+        auto assets = GetInstance();
+        uint64_t definitionsHash = HashMapDefinitions(definitions);
+        auto key = fmt::format("{}#{:016x}", AssetCache::CanonicalPath(path), definitionsHash);
+
+        size_t cached = assets->_mapCache.FindPath(key);
+        if (cached != Config::MAX_SIZE) {
+            assets->_mapCache.RecordHit(cached, false);
+            assets->EnsureResident(AssetType::TileMap, cached);
+            LOW_LOG_DEBUG(Assets, "Map {} already loaded with id {}", path, cached);
+            return cached;
         }
 
-        nlohmann::json jsonData;
-        file >> jsonData;
+        uint64_t hash = 0;
+        bool hashed = AssetCache::HashFile(path, hash);
+        hash = AssetCache::Combine(hash, definitionsHash);
+        if (hashed) {
+            cached = assets->_mapCache.FindContent(hash);
+            if (cached != Config::MAX_SIZE) {
+                assets->_mapCache.AddPath(key, cached, {});
+                assets->_mapCache.RecordHit(cached, true);
+                assets->EnsureResident(AssetType::TileMap, cached);
+                LOW_LOG_DEBUG(Assets, "Map {} has the same content as map with id {}", path, cached);
+                return cached;
+            }
+        }
 
         Terrain::TileMap map(GetDefaultTexture());
-        map.LoadFromLDTkJson(jsonData);
-
-        if (terrainLayerDefinition != nullptr) {
-            LoadTerrainLayerData(terrainLayerDefinition, map);
-            ReadNavDataForLayer(map, map.TerrainLayer, terrainLayerDefinition);
-        }
-        if (featuresLayerDefinition != nullptr) {
-            LoadFeatureLayerData(featuresLayerDefinition, map);
-            ReadNavDataForLayer(map, map.FeaturesLayer, featuresLayerDefinition);
+        bool cooked = false;
+        if (!ParseTileMap(path, definitions, map, cooked)) {
+            throw std::runtime_error("Failed to load terrain");
         }
 
-        GetInstance()->_maps.emplace_back(std::move(map));
-        size_t index = static_cast<int>(GetInstance()->_maps.size() - 1);
+        ApplyLayerDefinitions(definitions, map, cooked);
+
+        size_t bytes = EstimateMapBytes(map);
+        assets->_maps.emplace_back(std::move(map));
+        size_t index = assets->_maps.size() - 1;
 
-        _log->debug("New map loaded: {} with id {}", path, index);
+        assets->_mapDefinitions[index] = definitions;
+        assets->_mapCache.RecordLoad();
+        assets->_mapCache.AddPath(key, index, ReadyFuture(true));
+        assets->_mapCache.Track(index, path, bytes);
+        if (hashed) {
+            assets->_mapCache.AddContent(hash, index);
+        }
+
+        LOW_LOG_DEBUG(Assets, "New map loaded: {} with id {}", path, index);
 
         return index;
     }
 
     size_t Assets::LoadTileMap(const std::string& path, const std::string& alias, const std::vector<Terrain::LayerDefinition>& definitions) {
         size_t index = LoadTileMap(path, definitions);
-        if (index != -1) {
-            GetInstance()->_mapAliases[alias] = index;
+        if (index != Config::MAX_SIZE) {
+            SetAlias(GetInstance()->_mapAliases, alias, index, "Map");
         }
         return index;
     }
 
+    AssetHandle<sf::Texture> Assets::AcquireTexture(const std::string& path) {
+        size_t id = GetInstance()->LoadTextureData(path);
+        if (id == Config::MAX_SIZE) return {};
+
+        AssetHandle<sf::Texture> handle(id);
+        GetInstance()->EnforceBudget(AssetType::Texture, id);
+        return handle;
+    }
+
+    AssetHandle<sf::Texture> Assets::AcquireTexture(size_t textureId) {
+        if (textureId >= GetInstance()->_textures.size()) {
+            _log->error("Texture with id {} does not exist", textureId);
+            return {};
+        }
+
+        return AssetHandle<sf::Texture>(textureId);
+    }
+
+    AssetHandle<sf::SoundBuffer> Assets::AcquireSound(const std::string& path) {
+        size_t id = GetInstance()->LoadSoundData(path);
+        if (id == Config::MAX_SIZE) return {};
+
+        AssetHandle<sf::SoundBuffer> handle(id);
+        GetInstance()->EnforceBudget(AssetType::Sound, id);
+        return handle;
+    }
+
+    AssetHandle<Terrain::TileMap> Assets::AcquireTileMap(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions) {
+        size_t id = GetInstance()->LoadTileMapData(path, definitions);
+
+        AssetHandle<Terrain::TileMap> handle(id);
+        GetInstance()->EnforceBudget(AssetType::TileMap, id);
+        return handle;
+    }
+
     Terrain::TileMap& Assets::GetTileMap(size_t mapId) {
         if (GetInstance()->_maps.size() <= mapId) {
             _log->error("Map with id {} does not exist", mapId);
             throw std::runtime_error("Map with id does not exist");
         }
 
-        return GetInstance()->_maps[mapId];
+        return GetInstance()->_maps[GetInstance()->EnsureResident(AssetType::TileMap, mapId)];
     }
 
     Terrain::TileMap& Assets::GetTileMap(const std::string& mapAlias) {
-        auto map = GetInstance()->_mapAliases.find(mapAlias);
-        if (map == GetInstance()->_mapAliases.end()) {
-            _log->error("Map with alias {} does not exist", mapAlias);
-            throw std::runtime_error("Map with alias does not exist");
-        }
+        return GetTileMap(GetTileMapId(mapAlias));
+    }
 
-        return GetInstance()->_maps[map->second];
+    Terrain::TileMap& Assets::GetTileMap(StringId mapAlias) {
+        return GetTileMap(GetTileMapId(mapAlias));
     }
 
     size_t Assets::GetTileMapId(const std::string& mapAlias) {
-        auto map = GetInstance()->_mapAliases.find(mapAlias);
-        if (map == GetInstance()->_mapAliases.end()) {
-            _log->error("Map with alias {} does not exist", mapAlias);
-            throw std::runtime_error("Map with alias does not exist");
+        return FindAlias(GetInstance()->_mapAliases, StringId(mapAlias), "Map", mapAlias);
+    }
+
+    size_t Assets::GetTileMapId(StringId mapAlias) {
+        return FindAlias(GetInstance()->_mapAliases, mapAlias, "Map");
+    }
+
+    void Assets::UnloadTileMap(size_t mapId) {
+        auto assets = GetInstance();
+        if (assets->_maps.size() <= mapId) {
+            _log->error("Map with id {} does not exist", mapId);
+            throw std::runtime_error("Map with id does not exist");
+        }
+
+        // the same map could be returned to several loads by the cache - it's released only after the last one
+        size_t storageId = assets->_mapCache.Resolve(mapId);
+        size_t users = assets->_mapCache.Release(mapId);
+        if (users > 0) {
+            LOW_LOG_DEBUG(Assets, "Map with id {} is still used by {} loads", mapId, users);
+            return;
         }
-        return map->second;
+
+        assets->_maps[storageId] = Terrain::TileMap(GetDefaultTexture());
+        assets->_mapCache.Remove(storageId);
+        assets->_mapDefinitions.erase(storageId);
+        std::erase_if(assets->_mapAliases, [&](const auto& alias) { return alias.second == mapId || alias.second == storageId; });
+
+        LOW_LOG_DEBUG(Assets, "Map with id {} unloaded", mapId);
+    }
+
+    void Assets::UnloadTileMapWhenLoaded(const AssetRequest& request) {
+        if (request.Id == Config::MAX_SIZE) return;
+
+        GetInstance()->_orphanedMapRequests.push_back(request);
     }
 
     Animation::SpriteSheet* Assets::GetSpriteSheet(size_t textureId) {
@@ -253,11 +409,11 @@ namespace LowEngine {
     }
 
     Animation::SpriteSheet* Assets::GetSpriteSheet(const std::string& textureAlias) {
-        if (GetInstance()->_textureAliases.find(textureAlias) == GetInstance()->_textureAliases.end()) {
-            _log->error("Texture alias {} does not exist", textureAlias);
-            throw std::runtime_error("Texture alias does not exist");
-        }
-        return GetSpriteSheet(GetInstance()->_textureAliases[textureAlias]);
+        return GetSpriteSheet(GetTextureId(textureAlias));
+    }
+
+    Animation::SpriteSheet* Assets::GetSpriteSheet(StringId textureAlias) {
+        return GetSpriteSheet(GetTextureId(textureAlias));
     }
 
     sf::Texture& Assets::GetDefaultTexture() {
@@ -269,23 +425,154 @@ namespace LowEngine {
             _log->error("Texture with id {} does not exist", textureId);
             throw std::runtime_error("Texture with id does not exist");
         }
-        return GetInstance()->_textures[textureId];
+        return GetInstance()->_textures[GetInstance()->EnsureResident(AssetType::Texture, textureId)];
     }
 
     sf::Texture& Assets::GetTexture(const std::string& textureAlias) {
-        if (GetInstance()->_textureAliases.find(textureAlias) == GetInstance()->_textureAliases.end()) {
-            _log->error("Texture alias {} does not exist", textureAlias);
-            throw std::runtime_error("Texture alias does not exist");
-        }
-        return GetTexture(GetInstance()->_textureAliases[textureAlias]);
+        return GetTexture(GetTextureId(textureAlias));
+    }
+
+    sf::Texture& Assets::GetTexture(StringId textureAlias) {
+        return GetTexture(GetTextureId(textureAlias));
     }
 
     size_t Assets::GetTextureId(const std::string& textureAlias) {
-        if (GetInstance()->_textureAliases.find(textureAlias) == GetInstance()->_textureAliases.end()) {
-            _log->error("Texture alias {} does not exist", textureAlias);
-            throw std::runtime_error("Texture alias does not exist");
+        return FindAlias(GetInstance()->_textureAliases, StringId(textureAlias), "Texture", textureAlias);
+    }
+
+    size_t Assets::GetTextureId(StringId textureAlias) {
+        return FindAlias(GetInstance()->_textureAliases, textureAlias, "Texture");
+    }
+
+    sf::IntRect Assets::GetTextureRect(size_t textureId) {
+        auto assets = GetInstance();
+        auto region = assets->_atlasRegions.find(textureId);
+        if (region != assets->_atlasRegions.end()) {
+            return region->second;
+        }
+        return {{0, 0}, sf::Vector2i(GetTexture(textureId).getSize())};
+    }
+
+    Atlas::AtlasReport Assets::BuildAtlas(const std::vector<size_t>& textureIds, unsigned pageSize) {
+        auto assets = GetInstance();
+        Atlas::AtlasReport report;
+
+        struct Source {
+            size_t TextureId;
+            sf::Image Image;
+            size_t Page = 0;
+            sf::Vector2u Position;
+        };
+        std::vector<Source> sources;
+
+        const unsigned padding = Config::ATLAS_PADDING;
+        std::unordered_set<size_t> seen;
+        for (size_t textureId: textureIds) {
+            if (!seen.insert(textureId).second) continue;
+
+            bool valid = textureId != 0 && textureId < assets->_textures.size() &&
+                         !assets->_texturesInFlight.contains(textureId) &&
+                         !assets->_atlasRegions.contains(textureId) &&
+                         assets->_textureCache.Resolve(textureId) == textureId;
+            if (!valid) {
+                _log->warn("Texture with id {} can't be packed into an atlas - it's default, loading, shared or already packed", textureId);
+                report.SkippedTextures++;
+                continue;
+            }
+
+            auto size = GetTexture(textureId).getSize();
+            if (size.x == 0 || size.y == 0 || size.x + padding > pageSize || size.y + padding > pageSize) {
+                _log->warn("Texture with id {} ({}x{}) does not fit into an atlas page of {}x{}", textureId, size.x, size.y, pageSize, pageSize);
+                report.SkippedTextures++;
+                continue;
+            }
+
+            sources.push_back({textureId, GetTexture(textureId).copyToImage()});
+        }
+
+        if (sources.empty()) return report;
+
+        // tallest first - skyline packs best when heights decrease
+        std::ranges::sort(sources, [](const Source& a, const Source& b) {
+            if (a.Image.getSize().y != b.Image.getSize().y) return a.Image.getSize().y > b.Image.getSize().y;
+            return a.Image.getSize().x > b.Image.getSize().x;
+        });
+
+        std::vector<Atlas::SkylinePacker> pages;
+        for (auto& source: sources) {
+            auto size = source.Image.getSize() + sf::Vector2u(padding, padding);
+
+            bool placed = false;
+            for (size_t page = 0; page < pages.size() && !placed; page++) {
+                if (pages[page].Insert(size, source.Position)) {
+                    source.Page = page;
+                    placed = true;
+                }
+            }
+            if (!placed) {
+                pages.emplace_back(sf::Vector2u(pageSize, pageSize));
+                pages.back().Insert(size, source.Position);
+                source.Page = pages.size() - 1;
+            }
+        }
+
+        size_t usedArea = 0;
+        size_t pageArea = 0;
+        for (size_t page = 0; page < pages.size(); page++) {
+            sf::Image pageImage;
+            pageImage.resize({pageSize, pages[page].GetUsedHeight()}, sf::Color::Transparent);
+            for (auto& source: sources) {
+                if (source.Page == page && !pageImage.copy(source.Image, source.Position)) {
+                    _log->error("Failed to copy texture with id {} into atlas page", source.TextureId);
+                }
+            }
+
+            sf::Texture pageTexture;
+            if (!pageTexture.loadFromImage(pageImage)) {
+                _log->error("Failed to create atlas page {}x{}", pageImage.getSize().x, pageImage.getSize().y);
+                throw std::runtime_error("Failed to create atlas page");
+            }
+
+            // pages can't be loaded again from a file - they are never evicted
+            size_t pageId = assets->_textures.size();
+            size_t bytes = static_cast<size_t>(pageImage.getSize().x) * pageImage.getSize().y * 4;
+            assets->_textures.emplace_back(std::move(pageTexture));
+            assets->_textureCache.Track(pageId, "", bytes);
+            assets->_textureCache.Pin(pageId);
+            report.PageTextureIds.push_back(pageId);
+
+            pageArea += bytes / 4;
+        }
+
+        for (auto& source: sources) {
+            size_t pageId = report.PageTextureIds[source.Page];
+            auto position = sf::Vector2i(source.Position);
+            auto size = sf::Vector2i(source.Image.getSize());
+            usedArea += static_cast<size_t>(size.x) * size.y;
+
+            // duplicates redirected to the source are packed with it
+            auto ids = assets->_textureCache.GetRedirectsTo(source.TextureId);
+            ids.push_back(source.TextureId);
+
+            assets->_textureCache.Redirect(source.TextureId, pageId);
+            assets->RetireTexture(source.TextureId);
+
+            for (size_t id: ids) {
+                assets->_atlasRegions[id] = sf::IntRect(position, size);
+
+                auto sheet = assets->_animationSheets.find(id);
+                if (sheet != assets->_animationSheets.end()) {
+                    sheet->second.SetOffset(sf::Vector2<size_t>(source.Position.x, source.Position.y));
+                }
+            }
         }
-        return GetInstance()->_textureAliases[textureAlias];
+
+        report.PackedTextures = sources.size();
+        report.Efficiency = pageArea > 0 ? static_cast<float>(usedArea) / static_cast<float>(pageArea) : 0.0f;
+
+        _log->info("Packed {} textures into {} atlas pages, {:.1f}% of atlas area used",
+                   report.PackedTextures, report.PageTextureIds.size(), report.Efficiency * 100.0f);
+        return report;
     }
 
     sf::Font& Assets::GetDefaultFont() {
@@ -293,28 +580,70 @@ namespace LowEngine {
     }
 
     size_t Assets::LoadSound(const std::string& path) {
+        auto assets = GetInstance();
+        size_t id = assets->LoadSoundData(path);
+        if (id != Config::MAX_SIZE) {
+            assets->_soundCache.Pin(id);
+            assets->EnforceBudget(AssetType::Sound, id);
+        }
+        return id;
+    }
+
+    size_t Assets::LoadSoundData(const std::string& path) {
+        auto assets = GetInstance();
+        auto key = AssetCache::CanonicalPath(path);
+
+        size_t cached = assets->_soundCache.FindPath(key);
+        if (cached != Config::MAX_SIZE) {
+            assets->_soundCache.RecordHit(cached, false);
+            assets->EnsureResident(AssetType::Sound, cached);
+            LOW_LOG_DEBUG(Assets, "Sound {} already loaded with id {}", path, cached);
+            return cached;
+        }
+
+        uint64_t hash = 0;
+        bool hashed = AssetCache::HashFile(path, hash);
+        if (hashed) {
+            cached = assets->_soundCache.FindContent(hash);
+            if (cached != Config::MAX_SIZE) {
+                assets->_soundCache.AddPath(key, cached, {});
+                assets->_soundCache.RecordHit(cached, true);
+                assets->EnsureResident(AssetType::Sound, cached);
+                LOW_LOG_DEBUG(Assets, "Sound {} has the same content as sound with id {}", path, cached);
+                return cached;
+            }
+        }
+
         try {
             sf::SoundBuffer sound(path);
-            GetInstance()->_sounds.emplace_back(std::move(sound));
-            size_t index = static_cast<int>(GetInstance()->_sounds.size() - 1);
+            size_t bytes = sound.getSampleCount() * sizeof(std::int16_t);
+            assets->_sounds.emplace_back(std::move(sound));
+            size_t index = assets->_sounds.size() - 1;
+
+            assets->_soundCache.RecordLoad();
+            assets->_soundCache.AddPath(key, index, ReadyFuture(true));
+            assets->_soundCache.Track(index, path, bytes);
+            if (hashed) {
+                assets->_soundCache.AddContent(hash, index);
+            }
 
-            _log->debug("New sound loaded: {} with id {}", path, index);
+            LOW_LOG_DEBUG(Assets, "New sound loaded: {} with id {}", path, index);
 
             return index;
         } catch (sf::Exception& ex) {
             _log->error("Failed to load sound: {}", path);
             _log->error("Error: {}", ex.what());
-            return -1;
+            return Config::MAX_SIZE;
         }
     }
 
     size_t Assets::LoadSound(const std::string& path, const std::string& alias) {
         size_t index = LoadSound(path);
-        if (index != -1) {
-            GetInstance()->_soundAliases[alias] = index;
+        if (index != Config::MAX_SIZE) {
+            SetAlias(GetInstance()->_soundAliases, alias, index, "Sound");
         }
 
-        _log->debug("Sound with id {} loaded with alias '{}'", index, alias);
+        LOW_LOG_DEBUG(Assets, "Sound with id {} loaded with alias '{}'", index, alias);
 
         return index;
     }
@@ -329,131 +658,713 @@ namespace LowEngine {
             throw std::runtime_error("Sound with id does not exist");
         }
 
-        return GetInstance()->_sounds[soundId];
+        return GetInstance()->_sounds[GetInstance()->EnsureResident(AssetType::Sound, soundId)];
     }
 
     sf::SoundBuffer& Assets::GetSound(const std::string& soundAlias) {
-        if (GetInstance()->_soundAliases.find(soundAlias) == GetInstance()->_soundAliases.end()) {
-            _log->error("Sound alias {} does not exist", soundAlias);
-            throw std::runtime_error("Sound alias does not exist");
-        }
+        return GetSound(GetSoundId(soundAlias));
+    }
 
-        return GetSound(GetInstance()->_soundAliases[soundAlias]);
+    sf::SoundBuffer& Assets::GetSound(StringId soundAlias) {
+        return GetSound(GetSoundId(soundAlias));
     }
 
-    void Assets::UnloadAll() {
-        GetInstance()->_maps.clear();
-        GetInstance()->_mapAliases.clear();
+    size_t Assets::GetSoundId(const std::string& soundAlias) {
+        return FindAlias(GetInstance()->_soundAliases, StringId(soundAlias), "Sound", soundAlias);
+    }
 
-        GetInstance()->_textures.clear();
-        GetInstance()->_textureAliases.clear();
-        GetInstance()->_animationSheets.clear();
+    size_t Assets::GetSoundId(StringId soundAlias) {
+        return FindAlias(GetInstance()->_soundAliases, soundAlias, "Sound");
+    }
 
-        GetInstance()->_fonts.clear();
-        GetInstance()->_fontAliases.clear();
+    AssetRequest Assets::LoadTextureAsync(const std::string& path) {
+        return LoadTextureAsync(path, "");
+    }
 
-        GetInstance()->_sounds.clear();
-        GetInstance()->_soundAliases.clear();
+    AssetRequest Assets::LoadTextureAsync(const std::string& path, const std::string& alias) {
+        auto assets = GetInstance();
+        auto key = AssetCache::CanonicalPath(path);
+
+        size_t cached = assets->_textureCache.FindPath(key);
+        if (cached != Config::MAX_SIZE) {
+            assets->_textureCache.RecordHit(cached, false);
+            assets->_textureCache.Pin(cached);
+            assets->EnsureResident(AssetType::Texture, cached);
+            if (!alias.empty()) {
+                SetAlias(assets->_textureAliases, alias, cached, "Texture");
+            }
+            return CachedRequest(AssetType::Texture, cached, path, assets->_textureCache.GetLoaded(cached));
+        }
 
-        _log->info("All assets unloaded");
+        // reserve the slot, so ID can be used before texture is ready
+        size_t id = assets->_textures.size();
+        assets->_textures.emplace_back();
+        assets->_texturesInFlight.insert(id);
+        if (!alias.empty()) {
+            SetAlias(assets->_textureAliases, alias, id, "Texture");
+        }
+
+        std::shared_ptr<std::promise<bool>> promise;
+        AssetRequest request = assets->BeginRequest(AssetType::Texture, id, path, promise);
+        assets->_textureCache.AddPath(key, id, request.Loaded);
+        assets->_textureCache.Pin(id);
+
+        assets->GetLoaders().Submit([path, alias, id, promise]() {
+            uint64_t hash = 0;
+            bool hashed = AssetCache::HashFile(path, hash);
+            auto image = std::make_shared<sf::Image>();
+            bool decoded = image->loadFromFile(path);
+
+            PendingUpload upload;
+            upload.Promise = promise;
+            upload.Upload = [path, alias, id, image, decoded, hashed, hash]() {
+                auto assets = GetInstance();
+                assets->_texturesInFlight.erase(id);
+
+                // identical file under a different path - share its texture instead of uploading another copy
+                size_t duplicate = hashed ? assets->_textureCache.FindContent(hash) : Config::MAX_SIZE;
+                if (decoded && duplicate != Config::MAX_SIZE) {
+                    assets->_textureCache.Redirect(id, duplicate);
+                    assets->_textureCache.RecordHit(id, true);
+                    LOW_LOG_DEBUG(Assets, "Texture {} has the same content as texture with id {}", path, duplicate);
+                    return true;
+                }
+
+                if (decoded && assets->_textures[id].loadFromImage(*image)) {
+                    assets->_textureCache.RecordLoad();
+                    assets->_textureCache.Track(id, path, static_cast<size_t>(image->getSize().x) * image->getSize().y * 4);
+                    if (hashed) {
+                        assets->_textureCache.AddContent(hash, id);
+                    }
+                    assets->EnforceBudget(AssetType::Texture, id);
+                    LOW_LOG_DEBUG(Assets, "New texture loaded: {} with id {}", path, id);
+                    return true;
+                }
+
+                _log->error("Failed to load texture: {}", path);
+                assets->_textureCache.Remove(id);
+                if (!alias.empty()) {
+                    auto it = assets->_textureAliases.find(StringId(alias));
+                    if (it != assets->_textureAliases.end() && it->second == id) {
+                        assets->_textureAliases.erase(it);
+                    }
+                }
+                return false;
+            };
+            GetInstance()->QueueUpload(std::move(upload));
+        });
+
+        return request;
     }
 
-    void Assets::LoadTerrainLayerData(const Terrain::LayerDefinition* terrainLayerDefinition, Terrain::TileMap& map) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+    AssetRequest Assets::LoadSoundAsync(const std::string& path) {
+        return LoadSoundAsync(path, "");
+    }
 
-        size_t textureId = terrainLayerDefinition->TextureId;
+    AssetRequest Assets::LoadSoundAsync(const std::string& path, const std::string& alias) {
+        auto assets = GetInstance();
+        auto key = AssetCache::CanonicalPath(path);
+
+        size_t cached = assets->_soundCache.FindPath(key);
+        if (cached != Config::MAX_SIZE) {
+            assets->_soundCache.RecordHit(cached, false);
+            assets->_soundCache.Pin(cached);
+            assets->EnsureResident(AssetType::Sound, cached);
+            if (!alias.empty()) {
+                SetAlias(assets->_soundAliases, alias, cached, "Sound");
+            }
+            return CachedRequest(AssetType::Sound, cached, path, assets->_soundCache.GetLoaded(cached));
+        }
 
-        map.TerrainLayer.LoadTexture(textureId);
-        auto animSheet = GetSpriteSheet(textureId);
-        if (animSheet == nullptr) {
-            _log->error("Sprite sheet does not exist for texture id {}", textureId);
-            throw std::runtime_error("Sprite sheet does not exist");
+        size_t id = assets->_sounds.size();
+        assets->_sounds.emplace_back();
+        if (!alias.empty()) {
+            SetAlias(assets->_soundAliases, alias, id, "Sound");
         }
 
-        for (auto& cellDefinition: terrainLayerDefinition->CellDefinitions) {
-            for (auto animClipName: cellDefinition.second.AnimationClipNames) {
-                auto clip = animSheet->GetAnimationClip(animClipName);
-                if (clip == nullptr) {
-                    _log->error("Animation clip {} does not exist for texture id {}", animClipName, textureId);
-                    throw std::runtime_error("Animation clip does not exist");
+        std::shared_ptr<std::promise<bool>> promise;
+        AssetRequest request = assets->BeginRequest(AssetType::Sound, id, path, promise);
+        assets->_soundCache.AddPath(key, id, request.Loaded);
+        assets->_soundCache.Pin(id);
+
+        assets->GetLoaders().Submit([path, alias, id, promise]() {
+            uint64_t hash = 0;
+            bool hashed = AssetCache::HashFile(path, hash);
+
+            // decode whole file to samples - only handing them over to the audio device is left for the main thread
+            auto samples = std::make_shared<std::vector<std::int16_t>>();
+            unsigned int channelCount = 0;
+            unsigned int sampleRate = 0;
+            std::vector<sf::SoundChannel> channelMap;
+
+            sf::InputSoundFile file;
+            bool decoded = file.openFromFile(path);
+            if (decoded) {
+                channelCount = file.getChannelCount();
+                sampleRate = file.getSampleRate();
+                channelMap = file.getChannelMap();
+                samples->resize(file.getSampleCount());
+                decoded = file.read(samples->data(), samples->size()) == samples->size();
+            }
+
+            PendingUpload upload;
+            upload.Promise = promise;
+            upload.Upload = [path, alias, id, samples, channelCount, sampleRate, channelMap, decoded, hashed, hash]() {
+                auto assets = GetInstance();
+
+                size_t duplicate = hashed ? assets->_soundCache.FindContent(hash) : Config::MAX_SIZE;
+                if (decoded && duplicate != Config::MAX_SIZE) {
+                    assets->_soundCache.Redirect(id, duplicate);
+                    assets->_soundCache.RecordHit(id, true);
+                    LOW_LOG_DEBUG(Assets, "Sound {} has the same content as sound with id {}", path, duplicate);
+                    return true;
+                }
+
+                if (decoded && assets->_sounds[id].loadFromSamples(samples->data(), samples->size(), channelCount, sampleRate, channelMap)) {
+                    assets->_soundCache.RecordLoad();
+                    assets->_soundCache.Track(id, path, samples->size() * sizeof(std::int16_t));
+                    if (hashed) {
+                        assets->_soundCache.AddContent(hash, id);
+                    }
+                    assets->EnforceBudget(AssetType::Sound, id);
+                    LOW_LOG_DEBUG(Assets, "New sound loaded: {} with id {}", path, id);
+                    return true;
                 }
-                map.TerrainLayer.AnimatedTiles[cellDefinition.first].Clips.emplace_back(clip);
+
+                _log->error("Failed to load sound: {}", path);
+                assets->_soundCache.Remove(id);
+                if (!alias.empty()) {
+                    auto it = assets->_soundAliases.find(StringId(alias));
+                    if (it != assets->_soundAliases.end() && it->second == id) {
+                        assets->_soundAliases.erase(it);
+                    }
+                }
+                return false;
+            };
+            GetInstance()->QueueUpload(std::move(upload));
+        });
+
+        return request;
+    }
+
+    AssetRequest Assets::LoadTileMapAsync(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions) {
+        return LoadTileMapAsync(path, "", definitions);
+    }
+
+    AssetRequest Assets::LoadTileMapAsync(const std::string& path, const std::string& alias, const std::vector<Terrain::LayerDefinition>& definitions) {
+        // invalid definitions are a programming error - report them right away, same as LoadTileMap()
+        const Terrain::LayerDefinition* terrainLayerDefinition = nullptr;
+        const Terrain::LayerDefinition* featuresLayerDefinition = nullptr;
+        SelectLayerDefinitions(definitions, terrainLayerDefinition, featuresLayerDefinition);
+
+        auto assets = GetInstance();
+        uint64_t definitionsHash = HashMapDefinitions(definitions);
+        auto key = fmt::format("{}#{:016x}", AssetCache::CanonicalPath(path), definitionsHash);
+
+        size_t cached = assets->_mapCache.FindPath(key);
+        if (cached != Config::MAX_SIZE) {
+            assets->_mapCache.RecordHit(cached, false);
+            assets->_mapCache.Acquire(cached);
+            assets->EnsureResident(AssetType::TileMap, cached);
+            if (!alias.empty()) {
+                SetAlias(assets->_mapAliases, alias, cached, "Map");
             }
+            return CachedRequest(AssetType::TileMap, cached, path, assets->_mapCache.GetLoaded(cached));
+        }
+
+        size_t id = assets->_maps.size();
+        assets->_maps.emplace_back(GetDefaultTexture());
+        if (!alias.empty()) {
+            SetAlias(assets->_mapAliases, alias, id, "Map");
+        }
+
+        std::shared_ptr<std::promise<bool>> promise;
+        AssetRequest request = assets->BeginRequest(AssetType::TileMap, id, path, promise);
+        assets->_mapCache.AddPath(key, id, request.Loaded);
+        assets->_mapCache.Acquire(id);
+
+        std::vector<size_t> textureDependencies;
+        for (auto& definition: definitions) {
+            textureDependencies.push_back(definition.TextureId);
         }
 
-        for (size_t cellIndex = 0; cellIndex < map.TerrainLayer.Cells.size(); cellIndex++) {
-            auto cellValue = map.TerrainLayer.Cells[cellIndex];
-            if (cellValue != Config::MAX_SIZE) {
-                if (map.TerrainLayer.AnimatedTiles.size() > 1) {
-                    if (map.TerrainLayer.AnimatedTiles.find(cellValue) != map.TerrainLayer.AnimatedTiles.end()) {
-                        std::uniform_int_distribution<> dis(0, static_cast<int>(map.TerrainLayer.AnimatedTiles.size() - 1));
-                        size_t clipIndex = dis(gen);
-                        map.TerrainLayer.CellClipIndex[cellIndex] = clipIndex;
+        // loader threads must not touch Assets' containers - main thread may grow them at the same time
+        // elements of a deque don't move when it grows, so the pointer stays valid
+        const sf::Texture* defaultTexture = &GetDefaultTexture();
+
+        assets->GetLoaders().Submit([path, alias, id, promise, definitions, textureDependencies, definitionsHash, defaultTexture]() {
+            uint64_t hash = 0;
+            bool hashed = AssetCache::HashFile(path, hash);
+            hash = AssetCache::Combine(hash, definitionsHash);
+
+            auto map = std::make_shared<Terrain::TileMap>(*defaultTexture);
+            bool cooked = false;
+            bool parsed = ParseTileMap(path, definitions, *map, cooked);
+
+            PendingUpload upload;
+            upload.Promise = promise;
+            upload.TextureDependencies = textureDependencies;
+            upload.Upload = [path, alias, id, map, parsed, cooked, definitions, hashed, hash]() {
+                auto assets = GetInstance();
+
+                size_t duplicate = hashed ? assets->_mapCache.FindContent(hash) : Config::MAX_SIZE;
+                if (parsed && duplicate != Config::MAX_SIZE) {
+                    assets->_mapCache.Redirect(id, duplicate);
+                    assets->_mapCache.RecordHit(id, true);
+                    LOW_LOG_DEBUG(Assets, "Map {} has the same content as map with id {}", path, duplicate);
+                    return true;
+                }
+
+                if (parsed) {
+                    try {
+                        ApplyLayerDefinitions(definitions, *map, cooked);
+                        assets->_mapCache.RecordLoad();
+                        assets->_mapCache.Track(id, path, EstimateMapBytes(*map));
+                        if (hashed) {
+                            assets->_mapCache.AddContent(hash, id);
+                        }
+                        assets->_mapDefinitions[id] = definitions;
+                        assets->_maps[id] = std::move(*map);
+                        assets->EnforceBudget(AssetType::TileMap, id);
+
+                        LOW_LOG_DEBUG(Assets, "New map loaded: {} with id {}", path, id);
+                        return true;
+                    } catch (std::exception& ex) {
+                        _log->error("Error: {}", ex.what());
+                    }
+                }
+
+                _log->error("Failed to load terrain file: {}", path);
+                assets->_mapCache.Remove(id);
+                if (!alias.empty()) {
+                    auto it = assets->_mapAliases.find(StringId(alias));
+                    if (it != assets->_mapAliases.end() && it->second == id) {
+                        assets->_mapAliases.erase(it);
                     }
+                }
+                return false;
+            };
+            GetInstance()->QueueUpload(std::move(upload));
+        });
+
+        return request;
+    }
+
+    size_t Assets::ProcessPendingUploads(sf::Time budget) {
+        auto assets = GetInstance();
+        sf::Clock clock;
+        size_t finished = 0;
+
+        auto isOverBudget = [&]() {
+            return budget != sf::Time::Zero && clock.getElapsedTime() >= budget;
+        };
+
+        while (!isOverBudget()) {
+            PendingUpload upload;
+            {
+                std::lock_guard lock(assets->_uploadMutex);
+                if (assets->_pendingUploads.empty()) break;
+
+                upload = std::move(assets->_pendingUploads.front());
+                assets->_pendingUploads.pop_front();
+            }
+
+            if (assets->FinishUpload(upload)) {
+                finished++;
+            } else {
+                assets->_deferredUploads.emplace_back(std::move(upload));
+            }
+        }
+
+        // deferred uploads wait for textures - retry them until nothing changes
+        bool progress = true;
+        while (progress && !assets->_deferredUploads.empty() && !isOverBudget()) {
+            progress = false;
+            for (size_t i = 0; i < assets->_deferredUploads.size() && !isOverBudget();) {
+                if (assets->FinishUpload(assets->_deferredUploads[i])) {
+                    assets->_deferredUploads.erase(assets->_deferredUploads.begin() + static_cast<std::ptrdiff_t>(i));
+                    finished++;
+                    progress = true;
                 } else {
-                    map.TerrainLayer.CellClipIndex[cellIndex] = 0;
+                    i++;
                 }
             }
         }
+
+        std::erase_if(assets->_orphanedMapRequests, [](const AssetRequest& request) {
+            if (!request.IsReady()) return false;
+            if (request.Succeeded()) UnloadTileMap(request.Id);
+            return true;
+        });
+
+        return finished;
+    }
+
+    void Assets::WaitForPendingUploads(sf::Time timeout) {
+        auto assets = GetInstance();
+
+        std::unique_lock lock(assets->_uploadMutex);
+        assets->_uploadQueued.wait_for(lock, std::chrono::microseconds(timeout.asMicroseconds()),
+                                       [assets]() { return !assets->_pendingUploads.empty(); });
+    }
+
+    size_t Assets::GetPendingLoadCount() {
+        return GetInstance()->_loadsInFlight;
+    }
+
+    const AssetCacheStats& Assets::GetCacheStats(AssetType type) {
+        return GetInstance()->GetCache(type).GetStats();
+    }
+
+    void Assets::SetMemoryBudget(AssetType type, size_t bytes) {
+        auto assets = GetInstance();
+        assets->GetCache(type).SetBudget(bytes);
+        assets->EnforceBudget(type, Config::MAX_SIZE);
+    }
+
+    void Assets::SetRenderFrames(uint64_t nextFrame, uint64_t retiredFrame) {
+        auto assets = GetInstance();
+        assets->_nextRenderFrame = nextFrame;
+        assets->_retiredRenderFrame = retiredFrame;
+        assets->ReleaseRetiredTextures();
+    }
+
+    void Assets::RetireRenderTexture(std::unique_ptr<sf::RenderTexture> texture) {
+        auto assets = GetInstance();
+        if (texture == nullptr || assets->_retiredRenderFrame >= assets->_nextRenderFrame) return;
+
+        assets->_retiredRenderTextures.push_back({assets->_nextRenderFrame, std::move(texture)});
+    }
+
+    void Assets::AddReference(AssetType type, size_t id) {
+        GetInstance()->GetCache(type).Acquire(id);
+    }
+
+    void Assets::ReleaseReference(AssetType type, size_t id) {
+        auto assets = GetInstance();
+        if (assets->GetCache(type).Release(id) == 0) {
+            assets->EnforceBudget(type, Config::MAX_SIZE);
+        }
     }
 
-    void Assets::LoadFeatureLayerData(const Terrain::LayerDefinition* featuresLayerDefinition, Terrain::TileMap& map) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+    void Assets::LogCacheReport() {
+        auto logStats = [](const char* category, const AssetCacheStats& stats) {
+            constexpr double megabyte = 1024.0 * 1024.0;
+            _log->info("{}: {} loaded, {} duplicates by path, {} by content, {:.2f} MB saved",
+                       category, stats.Loads, stats.PathHits, stats.ContentHits,
+                       static_cast<double>(stats.BytesSaved) / megabyte);
+            _log->info("{}: {:.2f} MB resident, {} hits, {} misses, {} evictions",
+                       category, static_cast<double>(stats.ResidentBytes) / megabyte,
+                       stats.Hits, stats.Misses, stats.Evictions);
+        };
+
+        _log->info("Asset cache report:");
+        logStats("Textures", GetCacheStats(AssetType::Texture));
+        logStats("Sounds", GetCacheStats(AssetType::Sound));
+        logStats("Maps", GetCacheStats(AssetType::TileMap));
+    }
+
+    void Assets::UnloadAll() {
+        auto assets = GetInstance();
+
+        // loader threads reference reserved slots - let them finish before slots are gone
+        if (assets->_loaders) {
+            assets->_loaders->WaitIdle();
+        }
+        {
+            std::lock_guard lock(assets->_uploadMutex);
+            for (auto& upload: assets->_pendingUploads) {
+                upload.Promise->set_value(false);
+            }
+            assets->_pendingUploads.clear();
+        }
+        for (auto& upload: assets->_deferredUploads) {
+            upload.Promise->set_value(false);
+        }
+        assets->_deferredUploads.clear();
+        assets->_orphanedMapRequests.clear();
+        assets->_texturesInFlight.clear();
+        assets->_loadsInFlight = 0;
+        assets->_retiredTextures.clear();
+        assets->_retiredRenderTextures.clear();
+
+        assets->_maps.clear();
+        assets->_mapAliases.clear();
+        assets->_mapDefinitions.clear();
+        assets->_mapCache.Clear();
+        assets->_textureCache.Clear();
+        assets->_soundCache.Clear();
+
+        // defaults are created once, in constructor - new Components would reference destroyed ones
+        assets->_textures.erase(assets->_textures.begin() + 1, assets->_textures.end());
+        assets->_textureAliases.clear();
+        assets->_textureAliases[StringId::Intern("default")] = 0;
+        assets->_animationSheets.clear();
+        assets->_atlasRegions.clear();
+
+        assets->_fonts.erase(assets->_fonts.begin() + 1, assets->_fonts.end());
+        assets->_fontAliases.clear();
+
+        assets->_sounds.erase(assets->_sounds.begin() + 1, assets->_sounds.end());
+        assets->_soundAliases.clear();
+        assets->_soundAliases[StringId::Intern("default")] = 0;
+
+        _log->info("All assets unloaded");
+    }
 
-        size_t textureId = featuresLayerDefinition->TextureId;
+    void Assets::LoadLayerData(const Terrain::LayerDefinition& layerDefinition, Terrain::Layer& layer) {
+        size_t textureId = layerDefinition.TextureId;
 
-        map.FeaturesLayer.LoadTexture(textureId);
+        layer.LoadTexture(textureId);
         auto animSheet = GetSpriteSheet(textureId);
         if (animSheet == nullptr) {
             _log->error("Sprite sheet does not exist for texture id {}", textureId);
             throw std::runtime_error("Sprite sheet does not exist");
         }
 
-        for (auto& cellDefinition: featuresLayerDefinition->CellDefinitions) {
+        for (auto& cellDefinition: layerDefinition.CellDefinitions) {
             for (auto animClipName: cellDefinition.second.AnimationClipNames) {
                 auto clip = animSheet->GetAnimationClip(animClipName);
                 if (clip == nullptr) {
                     _log->error("Animation clip {} does not exist for texture id {}", animClipName, textureId);
                     throw std::runtime_error("Animation clip does not exist");
                 }
-                map.FeaturesLayer.AnimatedTiles[cellDefinition.first].Clips.emplace_back(clip);
+                layer.AnimatedTiles[cellDefinition.first].Clips.emplace_back(clip);
+            }
+        }
+    }
+
+    void Assets::SelectLayerDefinitions(const std::vector<Terrain::LayerDefinition>& definitions,
+                                        const Terrain::LayerDefinition*& terrainLayerDefinition,
+                                        const Terrain::LayerDefinition*& featuresLayerDefinition) {
+        for (auto& definition: definitions) {
+            switch (definition.Type) {
+                case Terrain::Terrain:
+                    terrainLayerDefinition = &definition;
+                    break;
+                case Terrain::Features:
+                    featuresLayerDefinition = &definition;
+                    break;
+                default:
+                    _log->error("Invalid layer definition type: '{}'", LayerTypeToString(definition.Type));
+                    throw std::runtime_error("Invalid layer definition type");
+            }
+        }
+    }
+
+    bool Assets::ParseTileMap(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions,
+                              Terrain::TileMap& map, bool& cooked) {
+        cooked = Terrain::CookedMap::IsCookedMap(path);
+        if (cooked) {
+            return Terrain::CookedMap::Load(path, definitions, map);
+        }
+
+        // streamed - building JSON document for the whole file would take several times its size in memory
+        if (!map.LoadFromLDTkFile(path)) {
+            _log->error("Failed to load terrain file: {}", path);
+            return false;
+        }
+
+        return true;
+    }
+
+    void Assets::ApplyLayerDefinitions(const std::vector<Terrain::LayerDefinition>& definitions, Terrain::TileMap& map, bool cooked) {
+        const Terrain::LayerDefinition* terrainLayerDefinition = nullptr;
+        const Terrain::LayerDefinition* featuresLayerDefinition = nullptr;
+        SelectLayerDefinitions(definitions, terrainLayerDefinition, featuresLayerDefinition);
+
+        if (terrainLayerDefinition != nullptr) {
+            LoadLayerData(*terrainLayerDefinition, map.TerrainLayer);
+            if (!cooked) {
+                map.TerrainLayer.AssignClipIndices(terrainLayerDefinition->GetClipCounts());
+                map.ReadNavData(map.TerrainLayer, *terrainLayerDefinition);
             }
         }
+        if (featuresLayerDefinition != nullptr) {
+            LoadLayerData(*featuresLayerDefinition, map.FeaturesLayer);
+            if (!cooked) {
+                map.FeaturesLayer.AssignClipIndices(featuresLayerDefinition->GetClipCounts());
+                map.ReadNavData(map.FeaturesLayer, *featuresLayerDefinition);
+            }
+        }
+
+        // cooked maps come with their regions
+        if (!cooked) {
+            map.NavGrid.BuildRegions();
+        }
+    }
+
+    AssetCache& Assets::GetCache(AssetType type) {
+        switch (type) {
+            case AssetType::Sound:
+                return _soundCache;
+            case AssetType::TileMap:
+                return _mapCache;
+            case AssetType::Texture:
+            default:
+                return _textureCache;
+        }
+    }
+
+    size_t Assets::EnsureResident(AssetType type, size_t id) {
+        size_t storageId = GetCache(type).Resolve(id);
+        if (!GetCache(type).Touch(storageId)) {
+            ReloadAsset(type, storageId);
+        }
+        return storageId;
+    }
 
-        for (size_t cellIndex = 0; cellIndex < map.FeaturesLayer.Cells.size(); cellIndex++) {
-            auto cellValue = map.FeaturesLayer.Cells[cellIndex];
-            if (cellValue != Config::MAX_SIZE) {
-                auto animTile = map.FeaturesLayer.AnimatedTiles.find(cellValue);
-                if (animTile != map.FeaturesLayer.AnimatedTiles.end()) {
-                    if (animTile->second.Clips.size() >= 2) {
-                        std::uniform_int_distribution<> dis(0, static_cast<int>(animTile->second.Clips.size() - 1));
-                        size_t clipIndex = dis(gen);
-                        map.FeaturesLayer.CellClipIndex[cellIndex] = clipIndex;
-                    } else {
-                        map.FeaturesLayer.CellClipIndex[cellIndex] = 0;
+    void Assets::ReloadAsset(AssetType type, size_t id) {
+        auto& cache = GetCache(type);
+        auto path = cache.GetPath(id);
+        size_t bytes = 0;
+        bool loaded = false;
+
+        switch (type) {
+            case AssetType::Texture: {
+                // evicted, but render thread didn't let go of it yet - its data is still there
+                auto retired = std::ranges::find(_retiredTextures, id, &RetiredTexture<size_t>::Texture);
+                if (retired != _retiredTextures.end()) {
+                    _retiredTextures.erase(retired);
+                    loaded = true;
+                } else {
+                    loaded = _textures[id].loadFromFile(path);
+                }
+                bytes = static_cast<size_t>(_textures[id].getSize().x) * _textures[id].getSize().y * 4;
+                break;
+            }
+            case AssetType::Sound:
+                loaded = _sounds[id].loadFromFile(path);
+                bytes = _sounds[id].getSampleCount() * sizeof(std::int16_t);
+                break;
+            case AssetType::TileMap: {
+                auto& definitions = _mapDefinitions[id];
+                Terrain::TileMap map(GetDefaultTexture());
+                bool cooked = false;
+                try {
+                    if (ParseTileMap(path, definitions, map, cooked)) {
+                        ApplyLayerDefinitions(definitions, map, cooked);
+                        bytes = EstimateMapBytes(map);
+                        _maps[id] = std::move(map);
+                        loaded = true;
                     }
+                } catch (std::exception& ex) {
+                    _log->error("Error: {}", ex.what());
                 }
+                break;
             }
         }
+
+        // failed reload keeps the empty asset - it's not retried on every access
+        if (!loaded) {
+            _log->error("Failed to reload evicted asset: {}", path);
+        } else {
+            LOW_LOG_DEBUG(Assets, "Evicted asset reloaded: {} with id {}", path, id);
+        }
+        cache.MarkResident(id, bytes);
+        EnforceBudget(type, id);
+    }
+
+    void Assets::RetireTexture(size_t id) {
+        if (_retiredRenderFrame >= _nextRenderFrame) {
+            _textures[id] = sf::Texture();
+            return;
+        }
+
+        _retiredTextures.push_back({_nextRenderFrame, id});
+        LOW_LOG_DEBUG(Assets, "Texture {} is released once render thread draws frame {}", id, _nextRenderFrame);
     }
 
-    void Assets::ReadNavDataForLayer(Terrain::TileMap& map, Terrain::Layer& layer, const Terrain::LayerDefinition* layerDefinition) {
-        for (size_t i = 0; i < map.NavGrid.Cells.size(); i++) {
-            auto& navCell = map.NavGrid.Cells[i];
-            navCell.Position.x = i % map.NavGrid.Width;
-            navCell.Position.y = i / map.NavGrid.Width;
+    void Assets::ReleaseRetiredTextures() {
+        std::erase_if(_retiredTextures, [this](const RetiredTexture<size_t>& retired) {
+            if (retired.Frame > _retiredRenderFrame) return false;
 
-            size_t terrainCellIndexType = layer.Cells[i];
-            if (terrainCellIndexType != Config::MAX_SIZE) {
-                auto& typeDefinition = layerDefinition->CellDefinitions.at(terrainCellIndexType);
+            _textures[retired.Texture] = sf::Texture();
+            return true;
+        });
+        std::erase_if(_retiredRenderTextures, [this](const RetiredTexture<std::unique_ptr<sf::RenderTexture>>& retired) {
+            return retired.Frame <= _retiredRenderFrame;
+        });
+    }
 
-                navCell.IsWalkable = typeDefinition.IsWalkable;
-                navCell.IsSwimmable = typeDefinition.IsSwimmable;
-                navCell.IsFlyable = typeDefinition.IsFlyable;
-                navCell.MoveCost = typeDefinition.MoveCost;
+    void Assets::EnforceBudget(AssetType type, size_t keep) {
+        for (size_t id: GetCache(type).CollectEvictions(keep)) {
+            switch (type) {
+                case AssetType::Texture:
+                    RetireTexture(id);
+                    break;
+                case AssetType::Sound:
+                    _sounds[id] = sf::SoundBuffer();
+                    break;
+                case AssetType::TileMap:
+                    _maps[id] = Terrain::TileMap(GetDefaultTexture());
+                    break;
             }
+            LOW_LOG_DEBUG(Assets, "Evicted asset {} to stay within memory budget", id);
+        }
+    }
+
+    void Assets::SetAlias(std::unordered_map<StringId, size_t>& aliases, const std::string& alias, size_t id, const char* category) {
+        auto key = StringId::Intern(alias);
+        auto it = aliases.find(key);
+        if (it != aliases.end() && it->second != id) {
+            _log->warn("{} alias '{}' was assigned to id {}, now reassigned to id {}", category, alias, it->second, id);
+        }
+        aliases[key] = id;
+    }
+
+    size_t Assets::FindAlias(const std::unordered_map<StringId, size_t>& aliases, StringId alias, const char* category,
+                             std::string_view name) {
+        auto it = aliases.find(alias);
+        if (it == aliases.end()) {
+            _log->error("{} alias {} does not exist", category, name.empty() ? alias.GetString() : std::string(name));
+            throw std::runtime_error(std::string(category) + " alias does not exist");
+        }
+        return it->second;
+    }
+
+    Threading::ThreadPool& Assets::GetLoaders() {
+        if (!_loaders) {
+            _loaders = std::make_unique<Threading::ThreadPool>();
+            LOW_LOG_DEBUG(Assets, "Started {} asset loader threads", _loaders->GetThreadCount());
+        }
+        return *_loaders;
+    }
+
+    AssetRequest Assets::BeginRequest(AssetType type, size_t id, const std::string& path, std::shared_ptr<std::promise<bool>>& promise) {
+        promise = std::make_shared<std::promise<bool>>();
+        _loadsInFlight++;
+
+        AssetRequest request;
+        request.Type = type;
+        request.Id = id;
+        request.Path = path;
+        request.Loaded = promise->get_future().share();
+        return request;
+    }
+
+    void Assets::QueueUpload(PendingUpload upload) {
+        {
+            std::lock_guard lock(_uploadMutex);
+            _pendingUploads.emplace_back(std::move(upload));
+        }
+        _uploadQueued.notify_all();
+    }
+
+    bool Assets::FinishUpload(PendingUpload& upload) {
+        for (size_t textureId: upload.TextureDependencies) {
+            if (_texturesInFlight.contains(textureId)) return false;
         }
+
+        bool success = false;
+        try {
+            success = upload.Upload();
+        } catch (std::exception& ex) {
+            _log->error("Failed to finish asset upload: {}", ex.what());
+        }
+
+        upload.Promise->set_value(success);
+        if (_loadsInFlight > 0) _loadsInFlight--;
+        return true;
     }
 }
@@ -1,20 +1,33 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <fstream>
 #include <random>
 
 #include "SFML/Graphics/Color.hpp"
 #include "SFML/Graphics/Image.hpp"
+#include "SFML/Graphics/RenderTexture.hpp"
 #include "SFML/Graphics/Texture.hpp"
 #include "SFML/System/Exception.hpp"
+#include "SFML/System/Time.hpp"
 #include "nlohmann/json.hpp"
 
 #include "Log.h"
+#include "StringId.h"
 
+#include "AssetCache.h"
+#include "AssetHandle.h"
+#include "AssetRequest.h"
+#include "atlas/AtlasReport.h"
 #include "animation/SpriteSheet.h"
 #include "terrain/TileMap.h"
 
@@ -24,12 +37,24 @@
 #include "defaults/unitblock.hpp"
 #include "SFML/Audio/SoundBuffer.hpp"
 #include "terrain/LayerDefinition.h"
+#include "threading/ThreadPool.h"
 
 namespace LowEngine {
     /**
      * @brief Asset Manager for LowEngine.
      *
      * Static (singleton) class that manages loading and accessing textures, sounds, fonts, and other assets.
+     *
+     * Textures, sounds and maps are deduplicated - loading a file that's already loaded, from the same path or an
+     * identical copy under a different path, returns ID of the existing asset instead of decoding it again.
+     *
+     * Assets acquired through Asset Handles are reference counted. Once no handle refers to an asset, it can be evicted
+     * to keep memory of its category within budget, least recently used first. Evicted assets are loaded again,
+     * synchronously, on next access. Assets loaded by APIs that return raw IDs are never evicted.
+     *
+     * Render snapshots refer to textures by pointer, and render thread may draw one for a few frames after it was
+     * published. Textures replaced on the main thread - evicted or packed into an atlas - are therefore released
+     * only once the render thread has moved on to a snapshot published after the replacement.
      */
     class Assets {
     public:
@@ -126,7 +151,8 @@ namespace LowEngine {
         /**
          * @brief Load tile map from file.
          *
-         * Supports LDTk format (*.ldtkl). Names of layers in file MUST follow the same naming convention as in LowEngine::Terrain::LayerType enum.
+         * Supports LDTk format (*.ldtkl) and maps cooked by LowMapCooker (*.lowmap). Names of layers in file MUST follow the same naming convention as in LowEngine::Terrain::LayerType enum.
+         * Cooked maps are memory-mapped and used without parsing - definitions must be the same as the ones used for cooking.
          *
          * Mappings are used to assign texture to layer. Only texture following specified layout are supported.
          * Texture must be a vertical texture atlas with all tiles in a single column. Any additional columns can be used for animated tiles.
@@ -135,7 +161,7 @@ namespace LowEngine {
          * For animated tiles, Animation Clips with aliases must be defined before loading map.
          * Aliases for Clips must be provided on appropriate indexes of LayerToTextureMapping::AnimationClipNames vector.
          * Multiple clips can be defined for a single tile - in that case particular tile with have Clip assigned randomly.
-         * @param path Path to the map file (*.ldtkl)
+         * @param path Path to the map file (*.ldtkl or *.lowmap)
          * @param definitions Vector for each layer to map texture and Animations Clips.
          * @return Map ID
          */
@@ -144,7 +170,8 @@ namespace LowEngine {
         /**
          * @brief Load tile map from file with alias.
          *
-         * Supports LDTk format (*.ldtkl). Names of layers in file MUST follow the same naming convention as in LowEngine::Terrain::LayerType enum.
+         * Supports LDTk format (*.ldtkl) and maps cooked by LowMapCooker (*.lowmap). Names of layers in file MUST follow the same naming convention as in LowEngine::Terrain::LayerType enum.
+         * Cooked maps are memory-mapped and used without parsing - definitions must be the same as the ones used for cooking.
          *
          * Mappings are used to assign texture to layer. Only texture following specified layout are supported.
          * Texture must be a vertical texture atlas with all tiles in a single column. Any additional columns can be used for animated tiles.
@@ -153,13 +180,47 @@ namespace LowEngine {
          * For animated tiles, Animation Clips with aliases must be defined before loading map.
          * Aliases for Clips must be provided on appropriate indexes of LayerToTextureMapping::AnimationClipNames vector.
          * Multiple clips can be defined for a single tile - in that case particular tile with have Clip assigned randomly.
-         * @param path Path to the map file (*.ldtkl)
+         * @param path Path to the map file (*.ldtkl or *.lowmap)
          * @param alias Alias that will be used to access the map
          * @param definitions Vector for each layer to map texture and Animations Clips.
          * @return Map ID
          */
         static size_t LoadTileMap(const std::string& path, const std::string& alias, const std::vector<Terrain::LayerDefinition>& definitions);
 
+        /**
+         * @brief Load texture, or reuse the loaded one, and return a handle that keeps it in memory.
+         *
+         * Once all handles are gone, texture may be evicted when textures exceed their memory budget.
+         * @param path Path to the texture file
+         * @return Handle to the texture. Invalid if texture could not be loaded.
+         */
+        static AssetHandle<sf::Texture> AcquireTexture(const std::string& path);
+
+        /**
+         * @brief Reference a texture that is already loaded, i.e. one a Sprite is about to draw.
+         * @see AcquireTexture()
+         * @param textureId ID of the texture.
+         * @return Handle to the texture. Invalid if texture does not exist.
+         */
+        static AssetHandle<sf::Texture> AcquireTexture(size_t textureId);
+
+        /**
+         * @brief Load sound, or reuse the loaded one, and return a handle that keeps it in memory.
+         * @see AcquireTexture()
+         * @param path Path to the sound file
+         * @return Handle to the sound. Invalid if sound could not be loaded.
+         */
+        static AssetHandle<sf::SoundBuffer> AcquireSound(const std::string& path);
+
+        /**
+         * @brief Load tile map, or reuse the loaded one, and return a handle that keeps it in memory.
+         * @see LoadTileMap(), AcquireTexture()
+         * @param path Path to the map file (*.ldtkl or *.lowmap)
+         * @param definitions Vector for each layer to map texture and Animations Clips.
+         * @return Handle to the map.
+         */
+        static AssetHandle<Terrain::TileMap> AcquireTileMap(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions);
+
         /**
          * @brief Retrieve a tile map by its ID.
          * @param mapId The unique ID of the tile map to retrieve.
@@ -174,6 +235,13 @@ namespace LowEngine {
          */
         static Terrain::TileMap& GetTileMap(const std::string& mapAlias);
 
+        /**
+         * @brief Retrieve a tile map by id of its alias, i.e. `"Level1"_sid`.
+         * @param mapAlias Id of the alias of the tile map to retrieve.
+         * @return Reference to the requested `Terrain::TileMap`.
+         */
+        static Terrain::TileMap& GetTileMap(StringId mapAlias);
+
         /**
          * @brief Retrieve Id of the map by its alias.
          * @param mapAlias Alias of the map.
@@ -181,6 +249,30 @@ namespace LowEngine {
          */
         static size_t GetTileMapId(const std::string& mapAlias);
 
+        /**
+         * @brief Retrieve Id of the map by id of its alias.
+         * @param mapAlias Id of map's alias.
+         * @return Id of the map.
+         */
+        static size_t GetTileMapId(StringId mapAlias);
+
+        /**
+         * @brief Release tile map's data and remove its aliases.
+         *
+         * Id stays reserved and refers to an empty map, so Components that still hold it don't break.
+         * Map must not be loading in the background.
+         * @param mapId Id of the map to unload.
+         */
+        static void UnloadTileMap(size_t mapId);
+
+        /**
+         * @brief Unload tile map requested with LoadTileMapAsync() as soon as its loading finishes.
+         *
+         * For requests whose owner doesn't need the map anymore. Finished requests are released by ProcessPendingUploads().
+         * @param request Request of the map.
+         */
+        static void UnloadTileMapWhenLoaded(const AssetRequest& request);
+
         /**
          * @brief Retrieve the animation sheet associated with a texture ID.
          * @param textureId The unique ID of the texture.
@@ -195,6 +287,13 @@ namespace LowEngine {
          */
         static Animation::SpriteSheet* GetSpriteSheet(const std::string& textureAlias);
 
+        /**
+         * @brief Retrieve the animation sheet associated with id of texture's alias.
+         * @param textureAlias Id of the alias of the texture.
+         * @return Pointer to the `Animation::AnimationSheet` if it exists, otherwise throws an exception.
+         */
+        static Animation::SpriteSheet* GetSpriteSheet(StringId textureAlias);
+
         /**
          * @brief Retrieve the default texture.
          * @return Reference to the default `sf::Texture`.
@@ -215,6 +314,13 @@ namespace LowEngine {
          */
         static sf::Texture& GetTexture(const std::string& textureAlias);
 
+        /**
+         * @brief Retrieve a texture by id of its alias, i.e. `"Player"_sid`. Preferred in code that runs every frame.
+         * @param textureAlias Id of the alias of the texture to retrieve.
+         * @return Reference to the requested `sf::Texture`.
+         */
+        static sf::Texture& GetTexture(StringId textureAlias);
+
         /**
          * @brief Retrieve the ID of a texture by its alias.
          * @param textureAlias The alias of the texture.
@@ -222,6 +328,35 @@ namespace LowEngine {
          */
         static size_t GetTextureId(const std::string& textureAlias);
 
+        /**
+         * @brief Retrieve the ID of a texture by id of its alias.
+         * @param textureAlias Id of the alias of the texture.
+         * @return The unique ID of the requested texture.
+         */
+        static size_t GetTextureId(StringId textureAlias);
+
+        /**
+         * @brief Retrieve the part of GetTexture() that holds the texture, in pixels.
+         *
+         * Whole texture, unless it was packed into an atlas by BuildAtlas().
+         * @param textureId The unique ID of the texture.
+         */
+        static sf::IntRect GetTextureRect(size_t textureId);
+
+        /**
+         * @brief Pack loaded textures into few large atlas textures, so Sprites using them can be drawn without texture switches.
+         *
+         * Texture IDs stay valid - GetTexture() returns the atlas page and GetTextureRect() the texture's place on it.
+         * Sprite Sheets and their Animation Clips are moved to atlas coordinates. Memory of original textures is released.
+         *
+         * Must be called on the main thread, before Sprites start using the textures - Sprites keep texture they were given.
+         * Original textures are released once render thread can't draw them anymore.
+         * @param textureIds Textures to pack. Default texture, textures still loading and textures larger than a page are skipped.
+         * @param pageSize Width and height of a single atlas page, in pixels.
+         * @return Created pages and packing efficiency.
+         */
+        static Atlas::AtlasReport BuildAtlas(const std::vector<size_t>& textureIds, unsigned pageSize = Config::ATLAS_PAGE_SIZE);
+
         /**
          * @brief Retrive the default font.
          * @return Reference to the default font.
@@ -263,14 +398,202 @@ namespace LowEngine {
          */
         static sf::SoundBuffer& GetSound(const std::string& soundAlias);
 
+        /**
+         * @brief Retrieve a sound buffer by id of its alias.
+         * @param soundAlias Id of the alias of the sound buffer to retrieve.
+         * @return Reference to the requested `sf::SoundBuffer`.
+         */
+        static sf::SoundBuffer& GetSound(StringId soundAlias);
+
+        /**
+         * @brief Retrieve the ID of a sound buffer by its alias.
+         * @param soundAlias The alias of the sound buffer.
+         * @return The unique ID of the requested sound buffer.
+         */
+        static size_t GetSoundId(const std::string& soundAlias);
+
+        /**
+         * @brief Retrieve the ID of a sound buffer by id of its alias.
+         * @param soundAlias Id of the alias of the sound buffer.
+         * @return The unique ID of the requested sound buffer.
+         */
+        static size_t GetSoundId(StringId soundAlias);
+
+        /**
+         * @brief Load texture in the background.
+         *
+         * File is read and decoded on a loader thread. Only the upload to GPU is done on the main thread,
+         * by ProcessPendingUploads(). Must be called from the main thread.
+         * @param path Path to the texture file
+         * @return Request with reserved texture ID
+         */
+        static AssetRequest LoadTextureAsync(const std::string& path);
+
+        /**
+         * @brief Load texture in the background, with alias.
+         *
+         * Alias is registered right away and removed if loading fails.
+         * @param path Path to the texture file
+         * @param alias Alias that will be used to access the texture
+         * @return Request with reserved texture ID
+         */
+        static AssetRequest LoadTextureAsync(const std::string& path, const std::string& alias);
+
+        /**
+         * @brief Load sound in the background.
+         *
+         * File is read and decoded to samples on a loader thread. Samples are passed to the audio device on the main thread.
+         * @param path Path to the sound file
+         * @return Request with reserved sound ID
+         */
+        static AssetRequest LoadSoundAsync(const std::string& path);
+
+        /**
+         * @brief Load sound in the background, with alias.
+         * @param path Path to the sound file
+         * @param alias Alias that will be used to access the sound
+         * @return Request with reserved sound ID
+         */
+        static AssetRequest LoadSoundAsync(const std::string& path, const std::string& alias);
+
+        /**
+         * @brief Load tile map in the background.
+         *
+         * LDTk file is read and parsed on a loader thread. Layer textures, animation clips and navigation data are
+         * applied on the main thread, once all textures used by definitions are uploaded - so textures and map
+         * can be requested together.
+         * @see LoadTileMap()
+         * @param path Path to the map file (*.ldtkl or *.lowmap)
+         * @param definitions Vector for each layer to map texture and Animations Clips.
+         * @return Request with reserved map ID
+         */
+        static AssetRequest LoadTileMapAsync(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions);
+
+        /**
+         * @brief Load tile map in the background, with alias.
+         * @see LoadTileMapAsync()
+         * @param path Path to the map file (*.ldtkl or *.lowmap)
+         * @param alias Alias that will be used to access the map
+         * @param definitions Vector for each layer to map texture and Animations Clips.
+         * @return Request with reserved map ID
+         */
+        static AssetRequest LoadTileMapAsync(const std::string& path, const std::string& alias, const std::vector<Terrain::LayerDefinition>& definitions);
+
+        /**
+         * @brief Finish loading of assets decoded by loader threads.
+         *
+         * Must be called on the main thread. Game calls it every frame.
+         * @param budget Maximum time to spend on uploads. Zero means no limit.
+         * @return Number of finished requests.
+         */
+        static size_t ProcessPendingUploads(sf::Time budget = sf::Time::Zero);
+
+        /**
+         * @brief Block until a loader thread hands over an asset for upload, or until timeout passes.
+         *
+         * Used to wait for background loads on the main thread without busy looping.
+         * @param timeout Maximum time to wait.
+         */
+        static void WaitForPendingUploads(sf::Time timeout);
+
+        /**
+         * @brief Retrieve number of asynchronous requests that were not finished yet.
+         */
+        static size_t GetPendingLoadCount();
+
+        /**
+         * @brief Run a job on loader threads, i.e. to process data of loaded assets off the main thread.
+         *
+         * Job must not access Assets - it may be unloaded on the main thread meanwhile.
+         * @param job Callable without arguments.
+         * @return Future with job's result.
+         */
+        template<typename Job>
+        static std::future<std::invoke_result_t<Job>> RunInBackground(Job&& job) {
+            return GetInstance()->GetLoaders().Submit(std::forward<Job>(job));
+        }
+
+        /**
+         * @brief Retrieve counters of the deduplication cache of one asset category.
+         * @param type Category of assets.
+         */
+        static const AssetCacheStats& GetCacheStats(AssetType type);
+
+        /**
+         * @brief Set maximum memory taken by assets of one category. Unreferenced assets over the budget are evicted right away.
+         * @param type Category of assets.
+         * @param bytes Budget in bytes.
+         */
+        static void SetMemoryBudget(AssetType type, size_t bytes);
+
+        /**
+         * @brief INTERNAL: Tell which render snapshots may still be drawn. Game calls it every frame.
+         *
+         * Releases textures retired before the render thread moved past all snapshots that could refer to them.
+         * @param nextFrame Index of the snapshot that will be published next.
+         * @param retiredFrame Snapshots with lower index are never drawn again. Equal to nextFrame if there's no render thread.
+         */
+        static void SetRenderFrames(uint64_t nextFrame, uint64_t retiredFrame);
+
+        /**
+         * @brief Destroy a texture rendered by a Component, once no snapshot that can still be drawn refers to it.
+         * @param texture Texture to destroy. Destroyed right away if render thread isn't running.
+         */
+        static void RetireRenderTexture(std::unique_ptr<sf::RenderTexture> texture);
+
+        /**
+         * @brief INTERNAL: Add a reference to an asset. Used by Asset Handle.
+         */
+        static void AddReference(AssetType type, size_t id);
+
+        /**
+         * @brief INTERNAL: Drop a reference to an asset. Used by Asset Handle.
+         */
+        static void ReleaseReference(AssetType type, size_t id);
+
+        /**
+         * @brief Log duplicate loads avoided, memory saved, resident memory and evictions, for every asset category.
+         */
+        static void LogCacheReport();
+
         /**
          * @brief Unload all loaded assets, including textures, sounds, fonts, and tile maps and others.
          *
          * This method clears all internal storage and resets the asset manager to its initial state.
+         * Default texture, sound and font (id 0) are kept - Components fall back to them.
+         * Waits for background loads in progress - unfinished requests are reported as failed.
+         * Must not be called while render thread runs.
          */
         static void UnloadAll();
 
     protected:
+        /**
+         * @brief Asset decoded on a loader thread, waiting to be finished on the main thread.
+         */
+        struct PendingUpload {
+            /**
+             * @brief Textures that must be uploaded before this asset can be finished.
+             */
+            std::vector<size_t> TextureDependencies;
+            /**
+             * @brief Finishes the asset on the main thread. Returns true if successful.
+             */
+            std::function<bool()> Upload;
+            std::shared_ptr<std::promise<bool>> Promise;
+        };
+
+        /**
+         * @brief Texture replaced while render thread may still draw it.
+         */
+        template<typename T>
+        struct RetiredTexture {
+            /**
+             * @brief Index of the first snapshot that doesn't refer to the texture.
+             */
+            uint64_t Frame = 0;
+            T Texture;
+        };
+
         Assets();
 
         Assets(const Assets&) = delete;
@@ -286,22 +609,193 @@ namespace LowEngine {
             return &instance;
         }
 
-        static void LoadTerrainLayerData(const Terrain::LayerDefinition* terrainLayerDefinition, Terrain::TileMap& map);
-        static void LoadFeatureLayerData(const Terrain::LayerDefinition* featuresLayerDefinition, Terrain::TileMap& map);
+        /**
+         * @brief Apply layer's texture and resolve Animation Clips of animated cell types. Throws if a clip does not exist.
+         */
+        static void LoadLayerData(const Terrain::LayerDefinition& layerDefinition, Terrain::Layer& layer);
 
-        static void ReadNavDataForLayer(Terrain::TileMap& map, Terrain::Layer& layer, const Terrain::LayerDefinition* layerDefinition);
+        /**
+         * @brief Check layer definitions and select definitions for terrain and features layers. Throws if a definition is invalid.
+         */
+        static void SelectLayerDefinitions(const std::vector<Terrain::LayerDefinition>& definitions,
+                                           const Terrain::LayerDefinition*& terrainLayerDefinition,
+                                           const Terrain::LayerDefinition*& featuresLayerDefinition);
 
-        std::vector<Terrain::TileMap> _maps;
-        std::unordered_map<std::string, size_t> _mapAliases;
+        /**
+         * @brief Read LDTk or cooked map file. Safe to call from loader threads.
+         * @param[out] cooked Set to true if file was a cooked map - its clip indices and navigation data are already set.
+         * @return True if successful.
+         */
+        static bool ParseTileMap(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions,
+                                 Terrain::TileMap& map, bool& cooked);
 
-        std::vector<sf::Texture> _textures;
-        std::unordered_map<std::string, size_t> _textureAliases;
+        /**
+         * @brief Apply layer textures and animation clips to a parsed map. Must be called on the main thread.
+         *
+         * Clip indices, navigation data and navigation regions are generated only for maps that were not cooked.
+         */
+        static void ApplyLayerDefinitions(const std::vector<Terrain::LayerDefinition>& definitions, Terrain::TileMap& map, bool cooked);
+
+        /**
+         * @brief Deduplicate and load texture, without pinning nor referencing it.
+         * @return Texture ID. Config::MAX_SIZE if texture could not be loaded.
+         */
+        size_t LoadTextureData(const std::string& path);
+
+        /**
+         * @brief Deduplicate and load sound, without pinning nor referencing it.
+         * @return Sound ID. Config::MAX_SIZE if sound could not be loaded.
+         */
+        size_t LoadSoundData(const std::string& path);
+
+        /**
+         * @brief Deduplicate and load tile map, without referencing it. Throws if map could not be loaded.
+         */
+        size_t LoadTileMapData(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions);
+
+        AssetCache& GetCache(AssetType type);
+
+        /**
+         * @brief Resolve asset's storage, and load it again if it was evicted.
+         * @return ID of the storage that holds asset's data.
+         */
+        size_t EnsureResident(AssetType type, size_t id);
+
+        /**
+         * @brief Load evicted asset again, from the path it was first loaded from.
+         */
+        void ReloadAsset(AssetType type, size_t id);
+
+        /**
+         * @brief Release texture's storage once render thread can't draw it anymore. Storage of the ID stays reserved.
+         */
+        void RetireTexture(size_t id);
+
+        /**
+         * @brief Release retired textures that no snapshot which can still be drawn refers to.
+         */
+        void ReleaseRetiredTextures();
+
+        /**
+         * @brief Evict least recently used, unreferenced assets of a category until it fits the budget.
+         * @param keep ID of an asset that must not be evicted.
+         */
+        void EnforceBudget(AssetType type, size_t keep);
+
+        /**
+         * @brief Assign alias to an asset. Reassigning alias used by a different asset is reported.
+         */
+        static void SetAlias(std::unordered_map<StringId, size_t>& aliases, const std::string& alias, size_t id, const char* category);
+
+        /**
+         * @brief Find asset by id of its alias. Throws if alias does not exist.
+         * @param name Text of the alias for the error message. If empty, interned text is used.
+         */
+        static size_t FindAlias(const std::unordered_map<StringId, size_t>& aliases, StringId alias, const char* category,
+                                std::string_view name = {});
+
+        /**
+         * @brief Create loader threads on first use.
+         */
+        Threading::ThreadPool& GetLoaders();
+
+        /**
+         * @brief Register request on the main thread and return a handle to it.
+         */
+        AssetRequest BeginRequest(AssetType type, size_t id, const std::string& path, std::shared_ptr<std::promise<bool>>& promise);
+
+        /**
+         * @brief Hand decoded asset over to the main thread. Called by loader threads.
+         */
+        void QueueUpload(PendingUpload upload);
+
+        /**
+         * @brief Try to finish a single upload. Returns false if upload has to wait for its dependencies.
+         */
+        bool FinishUpload(PendingUpload& upload);
+
+        // deques - references returned by getters stay valid when assets are added, evicted or loaded again
+        std::deque<Terrain::TileMap> _maps;
+        std::unordered_map<StringId, size_t> _mapAliases;
+        /**
+         * @brief Definitions each map was loaded with, so evicted maps can be loaded again.
+         */
+        std::unordered_map<size_t, std::vector<Terrain::LayerDefinition>> _mapDefinitions;
+
+        std::deque<sf::Texture> _textures;
+        std::unordered_map<StringId, size_t> _textureAliases;
         std::unordered_map<size_t, Animation::SpriteSheet> _animationSheets;
+        /**
+         * @brief Places of textures packed into atlas pages, on their page.
+         */
+        std::unordered_map<size_t, sf::IntRect> _atlasRegions;
 
         std::vector<sf::Font> _fonts;
         std::unordered_map<std::string, sf::Font> _fontAliases;
 
-        std::vector<sf::SoundBuffer> _sounds;
-        std::unordered_map<std::string, size_t> _soundAliases;
+        std::deque<sf::SoundBuffer> _sounds;
+        std::unordered_map<StringId, size_t> _soundAliases;
+
+        AssetCache _textureCache;
+        AssetCache _soundCache;
+        AssetCache _mapCache;
+
+        std::unique_ptr<Threading::ThreadPool> _loaders;
+
+        std::mutex _uploadMutex;
+        std::condition_variable _uploadQueued;
+        std::deque<PendingUpload> _pendingUploads;
+
+        // accessed only on the main thread
+        std::vector<PendingUpload> _deferredUploads;
+        /**
+         * @brief Map requests to unload once they finish, see UnloadTileMapWhenLoaded().
+         */
+        std::vector<AssetRequest> _orphanedMapRequests;
+        std::unordered_set<size_t> _texturesInFlight;
+        size_t _loadsInFlight = 0;
+
+        uint64_t _nextRenderFrame = 0;
+        uint64_t _retiredRenderFrame = 0;
+        /**
+         * @brief IDs of textures whose storage is released once render thread moves past them.
+         */
+        std::vector<RetiredTexture<size_t>> _retiredTextures;
+        std::vector<RetiredTexture<std::unique_ptr<sf::RenderTexture>>> _retiredRenderTextures;
     };
+
+    template<typename T>
+    AssetHandle<T>::AssetHandle(size_t id) : _id(id) {
+        Assets::AddReference(AssetTypeOf<T>::Value, _id);
+    }
+
+    template<typename T>
+    AssetHandle<T>::AssetHandle(const AssetHandle& other) : _id(other._id) {
+        if (IsValid()) {
+            Assets::AddReference(AssetTypeOf<T>::Value, _id);
+        }
+    }
+
+    template<typename T>
+    void AssetHandle<T>::Reset() {
+        if (IsValid()) {
+            Assets::ReleaseReference(AssetTypeOf<T>::Value, std::exchange(_id, Config::MAX_SIZE));
+        }
+    }
+
+    template<typename T>
+    T& AssetHandle<T>::Get() const {
+        if (!IsValid()) {
+            _log->error("Asset handle is empty");
+            throw std::runtime_error("Asset handle is empty");
+        }
+
+        if constexpr (std::is_same_v<T, sf::Texture>) {
+            return Assets::GetTexture(_id);
+        } else if constexpr (std::is_same_v<T, sf::SoundBuffer>) {
+            return Assets::GetSound(_id);
+        } else {
+            return Assets::GetTileMap(_id);
+        }
+    }
 }
@@ -2,8 +2,10 @@
 
 namespace LowEngine::Animation {
     void SpriteSheet::AddAnimationClip(const std::string& name, size_t frameIndex, size_t frameCount, float frameDuration, const sf::Vector2<size_t>& firstFrameOrigin) {
-        AnimationClip& anim = _animations[name];
+        StringId nameId = StringId::Intern(name);
+        AnimationClip& anim = _animations[nameId];
         anim.Name = name;
+        anim.NameId = nameId;
         anim.StartFrame = frameIndex;
         anim.FrameCount = frameCount;
         anim.EndFrame = frameIndex + frameCount - 1;
@@ -14,8 +16,8 @@ namespace LowEngine::Animation {
         anim.Frames.resize(anim.FrameCount);
         for (size_t i = 0; i < anim.FrameCount; i++) {
             sf::IntRect frame;
-            frame.position.x = static_cast<int>((anim.StartFrame + i) % this->FrameCount.x * this->FrameSize.x);
-            frame.position.y = static_cast<int>(anim.StartFrame / this->FrameCount.x * this->FrameSize.y);
+            frame.position.x = static_cast<int>(Offset.x + (anim.StartFrame + i) % this->FrameCount.x * this->FrameSize.x);
+            frame.position.y = static_cast<int>(Offset.y + anim.StartFrame / this->FrameCount.x * this->FrameSize.y);
             frame.size.x = static_cast<int>(this->FrameSize.x);
             frame.size.y = static_cast<int>(this->FrameSize.y);
 
@@ -26,13 +28,28 @@ namespace LowEngine::Animation {
     std::vector<std::string> SpriteSheet::GetAnimationClipNames() {
         std::vector<std::string> names;
         for (auto& animation : _animations) {
-            names.emplace_back(animation.first);
+            names.emplace_back(animation.second.Name);
         }
         return names;
     }
 
     Animation::AnimationClip* SpriteSheet::GetAnimationClip(const std::string& name) {
-        if (_animations.find(name) == _animations.end()) return nullptr;
-        return &_animations[name];
+        return GetAnimationClip(StringId(name));
+    }
+
+    void SpriteSheet::SetOffset(const sf::Vector2<size_t>& offset) {
+        sf::Vector2i delta(static_cast<int>(offset.x) - static_cast<int>(Offset.x), static_cast<int>(offset.y) - static_cast<int>(Offset.y));
+        Offset = offset;
+
+        for (auto& animation: _animations) {
+            for (auto& frame: animation.second.Frames) {
+                frame.position += delta;
+            }
+        }
+    }
+
+    Animation::AnimationClip* SpriteSheet::GetAnimationClip(StringId name) {
+        auto animation = _animations.find(name);
+        return animation == _animations.end() ? nullptr : &animation->second;
     }
 }
@@ -9,6 +9,8 @@
 #include "SFML/System/Vector2.hpp"
 #include "SFML/Graphics/Rect.hpp"
 
+#include "StringId.h"
+
 namespace LowEngine::Animation {
     /**
      * @brief Stores data about particular animation.
@@ -19,6 +21,11 @@ namespace LowEngine::Animation {
          */
         std::string Name;
 
+        /**
+         * @brief Interned Name, used to find this animation.
+         */
+        StringId NameId;
+
         /**
          * @brief Index of starting frame for this animation.
          */
@@ -41,11 +48,13 @@ namespace LowEngine::Animation {
 
         /**
          * @brief Coordinates of orgin point (upper-left corner) for the first frame, in pixels.
+         *
+         * Relative to the sheet - it does not change when texture is packed into an atlas.
          */
         sf::Vector2<size_t> FirstFrameOrigin;
 
         /**
-         * @brief List of rectangles representing every frame of animation.
+         * @brief List of rectangles representing every frame of animation, in coordinates of the texture that's drawn.
          */
         std::vector<sf::IntRect> Frames;
 
@@ -83,6 +92,13 @@ namespace LowEngine::Animation {
          */
         sf::Vector2<size_t> FrameCount;
 
+        /**
+         * @brief Position of the sheet's upper-left corner on the texture, in pixels.
+         *
+         * Zero, unless the texture was packed into an atlas.
+         */
+        sf::Vector2<size_t> Offset;
+
         /**
          * @brief Add new animation definition to this Sheet.
          * @param name Name of the animation.
@@ -107,7 +123,20 @@ namespace LowEngine::Animation {
          */
         AnimationClip* GetAnimationClip(const std::string& name);
 
+        /**
+         * @brief Retrive Animation Clip by id of its name.
+         * @param name Id of Clip's name, i.e. `"Walk"_sid`.
+         * @return Pointer to Clip. Nullptr if Clip was not found.
+         */
+        AnimationClip* GetAnimationClip(StringId name);
+
+        /**
+         * @brief Move the sheet to a different place on its texture, i.e. into an atlas. Frames of all Clips are moved too.
+         * @param offset New position of the sheet's upper-left corner, in pixels.
+         */
+        void SetOffset(const sf::Vector2<size_t>& offset);
+
     protected:
-        std::unordered_map<std::string, AnimationClip> _animations;
+        std::unordered_map<StringId, AnimationClip> _animations;
     };
 }
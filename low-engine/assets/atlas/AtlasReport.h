@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace LowEngine::Atlas {
+    /**
+     * @brief Result of packing textures into atlas pages.
+     */
+    struct AtlasReport {
+        /**
+         * @brief IDs of textures created for atlas pages.
+         */
+        std::vector<size_t> PageTextureIds;
+
+        /**
+         * @brief Number of textures moved into the atlas.
+         */
+        size_t PackedTextures = 0;
+
+        /**
+         * @brief Number of textures left as they were - too large, already packed, or still loading.
+         */
+        size_t SkippedTextures = 0;
+
+        /**
+         * @brief Area of packed textures divided by area of all pages. 1 means no wasted space.
+         */
+        float Efficiency = 0.0f;
+    };
+}
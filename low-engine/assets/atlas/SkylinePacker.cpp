@@ -0,0 +1,92 @@
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace LowEngine::Atlas {
+    SkylinePacker::SkylinePacker(sf::Vector2u size) : _size(size) {
+        _skyline.push_back({0, 0, size.x});
+    }
+
+    bool SkylinePacker::Insert(sf::Vector2u size, sf::Vector2u& position) {
+        if (size.x == 0 || size.y == 0 || size.x > _size.x || size.y > _size.y) return false;
+
+        size_t bestIndex = _skyline.size();
+        unsigned bestTop = std::numeric_limits<unsigned>::max();
+        unsigned bestWidth = std::numeric_limits<unsigned>::max();
+
+        for (size_t i = 0; i < _skyline.size(); i++) {
+            unsigned y;
+            if (!Fits(i, size, y)) continue;
+
+            // lowest top edge wins, narrower segment breaks ties - it leaves wider gaps for later rectangles
+            unsigned top = y + size.y;
+            if (top < bestTop || (top == bestTop && _skyline[i].Width < bestWidth)) {
+                bestIndex = i;
+                bestTop = top;
+                bestWidth = _skyline[i].Width;
+                position = {_skyline[i].X, y};
+            }
+        }
+
+        if (bestIndex == _skyline.size()) return false;
+
+        AddSegment(bestIndex, position, size);
+        _usedArea += static_cast<size_t>(size.x) * size.y;
+        return true;
+    }
+
+    unsigned SkylinePacker::GetUsedHeight() const {
+        unsigned height = 0;
+        for (auto& segment: _skyline) {
+            height = std::max(height, segment.Y);
+        }
+        return height;
+    }
+
+    bool SkylinePacker::Fits(size_t segmentIndex, sf::Vector2u size, unsigned& y) const {
+        unsigned x = _skyline[segmentIndex].X;
+        if (x + size.x > _size.x) return false;
+
+        y = 0;
+        unsigned widthLeft = size.x;
+        for (size_t i = segmentIndex; widthLeft > 0; i++) {
+            y = std::max(y, _skyline[i].Y);
+            if (y + size.y > _size.y) return false;
+
+            widthLeft -= std::min(widthLeft, _skyline[i].Width);
+        }
+        return true;
+    }
+
+    void SkylinePacker::AddSegment(size_t segmentIndex, sf::Vector2u position, sf::Vector2u size) {
+        _skyline.insert(_skyline.begin() + static_cast<std::ptrdiff_t>(segmentIndex), {position.x, position.y + size.y, size.x});
+
+        // shrink or remove segments now hidden under the new one
+        unsigned right = position.x + size.x;
+        for (size_t i = segmentIndex + 1; i < _skyline.size();) {
+            auto& segment = _skyline[i];
+            if (segment.X >= right) break;
+
+            unsigned segmentRight = segment.X + segment.Width;
+            if (segmentRight <= right) {
+                _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+
+            segment.Width = segmentRight - right;
+            segment.X = right;
+            break;
+        }
+
+        // merge neighbours at the same height
+        for (size_t i = 0; i + 1 < _skyline.size();) {
+            if (_skyline[i].Y == _skyline[i + 1].Y) {
+                _skyline[i].Width += _skyline[i + 1].Width;
+                _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            } else {
+                i++;
+            }
+        }
+    }
+}
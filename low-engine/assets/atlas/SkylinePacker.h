@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include "SFML/System/Vector2.hpp"
+
+namespace LowEngine::Atlas {
+    /**
+     * @brief Packs rectangles into a single page using the skyline bottom-left heuristic.
+     *
+     * Top edge of everything placed so far is kept as a list of horizontal segments (the skyline).
+     * Each rectangle goes where its top edge ends lowest, so pages fill from the bottom up with little waste
+     * for sprites of similar heights. Insert rectangles sorted by height, tallest first, for the best results.
+     */
+    class SkylinePacker {
+    public:
+        /**
+         * @brief Create an empty page.
+         * @param size Size of the page, in pixels.
+         */
+        explicit SkylinePacker(sf::Vector2u size);
+
+        /**
+         * @brief Find place for a rectangle and reserve it.
+         * @param size Size of the rectangle, in pixels.
+         * @param[out] position Upper-left corner of the rectangle on the page.
+         * @return True if rectangle fits. False if there's no space left for it.
+         */
+        bool Insert(sf::Vector2u size, sf::Vector2u& position);
+
+        [[nodiscard]] sf::Vector2u GetSize() const { return _size; }
+
+        /**
+         * @brief Area taken by inserted rectangles, in pixels.
+         */
+        [[nodiscard]] size_t GetUsedArea() const { return _usedArea; }
+
+        /**
+         * @brief Height of the highest point of the skyline. Page can be trimmed to it.
+         */
+        [[nodiscard]] unsigned GetUsedHeight() const;
+
+    protected:
+        /**
+         * @brief Horizontal part of the skyline, spanning from X to X + Width at height Y.
+         */
+        struct Segment {
+            unsigned X = 0;
+            unsigned Y = 0;
+            unsigned Width = 0;
+        };
+
+        sf::Vector2u _size;
+        std::vector<Segment> _skyline;
+        size_t _usedArea = 0;
+
+        /**
+         * @brief Check if rectangle can be placed with its left edge at the start of a segment.
+         * @param[out] y Lowest height at which rectangle fits over the following segments.
+         */
+        [[nodiscard]] bool Fits(size_t segmentIndex, sf::Vector2u size, unsigned& y) const;
+
+        /**
+         * @brief Raise skyline under a placed rectangle.
+         */
+        void AddSegment(size_t segmentIndex, sf::Vector2u position, sf::Vector2u size);
+    };
+}
@@ -0,0 +1,369 @@
+#include "CookedMap.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ranges>
+
+#include "Config.h"
+#include "Log.h"
+#include "TileMap.h"
+#include "serialization/MappedFile.h"
+
+namespace LowEngine::Terrain {
+    namespace {
+        Layer& GetLayer(TileMap& map, LayerType type) {
+            return type == Features ? map.FeaturesLayer : map.TerrainLayer;
+        }
+
+        void HashBytes(uint64_t& hash, const void* data, size_t size) {
+            // FNV-1a
+            auto bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+
+        template<typename T>
+        void HashValue(uint64_t& hash, const T& value) {
+            HashBytes(hash, &value, sizeof(T));
+        }
+    }
+
+    bool CookedMap::IsCookedMap(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        char magic[4] = {};
+        if (!file.read(magic, sizeof(magic))) return false;
+
+        return std::memcmp(magic, CookedMapHeader().Magic, sizeof(magic)) == 0;
+    }
+
+    bool CookedMap::Cook(TileMap& map, const std::vector<LayerDefinition>& definitions, Serialization::BinaryWriter& writer) {
+        auto sorted = SortDefinitions(definitions);
+
+        for (auto definition: sorted) {
+            auto& layer = GetLayer(map, definition->Type);
+
+            for (auto cellType: layer.Cells) {
+                if (cellType != Config::MAX_SIZE && !definition->CellDefinitions.contains(cellType)) {
+                    _log->error("Cell type {} used on layer '{}' is not defined", cellType, LayerTypeToString(definition->Type));
+                    return false;
+                }
+            }
+
+            auto clipCounts = definition->GetClipCounts();
+            for (auto& [cellType, clipCount]: clipCounts) {
+                if (clipCount > std::numeric_limits<uint8_t>::max()) {
+                    _log->error("Cell type {} has {} Animation Clips - cooked maps support up to 255", cellType, clipCount);
+                    return false;
+                }
+            }
+
+            layer.AssignClipIndices(clipCounts);
+            map.ReadNavData(layer, *definition);
+        }
+
+        CookedMapHeader header;
+        header.SizeX = map.Size.x;
+        header.SizeY = map.Size.y;
+        header.NavWidth = map.NavGrid.Width;
+        header.NavHeight = map.NavGrid.Height;
+        header.LayerCount = static_cast<uint32_t>(sorted.size());
+        header.NameLength = static_cast<uint32_t>(map.Name.size());
+
+        size_t headerPosition = writer.Position();
+        writer.Write(header);
+
+        header.NameOffset = writer.Position() - headerPosition;
+        writer.WriteBlock(map.Name.data(), map.Name.size());
+
+        // layer headers are patched once offsets of their arrays are known
+        writer.Align(COOKED_MAP_ALIGNMENT);
+        header.LayersOffset = writer.Position() - headerPosition;
+        std::vector<CookedLayerHeader> layerHeaders(sorted.size());
+        writer.WriteArray(layerHeaders);
+
+        for (size_t i = 0; i < sorted.size(); i++) {
+            auto& layer = GetLayer(map, sorted[i]->Type);
+            auto& layerHeader = layerHeaders[i];
+
+            layerHeader.Type = static_cast<uint32_t>(sorted[i]->Type);
+            layerHeader.DefinitionHash = HashDefinition(*sorted[i]);
+            layerHeader.CellCountX = layer.CellCount.x;
+            layerHeader.CellCountY = layer.CellCount.y;
+            layerHeader.CellSize = layer.CellSize;
+
+            std::vector<uint32_t> cells(layer.Cells.begin(), layer.Cells.end());
+            writer.Align(COOKED_MAP_ALIGNMENT);
+            layerHeader.CellsOffset = writer.Position() - headerPosition;
+            writer.WriteArray(cells);
+
+            std::vector<uint8_t> clipIndices(layer.CellClipIndex.begin(), layer.CellClipIndex.end());
+            writer.Align(COOKED_MAP_ALIGNMENT);
+            layerHeader.ClipIndicesOffset = writer.Position() - headerPosition;
+            writer.WriteArray(clipIndices);
+        }
+
+        size_t navCellCount = map.NavGrid.GetCellCount();
+        std::vector<uint8_t> navFlags(navCellCount);
+        std::vector<float> navCosts(navCellCount);
+        for (size_t i = 0; i < navCellCount; i++) {
+            auto navCell = map.NavGrid.GetCell(i);
+            navFlags[i] = (navCell.IsWalkable ? NavWalkable : 0) |
+                          (navCell.IsSwimmable ? NavSwimmable : 0) |
+                          (navCell.IsFlyable ? NavFlyable : 0);
+            navCosts[i] = navCell.MoveCost;
+        }
+
+        writer.Align(COOKED_MAP_ALIGNMENT);
+        header.NavFlagsOffset = writer.Position() - headerPosition;
+        writer.WriteArray(navFlags);
+
+        writer.Align(COOKED_MAP_ALIGNMENT);
+        header.NavCostsOffset = writer.Position() - headerPosition;
+        writer.WriteArray(navCosts);
+
+        map.NavGrid.BuildRegions();
+        for (auto movementType: {Navigation::Walk, Navigation::Swim, Navigation::Fly}) {
+            auto& movement = header.Movement[movementType];
+            auto regionSizes = map.NavGrid.GetRegionSizes(movementType);
+            movement.RegionCount = regionSizes.size();
+
+            writer.Align(COOKED_MAP_ALIGNMENT);
+            movement.CellRegionsOffset = writer.Position() - headerPosition;
+            writer.WriteArray(map.NavGrid.GetCellRegions(movementType));
+
+            writer.Align(COOKED_MAP_ALIGNMENT);
+            movement.RegionSizesOffset = writer.Position() - headerPosition;
+            writer.WriteArray(regionSizes);
+
+            writer.Align(COOKED_MAP_ALIGNMENT);
+            movement.VaryingCostOffset = writer.Position() - headerPosition;
+            writer.WriteArray(map.NavGrid.GetVaryingCostRegions(movementType));
+
+            // no cell can be entered - nothing to search
+            if (regionSizes.empty()) continue;
+
+            writer.Align(COOKED_MAP_ALIGNMENT);
+            movement.JumpDistancesOffset = writer.Position() - headerPosition;
+            writer.WriteArray(map.NavGrid.GetJumpDistances(movementType));
+        }
+
+        header.TotalSize = writer.Position() - headerPosition;
+        writer.Patch(headerPosition, header);
+        for (size_t i = 0; i < layerHeaders.size(); i++) {
+            writer.Patch(headerPosition + header.LayersOffset + i * sizeof(CookedLayerHeader), layerHeaders[i]);
+        }
+
+        return true;
+    }
+
+    bool CookedMap::Load(const std::string& path, const std::vector<LayerDefinition>& definitions, TileMap& map) {
+        Serialization::MappedFile file;
+        if (!file.Open(path)) {
+            _log->error("Failed to open cooked map: {}", path);
+            return false;
+        }
+
+        Serialization::BinaryReader reader(file.Data());
+        if (!Load(reader, definitions, map)) {
+            _log->error("Failed to load cooked map: {}", path);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool CookedMap::Load(Serialization::BinaryReader& reader, const std::vector<LayerDefinition>& definitions, TileMap& map) {
+        auto header = reader.Read<CookedMapHeader>();
+        if (reader.Failed() || std::memcmp(header.Magic, CookedMapHeader().Magic, sizeof(header.Magic)) != 0) {
+            _log->error("Not a cooked map");
+            return false;
+        }
+        if (header.Version != COOKED_MAP_VERSION) {
+            _log->error("Unsupported cooked map version {}, expected {} - map needs to be cooked again", header.Version, COOKED_MAP_VERSION);
+            return false;
+        }
+
+        std::vector<CookedLayerHeader> layerHeaders;
+        reader.Seek(header.LayersOffset);
+        reader.ReadArray(layerHeaders, header.LayerCount);
+        if (reader.Failed()) {
+            _log->error("Cooked map is truncated");
+            return false;
+        }
+
+        // every definition must match the one map was cooked with - clip indices and nav data depend on it
+        for (auto& definition: definitions) {
+            auto layerHeader = std::ranges::find_if(layerHeaders, [&definition](const CookedLayerHeader& cooked) {
+                return cooked.Type == static_cast<uint32_t>(definition.Type);
+            });
+            if (layerHeader == layerHeaders.end()) {
+                _log->error("Layer '{}' was not cooked", LayerTypeToString(definition.Type));
+                return false;
+            }
+            if (layerHeader->DefinitionHash != HashDefinition(definition)) {
+                _log->error("Definition of layer '{}' changed since the map was cooked - map needs to be cooked again",
+                            LayerTypeToString(definition.Type));
+                return false;
+            }
+        }
+
+        map.Name.resize(header.NameLength);
+        reader.Seek(header.NameOffset);
+        reader.ReadBlock(map.Name.data(), header.NameLength);
+        map.Size = {header.SizeX, header.SizeY};
+
+        for (auto& layerHeader: layerHeaders) {
+            if (layerHeader.Type > Features) {
+                _log->error("Invalid layer type {}", layerHeader.Type);
+                return false;
+            }
+
+            size_t cellCount = layerHeader.CellCountX * layerHeader.CellCountY;
+            if (layerHeader.CellCountX != 0 && cellCount / layerHeader.CellCountX != layerHeader.CellCountY) {
+                _log->error("Invalid layer size {}x{}", layerHeader.CellCountX, layerHeader.CellCountY);
+                return false;
+            }
+
+            // cells are viewed before the layer is sized, so a bogus size fails here instead of allocating
+            reader.Seek(layerHeader.CellsOffset);
+            auto cells = reader.View<uint32_t>(cellCount);
+            reader.Seek(layerHeader.ClipIndicesOffset);
+            auto clipIndices = reader.View<uint8_t>(cellCount);
+            if (reader.Failed()) {
+                _log->error("Cooked map is truncated");
+                return false;
+            }
+
+            // definition hash covers only number of clips - cells and clip indices are checked like in Cook()
+            auto definition = std::ranges::find_if(definitions, [&layerHeader](const LayerDefinition& candidate) {
+                return static_cast<uint32_t>(candidate.Type) == layerHeader.Type;
+            });
+            if (definition != definitions.end()) {
+                auto clipCounts = definition->GetClipCounts();
+                for (size_t i = 0; i < cellCount; i++) {
+                    if (cells[i] == Config::MAX_SIZE) continue;
+
+                    if (!definition->CellDefinitions.contains(cells[i])) {
+                        _log->error("Cooked map uses cell type {} that is not defined on layer '{}'", cells[i], LayerTypeToString(definition->Type));
+                        return false;
+                    }
+                    auto clipCount = clipCounts.find(cells[i]);
+                    if (clipIndices[i] != 0 && (clipCount == clipCounts.end() || clipIndices[i] >= clipCount->second)) {
+                        _log->error("Cooked map has invalid Animation Clip index {} for cell type {}", clipIndices[i], cells[i]);
+                        return false;
+                    }
+                }
+            }
+
+            auto& layer = GetLayer(map, static_cast<LayerType>(layerHeader.Type));
+            layer.SetSize({layerHeader.CellCountX, layerHeader.CellCountY}, layerHeader.CellSize);
+            layer.Cells.assign(cells.begin(), cells.end());
+            layer.CellClipIndex.assign(clipIndices.begin(), clipIndices.end());
+        }
+
+        size_t navCellCount = header.NavWidth * header.NavHeight;
+        if (header.NavWidth != 0 && navCellCount / header.NavWidth != header.NavHeight) {
+            _log->error("Invalid navigation grid size {}x{}", header.NavWidth, header.NavHeight);
+            return false;
+        }
+
+        reader.Seek(header.NavFlagsOffset);
+        auto navFlags = reader.View<uint8_t>(navCellCount);
+        reader.Seek(header.NavCostsOffset);
+        auto navCosts = reader.View<float>(navCellCount);
+        if (reader.Failed()) {
+            _log->error("Cooked map is truncated");
+            return false;
+        }
+
+        map.NavGrid.Resize(header.NavWidth, header.NavHeight);
+        for (size_t i = 0; i < navCellCount; i++) {
+            map.NavGrid.SetCell(i, {(navFlags[i] & NavWalkable) != 0, (navFlags[i] & NavSwimmable) != 0, (navFlags[i] & NavFlyable) != 0, navCosts[i]});
+        }
+
+        if (navCellCount > std::numeric_limits<size_t>::max() / (8 * sizeof(int32_t))) {
+            _log->error("Invalid navigation grid size {}x{}", header.NavWidth, header.NavHeight);
+            return false;
+        }
+
+        std::array<Navigation::RegionLabelsView, 3> regions;
+        std::array<std::span<const int32_t>, 3> jumpDistances;
+        for (auto movementType: {Navigation::Walk, Navigation::Swim, Navigation::Fly}) {
+            auto& movement = header.Movement[movementType];
+            auto& labels = regions[movementType];
+            // every region has at least one cell
+            if (movement.RegionCount > navCellCount) {
+                _log->error("Invalid region count {}", movement.RegionCount);
+                return false;
+            }
+
+            reader.Seek(movement.CellRegionsOffset);
+            labels.CellRegions = reader.View<uint32_t>(navCellCount);
+            reader.Seek(movement.RegionSizesOffset);
+            labels.RegionSizes = reader.View<uint64_t>(movement.RegionCount);
+            reader.Seek(movement.VaryingCostOffset);
+            labels.HasVaryingCost = reader.View<uint8_t>(movement.RegionCount);
+
+            if (movement.JumpDistancesOffset != 0) {
+                reader.Seek(movement.JumpDistancesOffset);
+                jumpDistances[movementType] = reader.View<int32_t>(navCellCount * 8);
+            }
+        }
+        if (reader.Failed()) {
+            _log->error("Cooked map is truncated");
+            return false;
+        }
+
+        if (!map.NavGrid.SetRegions(regions)) {
+            _log->error("Cooked map has invalid navigation regions");
+            return false;
+        }
+        for (auto movementType: {Navigation::Walk, Navigation::Swim, Navigation::Fly}) {
+            if (header.Movement[movementType].JumpDistancesOffset != 0 && !map.NavGrid.SetJumpDistances(movementType, jumpDistances[movementType])) {
+                _log->error("Cooked map has invalid jump distances");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    uint64_t CookedMap::HashDefinition(const LayerDefinition& definition) {
+        std::vector<unsigned> cellTypes;
+        for (auto& cellType: definition.CellDefinitions | std::views::keys) {
+            cellTypes.push_back(cellType);
+        }
+        std::ranges::sort(cellTypes);
+
+        uint64_t hash = 14695981039346656037ull;
+        HashValue(hash, static_cast<uint32_t>(definition.Type));
+        for (auto cellType: cellTypes) {
+            auto& cellDefinition = definition.CellDefinitions.at(cellType);
+            HashValue(hash, cellType);
+            HashValue(hash, cellDefinition.IsWalkable);
+            HashValue(hash, cellDefinition.IsSwimmable);
+            HashValue(hash, cellDefinition.IsFlyable);
+            HashValue(hash, std::bit_cast<uint32_t>(cellDefinition.MoveCost));
+            HashValue(hash, static_cast<uint64_t>(cellDefinition.AnimationClipNames.size()));
+        }
+        return hash;
+    }
+
+    std::vector<const LayerDefinition*> CookedMap::SortDefinitions(const std::vector<LayerDefinition>& definitions) {
+        std::vector<const LayerDefinition*> sorted;
+        for (auto& definition: definitions) {
+            sorted.push_back(&definition);
+        }
+
+        // features are applied last, so their navigation data overrides terrain's
+        std::ranges::stable_sort(sorted, [](const LayerDefinition* a, const LayerDefinition* b) {
+            return a->Type < b->Type;
+        });
+        return sorted;
+    }
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LayerDefinition.h"
+#include "serialization/BinaryReader.h"
+#include "serialization/BinaryWriter.h"
+
+namespace LowEngine::Terrain {
+    class TileMap;
+
+    /**
+     * @brief Current version of the cooked map format. Files with different version are rejected.
+     */
+    inline constexpr uint32_t COOKED_MAP_VERSION = 2;
+
+    /**
+     * @brief Alignment of every array in cooked map file, in bytes. Arrays are used in-place from memory-mapped file.
+     */
+    inline constexpr size_t COOKED_MAP_ALIGNMENT = 16;
+
+    /**
+     * @brief Packed navigation properties of a single cell.
+     */
+    enum CookedNavFlags : uint8_t {
+        NavWalkable = 1 << 0,
+        NavSwimmable = 1 << 1,
+        NavFlyable = 1 << 2
+    };
+
+    /**
+     * @brief Navigation regions and jump distances of a single type of movement. Offsets are relative to the beginning of the file.
+     */
+    struct CookedMovementData {
+        uint64_t RegionCount = 0;
+        /**
+         * @brief uint32_t region ID for every navigation cell, NavigationGrid::NO_REGION for cells that can't be entered.
+         */
+        uint64_t CellRegionsOffset = 0;
+        /**
+         * @brief uint64_t number of cells for every region.
+         */
+        uint64_t RegionSizesOffset = 0;
+        /**
+         * @brief uint8_t flag for every region, 1 if its cells have different move costs.
+         */
+        uint64_t VaryingCostOffset = 0;
+        /**
+         * @brief int32_t Jump Point Search distance for every navigation cell and direction. 0 if movement type has no regions.
+         */
+        uint64_t JumpDistancesOffset = 0;
+    };
+
+    /**
+     * @brief Header of cooked map file. Offsets are relative to the beginning of the file.
+     */
+    struct CookedMapHeader {
+        char Magic[4] = {'L', 'O', 'W', 'T'};
+        uint32_t Version = COOKED_MAP_VERSION;
+        uint64_t SizeX = 0;
+        uint64_t SizeY = 0;
+        uint64_t NavWidth = 0;
+        uint64_t NavHeight = 0;
+        uint32_t LayerCount = 0;
+        uint32_t NameLength = 0;
+        uint64_t NameOffset = 0;
+        uint64_t LayersOffset = 0;
+        /**
+         * @brief uint8_t CookedNavFlags for every navigation cell.
+         */
+        uint64_t NavFlagsOffset = 0;
+        /**
+         * @brief float MoveCost for every navigation cell.
+         */
+        uint64_t NavCostsOffset = 0;
+        /**
+         * @brief Regions and jump distances of Walk, Swim and Fly movement, in that order.
+         */
+        std::array<CookedMovementData, 3> Movement = {};
+        uint64_t TotalSize = 0;
+    };
+
+    /**
+     * @brief Description of a single layer in cooked map file.
+     */
+    struct CookedLayerHeader {
+        uint32_t Type = 0;
+        uint32_t Padding = 0;
+        /**
+         * @brief Hash of LayerDefinition used for cooking. Map must be loaded with matching definition.
+         */
+        uint64_t DefinitionHash = 0;
+        uint64_t CellCountX = 0;
+        uint64_t CellCountY = 0;
+        uint64_t CellSize = 0;
+        /**
+         * @brief uint32_t cell type for every cell, Config::MAX_SIZE for empty cells.
+         */
+        uint64_t CellsOffset = 0;
+        /**
+         * @brief uint8_t Animation Clip index for every cell.
+         */
+        uint64_t ClipIndicesOffset = 0;
+    };
+
+    /**
+     * @brief Offline conversion of LDTk maps into a binary file that can be loaded without any parsing.
+     *
+     * Cooked file holds everything derived from LDTk level and layer definitions: cell arrays, selected
+     * Animation Clip for every cell, packed navigation data with its regions and Jump Point Search distances.
+     * Loading it is a memory map and a few array copies - no flood fill or jump distance computation.
+     * Textures and Animation Clips are still resolved at load time, as they only exist at runtime.
+     */
+    class CookedMap {
+    public:
+        /**
+         * @brief Check if the file is a cooked map, by its magic value.
+         * @param path Path to the file.
+         */
+        static bool IsCookedMap(const std::string& path);
+
+        /**
+         * @brief Assign Animation Clips and navigation data to the map and write it in cooked format.
+         * @param map Map loaded from LDTk file.
+         * @param definitions Definitions of map's layers. Texture IDs are ignored.
+         * @param writer Writer that receives the file.
+         * @return True if successful. False if definitions don't match the map.
+         */
+        static bool Cook(TileMap& map, const std::vector<LayerDefinition>& definitions, Serialization::BinaryWriter& writer);
+
+        /**
+         * @brief Load cooked map from file. Safe to call from loader threads.
+         *
+         * Provided definitions must match the ones used for cooking - otherwise clip indices and navigation
+         * data would be stale and the file is rejected.
+         * @param path Path to the cooked map file.
+         * @param definitions Definitions of map's layers.
+         * @param map Map to fill.
+         * @return True if successful.
+         */
+        static bool Load(const std::string& path, const std::vector<LayerDefinition>& definitions, TileMap& map);
+
+        /**
+         * @brief Load cooked map from memory.
+         * @see Load()
+         */
+        static bool Load(Serialization::BinaryReader& reader, const std::vector<LayerDefinition>& definitions, TileMap& map);
+
+        /**
+         * @brief Hash of everything in LayerDefinition that affects cooked data.
+         */
+        static uint64_t HashDefinition(const LayerDefinition& definition);
+
+        /**
+         * @brief Order definitions the way they are applied: Terrain first, then Features.
+         */
+        static std::vector<const LayerDefinition*> SortDefinitions(const std::vector<LayerDefinition>& definitions);
+    };
+}
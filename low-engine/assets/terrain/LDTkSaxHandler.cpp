@@ -0,0 +1,227 @@
+#include "LDTkSaxHandler.h"
+
+#include "Config.h"
+#include "TileMap.h"
+
+namespace LowEngine::Terrain {
+    bool LDTkSaxHandler::null() {
+        return true;
+    }
+
+    bool LDTkSaxHandler::boolean(bool) {
+        return true;
+    }
+
+    bool LDTkSaxHandler::number_integer(number_integer_t val) {
+        if (val < 0) {
+            // negative values are only used by fields the map doesn't read (i.e. world coordinates)
+            auto context = Current();
+            if (context == Context::TileDestination || context == Context::TileSource) {
+                return Fail("Negative tile coordinate");
+            }
+            return true;
+        }
+        return OnNumber(static_cast<size_t>(val));
+    }
+
+    bool LDTkSaxHandler::number_unsigned(number_unsigned_t val) {
+        return OnNumber(static_cast<size_t>(val));
+    }
+
+    bool LDTkSaxHandler::number_float(number_float_t val, const string_t&) {
+        if (val < 0) return true;
+        return OnNumber(static_cast<size_t>(val));
+    }
+
+    bool LDTkSaxHandler::string(string_t& val) {
+        auto context = Current();
+        if (context == Context::Root && _key == "identifier") {
+            _map.Name = val;
+        } else if (context == Context::Layer && _key == "__identifier") {
+            _hasIdentifier = true;
+            if (val == "Terrain") {
+                _layer = &_map.TerrainLayer;
+                _isTerrainLayer = true;
+            } else if (val == "Features") {
+                _layer = &_map.FeaturesLayer;
+            }
+            return TryBeginLayer();
+        }
+        return true;
+    }
+
+    bool LDTkSaxHandler::binary(binary_t&) {
+        return true;
+    }
+
+    bool LDTkSaxHandler::start_object(std::size_t) {
+        switch (Current()) {
+            case Context::LayerInstances:
+                _layer = nullptr;
+                _isTerrainLayer = false;
+                _layerReady = false;
+                _hasIdentifier = false;
+                _cellCountX = Config::MAX_SIZE;
+                _cellCountY = Config::MAX_SIZE;
+                _gridSize = Config::MAX_SIZE;
+                _bufferedTiles.clear();
+                _contexts.push_back(Context::Layer);
+                break;
+            case Context::GridTiles:
+                _tileCellIndex = Config::MAX_SIZE;
+                _tileSourceY = Config::MAX_SIZE;
+                _contexts.push_back(Context::Tile);
+                break;
+            default:
+                _contexts.push_back(_contexts.empty() ? Context::Root : Context::Skip);
+                break;
+        }
+        return true;
+    }
+
+    bool LDTkSaxHandler::key(string_t& val) {
+        auto context = Current();
+        // keys are only needed in objects that hold values of interest
+        if (context != Context::Skip) {
+            _key = val;
+        }
+        return true;
+    }
+
+    bool LDTkSaxHandler::end_object() {
+        auto context = Current();
+        _contexts.pop_back();
+
+        if (context == Context::Tile) {
+            if (_tileCellIndex == Config::MAX_SIZE || _tileSourceY == Config::MAX_SIZE) {
+                return Fail("Tile without destination or source");
+            }
+
+            if (_layerReady) {
+                return WriteTile(_tileCellIndex, _tileSourceY);
+            }
+            if (!_hasIdentifier || _layer != nullptr) {
+                _bufferedTiles.emplace_back(_tileCellIndex, _tileSourceY);
+            }
+        }
+
+        if (context == Context::Layer) {
+            return EndLayer();
+        }
+
+        return true;
+    }
+
+    bool LDTkSaxHandler::start_array(std::size_t) {
+        auto context = Current();
+        if (context == Context::Root && _key == "layerInstances") {
+            _contexts.push_back(Context::LayerInstances);
+        } else if (context == Context::Layer && _key == "gridTiles") {
+            _contexts.push_back(Context::GridTiles);
+        } else if (context == Context::Tile && _key == "d") {
+            _arrayIndex = 0;
+            _contexts.push_back(Context::TileDestination);
+        } else if (context == Context::Tile && _key == "src") {
+            _arrayIndex = 0;
+            _contexts.push_back(Context::TileSource);
+        } else {
+            _contexts.push_back(Context::Skip);
+        }
+        return true;
+    }
+
+    bool LDTkSaxHandler::end_array() {
+        _contexts.pop_back();
+        return true;
+    }
+
+    bool LDTkSaxHandler::parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+        return Fail(ex.what());
+    }
+
+    bool LDTkSaxHandler::OnNumber(size_t val) {
+        switch (Current()) {
+            case Context::Root:
+                if (_key == "pxWid") _map.Size.x = val;
+                else if (_key == "pxHei") _map.Size.y = val;
+                break;
+            case Context::Layer:
+                if (_key == "__cWid") _cellCountX = val;
+                else if (_key == "__cHei") _cellCountY = val;
+                else if (_key == "__gridSize") _gridSize = val;
+                else break;
+                return TryBeginLayer();
+            case Context::TileDestination:
+                // "d" holds [cellIndex], possibly followed by other values
+                if (_arrayIndex == 0) _tileCellIndex = val;
+                _arrayIndex++;
+                break;
+            case Context::TileSource:
+                // "src" holds [x, y] of the tile on the tileset, in pixels
+                if (_arrayIndex == 1) _tileSourceY = val;
+                _arrayIndex++;
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    bool LDTkSaxHandler::TryBeginLayer() {
+        if (_layerReady || !_hasIdentifier || _cellCountX == Config::MAX_SIZE ||
+            _cellCountY == Config::MAX_SIZE || _gridSize == Config::MAX_SIZE) {
+            return true;
+        }
+        _layerReady = true;
+
+        if (_layer == nullptr) {
+            _bufferedTiles.clear();
+            return true;
+        }
+
+        _layer->SetSize({_cellCountX, _cellCountY}, _gridSize);
+        _layer->Cells.assign(_cellCountX * _cellCountY, Config::MAX_SIZE);
+
+        if (_isTerrainLayer) {
+            _map.NavGrid.Resize(_cellCountX, _cellCountY);
+        }
+
+        // tiles are written in file's order - later tiles in the same cell overwrite earlier ones
+        for (auto& [cellIndex, sourceY]: _bufferedTiles) {
+            if (!WriteTile(cellIndex, sourceY)) return false;
+        }
+        _bufferedTiles.clear();
+        return true;
+    }
+
+    bool LDTkSaxHandler::WriteTile(size_t cellIndex, size_t sourceY) {
+        if (_layer == nullptr) return true;
+
+        if (_gridSize == 0) {
+            return Fail("Layer with zero grid size");
+        }
+        if (cellIndex >= _layer->Cells.size()) {
+            return Fail("Tile outside of the layer");
+        }
+
+        _layer->Cells[cellIndex] = sourceY / _gridSize;
+        return true;
+    }
+
+    bool LDTkSaxHandler::EndLayer() {
+        if (!_bufferedTiles.empty()) {
+            return Fail("Layer with tiles, but without identifier or size");
+        }
+
+        _layer = nullptr;
+        _layerReady = false;
+        return true;
+    }
+
+    bool LDTkSaxHandler::Fail(const std::string& error) {
+        if (_error.empty()) {
+            _error = error;
+        }
+        return false;
+    }
+}
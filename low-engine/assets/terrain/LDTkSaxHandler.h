@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace LowEngine::Terrain {
+    class TileMap;
+    class Layer;
+
+    /**
+     * @brief Streaming reader of LDTk level files (*.ldtkl), built on nlohmann's SAX interface.
+     *
+     * Tiles are written straight into layer's Cells while the file is tokenized - no JSON DOM is built,
+     * so memory use doesn't grow with file size beyond the map itself. Only values used by
+     * TileMap::LoadFromLDTkJson() are read, everything else is skipped.
+     */
+    class LDTkSaxHandler : public nlohmann::json_sax<nlohmann::json> {
+    public:
+        /**
+         * @brief Create handler that fills provided map.
+         * @param map Map to fill. Must outlive the handler.
+         */
+        explicit LDTkSaxHandler(TileMap& map) : _map(map) {
+        }
+
+        bool null() override;
+
+        bool boolean(bool val) override;
+
+        bool number_integer(number_integer_t val) override;
+
+        bool number_unsigned(number_unsigned_t val) override;
+
+        bool number_float(number_float_t val, const string_t& s) override;
+
+        bool string(string_t& val) override;
+
+        bool binary(binary_t& val) override;
+
+        bool start_object(std::size_t elements) override;
+
+        bool key(string_t& val) override;
+
+        bool end_object() override;
+
+        bool start_array(std::size_t elements) override;
+
+        bool end_array() override;
+
+        bool parse_error(std::size_t position, const std::string& lastToken, const nlohmann::detail::exception& ex) override;
+
+        /**
+         * @brief Description of the first error found in the file. Empty if there was none.
+         */
+        [[nodiscard]] const std::string& GetError() const { return _error; }
+
+    protected:
+        /**
+         * @brief JSON containers the handler cares about. Everything else is Skip.
+         */
+        enum class Context {
+            Root,
+            LayerInstances,
+            Layer,
+            GridTiles,
+            Tile,
+            TileDestination,
+            TileSource,
+            Skip
+        };
+
+        TileMap& _map;
+        std::vector<Context> _contexts;
+        std::string _key;
+        std::string _error;
+
+        // state of the layer object being read
+        Layer* _layer = nullptr;
+        bool _isTerrainLayer = false;
+        bool _layerReady = false;
+        size_t _cellCountX = 0;
+        size_t _cellCountY = 0;
+        size_t _gridSize = 0;
+        bool _hasIdentifier = false;
+        /**
+         * @brief Tiles read before layer's identifier and size - only used if file doesn't follow LDTk's key order.
+         */
+        std::vector<std::pair<size_t, size_t>> _bufferedTiles;
+
+        // state of the tile object being read
+        size_t _tileCellIndex = 0;
+        size_t _tileSourceY = 0;
+        size_t _arrayIndex = 0;
+
+        [[nodiscard]] Context Current() const { return _contexts.empty() ? Context::Skip : _contexts.back(); }
+
+        bool OnNumber(size_t val);
+
+        /**
+         * @brief Prepare layer's Cells once identifier and size are known and write tiles read before that.
+         */
+        bool TryBeginLayer();
+
+        bool WriteTile(size_t cellIndex, size_t sourceY);
+
+        bool EndLayer();
+
+        bool Fail(const std::string& error);
+    };
+}
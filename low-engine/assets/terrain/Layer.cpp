@@ -1,5 +1,7 @@
 #include "Layer.h"
 
+#include <random>
+
 #include "Config.h"
 #include "assets/Assets.h"
 #include "SFML/System/Vector2.hpp"
@@ -8,7 +10,18 @@ namespace LowEngine::Terrain {
     void Layer::LoadTexture(size_t textureId) {
         _textureId = textureId;
 
-        _sourceImage = Assets::GetTexture(_textureId).copyToImage();
+        // texture packed into an atlas is only a part of atlas page - cells are read relative to texture's corner
+        auto region = Assets::GetTextureRect(_textureId);
+        auto& texture = Assets::GetTexture(_textureId);
+        if (region.position == sf::Vector2i(0, 0) && sf::Vector2u(region.size) == texture.getSize()) {
+            _sourceImage = texture.copyToImage();
+            return;
+        }
+
+        _sourceImage.resize(sf::Vector2u(region.size), sf::Color::Transparent);
+        if (!_sourceImage.copy(texture.copyToImage(), {0, 0}, region)) {
+            _log->error("Failed to copy texture with id {} from atlas for a map's Layer.", _textureId);
+        }
     }
 
     void Layer::SetSize(const sf::Vector2<size_t>& cellCount, const size_t& cellSize) {
@@ -18,16 +31,36 @@ namespace LowEngine::Terrain {
         LayerSize.x = CellCount.x * CellSize;
         LayerSize.y = CellCount.y * CellSize;
 
-        _image.resize({static_cast<unsigned>(LayerSize.x), static_cast<unsigned>(LayerSize.y)}, sf::Color::Transparent);
+        // image is allocated on first draw - maps used only for navigation would hold gigabytes of pixels
+        _image = sf::Image();
         _sprite.setTextureRect(sf::IntRect({0, 0}, {static_cast<int>(LayerSize.x), static_cast<int>(LayerSize.y)}));
     }
 
+    void Layer::AssignClipIndices(const std::unordered_map<size_t, size_t>& clipCounts) {
+        std::random_device rd;
+        std::mt19937 gen(rd());
+
+        CellClipIndex.assign(Cells.size(), 0);
+        for (size_t cellIndex = 0; cellIndex < Cells.size(); cellIndex++) {
+            auto clipCount = clipCounts.find(Cells[cellIndex]);
+            if (clipCount != clipCounts.end() && clipCount->second >= 2) {
+                std::uniform_int_distribution<> dis(0, static_cast<int>(clipCount->second - 1));
+                CellClipIndex[cellIndex] = dis(gen);
+            }
+        }
+    }
+
     sf::Sprite* Layer::GetDrawable() {
         if (_sourceImage.getSize() == sf::Vector2u(0, 0)) {
             // source image for this layer was not assigned - layer will not be drawn
             return nullptr;
         }
 
+        sf::Vector2u imageSize(static_cast<unsigned>(LayerSize.x), static_cast<unsigned>(LayerSize.y));
+        if (_image.getSize() != imageSize) {
+            _image.resize(imageSize, sf::Color::Transparent);
+        }
+
         // function updates _image, whish is a local "buffer"/source for internal Sprite.
         // it goes through all Cells, checking what is the index for each of it. Index is equvalent to "Cell Type" (and also actual image, that should be used)
         for (size_t cellIndex = 0; cellIndex < Cells.size(); cellIndex++) {
@@ -101,12 +101,12 @@ namespace LowEngine::Terrain {
         std::unordered_map<size_t, AnimatedTileState> AnimatedTiles;
 
         /**
-         * @brief Index of Animation Clip that was assigned to a cell.
+         * @brief Index of Animation Clip that was assigned to a cell, for every cell of the layer.
          *
          * If particular cell has multiple Animation Clips assigned to it, on load one of the Clips will be selected at random.
-         * Index of the selected Clip will be stored in this map.
+         * Index of the selected Clip will be stored in this vector. Cells that are not animated hold 0.
          */
-        std::unordered_map<size_t, size_t> CellClipIndex;
+        std::vector<size_t> CellClipIndex;
 
         /**
          * @brief Constructs a new Layer object with a default texture.
@@ -137,6 +137,14 @@ namespace LowEngine::Terrain {
          */
         void SetSize(const sf::Vector2<size_t>& cellCount, const size_t& cellSize);
 
+        /**
+         * @brief Select Animation Clip for every animated cell at random.
+         *
+         * Selection is done once, so Clips don't switch during gameplay. Cooked maps store the result.
+         * @param clipCounts Number of Clips defined for each animated cell type.
+         */
+        void AssignClipIndices(const std::unordered_map<size_t, size_t>& clipCounts);
+
         /**
          * @brief Updates underlying Sprite object to reflect current state of animated tiles and return a pointer to the updated Sprite.
          * @return Pointer to updated Sprite. Nullpointer if generation failed.
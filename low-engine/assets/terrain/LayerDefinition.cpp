@@ -1,2 +1,13 @@
-
 #include "LayerDefinition.h"
+
+namespace LowEngine::Terrain {
+    std::unordered_map<size_t, size_t> LayerDefinition::GetClipCounts() const {
+        std::unordered_map<size_t, size_t> clipCounts;
+        for (auto& [cellType, cellDefinition]: CellDefinitions) {
+            if (!cellDefinition.AnimationClipNames.empty()) {
+                clipCounts[cellType] = cellDefinition.AnimationClipNames.size();
+            }
+        }
+        return clipCounts;
+    }
+}
@@ -68,5 +68,10 @@ namespace LowEngine::Terrain {
               TextureId(textureId),
               CellDefinitions(std::move(cellDefinitions)) {
         }
+
+        /**
+         * @brief Retrieve number of Animation Clips for every animated cell type.
+         */
+        [[nodiscard]] std::unordered_map<size_t, size_t> GetClipCounts() const;
     };
 }
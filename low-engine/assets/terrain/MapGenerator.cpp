@@ -0,0 +1,299 @@
+#include "MapGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <ranges>
+
+#include <spdlog/fmt/fmt.h>
+
+#include "Config.h"
+#include "Log.h"
+#include "TileMap.h"
+#include "threading/ThreadPool.h"
+
+namespace LowEngine::Terrain {
+    /**
+     * @brief Navigation properties and number of Animation Clips of a layer's cell types, indexed by cell type.
+     */
+    struct CellTypeTable {
+        std::vector<const CellDefinition*> Definitions;
+        std::vector<size_t> ClipCounts;
+
+        explicit CellTypeTable(const LayerDefinition* definition) {
+            if (definition == nullptr) return;
+
+            for (auto& [cellType, cellDefinition]: definition->CellDefinitions) {
+                if (cellType >= Definitions.size()) {
+                    Definitions.resize(cellType + 1, nullptr);
+                    ClipCounts.resize(cellType + 1, 0);
+                }
+                Definitions[cellType] = &cellDefinition;
+                ClipCounts[cellType] = cellDefinition.AnimationClipNames.size();
+            }
+        }
+    };
+
+    static size_t Pick(const std::vector<size_t>& types, uint32_t random) {
+        if (types.empty()) return Config::MAX_SIZE;
+        return types[random % types.size()];
+    }
+
+    static Navigation::NavigationCell GetNavData(const CellDefinition& definition) {
+        return {definition.IsWalkable, definition.IsSwimmable, definition.IsFlyable, definition.MoveCost};
+    }
+
+    bool MapGenerator::Generate(const MapGeneratorSettings& settings, const std::vector<LayerDefinition>& definitions,
+                                TileMap& map, Threading::ThreadPool* pool) {
+        if (settings.Width == 0 || settings.Height == 0 || settings.CellSize == 0 || settings.Octaves == 0 ||
+            settings.TerrainScale <= 0.0f || settings.FeatureScale <= 0.0f) {
+            _log->error("Map generator: invalid settings for map of {}x{} cells", settings.Width, settings.Height);
+            return false;
+        }
+
+        const LayerDefinition* terrainDefinition = nullptr;
+        const LayerDefinition* featuresDefinition = nullptr;
+        for (auto& definition: definitions) {
+            if (definition.Type == LayerType::Terrain && terrainDefinition == nullptr) terrainDefinition = &definition;
+            if (definition.Type == LayerType::Features && featuresDefinition == nullptr) featuresDefinition = &definition;
+        }
+
+        if (terrainDefinition == nullptr) {
+            _log->error("Map generator: definition of Terrain layer is required");
+            return false;
+        }
+
+        CellTypes terrainTypes = SelectCellTypes(*terrainDefinition);
+        if (terrainTypes.Walkable.empty() || terrainTypes.Swimmable.empty()) {
+            _log->error("Map generator: Terrain layer needs at least one walkable and one swimmable (not walkable) cell type");
+            return false;
+        }
+        CellTypes featureTypes = featuresDefinition != nullptr ? SelectCellTypes(*featuresDefinition) : CellTypes();
+
+        CellTypeTable terrainTable(terrainDefinition);
+        CellTypeTable featuresTable(featuresDefinition);
+
+        size_t width = settings.Width;
+        size_t cellCount = settings.Width * settings.Height;
+
+        map.Name = fmt::format("Generated_{}x{}_{}", settings.Width, settings.Height, settings.Seed);
+        map.Size = {settings.Width * settings.CellSize, settings.Height * settings.CellSize};
+
+        for (auto* layer: {&map.TerrainLayer, &map.FeaturesLayer}) {
+            layer->SetSize({settings.Width, settings.Height}, settings.CellSize);
+            layer->Cells.assign(cellCount, Config::MAX_SIZE);
+            layer->CellClipIndex.assign(cellCount, 0);
+            layer->AnimatedTiles.clear();
+        }
+
+        map.NavGrid.Resize(settings.Width, settings.Height);
+
+        // separate seeds keep the fields independent of each other
+        uint32_t elevationSeed = settings.Seed;
+        uint32_t forestSeed = Hash(1, 0, settings.Seed);
+        uint32_t variantSeed = Hash(2, 0, settings.Seed);
+
+        ForEachRowBand(settings.Height, pool, [&](size_t firstRow, size_t endRow) {
+            for (size_t y = firstRow; y < endRow; y++) {
+                for (size_t x = 0; x < width; x++) {
+                    size_t index = x + y * width;
+                    auto fx = static_cast<float>(x);
+                    auto fy = static_cast<float>(y);
+                    uint32_t variant = Hash(static_cast<int32_t>(x), static_cast<int32_t>(y), variantSeed);
+
+                    float elevation = FractalNoise(fx / settings.TerrainScale, fy / settings.TerrainScale, settings.Octaves, elevationSeed);
+                    size_t terrain;
+                    size_t feature = Config::MAX_SIZE;
+                    if (elevation < settings.WaterLevel) {
+                        terrain = Pick(terrainTypes.Swimmable, variant);
+                    } else {
+                        terrain = Pick(terrainTypes.Walkable, variant);
+                        if (elevation > settings.MountainLevel) {
+                            feature = Pick(featureTypes.Blocking, variant >> 8);
+                        } else if (!featureTypes.Walkable.empty() &&
+                                   FractalNoise(fx / settings.FeatureScale, fy / settings.FeatureScale, settings.Octaves, forestSeed) > settings.ForestLevel) {
+                            feature = Pick(featureTypes.Walkable, variant >> 8);
+                        }
+                    }
+
+                    // same rules as TileMap::ReadNavData() - features overwrite navigation data of terrain
+                    auto navCell = GetNavData(*terrainTable.Definitions[terrain]);
+
+                    map.TerrainLayer.Cells[index] = terrain;
+                    if (terrainTable.ClipCounts[terrain] >= 2) {
+                        map.TerrainLayer.CellClipIndex[index] = (variant >> 16) % terrainTable.ClipCounts[terrain];
+                    }
+
+                    if (feature != Config::MAX_SIZE) {
+                        map.FeaturesLayer.Cells[index] = feature;
+                        navCell = GetNavData(*featuresTable.Definitions[feature]);
+                        if (featuresTable.ClipCounts[feature] >= 2) {
+                            map.FeaturesLayer.CellClipIndex[index] = (variant >> 24) % featuresTable.ClipCounts[feature];
+                        }
+                    }
+
+                    map.NavGrid.SetCell(index, navCell);
+                }
+            }
+        });
+
+        map.NavGrid.BuildRegions();
+
+        LOW_LOG_DEBUG(Assets, "Generated map '{}' of {}x{} cells", map.Name, settings.Width, settings.Height);
+        return true;
+    }
+
+    bool MapGenerator::SaveAsLDTk(const TileMap& map, const std::string& path, Threading::ThreadPool* pool) {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            _log->error("Failed to open LDTk file for writing: {}", path);
+            return false;
+        }
+
+        file << fmt::format(R"({{"identifier":"{}","pxWid":{},"pxHei":{},"layerInstances":[)", map.Name, map.Size.x, map.Size.y);
+
+        bool firstLayer = true;
+        // LDTk lists layers from the top one
+        for (auto* layer: {&map.FeaturesLayer, &map.TerrainLayer}) {
+            if (layer->Cells.empty()) continue;
+
+            size_t width = layer->CellCount.x;
+            size_t cellSize = layer->CellSize;
+            file << (firstLayer ? "" : ",")
+                 << fmt::format(R"({{"__identifier":"{}","__type":"Tiles","__cWid":{},"__cHei":{},"__gridSize":{},"gridTiles":[)",
+                                LayerTypeToString(layer->Type), layer->CellCount.x, layer->CellCount.y, cellSize);
+            firstLayer = false;
+
+            // rows are formatted in parallel, then written in order
+            std::vector<fmt::memory_buffer> bands(layer->CellCount.y);
+            ForEachRowBand(layer->CellCount.y, pool, [&](size_t firstRow, size_t endRow) {
+                for (size_t y = firstRow; y < endRow; y++) {
+                    auto& buffer = bands[y];
+                    for (size_t x = 0; x < width; x++) {
+                        size_t index = x + y * width;
+                        size_t cellType = layer->Cells[index];
+                        if (cellType == Config::MAX_SIZE) continue;
+
+                        fmt::format_to(std::back_inserter(buffer), R"({{"px":[{},{}],"src":[0,{}],"f":0,"t":{},"d":[{}]}},)",
+                                       x * cellSize, y * cellSize, cellType * cellSize, cellType, index);
+                    }
+                }
+            });
+
+            bool firstTile = true;
+            for (auto& buffer: bands) {
+                if (buffer.size() == 0) continue;
+                if (!firstTile) file << ",";
+                // every tile ends with a separator - the last one of a row is dropped
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size() - 1));
+                firstTile = false;
+            }
+            file << "]}";
+        }
+
+        file << "]}\n";
+        if (!file) {
+            _log->error("Failed to write LDTk file: {}", path);
+            return false;
+        }
+
+        LOW_LOG_DEBUG(Assets, "Map '{}' saved as LDTk file: {}", map.Name, path);
+        return true;
+    }
+
+    float MapGenerator::FractalNoise(float x, float y, unsigned octaves, uint32_t seed) {
+        float sum = 0.0f;
+        float amplitude = 1.0f;
+        float totalAmplitude = 0.0f;
+
+        for (unsigned octave = 0; octave < octaves; octave++) {
+            sum += ValueNoise(x, y, seed + octave) * amplitude;
+            totalAmplitude += amplitude;
+            amplitude *= 0.5f;
+            x *= 2.0f;
+            y *= 2.0f;
+        }
+
+        return sum / totalAmplitude;
+    }
+
+    MapGenerator::CellTypes MapGenerator::SelectCellTypes(const LayerDefinition& definition) {
+        // order of unordered_map differs between standard libraries - sorting keeps maps the same everywhere
+        std::vector<size_t> sortedTypes;
+        for (auto& cellType: definition.CellDefinitions | std::views::keys) {
+            sortedTypes.push_back(cellType);
+        }
+        std::sort(sortedTypes.begin(), sortedTypes.end());
+
+        CellTypes types;
+        for (size_t cellType: sortedTypes) {
+            auto& cell = definition.CellDefinitions.at(static_cast<unsigned>(cellType));
+            if (cell.IsWalkable) {
+                types.Walkable.push_back(cellType);
+            } else if (cell.IsSwimmable) {
+                types.Swimmable.push_back(cellType);
+            } else {
+                types.Blocking.push_back(cellType);
+            }
+        }
+        return types;
+    }
+
+    uint32_t MapGenerator::Hash(int32_t x, int32_t y, uint32_t seed) {
+        // integer finalizer of MurmurHash3 over combined coordinates
+        uint32_t hash = seed ^ (static_cast<uint32_t>(x) * 0x27d4eb2du) ^ (static_cast<uint32_t>(y) * 0x165667b1u);
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+    float MapGenerator::ValueNoise(float x, float y, uint32_t seed) {
+        float floorX = std::floor(x);
+        float floorY = std::floor(y);
+        auto cellX = static_cast<int32_t>(floorX);
+        auto cellY = static_cast<int32_t>(floorY);
+
+        // smoothstep keeps the surface continuous across lattice cells
+        float tx = x - floorX;
+        float ty = y - floorY;
+        tx = tx * tx * (3.0f - 2.0f * tx);
+        ty = ty * ty * (3.0f - 2.0f * ty);
+
+        constexpr float scale = 1.0f / 16777215.0f;
+        float corner00 = static_cast<float>(Hash(cellX, cellY, seed) >> 8) * scale;
+        float corner10 = static_cast<float>(Hash(cellX + 1, cellY, seed) >> 8) * scale;
+        float corner01 = static_cast<float>(Hash(cellX, cellY + 1, seed) >> 8) * scale;
+        float corner11 = static_cast<float>(Hash(cellX + 1, cellY + 1, seed) >> 8) * scale;
+
+        float top = corner00 + (corner10 - corner00) * tx;
+        float bottom = corner01 + (corner11 - corner01) * tx;
+        return top + (bottom - top) * ty;
+    }
+
+    void MapGenerator::ForEachRowBand(size_t height, Threading::ThreadPool* pool, const std::function<void(size_t, size_t)>& band) {
+        std::unique_ptr<Threading::ThreadPool> temporaryPool;
+        if (pool == nullptr) {
+            temporaryPool = std::make_unique<Threading::ThreadPool>();
+            pool = temporaryPool.get();
+        }
+
+        // more bands than threads - rows with many features take longer, small bands even out the load
+        size_t bandCount = std::min(height, pool->GetThreadCount() * 4);
+        size_t rowsPerBand = (height + bandCount - 1) / bandCount;
+
+        std::vector<std::future<void>> jobs;
+        for (size_t firstRow = 0; firstRow < height; firstRow += rowsPerBand) {
+            size_t endRow = std::min(height, firstRow + rowsPerBand);
+            jobs.push_back(pool->Submit([&band, firstRow, endRow] { band(firstRow, endRow); }));
+        }
+
+        for (auto& job: jobs) {
+            job.get();
+        }
+    }
+}
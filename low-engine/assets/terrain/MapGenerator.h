@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "LayerDefinition.h"
+
+namespace LowEngine::Threading {
+    class ThreadPool;
+}
+
+namespace LowEngine::Terrain {
+    class TileMap;
+
+    /**
+     * @brief Parameters of a generated map. The same settings and layer definitions always give the same map.
+     */
+    struct MapGeneratorSettings {
+        /**
+         * @brief Size of the map, in cells.
+         */
+        size_t Width = 256;
+        size_t Height = 256;
+
+        /**
+         * @brief Size of single cell, in pixels. Must match the tile size of layer textures.
+         */
+        size_t CellSize = 16;
+
+        uint32_t Seed = 1;
+
+        /**
+         * @brief Size of continents and lakes, in cells. Larger values give fewer, bigger areas.
+         */
+        float TerrainScale = 96.0f;
+
+        /**
+         * @brief Size of forests, in cells.
+         */
+        float FeatureScale = 24.0f;
+
+        /**
+         * @brief Number of noise layers summed together. More octaves give rougher coastlines.
+         */
+        unsigned Octaves = 5;
+
+        /**
+         * @brief Elevation (0-1) below which terrain is water.
+         */
+        float WaterLevel = 0.42f;
+
+        /**
+         * @brief Elevation (0-1) above which land is covered by blocking features, i.e. mountains.
+         */
+        float MountainLevel = 0.68f;
+
+        /**
+         * @brief Value (0-1) of the second noise field above which land is covered by passable features, i.e. forests.
+         */
+        float ForestLevel = 0.55f;
+    };
+
+    /**
+     * @brief Seeded generator of Tile Maps of any size, for stress testing terrain, navigation and rendering.
+     *
+     * Elevation comes from fractal value noise: cells below water level get a swimmable cell type of Terrain layer,
+     * others a walkable one. Highest land gets blocking features (mountains), second noise field places passable
+     * features (forests). Cell types are picked from layer definitions by their navigation properties, so any
+     * tileset works as long as its definition has such types - when a layer has several matching types,
+     * they're mixed at random.
+     *
+     * Every cell depends only on its position and the seed, so rows are generated in parallel and the result
+     * doesn't depend on number of threads.
+     */
+    class MapGenerator {
+    public:
+        /**
+         * @brief Fill map's layers and navigation grid.
+         *
+         * Textures are not applied - to draw generated map, save it with SaveAsLDTk() and load it through Assets.
+         * @param settings Size and shape of the map.
+         * @param definitions Definitions of Terrain layer (required) and Features layer (optional).
+         * @param map Map to fill. Previous content is replaced.
+         * @param pool Threads to generate on. Nullptr creates temporary pool for the call. Must not be called from a job of this pool.
+         * @return False if settings are invalid or Terrain definition lacks walkable or swimmable cell type.
+         */
+        static bool Generate(const MapGeneratorSettings& settings, const std::vector<LayerDefinition>& definitions,
+                             TileMap& map, Threading::ThreadPool* pool = nullptr);
+
+        /**
+         * @brief Write map as LDTk level file (*.ldtkl), loadable by Assets::LoadTileMap() and LowMapCooker.
+         *
+         * Only values read by the engine are written - file is not meant to be edited in LDTk.
+         * @param map Map to save.
+         * @param path Path of the file.
+         * @param pool Threads to format rows on. Nullptr creates temporary pool for the call.
+         * @return False if the file could not be written.
+         */
+        static bool SaveAsLDTk(const TileMap& map, const std::string& path, Threading::ThreadPool* pool = nullptr);
+
+        /**
+         * @brief Elevation of a point, in range 0-1. Sum of value noise octaves.
+         * @param x Position in noise space - cell coordinates divided by the scale.
+         * @param y Position in noise space - cell coordinates divided by the scale.
+         * @param octaves Number of octaves.
+         * @param seed Seed of the noise.
+         */
+        [[nodiscard]] static float FractalNoise(float x, float y, unsigned octaves, uint32_t seed);
+
+    protected:
+        /**
+         * @brief Cell types of a layer grouped by their purpose.
+         */
+        struct CellTypes {
+            std::vector<size_t> Walkable;
+            std::vector<size_t> Blocking;
+            std::vector<size_t> Swimmable;
+        };
+
+        static CellTypes SelectCellTypes(const LayerDefinition& definition);
+
+        [[nodiscard]] static uint32_t Hash(int32_t x, int32_t y, uint32_t seed);
+
+        [[nodiscard]] static float ValueNoise(float x, float y, uint32_t seed);
+
+        /**
+         * @brief Split rows between threads and wait until all are done.
+         */
+        static void ForEachRowBand(size_t height, Threading::ThreadPool* pool, const std::function<void(size_t, size_t)>& band);
+    };
+}
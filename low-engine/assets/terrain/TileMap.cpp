@@ -2,6 +2,9 @@
 #include "TileMap.h"
 
 #include "Config.h"
+#include "LDTkSaxHandler.h"
+#include "Log.h"
+#include "serialization/MappedFile.h"
 
 void LowEngine::Terrain::TileMap::Update(float deltaTime) {
     for (auto& state: TerrainLayer.AnimatedTiles | std::views::values) {
@@ -35,9 +38,7 @@ void LowEngine::Terrain::TileMap::LoadFromLDTkJson(nlohmann::json::const_referen
     for (auto& layer : jsonData["layerInstances"]) {
         if (layer["__identifier"] == "Terrain") {
             TerrainLayer.SetSize({layer["__cWid"].get<size_t>(), layer["__cHei"].get<size_t>()}, layer["__gridSize"].get<size_t>());
-            NavGrid.Cells.resize(layer["__cWid"].get<size_t>() * layer["__cHei"].get<size_t>());
-            NavGrid.Width = layer["__cWid"].get<size_t>();
-            NavGrid.Height = layer["__cHei"].get<size_t>();
+            NavGrid.Resize(layer["__cWid"].get<size_t>(), layer["__cHei"].get<size_t>());
 
             TerrainLayer.Cells.assign(TerrainLayer.CellCount.x * TerrainLayer.CellCount.y, Config::MAX_SIZE);
             for (auto& gridCell : layer["gridTiles"]) {
@@ -59,3 +60,38 @@ void LowEngine::Terrain::TileMap::LoadFromLDTkJson(nlohmann::json::const_referen
         }
     }
 }
+
+bool LowEngine::Terrain::TileMap::LoadFromLDTkFile(const std::string& path) {
+    Serialization::MappedFile file;
+    if (!file.Open(path)) {
+        _log->error("Failed to open LDTk file: {}", path);
+        return false;
+    }
+
+    auto data = file.Data();
+    auto first = reinterpret_cast<const char*>(data.data());
+
+    LDTkSaxHandler handler(*this);
+    if (!nlohmann::json::sax_parse(first, first + data.size(), &handler)) {
+        _log->error("Failed to parse LDTk file: {}", path);
+        _log->error("Error: {}", handler.GetError());
+        return false;
+    }
+
+    return true;
+}
+
+void LowEngine::Terrain::TileMap::ReadNavData(const Layer& layer, const LayerDefinition& definition) {
+    if (layer.Cells.size() != NavGrid.GetCellCount()) {
+        _log->warn("Layer '{}' doesn't match navigation grid - skipping its navigation data", LayerTypeToString(layer.Type));
+        return;
+    }
+
+    for (size_t i = 0; i < NavGrid.GetCellCount(); i++) {
+        size_t cellType = layer.Cells[i];
+        if (cellType != Config::MAX_SIZE) {
+            auto& typeDefinition = definition.CellDefinitions.at(cellType);
+            NavGrid.SetCell(i, {typeDefinition.IsWalkable, typeDefinition.IsSwimmable, typeDefinition.IsFlyable, typeDefinition.MoveCost});
+        }
+    }
+}
@@ -2,6 +2,7 @@
 #include <nlohmann/json.hpp>
 
 #include "Layer.h"
+#include "LayerDefinition.h"
 #include "navigation/NavigationGrid.h"
 
 namespace LowEngine::Terrain {
@@ -62,5 +63,25 @@ namespace LowEngine::Terrain {
          * @param jsonData JSON content of LDTk file.
          */
         void LoadFromLDTkJson(nlohmann::json::const_reference jsonData);
+
+        /**
+         * @brief Load data from LDTk file (*.ldtkl), streaming it without building a JSON document.
+         *
+         * Result is the same as LoadFromLDTkJson(), but file is memory-mapped and tiles are written
+         * into layers while it's being tokenized - peak memory use doesn't depend on file size.
+         * @see LowEngine::Terrain::LDTkSaxHandler
+         * @param path Path to the LDTk file.
+         * @return True if successful. False if file could not be opened or is malformed.
+         */
+        bool LoadFromLDTkFile(const std::string& path);
+
+        /**
+         * @brief Fill navigation data of cells occupied on provided layer, using properties from layer's definition.
+         *
+         * Layers applied later overwrite navigation data of earlier layers.
+         * @param layer Layer of this map.
+         * @param definition Definition of the layer. Must define every cell type used on the layer.
+         */
+        void ReadNavData(const Layer& layer, const LayerDefinition& definition);
     };
 }
@@ -0,0 +1,78 @@
+#include "WorldIndex.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+#include "Log.h"
+
+namespace LowEngine::Terrain {
+    bool WorldIndex::LoadFromLDTkFile(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            _log->error("Failed to open LDTk world file: {}", path);
+            return false;
+        }
+
+        // definitions and layer data can be much bigger than the index itself - drop them while parsing
+        auto skipUnused = [](int, nlohmann::json::parse_event_t event, nlohmann::json& parsed) {
+            if (event != nlohmann::json::parse_event_t::key) return true;
+            return parsed != "defs" && parsed != "layerInstances" && parsed != "fieldInstances" && parsed != "toc";
+        };
+
+        auto directory = std::filesystem::path(path).parent_path();
+
+        try {
+            auto jsonData = nlohmann::json::parse(file, skipUnused);
+
+            Name = std::filesystem::path(path).stem().string();
+            GridSize = jsonData.value("defaultGridSize", 0);
+            Levels.clear();
+
+            // multi-world projects keep levels in "worlds" - only the first world is used
+            const nlohmann::json* levels = &jsonData.at("levels");
+            auto worlds = jsonData.find("worlds");
+            if (levels->empty() && worlds != jsonData.end() && !worlds->empty()) {
+                if (worlds->size() > 1) {
+                    _log->warn("LDTk file {} holds {} worlds, only the first one is used", path, worlds->size());
+                }
+                levels = &worlds->front().at("levels");
+            }
+
+            for (auto& level: *levels) {
+                WorldLevel& worldLevel = Levels.emplace_back();
+                worldLevel.Identifier = level.at("identifier").get<std::string>();
+                worldLevel.Iid = level.value("iid", "");
+                worldLevel.Position = {level.at("worldX").get<int>(), level.at("worldY").get<int>()};
+                worldLevel.Size = {level.at("pxWid").get<unsigned>(), level.at("pxHei").get<unsigned>()};
+
+                auto externalPath = level.find("externalRelPath");
+                if (externalPath == level.end() || !externalPath->is_string()) {
+                    _log->error("Level '{}' is not saved in a separate file. Enable 'Save levels to separate files' in LDTk project settings",
+                                worldLevel.Identifier);
+                    Levels.clear();
+                    return false;
+                }
+                worldLevel.Path = (directory / externalPath->get<std::string>()).string();
+            }
+        } catch (std::exception& ex) {
+            _log->error("Failed to parse LDTk world file: {}", path);
+            _log->error("Error: {}", ex.what());
+            Levels.clear();
+            return false;
+        }
+
+        LOW_LOG_DEBUG(Assets, "World '{}' indexed with {} levels", Name, Levels.size());
+        return true;
+    }
+
+    const WorldLevel* WorldIndex::FindLevel(const std::string& identifier) const {
+        for (auto& level: Levels) {
+            if (level.Identifier == identifier) {
+                return &level;
+            }
+        }
+        return nullptr;
+    }
+}
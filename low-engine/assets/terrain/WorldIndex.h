@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SFML/Graphics/Rect.hpp"
+#include "SFML/System/Vector2.hpp"
+
+namespace LowEngine::Terrain {
+    /**
+     * @brief Single level of LDTk world, as described by the world file.
+     */
+    struct WorldLevel {
+        /**
+         * @brief Name of the level, unique in the world.
+         */
+        std::string Identifier;
+
+        /**
+         * @brief Unique instance identifier of the level.
+         */
+        std::string Iid;
+
+        /**
+         * @brief Path to level file (*.ldtkl), resolved against directory of the world file.
+         */
+        std::string Path;
+
+        /**
+         * @brief Position of level's top-left corner in the world, in pixels.
+         */
+        sf::Vector2i Position;
+
+        /**
+         * @brief Size of the level, in pixels.
+         */
+        sf::Vector2u Size;
+
+        /**
+         * @brief Area covered by the level in the world, in pixels.
+         */
+        [[nodiscard]] sf::FloatRect GetBounds() const {
+            return {sf::Vector2f(Position), sf::Vector2f(Size)};
+        }
+    };
+
+    /**
+     * @brief Layout of LDTk world (*.ldtk) - where every level is and which file holds it.
+     *
+     * Only the index is read. Levels have to be saved in separate files ("Save levels to separate files" option in LDTk),
+     * so they can be loaded one by one with Assets::LoadTileMapAsync().
+     */
+    class WorldIndex {
+    public:
+        /**
+         * @brief Name of the world, taken from file name.
+         */
+        std::string Name;
+
+        /**
+         * @brief Default size of a grid cell in the world, in pixels.
+         */
+        size_t GridSize = 0;
+
+        /**
+         * @brief All levels of the world.
+         */
+        std::vector<WorldLevel> Levels;
+
+        /**
+         * @brief Read world index from LDTk project file (*.ldtk).
+         *
+         * Layer and entity definitions, and any embedded layer data, are skipped while parsing.
+         * @param path Path to the LDTk project file.
+         * @return True if successful. False if file is malformed or its levels are not saved in separate files.
+         */
+        bool LoadFromLDTkFile(const std::string& path);
+
+        /**
+         * @brief Find level by its identifier.
+         * @param identifier Identifier of the level.
+         * @return Pointer to the level. Nullptr if there's no such level.
+         */
+        [[nodiscard]] const WorldLevel* FindLevel(const std::string& identifier) const;
+    };
+}
@@ -1,108 +1,95 @@
 #include "AStar.h"
 
-#include <bits/stl_algo.h>
+#include <algorithm>
+#include <cstdlib>
 
-namespace LowEngine::Terrain::Navigation {
-    std::vector<NavigationCell> AStar::FindPath(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType) const {
-        std::vector<NavigationCell*> openList; // Cells to be evaluated
-        std::vector<NavigationCell*> closedList; // Cells already evaluated
-
-        NavigationCell* firstNode = &_navGrid->at(start.x + start.y * _width);
-        firstNode->Parent = nullptr;
-
-        openList.push_back(firstNode);
-
-        while (!openList.empty()) {
-            NavigationCell* currentNode = GetNodeWithLowestCost(openList);
-
-            if (currentNode->Position == end) {
-                return ReconstructPath(currentNode);
-            }
-
-            // remove current node from open list
-            auto it = std::find(openList.begin(), openList.end(), currentNode);
-            openList.erase(it);
-            closedList.push_back(currentNode);
-
-            std::vector<NavigationCell*> neighbors = GetNeighbors(currentNode, _navGrid, _width, _height, movementType);
-            for (auto neighbor: neighbors) {
-                if (std::find(closedList.begin(), closedList.end(), neighbor) != closedList.end()) {
-                    continue; // already evaluated
-                }
-
-                float tentativeDistance = currentNode->DistanceFromStartNode + neighbor->MoveCost;
-
-                // if not in open list, add
-                if (std::find(openList.begin(), openList.end(), neighbor) == openList.end()) {
-                    openList.push_back(neighbor);
-                } else if (tentativeDistance >= neighbor->DistanceFromStartNode) {
-                    continue; // not a better path
-                }
-
-                // best path so far
-                neighbor->Parent = currentNode;
-                neighbor->DistanceFromStartNode = tentativeDistance;
-                neighbor->HeuristicDistanceToEndNode = GetHeuristicCost(currentNode, neighbor);
-                neighbor->TotalEstimatedCost = neighbor->DistanceFromStartNode + neighbor->HeuristicDistanceToEndNode;
-            }
-        }
-
-        return {}; // No path found. Return an empty path.
-    }
+#include "NavigationGrid.h"
 
-    NavigationCell* AStar::GetNodeWithLowestCost(std::vector<NavigationCell*> list) {
-        NavigationCell* smallestCost = list.front();
-
-        for (auto node: list) {
-            if (smallestCost->MoveCost > node->MoveCost) {
-                smallestCost = node;
-            }
+namespace LowEngine::Terrain::Navigation {
+    bool AStar::FindPath(const NavigationGrid& grid, const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType, NavigationPath& path) {
+        path.Clear();
+        _expandedNodes = 0;
+
+        size_t width = grid.Width;
+        size_t height = grid.Height;
+        auto& movementMasks = grid.GetMovementMasks();
+        auto& moveCosts = grid.GetMoveCosts();
+        if (movementMasks.size() != width * height) return false;
+        if (start.x >= width || start.y >= height || end.x >= width || end.y >= height) return false;
+
+        auto startIndex = static_cast<uint32_t>(start.x + start.y * width);
+        auto endIndex = static_cast<uint32_t>(end.x + end.y * width);
+        uint8_t movementBit = GetMovementBit(movementType);
+        if (startIndex != endIndex && (movementMasks[endIndex] & movementBit) == 0) return false;
+
+        // search state is kept between calls - a new stamp invalidates it without clearing the whole grid
+        _nodes.resize(width * height);
+        if (++_stamp == 0) {
+            std::ranges::fill(_nodes, SearchNode());
+            _stamp = 1;
         }
-
-        return smallestCost;
-    }
-
-    std::vector<NavigationCell*> AStar::GetNeighbors(NavigationCell* node, std::vector<NavigationCell>* navGrid, size_t width,
-                                                     size_t height, MovementType movementType) {
-        std::vector<NavigationCell*> neighbors;
-        sf::Vector2u position = node->Position;
-        for (int y = -1; y <= 1; ++y) {
-            for (int x = -1; x <= 1; ++x) {
-                if (x == 0 && y == 0) continue; // Skip the current node
-
-                sf::Vector2i neighborPos(static_cast<int>(position.x) + x, static_cast<int>(position.y) + y);
-
-                if (neighborPos.x >= 0 && neighborPos.x < width && neighborPos.y >= 0 && neighborPos.y < height) {
-                    NavigationCell* neighbor = &navGrid->at(neighborPos.x + neighborPos.y * width);
-
-                    if (movementType == MovementType::Walk && neighbor->IsWalkable) {
-                        neighbors.push_back(neighbor);
-                    } else if (movementType == MovementType::Swim && neighbor->IsSwimmable) {
-                        neighbors.push_back(neighbor);
-                    } else if (movementType == MovementType::Fly && neighbor->IsFlyable) {
-                        neighbors.push_back(neighbor);
-                    }
+        _openList.clear();
+
+        // every step costs at least the cheapest cell times its length, so octile distance scaled by it never overestimates
+        float minMoveCost = grid.GetMinMoveCost();
+        auto getHeuristicCost = [&end, minMoveCost](long long x, long long y) {
+            return GetOctileDistance(x - static_cast<long long>(end.x), y - static_cast<long long>(end.y)) * minMoveCost;
+        };
+
+        _nodes[startIndex] = {_stamp, startIndex, 0.0f, false};
+        _openList.push_back({getHeuristicCost(start.x, start.y), 0.0f, startIndex});
+
+        auto signedWidth = static_cast<long long>(width);
+        auto signedHeight = static_cast<long long>(height);
+        while (!_openList.empty()) {
+            std::ranges::pop_heap(_openList, IsWorse);
+            uint32_t index = _openList.back().Index;
+            _openList.pop_back();
+
+            auto& node = _nodes[index];
+            if (node.Closed) continue; // outdated entry - cell was queued again with lower cost
+            node.Closed = true;
+
+            if (index == endIndex) break;
+            _expandedNodes++;
+
+            auto x = static_cast<long long>(index % width);
+            auto y = static_cast<long long>(index / width);
+            float cost = node.Cost;
+            for (long long neighborY = std::max(y - 1, 0LL); neighborY <= std::min(y + 1, signedHeight - 1); neighborY++) {
+                for (long long neighborX = std::max(x - 1, 0LL); neighborX <= std::min(x + 1, signedWidth - 1); neighborX++) {
+                    auto neighborIndex = static_cast<uint32_t>(neighborX + neighborY * signedWidth);
+                    if ((movementMasks[neighborIndex] & movementBit) == 0 || neighborIndex == index) continue;
+
+                    float stepCost = NavigationGrid::GetMoveCost(moveCosts[neighborIndex]);
+                    if (neighborX != x && neighborY != y) stepCost *= DIAGONAL_COST;
+
+                    float tentativeCost = cost + stepCost;
+                    auto& neighbor = _nodes[neighborIndex];
+                    if (neighbor.Stamp == _stamp && (neighbor.Closed || neighbor.Cost <= tentativeCost)) continue;
+
+                    // best path so far
+                    neighbor = {_stamp, index, tentativeCost, false};
+                    _openList.push_back({tentativeCost + getHeuristicCost(neighborX, neighborY), tentativeCost, neighborIndex});
+                    std::ranges::push_heap(_openList, IsWorse);
                 }
             }
         }
 
-        return neighbors;
-    }
+        if (_nodes[endIndex].Stamp != _stamp || !_nodes[endIndex].Closed) return false; // No path found. Path stays empty.
 
-    float AStar::GetHeuristicCost(NavigationCell* node, NavigationCell* neighbor) {
-        // Chebyshev Distance
-        return static_cast<float>(std::max(std::abs(static_cast<int>(node->Position.x) - static_cast<int>(neighbor->Position.x)),
-                                           std::abs(static_cast<int>(node->Position.y) - static_cast<int>(neighbor->Position.y))));
+        uint32_t current = endIndex;
+        while (current != startIndex) {
+            path.Append(sf::Vector2u(static_cast<unsigned>(current % width), static_cast<unsigned>(current / width)));
+            current = _nodes[current].Parent;
+        }
+        path.Append(start);
+        path.Reverse();
+        return true;
     }
 
-    std::vector<NavigationCell> AStar::ReconstructPath(NavigationCell* endNode) {
-        std::vector<NavigationCell> path;
-        NavigationCell* currentNode = endNode;
-        while (currentNode != nullptr) {
-            path.push_back(*currentNode);
-            currentNode = currentNode->Parent;
-        }
-        std::reverse(path.begin(), path.end());
-        return path;
+    bool AStar::IsWorse(const OpenEntry& a, const OpenEntry& b) {
+        if (a.TotalEstimatedCost != b.TotalEstimatedCost) return a.TotalEstimatedCost > b.TotalEstimatedCost;
+        return a.Cost < b.Cost;
     }
 }
@@ -1,88 +1,82 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include "NavigationCell.h"
+#include "NavigationPath.h"
 
 namespace LowEngine::Terrain::Navigation {
+    class NavigationGrid;
+
     /**
      * @brief A* Pathfinding algorithm implementation.
      *
      * This class provides methods for finding paths on a navigation grid using the A* algorithm.
+     * Search state is kept separately from the grid's cells and reused between searches, so searches don't allocate
+     * once they have run on a grid of the same size.
      */
     class AStar {
     public:
-        /**
-         * @brief Constructor for AStar pathfinding algorithm.
-         *
-         * @param navGrid Navigation grid containing cells for pathfinding.
-         */
-        AStar(std::vector<NavigationCell>* navGrid, size_t width, size_t height)
-                    : _navGrid(navGrid), _width(width), _height(height) {
-        }
-
         /**
          * @brief Find a path from start to end position on the navigation grid.
          *
-         * @param start Starting position (in NavGrid coords) in the navigation grid.
+         * Movement goes in 8 directions. A straight step costs the move cost of the entered cell, a diagonal step
+         * costs DIAGONAL_COST times more - the same metric JumpPointSearch uses on areas of uniform cost.
+         * @param grid Navigation grid to search.
+         * @param start Starting position (in NavGrid coords) in the navigation grid. Doesn't need to be passable.
          * @param end Ending position (in NavGrid coords) in the navigation grid.
          * @param movementType Type of movement (walk, swim, fly).
-         * @return A vector of NavigationCell representing the path from start to end. Returns empty vector if path is not found.
+         * @param path Receives cells of the path from start to end. Left empty if path is not found.
+         * @return True if path was found.
          */
-        [[nodiscard]] std::vector<NavigationCell> FindPath(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType) const;
+        bool FindPath(const NavigationGrid& grid, const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType, NavigationPath& path);
 
-    protected:
-        /**
-         * @brief Width of the navigation grid in cells.
-         */
-        size_t _width = 0;
-        /**
-         * @brief Height of the navigation grid in cells.
-         */
-        size_t _height = 0;
         /**
-         * @brief Collection of cells in this NavGrid.
+         * @brief Number of cells expanded by the last FindPath() call.
          */
-        std::vector<NavigationCell>* _navGrid;
+        [[nodiscard]] size_t GetExpandedNodeCount() const { return _expandedNodes; }
 
         /**
-         * @brief Get the node with the lowest cost from a list of nodes.
-         *
-         * @param list List of NavigationCell pointers to evaluate.
-         * @return Pointer to the NavigationCell with the lowest cost.
+         * @brief Number of bytes used by search state kept between searches.
          */
-        [[nodiscard]] static NavigationCell* GetNodeWithLowestCost(std::vector<NavigationCell*> list);
+        [[nodiscard]] size_t GetMemorySize() const {
+            return _nodes.size() * sizeof(SearchNode) + _openList.capacity() * sizeof(OpenEntry);
+        }
 
+    protected:
         /**
-         * @brief Get the neighbors of a given node in the navigation grid.
-         *
-         * @param node The NavigationCell for which to find neighbors.
-         * @param navGrid The navigation grid containing all cells.
-         * @param width Width of the navigation grid in cells.
-         * @param height Height of the navigation grid in cells.
-         * @param movementType Type of movement (walk, swim, fly).
-         * @return A vector of pointers to neighboring NavigationCell objects.
+         * @brief Search state of a cell. Valid only if Stamp matches the current search.
          */
-        [[nodiscard]] static std::vector<NavigationCell*> GetNeighbors(NavigationCell* node, std::vector<NavigationCell>* navGrid, size_t width, size_t height, MovementType movementType);
+        struct SearchNode {
+            uint32_t Stamp = 0;
+            uint32_t Parent = 0;
+            /**
+             * @brief Cost of the best known path from the start node. (G)
+             */
+            float Cost = 0.0f;
+            bool Closed = false;
+        };
 
         /**
-         * @brief Calculate the heuristic cost between two navigation cells.
-         *
-         * This function estimates the cost to move from one cell to another based on their positions.
-         *
-         * @param node The current NavigationCell.
-         * @param neighbor The neighboring NavigationCell.
-         * @return The heuristic cost as a float.
+         * @brief Entry of the open list. Entries of cells that were reached again with lower cost stay in the list and are skipped.
          */
-        [[nodiscard]] static float GetHeuristicCost(NavigationCell* node, NavigationCell* neighbor);
+        struct OpenEntry {
+            /**
+             * @brief Cost from the start plus heuristic distance to the end node. (F)
+             */
+            float TotalEstimatedCost = 0.0f;
+            float Cost = 0.0f;
+            uint32_t Index = 0;
+        };
+
+        std::vector<SearchNode> _nodes;
+        std::vector<OpenEntry> _openList;
+        uint32_t _stamp = 0;
+        size_t _expandedNodes = 0;
 
         /**
-         * @brief Reconstruct the path from the end node back to the start node.
-         *
-         * This function traces back the parent pointers from the end node to reconstruct the path.
-         *
-         * @param endNode The NavigationCell at the end of the path.
-         * @return A vector of NavigationCell representing the reconstructed path. Returns empty vector if no path was found.
+         * @brief Order of the open list's heap - lowest total estimated cost first, deeper nodes first on ties.
          */
-        [[nodiscard]] static std::vector<NavigationCell> ReconstructPath(NavigationCell* endNode);
+        static bool IsWorse(const OpenEntry& a, const OpenEntry& b);
     };
 }
@@ -0,0 +1,261 @@
+#include "JumpPointSearch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace LowEngine::Terrain::Navigation {
+    /**
+     * @brief Offsets of 8 directions, clockwise from the top. Even directions are straight, odd are diagonal.
+     */
+    static constexpr int DIRECTIONS[8][2] = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}};
+
+    static int GetDirection(int dx, int dy) {
+        for (int direction = 0; direction < 8; direction++) {
+            if (DIRECTIONS[direction][0] == dx && DIRECTIONS[direction][1] == dy) return direction;
+        }
+        return -1;
+    }
+
+    static int Sign(long long value) {
+        return (value > 0) - (value < 0);
+    }
+
+    void JumpPointSearch::Build(const std::vector<uint8_t>& movementMasks, size_t width, size_t height, MovementType movementType) {
+        SetGrid(movementMasks, width, height, movementType);
+        _distances.assign(width * height * 8, 0);
+
+        // diagonal distances depend on straight ones - straight directions go first
+        for (int direction: {0, 2, 4, 6, 1, 3, 5, 7}) {
+            ComputeDirection(direction);
+        }
+    }
+
+    bool JumpPointSearch::Build(const std::vector<uint8_t>& movementMasks, size_t width, size_t height, MovementType movementType,
+                                std::span<const int32_t> distances) {
+        if (distances.size() != width * height * 8) return false;
+
+        // distances become steps of the search - a jump must not leave the grid
+        for (size_t y = 0; y < height; y++) {
+            for (size_t x = 0; x < width; x++) {
+                const int32_t* cellDistances = distances.data() + (x + y * width) * 8;
+                for (int direction = 0; direction < 8; direction++) {
+                    int dx = DIRECTIONS[direction][0];
+                    int dy = DIRECTIONS[direction][1];
+                    long long left = std::numeric_limits<long long>::max();
+                    if (dx != 0) left = dx > 0 ? static_cast<long long>(width - 1 - x) : static_cast<long long>(x);
+                    if (dy != 0) left = std::min(left, dy > 0 ? static_cast<long long>(height - 1 - y) : static_cast<long long>(y));
+                    if (std::abs(static_cast<long long>(cellDistances[direction])) > left) return false;
+                }
+            }
+        }
+
+        SetGrid(movementMasks, width, height, movementType);
+        _distances.assign(distances.begin(), distances.end());
+        return true;
+    }
+
+    void JumpPointSearch::SetGrid(const std::vector<uint8_t>& movementMasks, size_t width, size_t height, MovementType movementType) {
+        _width = width;
+        _height = height;
+        _movementType = movementType;
+
+        // border of closed cells around the grid saves bounds checks
+        _open.assign((width + 2) * (height + 2), 0);
+        uint8_t movementBit = GetMovementBit(movementType);
+        for (size_t y = 0; y < height; y++) {
+            const uint8_t* masks = movementMasks.data() + y * width;
+            uint8_t* open = _open.data() + (y + 1) * (width + 2) + 1;
+            for (size_t x = 0; x < width; x++) {
+                open[x] = (masks[x] & movementBit) != 0;
+            }
+        }
+    }
+
+    bool JumpPointSearch::FindPath(const sf::Vector2u& start, const sf::Vector2u& end, NavigationPath& path) {
+        path.Clear();
+        _expandedNodes = 0;
+        if (start.x >= _width || start.y >= _height || end.x >= _width || end.y >= _height) return false;
+
+        auto startIndex = static_cast<uint32_t>(start.x + start.y * _width);
+        auto endIndex = static_cast<uint32_t>(end.x + end.y * _width);
+        if (startIndex == endIndex) {
+            path.Append(start);
+            return true;
+        }
+        if (!IsOpen(end.x, end.y)) return false;
+
+        // search state is kept between calls - a new stamp invalidates it without clearing the whole grid
+        _nodes.resize(_width * _height);
+        if (++_stamp == 0) {
+            std::ranges::fill(_nodes, SearchNode());
+            _stamp = 1;
+        }
+
+        using OpenEntry = std::pair<float, uint32_t>;
+        std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<>> openList;
+
+        _nodes[startIndex] = {_stamp, startIndex, 0.0f, -1, false};
+        openList.emplace(GetOctileDistance(static_cast<long long>(end.x) - start.x, static_cast<long long>(end.y) - start.y), startIndex);
+
+        while (!openList.empty()) {
+            uint32_t index = openList.top().second;
+            openList.pop();
+
+            auto& node = _nodes[index];
+            if (node.Closed) continue; // outdated entry - cell was queued again with lower cost
+            node.Closed = true;
+
+            if (index == endIndex) break;
+            _expandedNodes++;
+
+            auto x = static_cast<long long>(index % _width);
+            auto y = static_cast<long long>(index / _width);
+            long long goalX = static_cast<long long>(end.x) - x;
+            long long goalY = static_cast<long long>(end.y) - y;
+
+            uint8_t directions = GetSearchDirections(x, y, node.Direction);
+            for (int direction = 0; direction < 8; direction++) {
+                if ((directions & (1 << direction)) == 0) continue;
+
+                int dx = DIRECTIONS[direction][0];
+                int dy = DIRECTIONS[direction][1];
+                int32_t distance = _distances[index * 8 + direction];
+                long long reach = std::abs(distance);
+                bool diagonal = direction % 2 == 1;
+
+                // goal is found when the jump passes it, or - for diagonal jumps - crosses its row or column
+                long long steps = 0;
+                if (!diagonal) {
+                    bool onLine = dx == 0 ? goalX == 0 && Sign(goalY) == dy : goalY == 0 && Sign(goalX) == dx;
+                    if (onLine && std::abs(goalX + goalY) <= reach) steps = std::abs(goalX + goalY);
+                } else if (Sign(goalX) == dx && Sign(goalY) == dy) {
+                    long long aligned = std::min(std::abs(goalX), std::abs(goalY));
+                    if (aligned <= reach) steps = aligned;
+                }
+                if (steps == 0 && distance > 0) steps = distance;
+                if (steps == 0) continue;
+
+                auto successor = static_cast<uint32_t>((x + dx * steps) + (y + dy * steps) * static_cast<long long>(_width));
+                float cost = node.Cost + static_cast<float>(steps) * (diagonal ? DIAGONAL_COST : 1.0f);
+
+                auto& next = _nodes[successor];
+                if (next.Stamp == _stamp && (next.Closed || next.Cost <= cost)) continue;
+
+                next = {_stamp, index, cost, static_cast<int8_t>(direction), false};
+                openList.emplace(cost + GetOctileDistance(goalX - dx * steps, goalY - dy * steps), successor);
+            }
+        }
+
+        if (_nodes[endIndex].Stamp != _stamp || !_nodes[endIndex].Closed) return false;
+
+        // jump points are connected by straight or diagonal lines - fill in the cells between them
+        uint32_t current = endIndex;
+        while (current != startIndex) {
+            uint32_t parent = _nodes[current].Parent;
+            auto parentX = static_cast<long long>(parent % _width);
+            auto parentY = static_cast<long long>(parent / _width);
+            auto x = static_cast<long long>(current % _width);
+            auto y = static_cast<long long>(current / _width);
+            int stepX = Sign(x - parentX);
+            int stepY = Sign(y - parentY);
+
+            while (x != parentX || y != parentY) {
+                path.Append(sf::Vector2u(static_cast<unsigned>(x), static_cast<unsigned>(y)));
+                x -= stepX;
+                y -= stepY;
+            }
+            current = parent;
+        }
+        path.Append(start);
+
+        path.Reverse();
+        return true;
+    }
+
+    bool JumpPointSearch::IsOpen(long long x, long long y) const {
+        return _open[(x + 1) + (y + 1) * static_cast<long long>(_width + 2)] != 0;
+    }
+
+    bool JumpPointSearch::HasForcedNeighbor(long long x, long long y, int direction) const {
+        int dx = DIRECTIONS[direction][0];
+        int dy = DIRECTIONS[direction][1];
+
+        if (direction % 2 == 1) {
+            return (IsOpen(x - dx, y + dy) && !IsOpen(x - dx, y)) ||
+                   (IsOpen(x + dx, y - dy) && !IsOpen(x, y - dy));
+        }
+
+        // obstacle at the side, with a free cell diagonally ahead of it
+        for (int side: {-1, 1}) {
+            int sideX = -dy * side;
+            int sideY = dx * side;
+            if (IsOpen(x + dx + sideX, y + dy + sideY) && !IsOpen(x + sideX, y + sideY)) return true;
+        }
+        return false;
+    }
+
+    uint8_t JumpPointSearch::GetSearchDirections(long long x, long long y, int direction) const {
+        if (direction < 0) return 0xFF;
+
+        int dx = DIRECTIONS[direction][0];
+        int dy = DIRECTIONS[direction][1];
+        uint8_t directions = 1 << direction;
+
+        if (direction % 2 == 1) {
+            // both straight components of the diagonal, and turns around obstacles behind
+            directions |= 1 << ((direction + 7) % 8);
+            directions |= 1 << ((direction + 1) % 8);
+            if (!IsOpen(x - dx, y)) directions |= 1 << GetDirection(-dx, dy);
+            if (!IsOpen(x, y - dy)) directions |= 1 << GetDirection(dx, -dy);
+            return directions;
+        }
+
+        for (int side: {-1, 1}) {
+            int sideX = -dy * side;
+            int sideY = dx * side;
+            if (!IsOpen(x + sideX, y + sideY)) directions |= 1 << GetDirection(dx + sideX, dy + sideY);
+        }
+        return directions;
+    }
+
+    void JumpPointSearch::ComputeDirection(int direction) {
+        int dx = DIRECTIONS[direction][0];
+        int dy = DIRECTIONS[direction][1];
+        bool diagonal = direction % 2 == 1;
+        int horizontal = dx > 0 ? 2 : 6;
+        int vertical = dy > 0 ? 4 : 0;
+
+        // cells are visited so that the next cell in the direction is always computed first
+        auto width = static_cast<long long>(_width);
+        auto height = static_cast<long long>(_height);
+        for (long long row = 0; row < height; row++) {
+            long long y = dy > 0 ? height - 1 - row : row;
+            for (long long column = 0; column < width; column++) {
+                long long x = dx > 0 ? width - 1 - column : column;
+                long long nextX = x + dx;
+                long long nextY = y + dy;
+
+                int32_t distance = 0;
+                if (IsOpen(nextX, nextY)) {
+                    size_t next = (nextX + nextY * width) * 8;
+                    bool jumpPoint = HasForcedNeighbor(nextX, nextY, direction);
+                    if (diagonal && !jumpPoint) {
+                        // diagonal run stops where one of its straight components would find a jump point
+                        jumpPoint = _distances[next + horizontal] > 0 || _distances[next + vertical] > 0;
+                    }
+
+                    if (jumpPoint) {
+                        distance = 1;
+                    } else {
+                        int32_t nextDistance = _distances[next + direction];
+                        distance = nextDistance > 0 ? nextDistance + 1 : nextDistance - 1;
+                    }
+                }
+                _distances[(x + y * width) * 8 + direction] = distance;
+            }
+        }
+    }
+}
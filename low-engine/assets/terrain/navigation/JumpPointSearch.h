@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "SFML/System/Vector2.hpp"
+#include "NavigationCell.h"
+#include "NavigationPath.h"
+
+namespace LowEngine::Terrain::Navigation {
+    /**
+     * @brief Jump Point Search (JPS+) pathfinding for areas where every cell has the same move cost.
+     *
+     * On open ground many paths of the same length lead to the goal, and A* expands cells of all of them. JPS skips
+     * straight and diagonal runs of cells, stopping only at jump points - cells where an obstacle forces a turn.
+     * Distances to the next jump point or wall are precomputed for every cell and direction, so a search only
+     * visits jump points. Movement follows the same rules as AStar: 8 directions, diagonal moves are allowed next
+     * to obstacles, diagonal steps cost DIAGONAL_COST. Paths found by both have the same cost on such areas.
+     *
+     * Costs of cells are ignored - use only on areas where all passable cells cost the same.
+     */
+    class JumpPointSearch {
+    public:
+        /**
+         * @brief Precompute jump distances for all cells, for single type of movement.
+         *
+         * Must be called again after passability of any cell changes.
+         * @param movementMasks Movement masks of cells of the navigation grid, see NavigationGrid::GetMovementMasks().
+         * @param width Width of the navigation grid in cells.
+         * @param height Height of the navigation grid in cells.
+         * @param movementType Type of movement the distances are computed for.
+         */
+        void Build(const std::vector<uint8_t>& movementMasks, size_t width, size_t height, MovementType movementType);
+
+        /**
+         * @brief Use jump distances computed earlier by Build() for the same cells, i.e. stored in a cooked map.
+         * @see Build()
+         * @param distances Jump distances, see GetDistances().
+         * @return False if number of distances doesn't match the grid or any jump leaves the grid.
+         */
+        bool Build(const std::vector<uint8_t>& movementMasks, size_t width, size_t height, MovementType movementType,
+                   std::span<const int32_t> distances);
+
+        /**
+         * @brief Jump distance for every cell and direction (cell * 8 + direction), computed by Build().
+         */
+        [[nodiscard]] const std::vector<int32_t>& GetDistances() const { return _distances; }
+
+        /**
+         * @brief Find a path from start to end position, on the grid passed to Build().
+         *
+         * @param start Starting position (in NavGrid coords). Doesn't need to be passable.
+         * @param end Ending position (in NavGrid coords).
+         * @param path Receives every cell of the path from start to end, as AStar gives it. Left empty if path is not found.
+         * @return True if path was found.
+         */
+        bool FindPath(const sf::Vector2u& start, const sf::Vector2u& end, NavigationPath& path);
+
+        /**
+         * @brief Number of jump points expanded by the last FindPath() call.
+         */
+        [[nodiscard]] size_t GetExpandedNodeCount() const { return _expandedNodes; }
+
+        /**
+         * @brief Number of bytes used by jump distances and search state.
+         */
+        [[nodiscard]] size_t GetMemorySize() const {
+            return _distances.size() * sizeof(int32_t) + _open.size() + _nodes.size() * sizeof(SearchNode);
+        }
+
+    protected:
+        /**
+         * @brief Search state of a cell. Valid only if Stamp matches the current search.
+         */
+        struct SearchNode {
+            uint32_t Stamp = 0;
+            uint32_t Parent = 0;
+            float Cost = 0.0f;
+            int8_t Direction = -1;
+            bool Closed = false;
+        };
+
+        size_t _width = 0;
+        size_t _height = 0;
+        MovementType _movementType = MovementType::Walk;
+
+        /**
+         * @brief Jump distance for every cell and direction (cell * 8 + direction).
+         *
+         * Positive - number of steps to the next jump point. Zero or negative - number of steps that can be made before a wall.
+         */
+        std::vector<int32_t> _distances;
+
+        /**
+         * @brief Passability of cells, with a border of closed cells around the grid.
+         */
+        std::vector<uint8_t> _open;
+
+        std::vector<SearchNode> _nodes;
+        uint32_t _stamp = 0;
+        size_t _expandedNodes = 0;
+
+        /**
+         * @brief Check passability of a cell. Position may be at most one cell outside of the grid.
+         */
+        [[nodiscard]] bool IsOpen(long long x, long long y) const;
+
+        /**
+         * @brief Check if a cell entered in provided direction has a forced neighbour - a cell that can be reached optimally only through it.
+         */
+        [[nodiscard]] bool HasForcedNeighbor(long long x, long long y, int direction) const;
+
+        /**
+         * @brief Directions worth following from a cell entered in provided direction. Direction -1 gives all 8.
+         * @return Bit mask of directions.
+         */
+        [[nodiscard]] uint8_t GetSearchDirections(long long x, long long y, int direction) const;
+
+        /**
+         * @brief Take over size of the grid and passability of its cells.
+         */
+        void SetGrid(const std::vector<uint8_t>& movementMasks, size_t width, size_t height, MovementType movementType);
+
+        void ComputeDirection(int direction);
+    };
+}
@@ -1,4 +1,7 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <utility>
 
 #include "SFML/System/Vector2.hpp"
@@ -14,15 +17,33 @@ namespace LowEngine::Terrain::Navigation {
     };
 
     /**
-     * @brief Single cell of NavGrid.
+     * @brief Bit of a cell's movement mask that allows provided type of movement.
+     */
+    constexpr uint8_t GetMovementBit(MovementType movementType) {
+        return static_cast<uint8_t>(1u << movementType);
+    }
+
+    /**
+     * @brief Length of a diagonal step relative to a straight one. Diagonal steps cost the entered cell's move cost times this.
+     */
+    constexpr float DIAGONAL_COST = 1.41421356f;
+
+    /**
+     * @brief Length of the shortest 8-directional path between two cells on open ground, with straight steps of 1.
+     */
+    inline float GetOctileDistance(long long dx, long long dy) {
+        auto straight = static_cast<float>(std::abs(std::abs(dx) - std::abs(dy)));
+        auto diagonal = static_cast<float>(std::min(std::abs(dx), std::abs(dy)));
+        return straight + diagonal * DIAGONAL_COST;
+    }
+
+    /**
+     * @brief Navigation properties of a single cell of NavGrid.
+     *
+     * NavigationGrid doesn't keep cells in this form - it packs them, see NavigationGrid::SetCell().
      */
     class NavigationCell {
     public:
-        /**
-         * @brief Position of this cell in the NavGrid.
-         */
-        sf::Vector2u Position;
-
         /**
          * @brief Can entity move to this cell if they are walking?
          */
@@ -41,34 +62,26 @@ namespace LowEngine::Terrain::Navigation {
          */
         float MoveCost = 1.0f;
 
-        /**
-         * @brief Pointer to the parent cell in the pathfinding tree.
-         *
-         * This is used to reconstruct the path after pathfinding is complete through A* algorithm.
-         */
-        NavigationCell* Parent = nullptr;
+        NavigationCell() = default;
 
-        /**
-         * @brief Cost of moving to this cell from the start position. (F)
-         *
-         * This is used in A* algorithm to determine the best path.
-         */
-        float TotalEstimatedCost = 0.0f;
+        NavigationCell(bool isWalkable, bool isSwimmable, bool isFlyable, float moveCost)
+            : IsWalkable(isWalkable), IsSwimmable(isSwimmable), IsFlyable(isFlyable), MoveCost(moveCost) {
+        }
 
         /**
-         * @brief Distance from the start node to this cell. (G)
-         *
-         * This is used in A* algorithm to determine the best path.
+         * @brief Can entity move to this cell with provided type of movement?
          */
-        float DistanceFromStartNode = 0.0f;
+        [[nodiscard]] bool AllowsMovement(MovementType movementType) const {
+            return (GetMovementMask() & GetMovementBit(movementType)) != 0;
+        }
 
         /**
-         * @brief Heuristic distance to the end node. (H)
-         *
-         * This is used in A* algorithm to determine the best path.
+         * @brief Types of movement allowed on this cell, as bits from GetMovementBit().
          */
-        float HeuristicDistanceToEndNode = 0.0f;
-
-        NavigationCell() = default;
+        [[nodiscard]] uint8_t GetMovementMask() const {
+            return static_cast<uint8_t>((IsWalkable ? GetMovementBit(Walk) : 0) |
+                                        (IsSwimmable ? GetMovementBit(Swim) : 0) |
+                                        (IsFlyable ? GetMovementBit(Fly) : 0));
+        }
     };
 }
@@ -1,7 +1,484 @@
 #include "NavigationGrid.h"
 
-std::vector<LowEngine::Terrain::Navigation::NavigationCell> LowEngine::Terrain::Navigation::NavigationGrid::FindPath(const sf::Vector2u& start,
-    const sf::Vector2u& end, MovementType movementType) {
-    AStar aStar(&Cells, Width, Height);
-    return aStar.FindPath(start, end, movementType);
+#include <algorithm>
+#include <cmath>
+
+#include "Log.h"
+
+namespace LowEngine::Terrain::Navigation {
+    bool NavigationGrid::FindPath(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType, NavigationPath& path) {
+        path.Clear();
+        _expandedNodes = 0;
+        if (Width > NavigationPath::MAX_GRID_SIZE || Height > NavigationPath::MAX_GRID_SIZE) {
+            _log->error("Navigation grid of {}x{} cells is too large for pathfinding, limit is {}", Width, Height, NavigationPath::MAX_GRID_SIZE);
+            return false;
+        }
+
+        if (start.x >= Width || start.y >= Height || end.x >= Width || end.y >= Height) return false;
+
+        // without regions, a search for unreachable cell would go through the whole area around start before giving up
+        if (!IsReachable(start, end, movementType)) return false;
+
+        if (_pathCache.Find(start, end, movementType, _version, path)) return true;
+
+        if (UsesJumpPointSearch(end, movementType)) {
+            auto& jumpPointSearch = GetJumpPointSearch(movementType);
+            bool found = jumpPointSearch.FindPath(start, end, path);
+            _expandedNodes = jumpPointSearch.GetExpandedNodeCount();
+            if (found) _pathCache.Add(start, end, movementType, _version, path);
+            return found;
+        }
+
+        bool found = _aStar.FindPath(*this, start, end, movementType, path);
+        _expandedNodes = _aStar.GetExpandedNodeCount();
+        if (found) _pathCache.Add(start, end, movementType, _version, path);
+        return found;
+    }
+
+    void NavigationGrid::SetPathfindingMethod(PathfindingMethod method) {
+        if (method == _pathfindingMethod) return;
+
+        // methods measure diagonal steps differently - paths of the other one are not optimal for this one
+        _pathfindingMethod = method;
+        _pathCache.Clear();
+    }
+
+    void NavigationGrid::Resize(size_t width, size_t height) {
+        _version++;
+        Width = width;
+        Height = height;
+        _movementMasks.assign(width * height, 0);
+        _moveCosts.assign(width * height, UNIT_MOVE_COST);
+        _minMoveCost = 0;
+    }
+
+    void NavigationGrid::SetCell(size_t index, const NavigationCell& cell) {
+        _movementMasks[index] = cell.GetMovementMask();
+        _moveCosts[index] = QuantizeMoveCost(cell.MoveCost);
+    }
+
+    NavigationCell NavigationGrid::GetCell(size_t index) const {
+        uint8_t mask = _movementMasks[index];
+        return {(mask & GetMovementBit(Walk)) != 0, (mask & GetMovementBit(Swim)) != 0, (mask & GetMovementBit(Fly)) != 0,
+                GetMoveCost(_moveCosts[index])};
+    }
+
+    uint8_t NavigationGrid::QuantizeMoveCost(float moveCost) {
+        return static_cast<uint8_t>(std::lround(std::clamp(moveCost, 0.0f, MAX_MOVE_COST) * COST_SCALE));
+    }
+
+    size_t NavigationGrid::GetMemorySize() const {
+        size_t size = _movementMasks.size() + _moveCosts.size() + _searchStamps.size() * sizeof(uint32_t);
+        for (auto& labels: _regions) {
+            size += labels.CellRegions.size() * sizeof(uint32_t) + labels.RegionSizes.size() * sizeof(size_t) +
+                    labels.FreeIds.size() * sizeof(uint32_t) + labels.HasVaryingCost.size();
+        }
+        for (auto& jumpPointSearch: _jumpPointSearch) {
+            size += jumpPointSearch.GetMemorySize();
+        }
+        return size + _aStar.GetMemorySize() + _pathCache.GetMemorySize();
+    }
+
+    bool NavigationGrid::UsesJumpPointSearch(const sf::Vector2u& end, MovementType movementType) const {
+        if (_pathfindingMethod != PathfindingMethod::JumpPointSearch) return false;
+
+        // path stays in the end's region - costs of cells elsewhere don't matter
+        uint32_t regionId = GetRegionId(end, movementType);
+        return regionId != NO_REGION && !_regions[movementType].HasVaryingCost[regionId];
+    }
+
+    void NavigationGrid::BuildRegions() {
+        _version++;
+        _passabilityVersion++;
+
+        for (auto movementType: {MovementType::Walk, MovementType::Swim, MovementType::Fly}) {
+            auto& labels = _regions[movementType];
+            labels.CellRegions.assign(_movementMasks.size(), NO_REGION);
+            labels.RegionSizes.clear();
+            labels.FreeIds.clear();
+            labels.HasVaryingCost.clear();
+
+            uint8_t movementBit = GetMovementBit(movementType);
+            for (size_t i = 0; i < _movementMasks.size(); i++) {
+                if (labels.CellRegions[i] != NO_REGION || (_movementMasks[i] & movementBit) == 0) continue;
+
+                uint32_t regionId = AcquireRegionId(labels);
+                labels.RegionSizes[regionId] = FloodFill(labels, movementType, i, NO_REGION, regionId);
+            }
+
+            for (size_t i = 0; i < _moveCosts.size(); i++) {
+                if (labels.CellRegions[i] != NO_REGION && _moveCosts[i] != UNIT_MOVE_COST) labels.HasVaryingCost[labels.CellRegions[i]] = 1;
+            }
+        }
+
+        UpdateMinMoveCost();
+    }
+
+    std::vector<uint64_t> NavigationGrid::GetRegionSizes(MovementType movementType) const {
+        auto& regionSizes = _regions[movementType].RegionSizes;
+        return {regionSizes.begin(), regionSizes.end()};
+    }
+
+    bool NavigationGrid::SetRegions(const std::array<RegionLabelsView, 3>& regions) {
+        for (auto& labels: _regions) {
+            labels = RegionLabels();
+        }
+        _version++;
+        _passabilityVersion++;
+
+        for (auto movementType: {MovementType::Walk, MovementType::Swim, MovementType::Fly}) {
+            auto& view = regions[movementType];
+            if (view.CellRegions.size() != _movementMasks.size() || view.HasVaryingCost.size() != view.RegionSizes.size()) return false;
+
+            // a linear pass instead of flood fills - IDs index region arrays, so they can't be trusted blindly
+            for (uint32_t regionId: view.CellRegions) {
+                if (regionId != NO_REGION && regionId >= view.RegionSizes.size()) return false;
+            }
+        }
+
+        for (auto movementType: {MovementType::Walk, MovementType::Swim, MovementType::Fly}) {
+            auto& view = regions[movementType];
+            auto& labels = _regions[movementType];
+            labels.CellRegions.assign(view.CellRegions.begin(), view.CellRegions.end());
+            labels.RegionSizes.assign(view.RegionSizes.begin(), view.RegionSizes.end());
+            labels.HasVaryingCost.assign(view.HasVaryingCost.begin(), view.HasVaryingCost.end());
+            for (uint32_t regionId = 0; regionId < labels.RegionSizes.size(); regionId++) {
+                if (labels.RegionSizes[regionId] == 0) labels.FreeIds.push_back(regionId);
+            }
+        }
+
+        UpdateMinMoveCost();
+        return true;
+    }
+
+    const std::vector<int32_t>& NavigationGrid::GetJumpDistances(MovementType movementType) {
+        return GetJumpPointSearch(movementType).GetDistances();
+    }
+
+    bool NavigationGrid::SetJumpDistances(MovementType movementType, std::span<const int32_t> distances) {
+        if (!_jumpPointSearch[movementType].Build(_movementMasks, Width, Height, movementType, distances)) return false;
+
+        _jumpPointVersions[movementType] = _passabilityVersion;
+        return true;
+    }
+
+    void NavigationGrid::SetCellNavigation(const sf::Vector2u& position, bool isWalkable, bool isSwimmable, bool isFlyable, float moveCost) {
+        if (position.x >= Width || position.y >= Height) return;
+
+        size_t index = position.x + position.y * Width;
+        SetCell(index, {isWalkable, isSwimmable, isFlyable, moveCost});
+        if (_movementMasks[index] != 0) _minMoveCost = std::min(_minMoveCost, _moveCosts[index]);
+        _version++;
+
+        for (auto movementType: {MovementType::Walk, MovementType::Swim, MovementType::Fly}) {
+            if (!HasRegions(movementType)) continue;
+
+            auto& labels = _regions[movementType];
+            bool wasPassable = labels.CellRegions[index] != NO_REGION;
+            bool isPassable = (_movementMasks[index] & GetMovementBit(movementType)) != 0;
+            if (wasPassable != isPassable) {
+                _passabilityVersion++;
+                if (isPassable) {
+                    AddCellToRegions(labels, movementType, index);
+                } else {
+                    RemoveCellFromRegions(labels, movementType, index);
+                }
+            }
+
+            if (isPassable && _moveCosts[index] != UNIT_MOVE_COST) labels.HasVaryingCost[labels.CellRegions[index]] = 1;
+        }
+    }
+
+    uint32_t NavigationGrid::GetRegionId(const sf::Vector2u& position, MovementType movementType) const {
+        if (!HasRegions(movementType) || position.x >= Width || position.y >= Height) return NO_REGION;
+        return _regions[movementType].CellRegions[position.x + position.y * Width];
+    }
+
+    bool NavigationGrid::IsReachable(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType) const {
+        if (start == end) return true;
+        if (!HasRegions(movementType)) return true;
+        if (start.x >= Width || start.y >= Height || end.x >= Width || end.y >= Height) return false;
+
+        auto& cellRegions = _regions[movementType].CellRegions;
+        uint32_t endRegion = cellRegions[end.x + end.y * Width];
+        if (endRegion == NO_REGION) return false;
+
+        size_t startIndex = start.x + start.y * Width;
+        if (cellRegions[startIndex] != NO_REGION) return cellRegions[startIndex] == endRegion;
+
+        // entity standing on a cell it can't enter can still step off it - any neighbour in end's region will do
+        for (auto neighbor: GetRing(startIndex)) {
+            if (neighbor != OUTSIDE && cellRegions[neighbor] == endRegion) return true;
+        }
+        return false;
+    }
+
+    std::vector<NavigationRegion> NavigationGrid::GetRegions(MovementType movementType) const {
+        if (!HasRegions(movementType)) return {};
+
+        auto& labels = _regions[movementType];
+        std::vector<NavigationRegion> regions;
+        std::vector<size_t> regionIndices(labels.RegionSizes.size(), OUTSIDE);
+        for (uint32_t regionId = 0; regionId < labels.RegionSizes.size(); regionId++) {
+            if (labels.RegionSizes[regionId] == 0) continue;
+
+            regionIndices[regionId] = regions.size();
+            auto& region = regions.emplace_back();
+            region.Id = regionId;
+            region.CellCount = labels.RegionSizes[regionId];
+            region.Min = {std::numeric_limits<unsigned>::max(), std::numeric_limits<unsigned>::max()};
+        }
+
+        for (size_t i = 0; i < labels.CellRegions.size(); i++) {
+            if (labels.CellRegions[i] == NO_REGION) continue;
+
+            auto& region = regions[regionIndices[labels.CellRegions[i]]];
+            auto x = static_cast<unsigned>(i % Width);
+            auto y = static_cast<unsigned>(i / Width);
+            region.Min = {std::min(region.Min.x, x), std::min(region.Min.y, y)};
+            region.Max = {std::max(region.Max.x, x), std::max(region.Max.y, y)};
+        }
+
+        return regions;
+    }
+
+    bool NavigationGrid::HasRegions(MovementType movementType) const {
+        return _movementMasks.size() == Width * Height && _regions[movementType].CellRegions.size() == _movementMasks.size();
+    }
+
+    void NavigationGrid::UpdateMinMoveCost() {
+        _minMoveCost = UNIT_MOVE_COST;
+        for (size_t i = 0; i < _moveCosts.size(); i++) {
+            if (_movementMasks[i] != 0) _minMoveCost = std::min(_minMoveCost, _moveCosts[i]);
+        }
+    }
+
+    JumpPointSearch& NavigationGrid::GetJumpPointSearch(MovementType movementType) {
+        auto& jumpPointSearch = _jumpPointSearch[movementType];
+        if (_jumpPointVersions[movementType] != _passabilityVersion) {
+            jumpPointSearch.Build(_movementMasks, Width, Height, movementType);
+            _jumpPointVersions[movementType] = _passabilityVersion;
+        }
+        return jumpPointSearch;
+    }
+
+    uint32_t NavigationGrid::AcquireRegionId(RegionLabels& labels) {
+        if (!labels.FreeIds.empty()) {
+            uint32_t regionId = labels.FreeIds.back();
+            labels.FreeIds.pop_back();
+            labels.HasVaryingCost[regionId] = 0;
+            return regionId;
+        }
+
+        labels.RegionSizes.push_back(0);
+        labels.HasVaryingCost.push_back(0);
+        return static_cast<uint32_t>(labels.RegionSizes.size() - 1);
+    }
+
+    void NavigationGrid::ReleaseRegionId(RegionLabels& labels, uint32_t regionId) {
+        labels.RegionSizes[regionId] = 0;
+        labels.FreeIds.push_back(regionId);
+    }
+
+    size_t NavigationGrid::FloodFill(RegionLabels& labels, MovementType movementType, size_t startIndex, uint32_t fromRegion, uint32_t toRegion) {
+        uint8_t movementBit = GetMovementBit(movementType);
+        std::vector<size_t> stack{startIndex};
+        labels.CellRegions[startIndex] = toRegion;
+        size_t count = 1;
+
+        while (!stack.empty()) {
+            size_t index = stack.back();
+            stack.pop_back();
+
+            // same neighbourhood as AStar - diagonal moves are allowed
+            for (auto neighbor: GetRing(index)) {
+                if (neighbor == OUTSIDE || labels.CellRegions[neighbor] != fromRegion) continue;
+                if ((_movementMasks[neighbor] & movementBit) == 0) continue;
+
+                labels.CellRegions[neighbor] = toRegion;
+                stack.push_back(neighbor);
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    void NavigationGrid::AddCellToRegions(RegionLabels& labels, MovementType movementType, size_t index) {
+        std::vector<uint32_t> touchingRegions;
+        for (auto neighbor: GetRing(index)) {
+            if (neighbor == OUTSIDE) continue;
+
+            uint32_t regionId = labels.CellRegions[neighbor];
+            if (regionId != NO_REGION && std::ranges::find(touchingRegions, regionId) == touchingRegions.end()) {
+                touchingRegions.push_back(regionId);
+            }
+        }
+
+        if (touchingRegions.empty()) {
+            uint32_t regionId = AcquireRegionId(labels);
+            labels.CellRegions[index] = regionId;
+            labels.RegionSizes[regionId] = 1;
+            return;
+        }
+
+        // the largest region keeps its ID - only cells of smaller ones are relabelled
+        uint32_t target = *std::ranges::max_element(touchingRegions, [&labels](uint32_t a, uint32_t b) {
+            return labels.RegionSizes[a] < labels.RegionSizes[b];
+        });
+        labels.CellRegions[index] = target;
+        labels.RegionSizes[target]++;
+
+        for (auto neighbor: GetRing(index)) {
+            if (neighbor == OUTSIDE) continue;
+
+            uint32_t regionId = labels.CellRegions[neighbor];
+            if (regionId == NO_REGION || regionId == target) continue;
+
+            labels.RegionSizes[target] += FloodFill(labels, movementType, neighbor, regionId, target);
+            labels.HasVaryingCost[target] |= labels.HasVaryingCost[regionId];
+            ReleaseRegionId(labels, regionId);
+        }
+    }
+
+    void NavigationGrid::RemoveCellFromRegions(RegionLabels& labels, MovementType movementType, size_t index) {
+        uint32_t regionId = labels.CellRegions[index];
+        labels.CellRegions[index] = NO_REGION;
+        labels.RegionSizes[regionId]--;
+
+        // passable cells around the removed one all belong to its region - count how many groups they form
+        // when connected only through the ring. A single group means every path through the cell has a detour.
+        auto ring = GetRing(index);
+        std::array<int, 8> groups{};
+        groups.fill(-1);
+        int groupCount = 0;
+        for (int i = 0; i < 8; i++) {
+            if (ring[i] == OUTSIDE || labels.CellRegions[ring[i]] == NO_REGION || groups[i] != -1) continue;
+
+            // walk the ring from this cell - neighbours on the ring, and side cells two steps apart, touch each other
+            std::array<int, 8> stack{};
+            int stackSize = 0;
+            stack[stackSize++] = i;
+            groups[i] = groupCount;
+            while (stackSize > 0) {
+                int current = stack[--stackSize];
+                int candidates[4] = {(current + 1) % 8, (current + 7) % 8, -1, -1};
+                if (current % 2 == 0) {
+                    candidates[2] = (current + 2) % 8;
+                    candidates[3] = (current + 6) % 8;
+                }
+                for (int candidate: candidates) {
+                    if (candidate < 0 || groups[candidate] != -1) continue;
+                    if (ring[candidate] == OUTSIDE || labels.CellRegions[ring[candidate]] == NO_REGION) continue;
+
+                    groups[candidate] = groupCount;
+                    stack[stackSize++] = candidate;
+                }
+            }
+            groupCount++;
+        }
+
+        if (groupCount == 0 && labels.RegionSizes[regionId] == 0) {
+            ReleaseRegionId(labels, regionId);
+            return;
+        }
+        if (groupCount <= 1) return;
+
+        // region may have been cut in parts. A search starts from every group and all of them advance in turns:
+        // searches that meet are connected, and a search that runs out of cells has found a part cut off from the rest.
+        // Cost depends on the size of smaller parts, or the length of the detour - not on the size of the region.
+        if (_searchStamps.size() != _movementMasks.size() || _searchStamp > std::numeric_limits<uint32_t>::max() - 8) {
+            _searchStamps.assign(_movementMasks.size(), 0);
+            _searchStamp = 0;
+        }
+        uint32_t firstStamp = _searchStamp + 1;
+        _searchStamp += groupCount;
+
+        struct Search {
+            std::vector<size_t> Queue;
+            size_t Next = 0;
+            int Parent = 0;
+            bool Removed = false;
+        };
+        std::vector<Search> searches(groupCount);
+        for (int i = 0; i < 8; i++) {
+            int group = groups[i];
+            if (group == -1 || !searches[group].Queue.empty()) continue;
+
+            searches[group].Queue.push_back(ring[i]);
+            searches[group].Parent = group;
+            _searchStamps[ring[i]] = firstStamp + group;
+        }
+
+        auto findSet = [&searches](int group) {
+            while (searches[group].Parent != group) group = searches[group].Parent;
+            return group;
+        };
+
+        int setCount = groupCount;
+        while (setCount > 1) {
+            for (int group = 0; group < groupCount; group++) {
+                auto& search = searches[group];
+                if (search.Removed || search.Next == search.Queue.size()) continue;
+
+                size_t current = search.Queue[search.Next++];
+                for (auto neighbor: GetRing(current)) {
+                    if (neighbor == OUTSIDE || labels.CellRegions[neighbor] != regionId) continue;
+
+                    uint32_t stamp = _searchStamps[neighbor];
+                    if (stamp >= firstStamp && stamp < firstStamp + groupCount) {
+                        int own = findSet(group);
+                        int other = findSet(static_cast<int>(stamp - firstStamp));
+                        if (own != other) {
+                            searches[other].Parent = own;
+                            setCount--;
+                        }
+                        continue;
+                    }
+
+                    _searchStamps[neighbor] = firstStamp + group;
+                    search.Queue.push_back(neighbor);
+                }
+            }
+
+            // a set whose searches all ran out of cells is a separate part - it gets a new ID, the last set keeps the old one
+            for (int root = 0; root < groupCount && setCount > 1; root++) {
+                if (searches[root].Removed || findSet(root) != root) continue;
+
+                bool finished = true;
+                for (int group = 0; group < groupCount; group++) {
+                    if (findSet(group) == root && searches[group].Next != searches[group].Queue.size()) finished = false;
+                }
+                if (!finished) continue;
+
+                uint32_t newRegion = AcquireRegionId(labels);
+                labels.RegionSizes[newRegion] = FloodFill(labels, movementType, searches[root].Queue.front(), regionId, newRegion);
+                labels.HasVaryingCost[newRegion] = labels.HasVaryingCost[regionId];
+                labels.RegionSizes[regionId] -= labels.RegionSizes[newRegion];
+                for (int group = 0; group < groupCount; group++) {
+                    if (findSet(group) == root) searches[group].Removed = true;
+                }
+                setCount--;
+            }
+        }
+    }
+
+    std::array<size_t, 8> NavigationGrid::GetRing(size_t index) const {
+        static constexpr int offsets[8][2] = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}};
+
+        auto x = static_cast<long long>(index % Width);
+        auto y = static_cast<long long>(index / Width);
+
+        std::array<size_t, 8> ring{};
+        for (size_t i = 0; i < 8; i++) {
+            long long neighborX = x + offsets[i][0];
+            long long neighborY = y + offsets[i][1];
+            if (neighborX < 0 || neighborY < 0 || neighborX >= static_cast<long long>(Width) || neighborY >= static_cast<long long>(Height)) {
+                ring[i] = OUTSIDE;
+            } else {
+                ring[i] = static_cast<size_t>(neighborX + neighborY * static_cast<long long>(Width));
+            }
+        }
+        return ring;
+    }
 }
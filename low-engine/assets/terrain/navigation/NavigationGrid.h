@@ -1,41 +1,396 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
 #include <vector>
 
 #include "SFML/System/Vector2.hpp"
 #include "NavigationCell.h"
 #include "AStar.h"
+#include "JumpPointSearch.h"
+#include "NavigationPath.h"
+#include "PathCache.h"
 
 namespace LowEngine::Terrain::Navigation {
+    /**
+     * @brief Connected area of the navigation grid - every cell of a region can be reached from any other cell of it.
+     */
+    struct NavigationRegion {
+        /**
+         * @brief ID of the region, valid until the grid changes.
+         */
+        uint32_t Id = 0;
+
+        /**
+         * @brief Number of cells in the region.
+         */
+        size_t CellCount = 0;
+
+        /**
+         * @brief Corners of the region's bounding box (inclusive), in NavGrid Space coordinates.
+         */
+        sf::Vector2u Min;
+        sf::Vector2u Max;
+    };
+
+    /**
+     * @brief Regions of a single type of movement, as labelled by NavigationGrid::BuildRegions().
+     *
+     * Lets regions be stored with the map, i.e. in a cooked map, so they don't have to be built on load.
+     */
+    struct RegionLabelsView {
+        /**
+         * @brief Region ID of every cell. NavigationGrid::NO_REGION for cells that can't be entered.
+         */
+        std::span<const uint32_t> CellRegions;
+        /**
+         * @brief Number of cells in every region, by ID.
+         */
+        std::span<const uint64_t> RegionSizes;
+        /**
+         * @brief 1 if cells of the region have different move costs, by ID.
+         */
+        std::span<const uint8_t> HasVaryingCost;
+    };
+
     /**
      * @brief Navigation grid that holds navigation data for the map.
      *
      * This grid is used for pathfinding and other navigation-related tasks.
+     * Cells are packed into planes of one byte each: a mask of allowed types of movement, and a quantized move cost.
+     * Positions of cells are implied by their index (x + y * Width).
      */
     class NavigationGrid {
     public:
         /**
-         * @brief Width of the navigation grid in cells.
+         * @brief Algorithm used by FindPath().
+         */
+        enum class PathfindingMethod {
+            /**
+             * @brief A* on every cell.
+             */
+            AStar,
+            /**
+             * @brief Jump Point Search where all cells of the region cost the same, A* elsewhere.
+             */
+            JumpPointSearch,
+        };
+
+        /**
+         * @brief Region ID of cells that can't be entered with particular type of movement.
+         */
+        static constexpr uint32_t NO_REGION = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @brief Index of a cell outside of the grid.
+         */
+        static constexpr size_t OUTSIDE = std::numeric_limits<size_t>::max();
+
+        /**
+         * @brief Move costs are stored in steps of 1 / COST_SCALE.
+         */
+        static constexpr float COST_SCALE = 16.0f;
+
+        /**
+         * @brief Highest move cost a cell can have - higher costs are clamped.
+         */
+        static constexpr float MAX_MOVE_COST = 255.0f / COST_SCALE;
+
+        /**
+         * @brief Quantized move cost of 1.
+         */
+        static constexpr uint8_t UNIT_MOVE_COST = 16;
+
+        /**
+         * @brief Width of the navigation grid in cells. Set by Resize().
          */
         size_t Width = 0;
         /**
-         * @brief Height of the navigation grid in cells.
+         * @brief Height of the navigation grid in cells. Set by Resize().
          */
         size_t Height = 0;
 
         /**
-         * @brief Collection of cells in this NavGrid.
+         * @brief Change size of the grid. All cells become impassable, with move cost of 1.
+         *
+         * Fill cells with SetCell(), then call BuildRegions().
+         */
+        void Resize(size_t width, size_t height);
+
+        [[nodiscard]] size_t GetCellCount() const { return _movementMasks.size(); }
+
+        /**
+         * @brief Set navigation properties of a cell, without updating regions.
+         *
+         * Meant for filling the grid - call BuildRegions() afterwards. Different cells may be set from multiple threads at once.
+         * Later changes should go through SetCellNavigation(), which keeps regions up to date.
+         * @param index Index of the cell (x + y * Width).
+         * @param cell Navigation properties. Move cost is quantized to steps of 1 / COST_SCALE.
+         */
+        void SetCell(size_t index, const NavigationCell& cell);
+
+        /**
+         * @brief Retrieve navigation properties of a cell, unpacked.
+         * @param index Index of the cell (x + y * Width).
+         */
+        [[nodiscard]] NavigationCell GetCell(size_t index) const;
+
+        /**
+         * @brief Mask of allowed types of movement for every cell, as bits from GetMovementBit().
+         */
+        [[nodiscard]] const std::vector<uint8_t>& GetMovementMasks() const { return _movementMasks; }
+
+        /**
+         * @brief Quantized move cost of every cell, see GetMoveCost().
+         */
+        [[nodiscard]] const std::vector<uint8_t>& GetMoveCosts() const { return _moveCosts; }
+
+        /**
+         * @brief Convert move cost to its quantized form.
+         */
+        [[nodiscard]] static uint8_t QuantizeMoveCost(float moveCost);
+
+        /**
+         * @brief Convert quantized move cost back to a float.
          */
-        std::vector<NavigationCell> Cells;
+        [[nodiscard]] static constexpr float GetMoveCost(uint8_t quantizedCost) { return static_cast<float>(quantizedCost) / COST_SCALE; }
+
+        /**
+         * @brief Lowest move cost of a passable cell, used by A* heuristic.
+         *
+         * Computed by BuildRegions() and lowered by SetCellNavigation(). Zero before regions are built.
+         */
+        [[nodiscard]] float GetMinMoveCost() const { return GetMoveCost(_minMoveCost); }
+
+        /**
+         * @brief Approximate number of bytes used by the grid - cells, regions and search data kept between searches.
+         */
+        [[nodiscard]] size_t GetMemorySize() const;
 
         /**
          * @brief Find a path from start to end position on the navigation grid.
          *
+         * Finds the cheapest path, where a straight step costs the move cost of the entered cell and a diagonal step
+         * DIAGONAL_COST times that. If regions are built, unreachable end is rejected without searching. Paths found earlier
+         * are answered from path cache (see GetPathCache()) until the grid changes.
          * @param start Starting position in NavGrid Space coordinates.
          * @param end Ending position in NavGrid Space coordinates.
          * @param movementType Type of movement (walk, swim, fly).
-         * @return A vector of NavigationCell representing the path from start to end (with NavGrid Space positions). Returns empty vector if path is not found.
+         * @param path Receives cells of the path from start to end (NavGrid Space positions). Left empty if path is not found.
+         * Reuse the same path for repeated searches - its memory is kept. Origin and CellSize are not changed.
+         * @return True if path was found. False also for grids wider or higher than NavigationPath::MAX_GRID_SIZE.
+         */
+        bool FindPath(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType, NavigationPath& path);
+
+        /**
+         * @brief Select algorithm used by FindPath(). Default is JumpPointSearch.
+         *
+         * Jump Point Search needs regions (see BuildRegions()) to know where move costs are uniform - without them A* is used.
+         * Jump distances are computed on first search for each type of movement, and again after passability of cells changes.
+         * Cooked maps come with jump distances, see SetJumpDistances().
+         * Both algorithms find paths of the same cost, so changing the method or a cell's cost doesn't change how paths are measured.
+         */
+        void SetPathfindingMethod(PathfindingMethod method);
+
+        [[nodiscard]] PathfindingMethod GetPathfindingMethod() const { return _pathfindingMethod; }
+
+        /**
+         * @brief Check if FindPath() would use Jump Point Search to reach the end position.
+         */
+        [[nodiscard]] bool UsesJumpPointSearch(const sf::Vector2u& end, MovementType movementType) const;
+
+        /**
+         * @brief Retrieve cache of paths found by FindPath(), i.e. to change its capacity or read its counters.
+         */
+        [[nodiscard]] PathCache& GetPathCache() { return _pathCache; }
+
+        [[nodiscard]] const PathCache& GetPathCache() const { return _pathCache; }
+
+        /**
+         * @brief Number of nodes expanded by the last FindPath() call - cells for A*, jump points for Jump Point Search.
+         * Zero if path was taken from cache.
+         */
+        [[nodiscard]] size_t GetExpandedNodeCount() const { return _expandedNodes; }
+
+        /**
+         * @brief Label connected regions of all cells, for every type of movement.
+         *
+         * Must be called after cells are filled with SetCell() - regions of a grid that changed size are ignored until then.
+         */
+        void BuildRegions();
+
+        /**
+         * @brief Number of cells in every region, by ID. Zero for unused IDs. Empty if regions are not built.
+         */
+        [[nodiscard]] std::vector<uint64_t> GetRegionSizes(MovementType movementType) const;
+
+        /**
+         * @brief Region ID of every cell, see GetRegionId(). Empty if regions are not built.
+         */
+        [[nodiscard]] const std::vector<uint32_t>& GetCellRegions(MovementType movementType) const { return _regions[movementType].CellRegions; }
+
+        /**
+         * @brief Whether a region has cells with move cost other than 1, by ID. Empty if regions are not built.
+         */
+        [[nodiscard]] const std::vector<uint8_t>& GetVaryingCostRegions(MovementType movementType) const { return _regions[movementType].HasVaryingCost; }
+
+        /**
+         * @brief Use regions built earlier by BuildRegions() for the same cells, instead of building them again.
+         *
+         * Must be called after cells are filled with SetCell(). Region IDs are checked to be in range, but labels
+         * are trusted to match the cells.
+         * @param regions Regions of Walk, Swim and Fly movement, in that order.
+         * @return False if regions don't match size of the grid - they are left not built then.
+         */
+        bool SetRegions(const std::array<RegionLabelsView, 3>& regions);
+
+        /**
+         * @brief Jump distances of Jump Point Search, computed first if passability of cells changed since.
+         * @see JumpPointSearch::GetDistances()
+         */
+        const std::vector<int32_t>& GetJumpDistances(MovementType movementType);
+
+        /**
+         * @brief Use jump distances computed earlier for the same cells, instead of computing them on first search.
+         *
+         * Must be called after SetRegions() or BuildRegions().
+         * @param distances Jump distances, see JumpPointSearch::GetDistances().
+         * @return False if number of distances doesn't match the grid or any jump leaves the grid.
+         */
+        bool SetJumpDistances(MovementType movementType, std::span<const int32_t> distances);
+
+        /**
+         * @brief Change navigation properties of a single cell and update regions around it.
+         *
+         * Opening a cell joins regions next to it, at cost of relabelling the smaller ones. Closing a cell may split
+         * its region - only parts cut off from the rest are relabelled.
+         * @param position Position of the cell, in NavGrid Space coordinates.
+         * @param isWalkable Can entity move to the cell when walking?
+         * @param isSwimmable Can entity move to the cell when swimming?
+         * @param isFlyable Can entity move to the cell when flying?
+         * @param moveCost Cost of moving to the cell.
+         */
+        void SetCellNavigation(const sf::Vector2u& position, bool isWalkable, bool isSwimmable, bool isFlyable, float moveCost);
+
+        /**
+         * @brief Retrieve ID of the region the cell belongs to.
+         * @param position Position of the cell, in NavGrid Space coordinates.
+         * @param movementType Type of movement.
+         * @return ID of the region. NO_REGION if the cell can't be entered, is outside of the grid or regions are not built.
+         */
+        [[nodiscard]] uint32_t GetRegionId(const sf::Vector2u& position, MovementType movementType) const;
+
+        /**
+         * @brief Check if a path between two cells exists, in constant time.
+         *
+         * Follows the same rules as FindPath() - start cell doesn't need to be passable, end cell does.
+         * @param start Starting position in NavGrid Space coordinates.
+         * @param end Ending position in NavGrid Space coordinates.
+         * @param movementType Type of movement.
+         * @return False if path certainly doesn't exist. True if it does, or if regions are not built.
+         */
+        [[nodiscard]] bool IsReachable(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType) const;
+
+        /**
+         * @brief List connected regions, i.e. to find islands or chokepoints for AI. Goes through the whole grid.
+         * @param movementType Type of movement.
+         * @return Regions ordered by ID. Empty if regions are not built.
+         */
+        [[nodiscard]] std::vector<NavigationRegion> GetRegions(MovementType movementType) const;
+
+        /**
+         * @brief Number incremented every time navigation data changes through Resize(), BuildRegions() or SetCellNavigation().
+         *
+         * Lets users of the grid detect that results computed earlier, like paths, may be outdated.
+         */
+        [[nodiscard]] uint64_t GetVersion() const { return _version; }
+
+    protected:
+        /**
+         * @brief Regions of a single type of movement.
+         */
+        struct RegionLabels {
+            /**
+             * @brief Region ID of every cell.
+             */
+            std::vector<uint32_t> CellRegions;
+
+            /**
+             * @brief Number of cells in every region, by ID. Zero for unused IDs.
+             */
+            std::vector<size_t> RegionSizes;
+
+            /**
+             * @brief IDs of regions that were merged or split, ready for reuse.
+             */
+            std::vector<uint32_t> FreeIds;
+
+            /**
+             * @brief Whether a region has cells with move cost other than 1, by ID. Cleared only by BuildRegions().
+             */
+            std::vector<uint8_t> HasVaryingCost;
+        };
+
+        std::vector<uint8_t> _movementMasks;
+        std::vector<uint8_t> _moveCosts;
+        uint8_t _minMoveCost = 0;
+
+        std::array<RegionLabels, 3> _regions;
+        uint64_t _version = 0;
+
+        PathfindingMethod _pathfindingMethod = PathfindingMethod::JumpPointSearch;
+        AStar _aStar;
+        PathCache _pathCache;
+        std::array<JumpPointSearch, 3> _jumpPointSearch;
+
+        /**
+         * @brief Passability version jump distances of each movement type were computed for. Zero if never computed.
+         */
+        std::array<uint64_t, 3> _jumpPointVersions{};
+
+        /**
+         * @brief Incremented when passability of any cell changes - unlike _version, changes of move cost don't count.
+         */
+        uint64_t _passabilityVersion = 0;
+        size_t _expandedNodes = 0;
+
+        /**
+         * @brief Marks of cells visited while checking if closing a cell split its region. Stamps of earlier checks are ignored.
+         */
+        std::vector<uint32_t> _searchStamps;
+        uint32_t _searchStamp = 0;
+
+        [[nodiscard]] bool HasRegions(MovementType movementType) const;
+
+        /**
+         * @brief Compute lowest move cost of passable cells.
+         */
+        void UpdateMinMoveCost();
+
+        /**
+         * @brief Compute jump distances of a movement type, if passability changed since they were computed last.
+         */
+        JumpPointSearch& GetJumpPointSearch(MovementType movementType);
+
+        static uint32_t AcquireRegionId(RegionLabels& labels);
+
+        static void ReleaseRegionId(RegionLabels& labels, uint32_t regionId);
+
+        /**
+         * @brief Move the cell and all passable cells connected to it from one region to another.
+         * @return Number of relabelled cells.
+         */
+        size_t FloodFill(RegionLabels& labels, MovementType movementType, size_t startIndex, uint32_t fromRegion, uint32_t toRegion);
+
+        void AddCellToRegions(RegionLabels& labels, MovementType movementType, size_t index);
+
+        void RemoveCellFromRegions(RegionLabels& labels, MovementType movementType, size_t index);
+
+        /**
+         * @brief Collect indices of 8 cells around the provided one, in clockwise order starting from the top. Cells outside of the grid are OUTSIDE.
          */
-        [[nodiscard]] std::vector<NavigationCell> FindPath(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType);
+        [[nodiscard]] std::array<size_t, 8> GetRing(size_t index) const;
     };
 }
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SFML/System/Vector2.hpp"
+
+namespace LowEngine::Terrain::Navigation {
+    /**
+     * @brief Position of a path's cell in NavGrid Space, packed into 4 bytes.
+     */
+    struct PathCell {
+        uint16_t X = 0;
+        uint16_t Y = 0;
+    };
+
+    /**
+     * @brief Result of pathfinding - cells from start to end, including both.
+     *
+     * Meant to be kept by the caller and passed to every search: cells are overwritten, but memory is reused,
+     * so repeated searches don't allocate once the path has grown to its usual length.
+     * World positions are computed only when asked for, from Origin and CellSize set by whoever ran the search.
+     */
+    class NavigationPath {
+    public:
+        /**
+         * @brief Largest width or height of a navigation grid that paths can describe.
+         */
+        static constexpr size_t MAX_GRID_SIZE = std::numeric_limits<uint16_t>::max();
+
+        /**
+         * @brief World position of cell (0, 0) of the navigation grid.
+         */
+        sf::Vector2f Origin;
+
+        /**
+         * @brief Size of single cell, in world units.
+         */
+        float CellSize = 1.0f;
+
+        /**
+         * @brief Remove all cells, keeping allocated memory.
+         */
+        void Clear() { _cells.clear(); }
+
+        void Reserve(size_t cellCount) { _cells.reserve(cellCount); }
+
+        [[nodiscard]] bool IsEmpty() const { return _cells.empty(); }
+
+        /**
+         * @brief Number of cells, including start and end.
+         */
+        [[nodiscard]] size_t GetSize() const { return _cells.size(); }
+
+        /**
+         * @brief Retrieve position of a cell, in NavGrid Space coordinates.
+         */
+        [[nodiscard]] sf::Vector2u GetCell(size_t index) const {
+            return {_cells[index].X, _cells[index].Y};
+        }
+
+        /**
+         * @brief Retrieve world position of a cell's corner.
+         */
+        [[nodiscard]] sf::Vector2f GetPoint(size_t index) const {
+            return {Origin.x + static_cast<float>(_cells[index].X) * CellSize, Origin.y + static_cast<float>(_cells[index].Y) * CellSize};
+        }
+
+        [[nodiscard]] const std::vector<PathCell>& GetCells() const { return _cells; }
+
+        /**
+         * @brief INTERNAL: Add a cell at the end of the path. Used by pathfinders.
+         */
+        void Append(const sf::Vector2u& cell) {
+            _cells.push_back({static_cast<uint16_t>(cell.x), static_cast<uint16_t>(cell.y)});
+        }
+
+        /**
+         * @brief INTERNAL: Replace cells of the path, i.e. with a path from cache.
+         */
+        void Assign(const PathCell* first, const PathCell* last) { _cells.assign(first, last); }
+
+        /**
+         * @brief INTERNAL: Reverse order of cells. Pathfinders collect cells from the end.
+         */
+        void Reverse() { std::ranges::reverse(_cells); }
+
+    protected:
+        std::vector<PathCell> _cells;
+    };
+}
@@ -0,0 +1,127 @@
+#include "PathCache.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace LowEngine::Terrain::Navigation {
+    PathCache::PathCache(const PathCache& other)
+        : _capacity(other._capacity), _suffixReuse(other._suffixReuse), _stats(other._stats) {
+    }
+
+    PathCache& PathCache::operator=(const PathCache& other) {
+        if (this == &other) return *this;
+
+        Clear();
+        _capacity = other._capacity;
+        _suffixReuse = other._suffixReuse;
+        _stats = other._stats;
+        return *this;
+    }
+
+    void PathCache::SetCapacity(size_t capacity) {
+        _capacity = capacity;
+        while (_entries.size() > _capacity) {
+            Evict(std::prev(_entries.end()));
+            _stats.Evictions++;
+        }
+    }
+
+    bool PathCache::Find(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType, uint64_t version, NavigationPath& path) {
+        if (_capacity == 0) return false;
+        Validate(version);
+
+        uint32_t startKey = GetCellKey(start);
+        uint32_t endKey = GetCellKey(end);
+        auto& byEndpoints = _byEndpoints[movementType];
+        if (auto found = byEndpoints.find(GetEndpointsKey(startKey, endKey)); found != byEndpoints.end()) {
+            auto entry = found->second;
+            _entries.splice(_entries.begin(), _entries, entry);
+            path.Assign(entry->Cells.data(), entry->Cells.data() + entry->Cells.size());
+            _stats.Hits++;
+            return true;
+        }
+
+        if (_suffixReuse) {
+            // start's own cell is not compared - a path starting there would have been found above
+            PathCell startCell{static_cast<uint16_t>(start.x), static_cast<uint16_t>(start.y)};
+            auto [first, last] = _byEnd[movementType].equal_range(endKey);
+            for (auto candidate = first; candidate != last; ++candidate) {
+                auto entry = candidate->second;
+                auto cell = std::find_if(entry->Cells.begin() + 1, entry->Cells.end(), [&startCell](const PathCell& pathCell) {
+                    return pathCell.X == startCell.X && pathCell.Y == startCell.Y;
+                });
+                if (cell == entry->Cells.end()) continue;
+
+                _entries.splice(_entries.begin(), _entries, entry);
+                path.Assign(&*cell, entry->Cells.data() + entry->Cells.size());
+                _stats.SuffixHits++;
+                return true;
+            }
+        }
+
+        _stats.Misses++;
+        return false;
+    }
+
+    void PathCache::Add(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType, uint64_t version, const NavigationPath& path) {
+        if (_capacity == 0 || path.IsEmpty()) return;
+        Validate(version);
+
+        uint32_t startKey = GetCellKey(start);
+        uint32_t endKey = GetCellKey(end);
+        auto& byEndpoints = _byEndpoints[movementType];
+        if (auto found = byEndpoints.find(GetEndpointsKey(startKey, endKey)); found != byEndpoints.end()) {
+            found->second->Cells = path.GetCells();
+            _entries.splice(_entries.begin(), _entries, found->second);
+            return;
+        }
+
+        while (_entries.size() >= _capacity) {
+            Evict(std::prev(_entries.end()));
+            _stats.Evictions++;
+        }
+
+        _entries.push_front({startKey, endKey, movementType, path.GetCells()});
+        byEndpoints[GetEndpointsKey(startKey, endKey)] = _entries.begin();
+        _byEnd[movementType].emplace(endKey, _entries.begin());
+    }
+
+    void PathCache::Clear() {
+        _entries.clear();
+        for (auto& byEndpoints: _byEndpoints) byEndpoints.clear();
+        for (auto& byEnd: _byEnd) byEnd.clear();
+    }
+
+    size_t PathCache::GetMemorySize() const {
+        size_t size = 0;
+        for (auto& entry: _entries) {
+            size += sizeof(Entry) + entry.Cells.capacity() * sizeof(PathCell);
+        }
+        return size;
+    }
+
+    void PathCache::Validate(uint64_t version) {
+        if (version == _version) return;
+
+        if (!_entries.empty()) {
+            Clear();
+            _stats.Invalidations++;
+        }
+        _version = version;
+    }
+
+    void PathCache::Evict(EntryList::iterator entry) {
+        _byEndpoints[entry->Movement].erase(GetEndpointsKey(entry->Start, entry->End));
+
+        auto& byEnd = _byEnd[entry->Movement];
+        auto [first, last] = byEnd.equal_range(entry->End);
+        for (auto candidate = first; candidate != last; ++candidate) {
+            if (candidate->second == entry) {
+                byEnd.erase(candidate);
+                break;
+            }
+        }
+
+        _entries.erase(entry);
+    }
+}
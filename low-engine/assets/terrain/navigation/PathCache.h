@@ -0,0 +1,166 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "NavigationCell.h"
+#include "NavigationPath.h"
+
+namespace LowEngine::Terrain::Navigation {
+    /**
+     * @brief Counters of a path cache.
+     */
+    struct PathCacheStats {
+        /**
+         * @brief Number of searches answered with a path cached for the same start and end.
+         */
+        size_t Hits = 0;
+        /**
+         * @brief Number of searches answered with the rest of a cached path that passes through the start.
+         */
+        size_t SuffixHits = 0;
+        /**
+         * @brief Number of searches that had to run pathfinding.
+         */
+        size_t Misses = 0;
+        /**
+         * @brief Number of paths dropped to stay within capacity.
+         */
+        size_t Evictions = 0;
+        /**
+         * @brief Number of times all paths were dropped, because the navigation grid changed.
+         */
+        size_t Invalidations = 0;
+    };
+
+    /**
+     * @brief Bounded cache of found paths, for searches repeated every frame or turn - i.e. routes of AI units.
+     *
+     * Paths are keyed by start, end and type of movement, and tagged with version of the navigation grid
+     * (see NavigationGrid::GetVersion()) - any change of the grid drops all of them. When the cache is full,
+     * the least recently used path is dropped.
+     *
+     * Cost of a path is the sum of costs of its steps, so the rest of an optimal path is optimal too. A unit that
+     * moves along its route and asks for a path to the same end again gets the rest of the route, without a search.
+     */
+    class PathCache {
+    public:
+        PathCache() = default;
+
+        /**
+         * @brief Copy settings and counters. Paths are not copied - they belong to the grid the cache was copied from.
+         */
+        PathCache(const PathCache& other);
+
+        PathCache& operator=(const PathCache& other);
+
+        PathCache(PathCache&& other) noexcept = default;
+
+        PathCache& operator=(PathCache&& other) noexcept = default;
+
+        /**
+         * @brief Maximum number of cached paths. Zero disables the cache. Paths above new capacity are dropped.
+         */
+        void SetCapacity(size_t capacity);
+
+        [[nodiscard]] size_t GetCapacity() const { return _capacity; }
+
+        /**
+         * @brief Should searches starting on a cached path be answered with the rest of it? Enabled by default.
+         */
+        void SetSuffixReuse(bool enabled) { _suffixReuse = enabled; }
+
+        [[nodiscard]] bool GetSuffixReuse() const { return _suffixReuse; }
+
+        /**
+         * @brief INTERNAL: Look for a cached path. Counts a hit or a miss.
+         * @param start Position of the start cell, in NavGrid Space coordinates.
+         * @param end Position of the end cell, in NavGrid Space coordinates.
+         * @param movementType Type of movement.
+         * @param version Current version of the navigation grid. Paths of other versions are dropped.
+         * @param path Receives cached cells. Not changed on a miss.
+         * @return True if path was found in the cache.
+         */
+        bool Find(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType, uint64_t version, NavigationPath& path);
+
+        /**
+         * @brief INTERNAL: Remember a path found by a search.
+         * @param start Position of the start cell, in NavGrid Space coordinates.
+         * @param end Position of the end cell, in NavGrid Space coordinates.
+         * @param movementType Type of movement.
+         * @param version Version of the navigation grid the path was found on.
+         * @param path Found path.
+         */
+        void Add(const sf::Vector2u& start, const sf::Vector2u& end, MovementType movementType, uint64_t version, const NavigationPath& path);
+
+        /**
+         * @brief Drop all paths. Counters are kept.
+         */
+        void Clear();
+
+        /**
+         * @brief Number of cached paths.
+         */
+        [[nodiscard]] size_t GetSize() const { return _entries.size(); }
+
+        /**
+         * @brief Number of bytes used by cached paths.
+         */
+        [[nodiscard]] size_t GetMemorySize() const;
+
+        [[nodiscard]] const PathCacheStats& GetStats() const { return _stats; }
+
+        void ResetStats() { _stats = PathCacheStats(); }
+
+    protected:
+        struct Entry {
+            /**
+             * @brief Packed positions of start and end, see GetCellKey().
+             */
+            uint32_t Start = 0;
+            uint32_t End = 0;
+            MovementType Movement = MovementType::Walk;
+            std::vector<PathCell> Cells;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        /**
+         * @brief Cached paths, most recently used first.
+         */
+        EntryList _entries;
+
+        /**
+         * @brief Paths by start and end (start << 32 | end), for every type of movement.
+         */
+        std::array<std::unordered_map<uint64_t, EntryList::iterator>, 3> _byEndpoints;
+
+        /**
+         * @brief Paths by end, for every type of movement - candidates for suffix reuse.
+         */
+        std::array<std::unordered_multimap<uint32_t, EntryList::iterator>, 3> _byEnd;
+
+        size_t _capacity = 64;
+        bool _suffixReuse = true;
+        uint64_t _version = 0;
+
+        PathCacheStats _stats;
+
+        /**
+         * @brief Drop all paths if the grid changed since they were cached.
+         */
+        void Validate(uint64_t version);
+
+        void Evict(EntryList::iterator entry);
+
+        /**
+         * @brief Pack position of a cell into 32 bits. Grids used for pathfinding are at most NavigationPath::MAX_GRID_SIZE cells wide.
+         */
+        static uint32_t GetCellKey(const sf::Vector2u& position) { return position.x << 16 | position.y; }
+
+        static uint64_t GetEndpointsKey(uint32_t start, uint32_t end) { return static_cast<uint64_t>(start) << 32 | end; }
+    };
+}
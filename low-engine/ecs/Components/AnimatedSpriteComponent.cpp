@@ -1,5 +1,7 @@
 #include "AnimatedSpriteComponent.h"
 
+#include <algorithm>
+
 namespace LowEngine::ECS {
     void AnimatedSpriteComponent::SetTexture(const std::string& textureAlias) {
         SpriteComponent::SetTexture(textureAlias);
@@ -8,7 +10,7 @@ namespace LowEngine::ECS {
         UpdateFrameSize();
     }
 
-    void AnimatedSpriteComponent::SetTexture(int32_t textureId) {
+    void AnimatedSpriteComponent::SetTexture(int textureId) {
         SpriteComponent::SetTexture(textureId);
         Sheet = Assets::GetSpriteSheet(textureId);
 
@@ -16,15 +18,19 @@ namespace LowEngine::ECS {
     }
 
     void AnimatedSpriteComponent::Play(const std::string& animationName, bool loop) {
+        Play(StringId(animationName), loop);
+    }
+
+    void AnimatedSpriteComponent::Play(StringId animationName, bool loop) {
         if (Sheet == nullptr) {
-            _log->error("Cannot play animation {}. No sprite sheet is not set.", animationName);
+            _log->error("Cannot play animation {}. No sprite sheet is not set.", animationName.GetString());
             return;
         }
 
         Clip = Sheet->GetAnimationClip(animationName);
 
         if (Clip == nullptr) {
-            _log->error("Cannot play animation {}. Animation clip does not exist.", animationName);
+            _log->error("Cannot play animation {}. Animation clip does not exist.", animationName.GetString());
             return;
         }
 
@@ -63,13 +69,42 @@ namespace LowEngine::ECS {
         Sprite.setTextureRect(Clip->Frames[CurrentFrame]);
     }
 
-    void AnimatedSpriteComponent::SetTexture(const sf::Texture& texture) {
-        SpriteComponent::SetTexture(texture);
+    void AnimatedSpriteComponent::ToRecord(Record& record, Serialization::StringTable& strings) const {
+        SpriteComponent::ToRecord(record.Sprite, strings);
+
+        if (Clip != nullptr) {
+            record.ClipName = strings.Add(Clip->Name);
+            record.HasClip = 1;
+        }
+        record.CurrentFrame = CurrentFrame;
+        record.FrameTime = FrameTime;
+        record.Loop = Loop ? 1 : 0;
+    }
+
+    void AnimatedSpriteComponent::FromRecord(const Record& record, const Serialization::StringTable& strings) {
+        SpriteComponent::FromRecord(record.Sprite, strings);
+
+        Clip = nullptr;
+        if (record.HasClip != 0 && Sheet != nullptr) {
+            auto clipName = std::string(strings.Get(record.ClipName));
+            Clip = Sheet->GetAnimationClip(clipName);
+            if (Clip == nullptr) {
+                _log->warn("Animation clip {} from save does not exist. Animation will be stopped.", clipName);
+            }
+        }
+        CurrentFrame = Clip != nullptr && Clip->FrameCount > 0 ? std::min<size_t>(record.CurrentFrame, Clip->FrameCount - 1) : 0;
+        FrameTime = record.FrameTime;
+        Loop = record.Loop != 0;
+    }
+
+    void AnimatedSpriteComponent::SetTexture(const sf::Texture& texture, const sf::IntRect& rectangle) {
+        SpriteComponent::SetTexture(texture, rectangle);
     }
 
     void AnimatedSpriteComponent::UpdateFrameSize() {
         auto size = sf::Vector2<int>(static_cast<int>(Sheet->FrameSize.x), static_cast<int>(Sheet->FrameSize.y));
-        Sprite.setTextureRect(sf::IntRect({0, 0}, size));
+        auto offset = sf::Vector2<int>(static_cast<int>(Sheet->Offset.x), static_cast<int>(Sheet->Offset.y));
+        Sprite.setTextureRect(sf::IntRect(offset, size));
         Sprite.setOrigin({static_cast<float>(size.x) / 2, static_cast<float>(size.y) / 2});
     }
 }
@@ -39,6 +39,20 @@ namespace LowEngine::ECS {
          */
         bool Loop = true;
 
+        /**
+         * @brief Serialized state of this Component.
+         *
+         * Sprite Sheet is re-acquired from Texture's Id, Clip is stored by its name.
+         */
+        struct Record {
+            SpriteComponent::Record Sprite;
+            Serialization::StringRef ClipName;
+            uint64_t CurrentFrame = 0;
+            float FrameTime = 0.0f;
+            uint8_t HasClip = 0;
+            uint8_t Loop = 0;
+        };
+
         static const std::vector<std::type_index>& Dependencies() {
             static std::vector dependencies = {
                 std::type_index(typeid(TransformComponent))
@@ -85,6 +99,15 @@ namespace LowEngine::ECS {
          */
         void Play(const std::string& animationName, bool loop = true);
 
+        /**
+         * @brief Play animation.
+         *
+         * Function will automatically find and load correct Animation Clip.
+         * @param animationName Id of animation's name, i.e. `"Walk"_sid`.
+         * @param loop Should animation loop?
+         */
+        void Play(StringId animationName, bool loop = true);
+
         /**
          * @brief Stop currently playing animation.
          *
@@ -103,8 +126,12 @@ namespace LowEngine::ECS {
             return &Sprite;
         }
 
+        void ToRecord(Record& record, Serialization::StringTable& strings) const;
+
+        void FromRecord(const Record& record, const Serialization::StringTable& strings);
+
     protected:
-        void SetTexture(const sf::Texture& texture) override;
+        void SetTexture(const sf::Texture& texture, const sf::IntRect& rectangle) override;
 
         /**
          * @brief Updates Sprite properties to match selected Texture's properties.
@@ -6,6 +6,8 @@ namespace LowEngine::ECS {
     void CameraComponent::Update(float deltaTime) {
         auto transformComponent = _memory->GetComponent<TransformComponent>(EntityId);
         if (transformComponent) {
+            _previousCenter = _hasPreviousCenter ? _view.getCenter() : transformComponent->Position;
+            _hasPreviousCenter = true;
             _view.setCenter(transformComponent->Position);
             _view.setRotation(transformComponent->Rotation);
         }
@@ -15,9 +17,32 @@ namespace LowEngine::ECS {
         _view.setSize(windowSize);
     }
 
-    void CameraComponent::SetView(sf::RenderWindow& window) {
-        auto size = window.getSize();
+    void CameraComponent::SetView(sf::RenderTarget& target, float alpha) {
+        auto size = target.getSize();
         _view.setSize({size.x * ZoomFactor, size.y * ZoomFactor});
-        window.setView(_view);
+        target.setView(GetView(size, alpha));
+    }
+
+    sf::View CameraComponent::GetView(sf::Vector2u targetSize, float alpha) const {
+        sf::View view = _view;
+        view.setSize({targetSize.x * ZoomFactor, targetSize.y * ZoomFactor});
+        if (alpha < 1.0f && _hasPreviousCenter) {
+            view.setCenter(_previousCenter + (_view.getCenter() - _previousCenter) * alpha);
+        }
+        return view;
+    }
+
+    void CameraComponent::ToRecord(Record& record, Serialization::StringTable& strings) const {
+        record.Center = _view.getCenter();
+        record.Size = _view.getSize();
+        record.Rotation = _view.getRotation().asDegrees();
+        record.ZoomFactor = ZoomFactor;
+    }
+
+    void CameraComponent::FromRecord(const Record& record, const Serialization::StringTable& strings) {
+        _view.setCenter(record.Center);
+        _view.setSize(record.Size);
+        _view.setRotation(sf::degrees(record.Rotation));
+        ZoomFactor = record.ZoomFactor;
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "TransformComponent.h"
 #include "ecs/IComponent.h"
+#include "SFML/Graphics/RenderTarget.hpp"
 #include "SFML/Graphics/View.hpp"
 
 namespace LowEngine::ECS {
@@ -20,12 +21,23 @@ namespace LowEngine::ECS {
          */
         float ZoomFactor = 1.0f;
 
+        /**
+         * @brief Serialized state of this Component.
+         */
+        struct Record {
+            sf::Vector2f Center;
+            sf::Vector2f Size;
+            float Rotation = 0.0f;
+            float ZoomFactor = 1.0f;
+        };
+
         explicit CameraComponent(Memory::Memory* memory)
             : IComponent(memory) {
         }
 
         CameraComponent(Memory::Memory* memory, CameraComponent const* other)
-            : IComponent(memory, other), _view(other->_view), ZoomFactor(other->ZoomFactor) {
+            : IComponent(memory, other), ZoomFactor(other->ZoomFactor), _view(other->_view),
+              _previousCenter(other->_previousCenter), _hasPreviousCenter(other->_hasPreviousCenter) {
         }
 
         ~CameraComponent() override = default;
@@ -34,6 +46,8 @@ namespace LowEngine::ECS {
             new(rawStorage) CameraComponent(newMemory, this);
         }
 
+        static constexpr bool HAS_DRAW = false;
+
         static const std::vector<std::type_index>& Dependencies() {
             static std::vector<std::type_index> dependencies = {
                 std::type_index(typeid(TransformComponent))
@@ -54,12 +68,27 @@ namespace LowEngine::ECS {
         void SetWindowSize(sf::Vector2f windowSize);
 
         /**
-         * @brief Set thi Component's View to provided window.
-         * @param window Reference to the Window that will have Component's view assigned to.
+         * @brief Set thi Component's View to provided render target.
+         * @param target Reference to the Window or off-screen texture that will have Component's view assigned to.
+         * @param alpha Interpolation factor between center from previous and current simulation step.
          */
-        void SetView(sf::RenderWindow& window);
+        void SetView(sf::RenderTarget& target, float alpha = 1.0f);
+
+        /**
+         * @brief Calculate this Component's View for render target of provided size.
+         * @param targetSize Size of the render target, in pixels.
+         * @param alpha Interpolation factor between center from previous and current simulation step.
+         * @return View scaled by ZoomFactor.
+         */
+        [[nodiscard]] sf::View GetView(sf::Vector2u targetSize, float alpha = 1.0f) const;
+
+        void ToRecord(Record& record, Serialization::StringTable& strings) const;
+
+        void FromRecord(const Record& record, const Serialization::StringTable& strings);
 
     protected:
         sf::View _view;
+        sf::Vector2f _previousCenter;
+        bool _hasPreviousCenter = false;
     };
 }
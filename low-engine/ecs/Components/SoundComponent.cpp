@@ -3,11 +3,26 @@
 
 namespace LowEngine::ECS {
     void SoundComponent::SetSound(const std::string& soundAlias) {
-        auto& newSound = Assets::GetSound(soundAlias);
-        Sound.setBuffer(newSound);
+        SoundId = Assets::GetSoundId(soundAlias);
+        Sound.setBuffer(Assets::GetSound(SoundId));
     }
 
     void SoundComponent::Play() {
         Sound.play();
     }
+
+    void SoundComponent::ToRecord(Record& record, Serialization::StringTable& strings) const {
+        record.SoundId = SoundId;
+        record.Volume = Sound.getVolume();
+        record.Pitch = Sound.getPitch();
+        record.Looping = Sound.isLooping() ? 1 : 0;
+    }
+
+    void SoundComponent::FromRecord(const Record& record, const Serialization::StringTable& strings) {
+        SoundId = record.SoundId;
+        Sound.setBuffer(Assets::GetSound(SoundId));
+        Sound.setVolume(record.Volume);
+        Sound.setPitch(record.Pitch);
+        Sound.setLooping(record.Looping != 0);
+    }
 }
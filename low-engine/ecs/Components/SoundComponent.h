@@ -15,12 +15,29 @@ namespace LowEngine::ECS {
          */
         sf::Sound Sound;
 
+        /**
+         * @brief Id of the sound buffer used by the Sound.
+         */
+        size_t SoundId = 0;
+
+        /**
+         * @brief Serialized state of this Component.
+         *
+         * Sound buffer is stored by its Id and re-acquired from Assets on load.
+         */
+        struct Record {
+            uint64_t SoundId = 0;
+            float Volume = 100.0f;
+            float Pitch = 1.0f;
+            uint8_t Looping = 0;
+        };
+
         explicit SoundComponent(Memory::Memory* memory)
             : IComponent(memory), Sound(Assets::GetDefaultSound()) {
         }
 
         SoundComponent(Memory::Memory* memory, SoundComponent const* other)
-            : IComponent(memory, other), Sound(other->Sound) {
+            : IComponent(memory, other), Sound(other->Sound), SoundId(other->SoundId) {
         }
 
         ~SoundComponent() override = default;
@@ -40,6 +57,13 @@ namespace LowEngine::ECS {
          */
         void Play();
 
+        void ToRecord(Record& record, Serialization::StringTable& strings) const;
+
+        void FromRecord(const Record& record, const Serialization::StringTable& strings);
+
+        static constexpr bool HAS_UPDATE = false;
+        static constexpr bool HAS_DRAW = false;
+
         static const std::vector<std::type_index>& Dependencies() {
             static std::vector<std::type_index> dependencies = {};
             return dependencies;
@@ -48,11 +72,6 @@ namespace LowEngine::ECS {
         void Initialize() override {
         }
 
-        void Update(float deltaTime) override {
-        }
-
-        Sprite* Draw() override { return nullptr; }
-
     protected:
     };
 }
@@ -1,27 +1,63 @@
 #include "SpriteComponent.h"
 
 namespace LowEngine::ECS {
-    void SpriteComponent::SetTexture(const sf::Texture& texture) {
+    void SpriteComponent::SetTexture(const sf::Texture& texture, const sf::IntRect& rectangle) {
         Sprite.setTexture(texture);
 
-        auto size = static_cast<sf::Vector2<int>>(texture.getSize());
-        Sprite.setTextureRect(sf::IntRect({0, 0}, size));
+        auto size = rectangle.size;
+        Sprite.setTextureRect(rectangle);
         Sprite.setOrigin({static_cast<float>(size.x) / 2, static_cast<float>(size.y) / 2});
     }
 
     void SpriteComponent::Update(float deltaTime) {
         auto transformComponent = _memory->GetComponent<TransformComponent>(EntityId);
-        Sprite.setPosition(transformComponent->Position);
+        Sprite.MoveTo(transformComponent->Position);
         Sprite.setRotation(transformComponent->Rotation);
         Sprite.setScale(transformComponent->Scale);
         Sprite.Layer = Layer;
     }
 
     void SpriteComponent::SetTexture(const std::string& textureAlias) {
-        SetTexture(Assets::GetTexture(textureAlias));
+        TextureId = Assets::GetTextureId(textureAlias);
+        _texture = Assets::AcquireTexture(TextureId);
+        auto region = Assets::GetTextureRect(TextureId);
+        _textureOffset = region.position;
+        SetTexture(Assets::GetTexture(TextureId), region);
     }
 
     void SpriteComponent::SetTexture(int textureId) {
-        SetTexture(Assets::GetTexture(textureId));
+        TextureId = textureId;
+        _texture = Assets::AcquireTexture(TextureId);
+        auto region = Assets::GetTextureRect(textureId);
+        _textureOffset = region.position;
+        SetTexture(Assets::GetTexture(textureId), region);
+    }
+
+    void SpriteComponent::ToRecord(Record& record, Serialization::StringTable& strings) const {
+        record.TextureId = TextureId;
+        // relative to the texture - a save must not depend on how textures were packed in the session that wrote it
+        record.TextureRect = Sprite.getTextureRect();
+        record.TextureRect.position -= _textureOffset;
+        record.Origin = Sprite.getOrigin();
+        record.Position = Sprite.getPosition();
+        record.Scale = Sprite.getScale();
+        record.Rotation = Sprite.getRotation().asDegrees();
+        record.Color = Sprite.getColor();
+        record.Layer = Layer;
+    }
+
+    void SpriteComponent::FromRecord(const Record& record, const Serialization::StringTable& strings) {
+        SetTexture(static_cast<int>(record.TextureId));
+
+        auto rectangle = record.TextureRect;
+        rectangle.position += _textureOffset;
+        Sprite.setTextureRect(rectangle);
+        Sprite.setOrigin(record.Origin);
+        Sprite.setPosition(record.Position);
+        Sprite.setScale(record.Scale);
+        Sprite.setRotation(sf::degrees(record.Rotation));
+        Sprite.setColor(record.Color);
+        Layer = record.Layer;
+        Sprite.Layer = record.Layer;
     }
 }
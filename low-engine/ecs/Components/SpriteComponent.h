@@ -12,6 +12,8 @@ namespace LowEngine::ECS {
     /**
      * Represents a component that displays a Sprite.
      *
+     * Component holds a reference to its texture, so the texture is never evicted while the Sprite draws it.
+     *
      * Depends on Transform Component
      */
     class SpriteComponent : public IComponent {
@@ -34,12 +36,30 @@ namespace LowEngine::ECS {
          */
         int Layer = 0;
 
+        /**
+         * @brief Serialized state of this Component.
+         *
+         * Texture is stored by its Id and re-acquired from Assets on load.
+         * Texture rect is relative to the texture's corner, not to the atlas page it may be packed into.
+         */
+        struct Record {
+            uint64_t TextureId = 0;
+            sf::IntRect TextureRect;
+            sf::Vector2f Origin;
+            sf::Vector2f Position;
+            sf::Vector2f Scale;
+            float Rotation = 0.0f;
+            sf::Color Color;
+            int32_t Layer = 0;
+        };
+
         explicit SpriteComponent(Memory::Memory* memory)
             : IComponent(memory), Sprite(Assets::GetDefaultTexture()) {
         }
 
         SpriteComponent(Memory::Memory* memory, SpriteComponent const* other)
-            : IComponent(memory, other), TextureId(other->TextureId), Sprite(other->Sprite), Layer(other->Layer) {
+            : IComponent(memory, other), TextureId(other->TextureId), Sprite(other->Sprite), Layer(other->Layer),
+              _texture(other->_texture), _textureOffset(other->_textureOffset) {
         }
 
         virtual ~SpriteComponent() = default;
@@ -76,11 +96,29 @@ namespace LowEngine::ECS {
          */
         virtual void SetTexture(int textureId);
 
+        void ToRecord(Record& record, Serialization::StringTable& strings) const;
+
+        void FromRecord(const Record& record, const Serialization::StringTable& strings);
+
     protected:
+        /**
+         * @brief Reference to the texture set by SetTexture(). Sprite points to the texture's storage directly.
+         */
+        AssetHandle<sf::Texture> _texture;
+
+        /**
+         * @brief Position of the texture on its atlas page, at the time it was set. Zero if texture is not packed.
+         *
+         * Sprite's rectangle is on the page the texture had when it was set, so saves subtract this offset instead of
+         * asking Assets for the current one.
+         */
+        sf::Vector2i _textureOffset;
+
         /**
          * @brief Changes the texture the Sprite is using.
          * @param texture Reference to texture.
+         * @param rectangle Part of the texture to display, i.e. texture's place in an atlas.
          */
-        virtual void SetTexture(const sf::Texture& texture);
+        virtual void SetTexture(const sf::Texture& texture, const sf::IntRect& rectangle);
     };
 }
@@ -1,30 +1,51 @@
 #include "TileMapComponent.h"
 
+#include "profiling/Profiler.h"
+
 namespace LowEngine::ECS {
+    TileMapComponent::~TileMapComponent() {
+        // published snapshots may still be drawn with these
+        for (auto& texture: _textures) {
+            Assets::RetireRenderTexture(std::move(texture));
+        }
+    }
+
     void TileMapComponent::Update(float deltaTime) {
         auto& map = Assets::GetTileMap(_mapId);
         map.Update(deltaTime);
 
         auto transformComponent = _memory->GetComponent<TransformComponent>(EntityId);
-        _sprite.setPosition(transformComponent->Position);
+        _sprite.MoveTo(transformComponent->Position);
         _sprite.setRotation(transformComponent->Rotation);
         _sprite.setScale(transformComponent->Scale);
         _sprite.Layer = Layer;
     }
 
     LowEngine::Sprite* TileMapComponent::Draw() {
+        LOW_PROFILE_ZONE("TileMapComponent::Draw");
+
         auto& map = Assets::GetTileMap(_mapId);
 
-        _texture.clear(sf::Color::Magenta);
+        auto& texture = _textures[_memory->GetDrawSlot()];
+        if (texture == nullptr) {
+            texture = std::make_unique<sf::RenderTexture>();
+        }
+        auto size = sf::Vector2u(static_cast<unsigned>(map.Size.x), static_cast<unsigned>(map.Size.y));
+        if (texture->getSize() != size && !texture->resize(size)) {
+            _log->error("Failed to resize map render texture to {}x{}.", size.x, size.y);
+            return nullptr;
+        }
+
+        texture->clear(sf::Color::Magenta);
 
         auto terrain = map.TerrainLayer.GetDrawable();
-        if (terrain) { _texture.draw(*terrain); }
+        if (terrain) { texture->draw(*terrain); }
         auto features = map.FeaturesLayer.GetDrawable();
-        if (features) { _texture.draw(*features); }
+        if (features) { texture->draw(*features); }
 
-        _texture.display();
+        texture->display();
 
-        _sprite.setTexture(_texture.getTexture());
+        _sprite.setTexture(texture->getTexture());
         return &_sprite;
     }
 
@@ -36,6 +57,20 @@ namespace LowEngine::ECS {
     }
 
     std::vector<sf::Vector2f> TileMapComponent::FindPath(sf::Vector2f start, sf::Vector2f end, Terrain::Navigation::MovementType movementType) {
+        Terrain::Navigation::NavigationPath navPath;
+        if (!FindPath(start, end, movementType, navPath)) return {};
+
+        // return as vector of sf::Vector2f points
+        std::vector<sf::Vector2f> result;
+        result.reserve(navPath.GetSize());
+        for (size_t i = 0; i < navPath.GetSize(); i++) {
+            result.emplace_back(navPath.GetPoint(i));
+        }
+        return result;
+    }
+
+    bool TileMapComponent::FindPath(sf::Vector2f start, sf::Vector2f end, Terrain::Navigation::MovementType movementType, Terrain::Navigation::NavigationPath& path) {
+        path.Clear();
         auto& map = Assets::GetTileMap(_mapId);
 
         auto offset = _sprite.getPosition();
@@ -57,34 +92,29 @@ namespace LowEngine::ECS {
         if (startCell.x >= map.NavGrid.Width || startCell.y >= map.NavGrid.Height ||
             endCell.x >= map.NavGrid.Width || endCell.y >= map.NavGrid.Height) {
             _log->warn("Tile Map -> FindPath: Start or end position is out of bounds of the navigation grid.");
-            return {};
+            return false;
         }
 
-        auto navPath = map.NavGrid.FindPath(startCell, endCell, movementType);
-
-        // return as vector of sf::Vector2f points
-        if (!navPath.empty()) {
-            std::vector<sf::Vector2f> result;
-            for (auto& cell : navPath) {
-                sf::Vector2f point = {
-                    static_cast<float>(cell.Position.x) * cellSize + offset.x,
-                    static_cast<float>(cell.Position.y) * cellSize + offset.y
-                };
-                result.emplace_back(point);
-            }
-
-            return result;
-        }
+        // points are converted to world positions only when read from the path
+        path.Origin = offset;
+        path.CellSize = static_cast<float>(cellSize);
+        return map.NavGrid.FindPath(startCell, endCell, movementType, path);
+    }
 
-        return {};
+    void TileMapComponent::ToRecord(Record& record, Serialization::StringTable& strings) const {
+        record.MapId = _mapId;
+        record.Layer = Layer;
     }
 
-    void TileMapComponent::Resize(Terrain::TileMap& map) {
-        if (!_texture.resize({map.Size.x, map.Size.y})) {
-            _log->error("Failed to resize map render texture to {}x{}.", map.Size.x, map.Size.y);
+    void TileMapComponent::FromRecord(const Record& record, const Serialization::StringTable& strings) {
+        Layer = record.Layer;
+        _sprite.Layer = record.Layer;
+        if (record.MapId != static_cast<uint64_t>(-1)) {
+            SetMapId(record.MapId);
         }
-        _texture.clear();
+    }
 
+    void TileMapComponent::Resize(Terrain::TileMap& map) {
         _sprite.setTextureRect(sf::IntRect({0, 0}, {static_cast<int>(map.Size.x), static_cast<int>(map.Size.y)}));
     }
 }
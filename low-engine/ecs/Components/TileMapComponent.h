@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <memory>
+
 #include "ecs/IComponent.h"
 #include "TransformComponent.h"
+#include "graphics/RenderSnapshot.h"
 #include "graphics/Sprite.h"
 
 namespace LowEngine::ECS {
@@ -20,6 +24,16 @@ namespace LowEngine::ECS {
          */
         int Layer = 0;
 
+        /**
+         * @brief Serialized state of this Component.
+         *
+         * Map is stored by its Id and re-acquired from Assets on load.
+         */
+        struct Record {
+            uint64_t MapId = 0;
+            int32_t Layer = 0;
+        };
+
         explicit TileMapComponent(Memory::Memory* memory)
             : IComponent(memory), _sprite(Assets::GetDefaultTexture()) {
         }
@@ -31,7 +45,7 @@ namespace LowEngine::ECS {
             Resize(map);
         }
 
-        ~TileMapComponent() override = default;
+        ~TileMapComponent() override;
 
         void CloneInto(Memory::Memory* newMemory, void* rawStorage) const override {
             new(rawStorage) TileMapComponent(newMemory, this);
@@ -57,8 +71,26 @@ namespace LowEngine::ECS {
          */
         void SetMapId(size_t mapId);
 
+        [[nodiscard]] size_t GetMapId() const { return _mapId; }
+
         std::vector<sf::Vector2f> FindPath(sf::Vector2f start, sf::Vector2f end, Terrain::Navigation::MovementType movementType);
 
+        /**
+         * @brief Find a path between two positions, into a path reused between searches.
+         *
+         * Unlike the overload returning points, doesn't allocate once the path has grown to its usual length.
+         * @param start Start position in the world.
+         * @param end End position in the world.
+         * @param movementType Type of movement.
+         * @param path Receives the path. Its Origin and CellSize are set, so GetPoint() gives world positions.
+         * @return True if path was found.
+         */
+        bool FindPath(sf::Vector2f start, sf::Vector2f end, Terrain::Navigation::MovementType movementType, Terrain::Navigation::NavigationPath& path);
+
+        void ToRecord(Record& record, Serialization::StringTable& strings) const;
+
+        void FromRecord(const Record& record, const Serialization::StringTable& strings);
+
     protected:
         size_t _mapId = -1;
 
@@ -68,12 +100,16 @@ namespace LowEngine::ECS {
         Sprite _sprite;
 
         /**
-         * @brief Internal texture used as a source for _sprite.
+         * @brief Internal textures used as a source for _sprite, one per render snapshot slot.
+         *
+         * Render thread draws the texture of a published snapshot while the map is rendered for the next one, so every
+         * slot has its own. Created and sized on first Draw() for a slot. Kept on the heap - snapshots point to them,
+         * and Components move when their pool grows.
          */
-        sf::RenderTexture _texture;
+        std::array<std::unique_ptr<sf::RenderTexture>, RenderSnapshot::SLOT_COUNT> _textures;
 
         /**
-         * @brief Resize internal _texture and _sprite to match provided map asset.
+         * @brief Resize _sprite to match provided map asset. Textures are resized on their next Draw().
          * @param map Reference to map asset to mach size to
          */
         void Resize(Terrain::TileMap& map);
@@ -1 +1,15 @@
 #include "TransformComponent.h"
+
+namespace LowEngine::ECS {
+    void TransformComponent::ToRecord(Record& record, Serialization::StringTable& strings) const {
+        record.Position = Position;
+        record.Scale = Scale;
+        record.Rotation = Rotation.asDegrees();
+    }
+
+    void TransformComponent::FromRecord(const Record& record, const Serialization::StringTable& strings) {
+        Position = record.Position;
+        Scale = record.Scale;
+        Rotation = sf::degrees(record.Rotation);
+    }
+}
@@ -26,6 +26,15 @@ namespace LowEngine::ECS {
          */
         sf::Vector2f Scale = sf::Vector2f(1.0f, 1.0f);
 
+        /**
+         * @brief Serialized state of this Component.
+         */
+        struct Record {
+            sf::Vector2f Position;
+            sf::Vector2f Scale;
+            float Rotation = 0.0f;
+        };
+
         explicit TransformComponent(Memory::Memory* memory)
             : IComponent(memory) {
         }
@@ -40,6 +49,9 @@ namespace LowEngine::ECS {
             new(rawStorage) TransformComponent(newMemory, this);
         }
 
+        static constexpr bool HAS_UPDATE = false;
+        static constexpr bool HAS_DRAW = false;
+
         static const std::vector<std::type_index>& Dependencies() {
             static std::vector<std::type_index> dependencies = {};
             return dependencies;
@@ -48,7 +60,8 @@ namespace LowEngine::ECS {
         void Initialize() override {
         }
 
-        void Update(float deltaTime) override {
-        }
+        void ToRecord(Record& record, Serialization::StringTable& strings) const;
+
+        void FromRecord(const Record& record, const Serialization::StringTable& strings);
     };
 }
@@ -60,7 +60,7 @@ namespace LowEngine::ECS {
                 return nullptr;
             }
 
-            _log->debug("Component of type {} created for entity with id {}", DemangledTypeName(typeid(T)), Id);
+            LOW_LOG_DEBUG(Ecs, "Component of type {} created for entity with id {}", DemangledTypeName(typeid(T)), Id);
             return component;
         }
 
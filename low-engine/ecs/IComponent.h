@@ -52,6 +52,11 @@ namespace LowEngine::ECS {
 
         /**
          * @brief Update Component's state.
+         *
+         * Components with nothing to update should declare `static constexpr bool HAS_UPDATE = false;` - pools of
+         * such Components are not deserialized from lazily loaded saves just to run the Update. Without the
+         * declaration every Component is assumed to update. Derived Components inherit it, so redeclare it as true
+         * when adding an Update to such a Component.
          * @param deltaTime Time that is passed since last update, in seconds.
          */
         virtual void Update(float deltaTime) {
@@ -59,6 +64,9 @@ namespace LowEngine::ECS {
 
         /**
          * @brief Retrieve a pointer to Sprite that should be drawn in current frame.
+         *
+         * Components that never draw anything should declare `static constexpr bool HAS_DRAW = false;`, for the same
+         * reason and with the same rules as HAS_UPDATE.
          * @return Pointer to Sprite. Returns nullptr if there's nothing to be drawn.
          */
         virtual Sprite* Draw() {
@@ -0,0 +1,43 @@
+#include "RenderSnapshot.h"
+
+#include "profiling/Profiler.h"
+
+namespace LowEngine {
+    void RenderSnapshot::Clear() {
+        Sprites.clear();
+        TextureSwitches = 0;
+        BatchSprites = false;
+        HasView = false;
+        Alpha = 1.0f;
+        StepSeconds = 0.0f;
+    }
+
+    size_t RenderSnapshot::Draw(sf::RenderTarget& target, float alpha, SpriteBatcher* batcher) const {
+        LOW_PROFILE_ZONE("RenderSnapshot::Draw");
+
+        if (HasView) {
+            if (alpha < 1.0f) {
+                sf::View view = View;
+                view.setCenter(PreviousViewCenter + (View.getCenter() - PreviousViewCenter) * alpha);
+                target.setView(view);
+            } else {
+                target.setView(View);
+            }
+        }
+
+        if (BatchSprites && batcher != nullptr) {
+            return batcher->Draw(target, Sprites, alpha);
+        }
+
+        for (auto& sprite: Sprites) {
+            if (alpha < 1.0f && sprite.HasPreviousPosition) {
+                sf::RenderStates states;
+                states.transform.translate(sprite.GetInterpolationOffset(alpha));
+                target.draw(sprite, states);
+            } else {
+                target.draw(sprite);
+            }
+        }
+        return Sprites.size();
+    }
+}
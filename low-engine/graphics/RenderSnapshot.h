@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SFML/Graphics/RenderTarget.hpp"
+#include "SFML/Graphics/View.hpp"
+#include "SFML/System/Clock.hpp"
+
+#include "graphics/Sprite.h"
+#include "graphics/SpriteBatcher.h"
+
+namespace LowEngine {
+    /**
+     * @brief Immutable description of a single frame, published by simulation and consumed by rendering.
+     *
+     * Contains copies of Sprites (texture handles, transforms and layers), already sorted, and camera's view.
+     * Nothing in the snapshot points to Components, so it can be drawn while simulation keeps running.
+     */
+    struct RenderSnapshot {
+        /**
+         * @brief Number of snapshots that can be in use at the same time, one per buffer of the render thread.
+         */
+        static constexpr size_t SLOT_COUNT = 3;
+
+        /**
+         * @brief Sprites to draw, in drawing order.
+         */
+        std::vector<Sprite> Sprites;
+
+        /**
+         * @brief Number of times a Sprite uses different texture than the Sprite drawn before it.
+         *
+         * Every switch breaks batching of draw calls. Packing textures into an atlas lowers it.
+         */
+        size_t TextureSwitches = 0;
+
+        /**
+         * @brief Should Sprites be drawn through a Sprite Batcher, if one is provided to Draw()?
+         */
+        bool BatchSprites = false;
+
+        /**
+         * @brief Does the snapshot define a View? If not, target's current View is used.
+         */
+        bool HasView = false;
+
+        /**
+         * @brief Camera's View in current simulation step.
+         */
+        sf::View View;
+
+        /**
+         * @brief Camera's center in previous simulation step.
+         */
+        sf::Vector2f PreviousViewCenter;
+
+        /**
+         * @brief Interpolation factor at the moment of publishing.
+         */
+        float Alpha = 1.0f;
+
+        /**
+         * @brief Duration of a simulation step, in seconds. 0 if simulation doesn't run at fixed timestep.
+         */
+        float StepSeconds = 0.0f;
+
+        /**
+         * @brief Number of the simulation frame that produced this snapshot.
+         */
+        uint64_t FrameIndex = 0;
+
+        /**
+         * @brief Time of publishing, measured by the clock shared with the consumer.
+         */
+        sf::Time PublishTime;
+
+        /**
+         * @brief Buffer the snapshot is stored in, below SLOT_COUNT.
+         *
+         * Textures rendered by Components, i.e. Tile Maps, are kept per slot - so the texture drawn by render thread
+         * is never the one being rendered for the next snapshot. Not changed by Clear().
+         */
+        size_t Slot = 0;
+
+        /**
+         * @brief Remove all content, keeping allocated memory.
+         */
+        void Clear();
+
+        /**
+         * @brief Draw the snapshot.
+         *
+         * Snapshot is not modified - interpolation is applied through render states, or by the batcher.
+         * @param target Window or off-screen texture to draw on.
+         * @param alpha Interpolation factor between previous and current simulation step.
+         * @param batcher Batcher used if BatchSprites is set. Nullptr draws every Sprite separately.
+         * @return Number of draw calls issued for Sprites.
+         */
+        size_t Draw(sf::RenderTarget& target, float alpha = 1.0f, SpriteBatcher* batcher = nullptr) const;
+    };
+}
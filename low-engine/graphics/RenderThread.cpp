@@ -0,0 +1,164 @@
+#include "RenderThread.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Log.h"
+#include "profiling/Profiler.h"
+
+namespace LowEngine {
+    RenderThread::~RenderThread() {
+        Stop();
+    }
+
+    bool RenderThread::Start(sf::RenderWindow& window) {
+        if (_running) {
+            _log->warn("Render thread is already running");
+            return false;
+        }
+
+        // context can be active only in one thread at a time
+        if (!window.setActive(false)) {
+            _log->error("Render thread: failed to release window's context");
+            return false;
+        }
+
+        _window = &window;
+        _firstFrame = _frameIndex;
+        _drawnFrame = _frameIndex;
+        {
+            std::lock_guard lock(_statsMutex);
+            _stats = RenderThreadStats();
+            _frameTimeCount = 0;
+        }
+
+        _running = true;
+        _thread = std::thread(&RenderThread::RenderLoop, this);
+
+        _log->info("Render thread started");
+        return true;
+    }
+
+    void RenderThread::Stop() {
+        if (!_thread.joinable()) return;
+
+        _running = false;
+        _thread.join();
+
+        if (!_window->setActive(true)) {
+            _log->error("Render thread: failed to re-acquire window's context");
+        }
+        _window = nullptr;
+
+        _log->info("Render thread stopped");
+    }
+
+    RenderSnapshot& RenderThread::BeginSnapshot() {
+        auto& snapshot = _snapshots.GetWriteBuffer();
+        snapshot.Clear();
+        snapshot.Slot = _snapshots.GetWriteIndex();
+        return snapshot;
+    }
+
+    void RenderThread::PublishSnapshot() {
+        auto& snapshot = _snapshots.GetWriteBuffer();
+        snapshot.FrameIndex = _frameIndex++;
+        snapshot.PublishTime = _clock.getElapsedTime();
+
+        bool dropped = _snapshots.Publish();
+
+        std::lock_guard lock(_statsMutex);
+        _stats.SnapshotsPublished++;
+        if (dropped) _stats.SnapshotsDropped++;
+    }
+
+    RenderThreadStats RenderThread::GetStats() const {
+        std::lock_guard lock(_statsMutex);
+        return _stats;
+    }
+
+    uint64_t RenderThread::GetRetiredFrameIndex() const {
+        if (!_running) return _frameIndex;
+        return _drawnFrame.load(std::memory_order_acquire);
+    }
+
+    void RenderThread::RenderLoop() {
+        if (!_window->setActive(true)) {
+            _log->error("Render thread: failed to activate window's context");
+            _running = false;
+            return;
+        }
+
+        Profiling::Profiler::SetThreadName("Render");
+
+        bool hasSnapshot = false;
+        sf::Time lastFrameTime = _clock.getElapsedTime();
+        while (_running) {
+            LOW_PROFILE_ZONE("RenderThread::Frame");
+
+            // snapshot left over from before Start() may refer to textures released in the meantime
+            bool isNew = _snapshots.Acquire() && _snapshots.GetReadBuffer().FrameIndex >= _firstFrame;
+            hasSnapshot = hasSnapshot || isNew;
+            const RenderSnapshot& snapshot = _snapshots.GetReadBuffer();
+            if (isNew) {
+                // previous snapshot is fully drawn - nothing older is read anymore
+                _drawnFrame.store(snapshot.FrameIndex, std::memory_order_release);
+            }
+
+            sf::Time now = _clock.getElapsedTime();
+            float alpha = snapshot.Alpha;
+            if (snapshot.StepSeconds > 0.0f) {
+                // keep blending towards current state while waiting for next snapshot
+                alpha = std::min(1.0f, snapshot.Alpha + (now - snapshot.PublishTime).asSeconds() / snapshot.StepSeconds);
+            }
+
+            _window->clear();
+            if (hasSnapshot) {
+                snapshot.Draw(*_window, alpha, &_batcher);
+            }
+            _window->display();
+
+            sf::Time presented = _clock.getElapsedTime();
+            RecordFrame((presented - lastFrameTime).asSeconds() * 1000.0f,
+                        hasSnapshot ? (presented - snapshot.PublishTime).asSeconds() * 1000.0f : 0.0f,
+                        hasSnapshot && !isNew);
+            lastFrameTime = presented;
+        }
+
+        if (!_window->setActive(false)) {
+            _log->error("Render thread: failed to release window's context");
+        }
+    }
+
+    void RenderThread::RecordFrame(float frameMs, float latencyMs, bool repeated) {
+        std::lock_guard lock(_statsMutex);
+
+        _frameTimes[_stats.FramesRendered % STATS_WINDOW] = frameMs;
+        _frameTimeCount = std::min(_frameTimeCount + 1, STATS_WINDOW);
+
+        _stats.FramesRendered++;
+        if (repeated) _stats.FramesRepeated++;
+        _stats.LastFrameMs = frameMs;
+        _stats.SnapshotLatencyMs = latencyMs;
+
+        float sum = 0.0f;
+        float min = _frameTimes[0];
+        float max = _frameTimes[0];
+        for (size_t i = 0; i < _frameTimeCount; i++) {
+            sum += _frameTimes[i];
+            min = std::min(min, _frameTimes[i]);
+            max = std::max(max, _frameTimes[i]);
+        }
+        float average = sum / static_cast<float>(_frameTimeCount);
+
+        float variance = 0.0f;
+        for (size_t i = 0; i < _frameTimeCount; i++) {
+            variance += (_frameTimes[i] - average) * (_frameTimes[i] - average);
+        }
+
+        _stats.AverageFrameMs = average;
+        _stats.MinFrameMs = min;
+        _stats.MaxFrameMs = max;
+        _stats.FrameJitterMs = std::sqrt(variance / static_cast<float>(_frameTimeCount));
+    }
+}
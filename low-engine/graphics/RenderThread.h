@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "SFML/Graphics/RenderWindow.hpp"
+#include "SFML/System/Clock.hpp"
+
+#include "graphics/RenderSnapshot.h"
+#include "threading/TripleBuffer.h"
+
+namespace LowEngine {
+    /**
+     * @brief Frame pacing statistics of the render thread.
+     *
+     * Frame times are calculated over the last RenderThread::STATS_WINDOW frames.
+     */
+    struct RenderThreadStats {
+        /**
+         * @brief Number of frames presented since the thread was started.
+         */
+        uint64_t FramesRendered = 0;
+        /**
+         * @brief Number of snapshots published by simulation.
+         */
+        uint64_t SnapshotsPublished = 0;
+        /**
+         * @brief Number of snapshots overwritten before render thread picked them up.
+         */
+        uint64_t SnapshotsDropped = 0;
+        /**
+         * @brief Number of frames that re-used previous snapshot, because simulation didn't publish a new one in time.
+         */
+        uint64_t FramesRepeated = 0;
+        float LastFrameMs = 0.0f;
+        float AverageFrameMs = 0.0f;
+        float MinFrameMs = 0.0f;
+        float MaxFrameMs = 0.0f;
+        /**
+         * @brief Standard deviation of frame time, in milliseconds. Low value means smooth pacing.
+         */
+        float FrameJitterMs = 0.0f;
+        /**
+         * @brief Time between publishing of the last drawn snapshot and presenting it, in milliseconds.
+         */
+        float SnapshotLatencyMs = 0.0f;
+    };
+
+    /**
+     * @brief Draws render snapshots on a dedicated thread.
+     *
+     * Simulation fills the buffer returned by BeginSnapshot() and calls PublishSnapshot() at the end of a frame.
+     * Render thread draws the latest published snapshot and presents the window. Snapshots are triple-buffered,
+     * so neither side ever waits for the other - render thread re-draws last snapshot if there's no new one.
+     *
+     * Window's OpenGL context is owned by render thread while it runs. Window events must still be polled
+     * on the thread that created the window.
+     */
+    class RenderThread {
+    public:
+        /**
+         * @brief Number of frames used to calculate frame pacing statistics.
+         */
+        static constexpr size_t STATS_WINDOW = 120;
+
+        RenderThread() = default;
+
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        /**
+         * @brief Start drawing on a dedicated thread.
+         * @param window Window to draw on. Must stay alive until Stop().
+         * @return True if successful. False if thread was already running or window's context could not be released.
+         */
+        bool Start(sf::RenderWindow& window);
+
+        /**
+         * @brief Stop the thread and give window's context back to the calling thread.
+         */
+        void Stop();
+
+        /**
+         * @brief Is render thread running?
+         */
+        [[nodiscard]] bool IsRunning() const { return _running; }
+
+        /**
+         * @brief Snapshot that simulation should fill for current frame.
+         */
+        RenderSnapshot& BeginSnapshot();
+
+        /**
+         * @brief Hand filled snapshot over to render thread.
+         */
+        void PublishSnapshot();
+
+        /**
+         * @brief Retrieve frame pacing statistics.
+         */
+        [[nodiscard]] RenderThreadStats GetStats() const;
+
+        /**
+         * @brief Index of the snapshot that will be published next.
+         */
+        [[nodiscard]] uint64_t GetNextFrameIndex() const { return _frameIndex; }
+
+        /**
+         * @brief Snapshots with lower index are never drawn again - textures they refer to can be released.
+         *
+         * Equals GetNextFrameIndex() while the thread is not running.
+         */
+        [[nodiscard]] uint64_t GetRetiredFrameIndex() const;
+
+    protected:
+        std::thread _thread;
+        std::atomic<bool> _running = false;
+        sf::RenderWindow* _window = nullptr;
+
+        Threading::TripleBuffer<RenderSnapshot> _snapshots;
+        static_assert(RenderSnapshot::SLOT_COUNT == Threading::TripleBuffer<RenderSnapshot>::BUFFER_COUNT);
+
+        /**
+         * @brief Index of the snapshot drawn by render thread. Snapshots published before Start() are never drawn.
+         */
+        std::atomic<uint64_t> _drawnFrame = 0;
+        uint64_t _firstFrame = 0;
+        SpriteBatcher _batcher;
+        sf::Clock _clock;
+        uint64_t _frameIndex = 0;
+
+        mutable std::mutex _statsMutex;
+        RenderThreadStats _stats;
+        std::array<float, STATS_WINDOW> _frameTimes{};
+        size_t _frameTimeCount = 0;
+
+        void RenderLoop();
+
+        void RecordFrame(float frameMs, float latencyMs, bool repeated);
+    };
+}
@@ -13,6 +13,18 @@ namespace LowEngine {
          */
         int Layer = 0;
 
+        /**
+         * @brief Position from before the last simulation step.
+         *
+         * Used to interpolate Sprite's position when simulation runs at fixed timestep.
+         */
+        sf::Vector2f PreviousPosition;
+
+        /**
+         * @brief Was PreviousPosition set by at least one simulation step?
+         */
+        bool HasPreviousPosition = false;
+
         explicit Sprite(const sf::Texture& texture)
             : sf::Sprite(texture) {
         }
@@ -28,5 +40,25 @@ namespace LowEngine {
         Sprite(const sf::Texture&& texture, const sf::IntRect& rectangle)
             : sf::Sprite(texture, rectangle) {
         }
+
+        /**
+         * @brief Move Sprite to position calculated by simulation step, keeping current one as PreviousPosition.
+         * @param position New position.
+         */
+        void MoveTo(sf::Vector2f position) {
+            PreviousPosition = HasPreviousPosition ? getPosition() : position;
+            HasPreviousPosition = true;
+            setPosition(position);
+        }
+
+        /**
+         * @brief Offset that moves Sprite from current position to position blended with PreviousPosition.
+         * @param alpha Blend factor. 0 is previous position, 1 is current position.
+         * @return Offset to apply when drawing. Zero if there's no previous position.
+         */
+        [[nodiscard]] sf::Vector2f GetInterpolationOffset(float alpha) const {
+            if (!HasPreviousPosition) return {0.0f, 0.0f};
+            return (PreviousPosition - getPosition()) * (1.0f - alpha);
+        }
     };
 }
@@ -0,0 +1,66 @@
+#include "SpriteBatcher.h"
+
+#include <cmath>
+
+namespace LowEngine {
+    size_t SpriteBatcher::Draw(sf::RenderTarget& target, const std::vector<Sprite>& sprites, float alpha) {
+        size_t drawCalls = 0;
+
+        size_t begin = 0;
+        while (begin < sprites.size()) {
+            const sf::Texture* texture = &sprites[begin].getTexture();
+            size_t end = begin + 1;
+            while (end < sprites.size() && &sprites[end].getTexture() == texture) {
+                end++;
+            }
+
+            auto& vertices = BuildVertices(sprites, begin, end, alpha);
+            target.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates(texture));
+            drawCalls++;
+
+            begin = end;
+        }
+
+        return drawCalls;
+    }
+
+    const std::vector<sf::Vertex>& SpriteBatcher::BuildVertices(const std::vector<Sprite>& sprites, size_t begin, size_t end, float alpha) {
+        _vertices.resize((end - begin) * 6);
+
+        sf::Vertex* vertex = _vertices.data();
+        for (size_t i = begin; i < end; i++) {
+            auto& sprite = sprites[i];
+            auto& rect = sprite.getTextureRect();
+            sf::Color color = sprite.getColor();
+
+            // same corners as sf::Sprite - negative rect size flips texture, not geometry
+            float width = std::abs(static_cast<float>(rect.size.x));
+            float height = std::abs(static_cast<float>(rect.size.y));
+            float left = static_cast<float>(rect.position.x);
+            float top = static_cast<float>(rect.position.y);
+            float right = left + static_cast<float>(rect.size.x);
+            float bottom = top + static_cast<float>(rect.size.y);
+
+            // 2D part of the 4x4 matrix - corners are transformed here instead of by the GPU, per draw call
+            const float* matrix = sprite.getTransform().getMatrix();
+            sf::Vector2f offset = alpha < 1.0f ? sprite.GetInterpolationOffset(alpha) : sf::Vector2f();
+            float a = matrix[0], b = matrix[4], c = matrix[1], d = matrix[5];
+            float tx = matrix[12] + offset.x, ty = matrix[13] + offset.y;
+
+            sf::Vector2f topLeft(tx, ty);
+            sf::Vector2f bottomLeft(b * height + tx, d * height + ty);
+            sf::Vector2f topRight(a * width + tx, c * width + ty);
+            sf::Vector2f bottomRight(a * width + b * height + tx, c * width + d * height + ty);
+
+            vertex[0] = {topLeft, color, {left, top}};
+            vertex[1] = {bottomLeft, color, {left, bottom}};
+            vertex[2] = {topRight, color, {right, top}};
+            vertex[3] = vertex[2];
+            vertex[4] = vertex[1];
+            vertex[5] = {bottomRight, color, {right, bottom}};
+            vertex += 6;
+        }
+
+        return _vertices;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include "SFML/Graphics/RenderTarget.hpp"
+#include "SFML/Graphics/Vertex.hpp"
+
+#include "graphics/Sprite.h"
+
+namespace LowEngine {
+    /**
+     * @brief Draws Sprites in as few draw calls as possible.
+     *
+     * Consecutive Sprites that use the same texture are merged into a single array of triangles, with corners
+     * transformed on the CPU, and drawn with one call. Drawing order is kept, so sorting still applies -
+     * the fewer texture switches in the sorted list (see Scene::GetTextureSwitchCount()), the fewer draw calls.
+     *
+     * Vertex memory is reused between frames. Not thread-safe - each rendering thread needs its own batcher.
+     */
+    class SpriteBatcher {
+    public:
+        /**
+         * @brief Draw Sprites in provided order.
+         * @param target Window or off-screen texture to draw on.
+         * @param sprites Sprites to draw.
+         * @param alpha Interpolation factor between previous and current simulation step.
+         * @return Number of draw calls issued.
+         */
+        size_t Draw(sf::RenderTarget& target, const std::vector<Sprite>& sprites, float alpha = 1.0f);
+
+        /**
+         * @brief Fill vertices for a run of Sprites, without drawing them. Used by Draw() and benchmarks.
+         * @param sprites Sprites to draw.
+         * @param begin Index of the first Sprite of the run.
+         * @param end Index past the last Sprite of the run.
+         * @param alpha Interpolation factor between previous and current simulation step.
+         * @return Vertices of the run - 6 per Sprite. Valid until the next call.
+         */
+        const std::vector<sf::Vertex>& BuildVertices(const std::vector<Sprite>& sprites, size_t begin, size_t end, float alpha = 1.0f);
+
+    protected:
+        std::vector<sf::Vertex> _vertices;
+    };
+}
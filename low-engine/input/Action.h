@@ -60,14 +60,15 @@ namespace LowEngine::Input {
         /**
          * @brief Action just started.
          *
-         * This is true only on Update during which key was pressed.
+         * Set when key is pressed and kept until a simulation step sees it - in Fixed timestep mode a press during a
+         * frame without steps isn't lost, and a frame with several steps shows it only to the first one.
          */
         bool Started = false;
 
         /**
          * @brief Action just ended.
          *
-         * This is true only on Update during which key was released.
+         * Set when key is released and kept until a simulation step sees it, same as Started.
          */
         bool Ended = false;
 
@@ -1,11 +1,17 @@
 #include "InputManager.h"
 
+#include "Log.h"
+
 namespace LowEngine::Input {
     sf::Vector2i InputManager::GetMousePosition() {
         return _currentMousePosition;
     }
 
     const Action* InputManager::GetAction(const std::string& actionName) const {
+        return GetAction(StringId(actionName));
+    }
+
+    const Action* InputManager::GetAction(StringId actionName) const {
         auto action = _actions.find(actionName);
         if (action != _actions.end()) {
             return &(action->second);
@@ -17,7 +23,22 @@ namespace LowEngine::Input {
     void InputManager::ClearActionState() {
         _inputChanged = false;
 
-        // reset state of actions that started/ended in previous update
+        // edges raised in a frame without simulation steps are kept for the next step
+        if (_edgesSeen) {
+            ClearEdges();
+            _edgesSeen = false;
+        }
+    }
+
+    void InputManager::BeginStep() {
+        // every edge is shown to a single step, even if frame runs several
+        if (_edgesSeen) {
+            ClearEdges();
+        }
+        _edgesSeen = true;
+    }
+
+    void InputManager::ClearEdges() {
         for (auto& action: _actions) {
             action.second.Started = false;
             action.second.Ended = false;
@@ -103,11 +124,13 @@ namespace LowEngine::Input {
                         if (!action.second.IsKeyPressed(_currentKeys) || action.second != _currentModifiers) {
                             action.second.Active = false;
                             action.second.Ended = true;
+                            LOW_LOG_TRACE(Input, "Action '{}' ended", action.first.GetString());
                         }
                     } else {
                         if (action.second.IsKeyPressed(_currentKeys) && action.second == _currentModifiers) {
                             action.second.Active = true;
                             action.second.Started = true;
+                            LOW_LOG_TRACE(Input, "Action '{}' started", action.first.GetString());
                         }
                     }
                 }
@@ -117,12 +140,14 @@ namespace LowEngine::Input {
                             _currentModifiers) {
                             action.second.Active = false;
                             action.second.Ended = true;
+                            LOW_LOG_TRACE(Input, "Action '{}' ended", action.first.GetString());
                         }
                     } else {
                         if (action.second.IsMouseButtonPressed(_currentMouseButtons) && action.second ==
                             _currentModifiers) {
                             action.second.Active = true;
                             action.second.Started = true;
+                            LOW_LOG_TRACE(Input, "Action '{}' started", action.first.GetString());
                         }
                     }
                 }
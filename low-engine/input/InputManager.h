@@ -7,6 +7,7 @@
 #include <optional>
 
 #include "Action.h"
+#include "StringId.h"
 #include "SFML/Window/Event.hpp"
 
 namespace LowEngine::Input {
@@ -153,7 +154,7 @@ namespace LowEngine::Input {
             newAction.Key = key;
             ApplyKeyboardModifiers(newAction, {modifiers...});
 
-            _actions[actionName] = std::move(newAction);
+            _actions[StringId::Intern(actionName)] = std::move(newAction);
         };
 
         /**
@@ -175,7 +176,7 @@ namespace LowEngine::Input {
             newAction.MouseButton = mouseButton;
             ApplyKeyboardModifiers(newAction, {modifiers...});
 
-            _actions[actionName] = std::move(newAction);
+            _actions[StringId::Intern(actionName)] = std::move(newAction);
         };
 
         /**
@@ -196,10 +197,26 @@ namespace LowEngine::Input {
         const Action* GetAction(const std::string& actionName) const;
 
         /**
-         * @brief INTERNAL: Clear current state for all Actions.
+         * @brief Retrieve defined Action by id of its name. Preferred in code that runs every frame.
+         * @param actionName Id of Action's name, i.e. `"Jump"_sid`.
+         * @return Action with provided name. Returns nullptr if Action with name doesn't exist.
+         */
+        const Action* GetAction(StringId actionName) const;
+
+        /**
+         * @brief INTERNAL: Start reading input of a new frame.
+         *
+         * Started/Ended flags are cleared only if a simulation step has already seen them.
          */
         void ClearActionState();
 
+        /**
+         * @brief INTERNAL: Called before every simulation step.
+         *
+         * Clears Started/Ended flags already seen by the previous step, and marks current ones as seen by this one.
+         */
+        void BeginStep();
+
         /**
          * @brief INTERNAL: Read input event from SFML.
          * @param event Current event.
@@ -210,7 +227,8 @@ namespace LowEngine::Input {
 
     protected:
         bool _inputChanged = false;
-        std::unordered_map<std::string, Action> _actions;
+        bool _edgesSeen = false;
+        std::unordered_map<StringId, Action> _actions;
 
         std::vector<sf::Keyboard::Key> _currentKeys;
         std::vector<sf::Mouse::Button> _currentMouseButtons;
@@ -223,5 +241,10 @@ namespace LowEngine::Input {
          * @param modifierKeys Modifiers to apply.
          */
         void ApplyKeyboardModifiers(Action& action, const std::vector<sf::Keyboard::Key>& modifierKeys);
+
+        /**
+         * @brief Reset Started/Ended flags of all Actions.
+         */
+        void ClearEdges();
     };
 }
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <span>
 #include <vector>
 #include <unordered_map>
 
 #include "Config.h"
 #include "Log.h"
 #include "graphics/Sprite.h"
+#include "serialization/BinaryReader.h"
+#include "serialization/BinaryWriter.h"
+#include "serialization/SaveFormat.h"
 
 namespace LowEngine::Memory {
     class Memory;
@@ -15,6 +20,18 @@ namespace LowEngine::Memory {
      */
     class IComponentPool {
     public:
+        /**
+         * @brief Runtime counters of the pool, reported by Memory::GetPoolStatistics().
+         */
+        struct PoolCounters {
+            uint64_t Lookups = 0;
+            size_t Reallocations = 0;
+            float UpdateMs = 0.0f;
+            float CollectMs = 0.0f;
+        };
+
+        PoolCounters Counters;
+
         virtual ~IComponentPool() = default;
 
         /**
@@ -44,6 +61,44 @@ namespace LowEngine::Memory {
          * @param[out] sprites Reference to collection that will be filled with Sprites that needs to be drawn.
          */
         virtual void CollectSprites(std::vector<Sprite>& sprites) = 0;
+
+        /**
+         * @brief Number of Components currently stored in the pool.
+         */
+        [[nodiscard]] virtual size_t Count() const = 0;
+
+        /**
+         * @brief Number of Components the pool can hold before reallocating.
+         */
+        [[nodiscard]] virtual size_t Capacity() const = 0;
+
+        /**
+         * @brief Memory taken by Components and index maps, in bytes. Size of maps is estimated.
+         */
+        [[nodiscard]] virtual size_t MemoryUsage() const = 0;
+
+        /**
+         * @brief Size of single serialized Component, in bytes.
+         * @return Size of Component's Record. Returns 0 if Component can't be serialized.
+         */
+        [[nodiscard]] virtual uint32_t RecordSize() const = 0;
+
+        /**
+         * @brief Write all Components to binary save.
+         * @param writer Writer that will receive the data.
+         */
+        virtual void Save(Serialization::BinaryWriter& writer) const = 0;
+
+        /**
+         * @brief Recreate Components from binary save.
+         *
+         * Pool must be empty. Storage is reserved up-front for all Components in the save.
+         * @param memory Pointer to Memory manager that owns this Component Pool.
+         * @param entityCount Number of Entities in Memory. Components of Entities outside of it make the data invalid.
+         * @param reader Reader limited to the pool's block.
+         * @return True if successful. False if data was invalid.
+         */
+        virtual bool Load(Memory* memory, size_t entityCount, Serialization::BinaryReader& reader) = 0;
     };
 
 
@@ -112,7 +167,8 @@ namespace LowEngine::Memory {
             size_t index = Storage.size();
             if (index >= Storage.capacity()) {
                 Storage.reserve(Storage.capacity() * 2);
-                _log->debug("Component pool: Reallocating memory for component type {}. Current size: {}", typeid(T).name(), Storage.capacity());
+                Counters.Reallocations++;
+                LOW_LOG_DEBUG(Ecs, "Component pool: Reallocating memory for component type {}. Current size: {}", typeid(T).name(), Storage.capacity());
             }
 
             // placement-new to initialize memory
@@ -216,6 +272,200 @@ namespace LowEngine::Memory {
             }
         }
 
+        [[nodiscard]] size_t Count() const override {
+            return Storage.size();
+        }
+
+        [[nodiscard]] size_t Capacity() const override {
+            return Storage.capacity();
+        }
+
+        [[nodiscard]] size_t MemoryUsage() const override {
+            return Storage.capacity() * sizeof(T) + MapMemoryUsage(IndexMap) + MapMemoryUsage(ReverseMap);
+        }
+
+        [[nodiscard]] uint32_t RecordSize() const override {
+            if constexpr (Serialization::SerializableComponent<T>) {
+                return sizeof(typename T::Record);
+            } else {
+                return 0;
+            }
+        }
+
+        /**
+         * @brief Write all Components to binary save.
+         *
+         * Layout: count, block of Entity Ids, block of Active flags, block of Records and string table.
+         * Each block is aligned to Serialization::SAVE_BLOCK_ALIGNMENT.
+         * @param writer Writer that will receive the data.
+         */
+        void Save(Serialization::BinaryWriter& writer) const override {
+            if constexpr (Serialization::SerializableComponent<T>) {
+                using Record = typename T::Record;
+
+                // blocks are filled in place - every pass goes through Storage once, without temporary arrays
+                size_t count = Storage.size();
+                writer.Write(static_cast<uint64_t>(count));
+                writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+                auto entityIds = writer.AppendArray<uint64_t>(count);
+                for (size_t i = 0; i < count; i++) {
+                    entityIds[i] = reinterpret_cast<const T*>(&Storage[i])->EntityId;
+                }
+
+                writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+                auto active = writer.AppendArray<uint8_t>(count);
+                for (size_t i = 0; i < count; i++) {
+                    active[i] = reinterpret_cast<const T*>(&Storage[i])->Active ? 1 : 0;
+                }
+
+                writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+                auto records = writer.AppendArray<Record>(count);
+                Serialization::StringTable strings;
+                for (size_t i = 0; i < count; i++) {
+                    auto record = new(&records[i]) Record();
+                    reinterpret_cast<const T*>(&Storage[i])->ToRecord(*record, strings);
+                }
+
+                writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+                writer.WriteString(strings.Data());
+            } else {
+                _log->warn("Component pool: Component {} does not define a Record and will not be saved.", DemangledTypeName(typeid(T)));
+                writer.Write(static_cast<uint64_t>(0));
+            }
+        }
+
+        /**
+         * @brief Recreate Components from binary save.
+         *
+         * Pool must be empty. Storage is reserved up-front for all Components in the save.
+         * Every Entity Id must be below entityCount and appear only once - otherwise the data is invalid.
+         * @param memory Pointer to Memory manager that owns this Component Pool.
+         * @param entityCount Number of Entities in Memory.
+         * @param reader Reader limited to the pool's block.
+         * @return True if successful. False if data was invalid.
+         */
+        bool Load(Memory* memory, size_t entityCount, Serialization::BinaryReader& reader) override {
+            if constexpr (Serialization::SerializableComponent<T>) {
+                if (!Storage.empty()) {
+                    _log->error("Component pool: Can't load {} into non-empty pool.", DemangledTypeName(typeid(T)));
+                    return false;
+                }
+
+                SavedView saved;
+                if (!View(reader, saved)) {
+                    return false;
+                }
+
+                size_t count = saved.Records.size();
+                Storage.reserve(std::max<size_t>(count, Storage.capacity()));
+                IndexMap.reserve(count);
+                ReverseMap.reserve(count);
+
+                for (size_t index = 0; index < count; index++) {
+                    uint64_t entityId = saved.EntityIds[index];
+                    if (entityId >= entityCount) {
+                        _log->error("Component pool: Save data for {} is corrupted: entity id {} is out of range ({} entities).",
+                                    DemangledTypeName(typeid(T)), entityId, entityCount);
+                        return false;
+                    }
+                    if (IndexMap.contains(entityId)) {
+                        _log->error("Component pool: Save data for {} is corrupted: entity id {} has more than one component.",
+                                    DemangledTypeName(typeid(T)), entityId);
+                        return false;
+                    }
+
+                    Storage.emplace_back();
+                    T* component = new(&Storage.back()) T(memory);
+
+                    component->EntityId = entityId;
+                    component->Active = saved.Active[index] != 0;
+                    component->FromRecord(saved.Records[index], saved.Strings);
+
+                    IndexMap[component->EntityId] = index;
+                    ReverseMap[index] = component->EntityId;
+                }
+
+                return true;
+            } else {
+                return reader.Read<uint64_t>() == 0;
+            }
+        }
+
+        /**
+         * @brief Saved Components of this type, viewed in-place without deserializing them.
+         */
+        struct SavedView {
+            std::span<const uint64_t> EntityIds;
+            std::span<const uint8_t> Active;
+            std::span<const typename T::Record> Records;
+            Serialization::StringTable Strings;
+        };
+
+        /**
+         * @brief Parse pool's block of binary save without copying any data.
+         *
+         * Views stay valid as long as underlying data (i.e. memory-mapped file) is alive.
+         * @param reader Reader limited to the pool's block.
+         * @param[out] saved View that will be filled with pool's content.
+         * @return True if successful. False if data was invalid.
+         */
+        static bool View(Serialization::BinaryReader& reader, SavedView& saved) requires Serialization::SerializableComponent<T> {
+            auto count = reader.Read<uint64_t>();
+            reader.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+            saved.EntityIds = reader.View<uint64_t>(count);
+            reader.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+            saved.Active = reader.View<uint8_t>(count);
+            reader.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+            saved.Records = reader.View<typename T::Record>(count);
+            reader.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+            auto stringsLength = reader.Read<uint32_t>();
+            auto stringsData = reader.View<char>(stringsLength);
+            if (reader.Failed()) {
+                _log->error("Component pool: Save data for {} is corrupted.", DemangledTypeName(typeid(T)));
+                saved = {};
+                return false;
+            }
+
+            saved.Strings = Serialization::StringTable(std::string_view(stringsData.data(), stringsData.size()));
+            return true;
+        }
+
+        /**
+         * @brief Check pool's block of binary save without deserializing it.
+         *
+         * Applies the same rules as Load - every Entity Id must be below entityCount and appear only once.
+         * @param reader Reader limited to the pool's block.
+         * @param entityCount Number of Entities in Memory.
+         * @return True if Load would accept the data. False if data was invalid.
+         */
+        static bool Validate(Serialization::BinaryReader& reader, size_t entityCount) {
+            if constexpr (Serialization::SerializableComponent<T>) {
+                SavedView saved;
+                if (!View(reader, saved)) {
+                    return false;
+                }
+
+                std::vector<bool> seen(entityCount, false);
+                for (uint64_t entityId: saved.EntityIds) {
+                    if (entityId >= entityCount) {
+                        _log->error("Component pool: Save data for {} is corrupted: entity id {} is out of range ({} entities).",
+                                    DemangledTypeName(typeid(T)), entityId, entityCount);
+                        return false;
+                    }
+                    if (seen[entityId]) {
+                        _log->error("Component pool: Save data for {} is corrupted: entity id {} has more than one component.",
+                                    DemangledTypeName(typeid(T)), entityId);
+                        return false;
+                    }
+                    seen[entityId] = true;
+                }
+
+                return true;
+            } else {
+                return reader.Read<uint64_t>() == 0;
+            }
+        }
+
     protected:
         /**
          * @brief Collection of storage objects. Each object is a single component.
@@ -236,5 +486,13 @@ namespace LowEngine::Memory {
          * Value Entity Id
          */
         std::unordered_map<size_t, size_t> ReverseMap;
+
+        /**
+         * @brief Estimate memory of a map - bucket array plus a node per element (value, next pointer, cached hash).
+         */
+        static size_t MapMemoryUsage(const std::unordered_map<size_t, size_t>& map) {
+            constexpr size_t nodeSize = sizeof(std::pair<const size_t, size_t>) + sizeof(void*) + sizeof(size_t);
+            return map.bucket_count() * sizeof(void*) + map.size() * nodeSize;
+        }
     };
 }
@@ -1,11 +1,19 @@
+#include <chrono>
+#include <cstring>
+
 #include "Memory.h"
 
+#include "ecs/ECSHeaders.h"
+#include "profiling/Profiler.h"
+
 namespace LowEngine::Memory {
     Memory::Memory() {
         // do nothing
     }
 
-    Memory::Memory(Memory const& other) : _typeInfos(other._typeInfos) {
+    Memory::Memory(Memory const& other) : _typeInfos(other._typeInfos),
+                                          _pendingPools(other._pendingPools),
+                                          _mappedFile(other._mappedFile) {
         _nextTypeId = other._nextTypeId;
 
         // clone entities
@@ -23,14 +31,89 @@ namespace LowEngine::Memory {
     }
 
     void Memory::UpdateAllComponents(float deltaTime) {
-        for (auto& component: _components) {
-            component.second->Update(deltaTime);
+        LOW_PROFILE_ZONE("Memory::UpdateAllComponents");
+
+        if (!_pendingPools.empty()) {
+            std::vector<std::type_index> types;
+            for (auto& [typeIndex, pending]: _pendingPools) {
+                if (pending.Type->HasUpdate) types.push_back(typeIndex);
+            }
+            for (auto& typeIndex: types) {
+                MaterializePool(typeIndex);
+            }
+        }
+
+        // pools deserialized or created during the loop join in the next frame
+        CollectFramePools();
+        for (auto pool: _framePools) {
+            auto start = std::chrono::steady_clock::now();
+            pool->Update(deltaTime);
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            pool->Counters.UpdateMs += (elapsed.count() - pool->Counters.UpdateMs) * STATS_SMOOTHING;
         }
     }
 
-    void Memory::CollectSprites(std::vector<Sprite>& sprites) {
-        for (auto& [type, pool]: _components) {
+    void Memory::CollectSprites(std::vector<Sprite>& sprites, size_t slot) {
+        LOW_PROFILE_ZONE("Memory::CollectSprites");
+        _drawSlot = slot;
+
+        if (!_pendingPools.empty()) {
+            std::vector<std::type_index> types;
+            for (auto& [typeIndex, pending]: _pendingPools) {
+                if (pending.Type->HasDraw) types.push_back(typeIndex);
+            }
+            for (auto& typeIndex: types) {
+                MaterializePool(typeIndex);
+            }
+        }
+
+        CollectFramePools();
+        for (auto pool: _framePools) {
+            auto start = std::chrono::steady_clock::now();
             pool->CollectSprites(sprites);
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            pool->Counters.CollectMs += (elapsed.count() - pool->Counters.CollectMs) * STATS_SMOOTHING;
+        }
+    }
+
+    void Memory::CollectFramePools() {
+        _framePools.clear();
+        for (auto& [type, pool]: _components) {
+            _framePools.push_back(pool.get());
+        }
+    }
+
+    std::vector<PoolStatistics> Memory::GetPoolStatistics() const {
+        std::vector<PoolStatistics> statistics;
+        statistics.reserve(_typeInfos.size());
+
+        for (auto& [typeIndex, typeInfo]: _typeInfos) {
+            PoolStatistics& entry = statistics.emplace_back();
+            entry.Name = typeInfo.Name;
+            entry.TypeId = typeInfo.Id;
+            entry.ComponentSize = typeInfo.Size;
+
+            auto pool = _components.find(typeIndex);
+            if (pool == _components.end()) {
+                entry.Pending = _pendingPools.contains(typeIndex);
+                continue;
+            }
+
+            entry.Count = pool->second->Count();
+            entry.Capacity = pool->second->Capacity();
+            entry.Bytes = pool->second->MemoryUsage();
+            entry.Reallocations = pool->second->Counters.Reallocations;
+            entry.UpdateMs = pool->second->Counters.UpdateMs;
+            entry.CollectMs = pool->second->Counters.CollectMs;
+            entry.Lookups = pool->second->Counters.Lookups;
+        }
+
+        return statistics;
+    }
+
+    void Memory::ResetPoolStatistics() {
+        for (auto& [type, pool]: _components) {
+            pool->Counters = {};
         }
     }
 
@@ -40,5 +123,242 @@ namespace LowEngine::Memory {
             component.second.reset();
         }
         _components.clear();
+        _pendingPools.clear();
+        _mappedFile.reset();
+    }
+
+    void Memory::Save(Serialization::BinaryWriter& writer) const {
+        size_t start = writer.Position();
+
+        Serialization::MemoryHeader header;
+        header.EntityCount = _entities.size();
+        writer.Write(header); // patched when all offsets are known
+
+        // entity table
+        writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+        header.EntityTableOffset = writer.Position() - start;
+
+        auto entityRecords = writer.AppendArray<Serialization::EntityRecord>(_entities.size());
+        Serialization::StringTable names;
+        for (size_t i = 0; i < _entities.size(); i++) {
+            auto ref = names.Add(_entities[i]->Name);
+            entityRecords[i].Id = _entities[i]->Id;
+            entityRecords[i].NameOffset = ref.Offset;
+            entityRecords[i].NameLength = ref.Length;
+            entityRecords[i].Active = _entities[i]->Active ? 1 : 0;
+        }
+        writer.WriteString(names.Data());
+
+        // component pools
+        std::vector<std::pair<std::string, Serialization::PoolDirectoryEntry> > directory;
+        for (auto& [typeIndex, pool]: _components) {
+            if (pool->RecordSize() == 0) {
+                _log->warn("Component {} does not define a Record and will not be saved.", DemangledTypeName(typeIndex));
+                continue;
+            }
+
+            writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+
+            Serialization::PoolDirectoryEntry entry;
+            entry.Offset = writer.Position() - start;
+            entry.Count = pool->Count();
+            entry.RecordSize = pool->RecordSize();
+            pool->Save(writer);
+            entry.Size = writer.Position() - start - entry.Offset;
+
+            directory.emplace_back(_typeInfos.at(typeIndex).Name, entry);
+        }
+
+        // pools still stored in mapped file are already in save format
+        for (auto& [typeIndex, pending]: _pendingPools) {
+            writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+
+            Serialization::PoolDirectoryEntry entry;
+            entry.Offset = writer.Position() - start;
+            entry.Size = pending.Data.size();
+            entry.RecordSize = pending.Type->RecordSize;
+            Serialization::BinaryReader countReader(pending.Data);
+            entry.Count = countReader.Read<uint64_t>();
+            writer.WriteBlock(pending.Data.data(), pending.Data.size());
+
+            directory.emplace_back(pending.Name, entry);
+        }
+
+        // pool directory
+        writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+        header.PoolDirectoryOffset = writer.Position() - start;
+        header.PoolCount = directory.size();
+        for (auto& [name, entry]: directory) {
+            writer.WriteString(name);
+            writer.Write(entry);
+        }
+
+        header.TotalSize = writer.Position() - start;
+        writer.Patch(start, header);
+
+        LOW_LOG_DEBUG(Ecs, "Memory saved: {} entities, {} component pools, {} bytes", header.EntityCount, header.PoolCount, header.TotalSize);
+    }
+
+    bool Memory::Load(Serialization::BinaryReader& reader, std::shared_ptr<const Serialization::MappedFile> mappedFile) {
+        RegisterEngineComponentTypes();
+        Destroy();
+
+        size_t start = reader.Position();
+        auto header = reader.Read<Serialization::MemoryHeader>();
+        if (reader.Failed() || std::memcmp(header.Magic, Serialization::MemoryHeader().Magic, sizeof(header.Magic)) != 0) {
+            _log->error("Memory save data is corrupted");
+            return false;
+        }
+        if (header.Version != Serialization::SAVE_FORMAT_VERSION) {
+            _log->error("Memory save data has version {}, but version {} is required", header.Version, Serialization::SAVE_FORMAT_VERSION);
+            return false;
+        }
+
+        // entity table
+        reader.Seek(start + header.EntityTableOffset);
+        if (header.EntityCount > reader.Remaining() / sizeof(Serialization::EntityRecord)) {
+            _log->error("Memory save data is corrupted: entity count {} exceeds entity table", header.EntityCount);
+            return false;
+        }
+        auto entityRecords = reader.Sub(header.EntityCount * sizeof(Serialization::EntityRecord));
+        auto namesLength = reader.Read<uint32_t>();
+        auto namesData = reader.View<char>(namesLength);
+        if (reader.Failed()) {
+            _log->error("Memory save data is corrupted: invalid entity table");
+            return false;
+        }
+        Serialization::StringTable names(std::string_view(namesData.data(), namesData.size()));
+
+        _entities.reserve(header.EntityCount);
+        for (size_t i = 0; i < header.EntityCount; i++) {
+            auto record = entityRecords.Read<Serialization::EntityRecord>();
+
+            auto entity = std::make_unique<ECS::Entity>(this);
+            entity->Id = _entities.size();
+            entity->Name = names.Get({record.NameOffset, record.NameLength});
+            entity->Active = record.Active != 0;
+            _entities.push_back(std::move(entity));
+        }
+
+        // component pools
+        auto& registry = GetComponentRegistry();
+        reader.Seek(start + header.PoolDirectoryOffset);
+        for (size_t i = 0; i < header.PoolCount; i++) {
+            std::string name = reader.ReadString();
+            auto entry = reader.Read<Serialization::PoolDirectoryEntry>();
+            if (reader.Failed()) {
+                _log->error("Memory save data is corrupted: invalid pool directory");
+                Destroy();
+                return false;
+            }
+
+            auto type = registry.find(name);
+            if (type == registry.end()) {
+                _log->error("Component type {} found in save is not registered. Components of this type will be skipped.", name);
+                continue;
+            }
+            if (type->second.RecordSize != entry.RecordSize) {
+                _log->error("Component type {} has different Record size than in save ({} vs {}). Components of this type will be skipped.",
+                            name, type->second.RecordSize, entry.RecordSize);
+                continue;
+            }
+
+            size_t dataSize = reader.Data().size();
+            if (entry.Offset > dataSize - start || entry.Size > dataSize - start - entry.Offset) {
+                _log->error("Memory save data is corrupted: pool {} is out of range", name);
+                Destroy();
+                return false;
+            }
+            auto poolData = reader.Data().subspan(start + entry.Offset, entry.Size);
+            RegisterTypeInfo(name, type->second.TypeIndex, type->second.Size);
+
+            if (mappedFile != nullptr) {
+                // invalid pools fail the load here, like in immediate loading - they can't be dropped on first access
+                Serialization::BinaryReader validateReader(poolData);
+                if (!type->second.ValidatePool(validateReader, _entities.size())) {
+                    Destroy();
+                    return false;
+                }
+                _pendingPools[type->second.TypeIndex] = PendingPool{name, &type->second, poolData};
+                continue;
+            }
+
+            Serialization::BinaryReader poolReader(poolData);
+            auto pool = type->second.CreatePool();
+            if (!pool->Load(this, _entities.size(), poolReader)) {
+                Destroy();
+                return false;
+            }
+
+            _components[type->second.TypeIndex] = std::move(pool);
+        }
+
+        if (!_pendingPools.empty()) {
+            _mappedFile = std::move(mappedFile);
+        }
+
+        LOW_LOG_DEBUG(Ecs, "Memory loaded: {} entities, {} component pools, {} pending", _entities.size(), _components.size(), _pendingPools.size());
+        return true;
+    }
+
+    void Memory::MaterializeAllPools() {
+        while (!_pendingPools.empty()) {
+            MaterializePool(_pendingPools.begin()->first);
+        }
+    }
+
+    bool Memory::MaterializePool(std::type_index typeIndex) {
+        auto it = _pendingPools.find(typeIndex);
+        if (it == _pendingPools.end()) {
+            return false;
+        }
+
+        PendingPool pending = std::move(it->second);
+        _pendingPools.erase(it);
+
+        Serialization::BinaryReader reader(pending.Data);
+        auto pool = pending.Type->CreatePool();
+        bool loaded = pool->Load(this, _entities.size(), reader);
+        if (loaded) {
+            _components[typeIndex] = std::move(pool);
+            LOW_LOG_DEBUG(Ecs, "Component pool {} deserialized from save file", pending.Name);
+        } else {
+            _log->error("Failed to deserialize component pool {} from save file. Components of this type are lost.", pending.Name);
+        }
+
+        if (_pendingPools.empty()) {
+            _mappedFile.reset();
+        }
+
+        return loaded;
+    }
+
+    std::unordered_map<std::string, Memory::ComponentTypeEntry>& Memory::GetComponentRegistry() {
+        static std::unordered_map<std::string, ComponentTypeEntry> registry;
+        return registry;
+    }
+
+    void Memory::RegisterEngineComponentTypes() {
+        static bool registered = false;
+        if (registered) return;
+
+        RegisterComponentType<ECS::TransformComponent>();
+        RegisterComponentType<ECS::SpriteComponent>();
+        RegisterComponentType<ECS::AnimatedSpriteComponent>();
+        RegisterComponentType<ECS::CameraComponent>();
+        RegisterComponentType<ECS::TileMapComponent>();
+        RegisterComponentType<ECS::SoundComponent>();
+
+        registered = true;
+    }
+
+    void Memory::RegisterTypeInfo(const std::string& name, std::type_index typeIndex, size_t size) {
+        if (_typeInfos.contains(typeIndex)) return;
+
+        TypeInfo& ti = _typeInfos[typeIndex];
+        ti.Name = name;
+        ti.Id = _nextTypeId++;
+        ti.TypeIndex = typeIndex;
+        ti.Size = size;
     }
 }
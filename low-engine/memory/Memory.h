@@ -1,6 +1,10 @@
 #pragma once
 
+#include <concepts>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
 #include <string>
 #include <typeindex>
 #include <vector>
@@ -17,7 +21,13 @@
 #include "Log.h"
 #include "ecs/IEntity.h"
 #include "memory/ComponentPool.h"
+#include "memory/PoolStatistics.h"
 #include "graphics/Sprite.h"
+#include "serialization/MappedFile.h"
+
+namespace LowEngine::ECS {
+    class IComponent;
+}
 
 namespace LowEngine::Memory {
     /**
@@ -41,6 +51,39 @@ namespace LowEngine::Memory {
             size_t Size = 0;
         };
 
+        /**
+         * @brief Entry of global Component Type registry.
+         *
+         * Used to recreate Component Pools from save files, where types are known only by their names.
+         */
+        struct ComponentTypeEntry {
+            std::type_index TypeIndex = std::type_index(typeid(void));
+            size_t Size = 0;
+            uint32_t RecordSize = 0;
+            /**
+             * @brief Does the Component need Update calls? Pools of such Components are needed by every Update call.
+             */
+            bool HasUpdate = true;
+            /**
+             * @brief Does the Component draw anything? Pools of such Components are needed by every Draw call.
+             */
+            bool HasDraw = true;
+            std::function<std::unique_ptr<IComponentPool>()> CreatePool;
+            /**
+             * @brief Check saved pool without deserializing it. Pools loaded lazily are checked up-front with it.
+             */
+            std::function<bool(Serialization::BinaryReader&, size_t)> ValidatePool;
+        };
+
+        /**
+         * @brief Component Pool that is still stored in memory-mapped save file and wasn't deserialized yet.
+         */
+        struct PendingPool {
+            std::string Name;
+            const ComponentTypeEntry* Type = nullptr;
+            std::span<const std::byte> Data;
+        };
+
         Memory();
 
         Memory(Memory const& other);
@@ -120,11 +163,7 @@ namespace LowEngine::Memory {
         T* CreateComponent(size_t entityId, Args&&... args) {
             // register type
             if (!_typeInfos.contains(std::type_index(typeid(T)))) {
-                TypeInfo& ti = _typeInfos[std::type_index(typeid(T))];
-                ti.Name = typeid(T).name();
-                ti.Id = _nextTypeId++;
-                ti.TypeIndex = std::type_index(typeid(T));
-                ti.Size = sizeof(T);
+                RegisterTypeInfo(RegisterComponentType<T>(), std::type_index(typeid(T)), sizeof(T));
             }
 
             if (entityId >= _entities.size()) {
@@ -162,10 +201,15 @@ namespace LowEngine::Memory {
                 _log->error("Entity id is out of range");
                 return nullptr;
             }
-            if (_components.find(typeIndex) == _components.end()) {
-                return nullptr;
+            auto it = _components.find(typeIndex);
+            if (it == _components.end()) {
+                if (!MaterializePool(typeIndex)) {
+                    return nullptr;
+                }
+                it = _components.find(typeIndex);
             }
-            return _components[typeIndex]->GetComponentPtr(entityId);
+            it->second->Counters.Lookups++;
+            return it->second->GetComponentPtr(entityId);
         }
 
         /**
@@ -203,26 +247,205 @@ namespace LowEngine::Memory {
          *
          * Sprites will be added to refered collection.
          * @param[out] sprites Reference to collection that will be filled with Sprites that needs to be drawn.
+         * @param slot Slot of the render snapshot being filled. See GetDrawSlot().
+         */
+        void CollectSprites(std::vector<Sprite>& sprites, size_t slot = 0);
+
+        /**
+         * @brief Slot of the render snapshot Sprites are currently collected for.
+         *
+         * Components that render their own textures keep one per slot - render thread may still draw the others.
+         */
+        [[nodiscard]] size_t GetDrawSlot() const { return _drawSlot; }
+
+        /**
+         * @brief Retrieve runtime statistics of all Component Pools, i.e. to find the most expensive Component Types.
+         * @return One entry per Component Type, in no particular order.
          */
-        void CollectSprites(std::vector<Sprite>& sprites);
+        [[nodiscard]] std::vector<PoolStatistics> GetPoolStatistics() const;
+
+        /**
+         * @brief Reset lookup and reallocation counters and average times of all Component Pools.
+         */
+        void ResetPoolStatistics();
 
         /**
          * @brief Remove all Entities and Component.
          */
         void Destroy();
 
+        /**
+         * @brief Write all Entities and Components to binary save.
+         *
+         * Entities are written as a single table, each Component Pool as a single block of Records.
+         * Components that don't define a Record are skipped. Pools that were not deserialized yet are copied as-is.
+         * @param writer Writer that will receive the data.
+         */
+        void Save(Serialization::BinaryWriter& writer) const;
+
+        /**
+         * @brief Replace all Entities and Components with content of binary save.
+         *
+         * Entities are recreated as ECS::Entity - their types are not saved, so Entities created with other IEntity
+         * subtypes lose their own fields and overrides. Components referring to Entities that are not in the save
+         * make the data invalid.
+         * Component Pools are reserved up-front for all Components in the save.
+         *
+         * If mappedFile is provided, reader must point into it. Component Pools are then only validated - with the
+         * same rules as immediate loading - and deserialized on first access to their type. Mapping is kept alive until all pools are deserialized
+         * or Memory is destroyed.
+         * @param reader Reader positioned at the beginning of Memory block.
+         * @param mappedFile Memory-mapped save file, for lazy loading. Nullptr to deserialize all pools immediately.
+         * @return True if successful. False if data was invalid - Memory is left empty in that case.
+         */
+        bool Load(Serialization::BinaryReader& reader, std::shared_ptr<const Serialization::MappedFile> mappedFile = nullptr);
+
+        /**
+         * @brief Number of Component Pools that still wait for deserialization.
+         */
+        [[nodiscard]] size_t GetPendingPoolCount() const {
+            return _pendingPools.size();
+        }
+
+        /**
+         * @brief Deserialize all Component Pools that are still stored in memory-mapped save file.
+         */
+        void MaterializeAllPools();
+
+        /**
+         * @brief Access saved Components of provided type in-place, without deserializing them.
+         *
+         * Intended for read-only static data (i.e. map-derived Components) that doesn't need live Component objects.
+         * View stays valid until the pool is deserialized or Memory is destroyed.
+         * @tparam T Type of the Component.
+         * @param[out] saved View that will be filled with saved Components.
+         * @return True if pool of this type is still pending in memory-mapped save file. False otherwise.
+         */
+        template<typename T>
+        bool ViewSavedComponents(typename ComponentPool<T>::SavedView& saved) const {
+            auto it = _pendingPools.find(std::type_index(typeid(T)));
+            if (it == _pendingPools.end()) {
+                return false;
+            }
+
+            Serialization::BinaryReader reader(it->second.Data);
+            return ComponentPool<T>::View(reader, saved);
+        }
+
+        /**
+         * @brief Register Component Type, so it can be recreated from save files.
+         *
+         * Called automatically when first Component of the type is created.
+         * Engine's Components are always registered.
+         * @tparam T Type of the Component.
+         * @return Name under which the type was registered.
+         */
+        template<typename T>
+        static std::string RegisterComponentType() {
+            std::string name = DemangledTypeName(typeid(T));
+            auto& registry = GetComponentRegistry();
+            if (!registry.contains(name)) {
+                ComponentTypeEntry& entry = registry[name];
+                entry.TypeIndex = std::type_index(typeid(T));
+                entry.Size = sizeof(T);
+                if constexpr (Serialization::SerializableComponent<T>) {
+                    entry.RecordSize = sizeof(typename T::Record);
+                }
+                entry.HasUpdate = ComponentHasUpdate<T>();
+                entry.HasDraw = ComponentHasDraw<T>();
+                entry.CreatePool = [] { return std::make_unique<ComponentPool<T> >(0); };
+                entry.ValidatePool = [](Serialization::BinaryReader& reader, size_t entityCount) {
+                    return ComponentPool<T>::Validate(reader, entityCount);
+                };
+            }
+            return name;
+        }
+
+        /**
+         * @brief Check if Component of type T needs Update calls - true unless it declares HAS_UPDATE as false.
+         */
+        template<typename T>
+        static constexpr bool ComponentHasUpdate() {
+            if constexpr (requires { { T::HAS_UPDATE } -> std::convertible_to<bool>; }) {
+                return T::HAS_UPDATE;
+            } else {
+                return true;
+            }
+        }
+
+        /**
+         * @brief Check if Component of type T draws anything - true unless it declares HAS_DRAW as false.
+         */
+        template<typename T>
+        static constexpr bool ComponentHasDraw() {
+            if constexpr (requires { { T::HAS_DRAW } -> std::convertible_to<bool>; }) {
+                return T::HAS_DRAW;
+            } else {
+                return true;
+            }
+        }
+
     protected:
         static inline unsigned int _nextTypeId = 0;
 
+        /**
+         * @brief Weight of the latest measurement in average times of pools. Smooths out single slow frames.
+         */
+        static constexpr float STATS_SMOOTHING = 0.1f;
+
         std::vector<std::unique_ptr<ECS::IEntity> > _entities;
         std::unordered_map<std::type_index, std::unique_ptr<IComponentPool> > _components;
         std::unordered_map<std::type_index, TypeInfo> _typeInfos;
+        std::unordered_map<std::type_index, PendingPool> _pendingPools;
+        std::shared_ptr<const Serialization::MappedFile> _mappedFile;
+
+        /**
+         * @brief Pools iterated by the current Update or sprite collection, reused between frames.
+         *
+         * Components may look up or create Components of other types meanwhile, which inserts pools into _components.
+         */
+        std::vector<IComponentPool*> _framePools;
+
+        size_t _drawSlot = 0;
+
+        /**
+         * @brief Retrieve global registry of Component Types, keyed by type name.
+         */
+        static std::unordered_map<std::string, ComponentTypeEntry>& GetComponentRegistry();
+
+        /**
+         * @brief Register engine's built-in Components in global registry.
+         */
+        static void RegisterEngineComponentTypes();
+
+        void RegisterTypeInfo(const std::string& name, std::type_index typeIndex, size_t size);
+
+        /**
+         * @brief Deserialize pending Component Pool of provided type.
+         * @param typeIndex Type of the Component.
+         * @return True if pool was deserialized. False if there was no pending pool of this type or its data was invalid.
+         */
+        bool MaterializePool(std::type_index typeIndex);
+
+        /**
+         * @brief Fill _framePools with all current pools.
+         */
+        void CollectFramePools();
 
         template<typename T>
         ComponentPool<T>& GetOrCreatePool() {
             auto typeIdx = std::type_index(typeid(T));
+            if (!_pendingPools.empty()) {
+                MaterializePool(typeIdx);
+            }
+
             auto it = _components.find(typeIdx);
             if (it == _components.end()) {
+                // pools created by lookups need TypeInfo too, i.e. to be saved
+                if (!_typeInfos.contains(typeIdx)) {
+                    RegisterTypeInfo(RegisterComponentType<T>(), typeIdx, sizeof(T));
+                }
+
                 auto newPool = std::make_unique<ComponentPool<T> >();
                 auto ptr = newPool.get();
                 _components[typeIdx] = std::move(newPool);
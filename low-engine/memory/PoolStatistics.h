@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace LowEngine::Memory {
+    /**
+     * @brief Runtime statistics of a single Component Pool, see Memory::GetPoolStatistics().
+     */
+    struct PoolStatistics {
+        /**
+         * @brief Name of the Component Type.
+         */
+        std::string Name;
+
+        /**
+         * @brief Id of the Component Type within its Memory.
+         */
+        unsigned int TypeId = 0;
+
+        /**
+         * @brief Size of a single Component, in bytes.
+         */
+        size_t ComponentSize = 0;
+
+        /**
+         * @brief Number of Components in the pool.
+         */
+        size_t Count = 0;
+
+        /**
+         * @brief Number of Components the pool can hold before reallocating.
+         */
+        size_t Capacity = 0;
+
+        /**
+         * @brief Memory taken by Components and index maps, in bytes. Maps are estimated.
+         */
+        size_t Bytes = 0;
+
+        /**
+         * @brief Number of times Components were moved to a larger block of memory.
+         */
+        size_t Reallocations = 0;
+
+        /**
+         * @brief Average time of updating all Components of the pool, in milliseconds.
+         */
+        float UpdateMs = 0.0f;
+
+        /**
+         * @brief Average time of collecting Sprites from all Components of the pool, in milliseconds.
+         */
+        float CollectMs = 0.0f;
+
+        /**
+         * @brief Number of GetComponent calls for this type.
+         */
+        uint64_t Lookups = 0;
+
+        /**
+         * @brief Pool is still stored in memory-mapped save file. All other values except names are 0.
+         */
+        bool Pending = false;
+    };
+}
@@ -0,0 +1,194 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+#include "Config.h"
+#include "Log.h"
+
+namespace LowEngine::Profiling {
+    Profiler::ThreadBuffer::ThreadBuffer(uint32_t threadId) : ThreadId(threadId), Name("Thread " + std::to_string(threadId)) {
+        size_t capacity = 2;
+        while (capacity < Config::PROFILER_ZONE_BUFFER_SIZE) capacity <<= 1;
+
+        Zones = std::make_unique<ZoneEvent[]>(capacity);
+        Mask = capacity - 1;
+    }
+
+    bool Profiler::BeginCapture(size_t frameCount, const std::string& path) {
+#ifndef LOWENGINE_PROFILER
+        _log->warn("Profiler is compiled out; build with LOW_ENGINE_PROFILER to capture '{}'", path);
+        return false;
+#endif
+        if (frameCount == 0) {
+            _log->error("Profiler capture needs at least one frame");
+            return false;
+        }
+
+        std::lock_guard lock(_mutex);
+        if (_framesRequested > 0) {
+            _log->warn("Profiler capture to '{}' is already in progress", _capturePath);
+            return false;
+        }
+
+        _capturePath = path;
+        _framesRequested = frameCount;
+        _framesCaptured = 0;
+        _droppedZones = 0;
+        _captured.clear();
+        _pending.store(true, std::memory_order_relaxed);
+
+        _log->info("Profiler capture of {} frames requested", frameCount);
+        return true;
+    }
+
+    bool Profiler::IsCapturing() {
+        // not inline - static data of a shared library is not visible to code compiled into the executable
+        return _recording.load(std::memory_order_relaxed);
+    }
+
+    bool Profiler::IsCapturePending() {
+        return _pending.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::MarkFrame() {
+        if (!_pending.load(std::memory_order_relaxed)) return;
+
+        // registration takes the lock - do it before
+        auto& mainThread = GetThreadBuffer();
+
+        std::lock_guard lock(_mutex);
+        if (_framesRequested == 0) return;
+
+        uint64_t now = Now();
+        if (!_recording.load(std::memory_order_relaxed)) {
+            // leftovers from before the capture would show up as zones outside of captured frames
+            CollectZones(false);
+            _recording.store(true, std::memory_order_relaxed);
+            _frameStart = now;
+            _captureStartTicks = now;
+            _captureStartNanoseconds = NowNanoseconds();
+            return;
+        }
+
+        CollectZones(true);
+        _captured.push_back({mainThread.ThreadId, {"Frame", _frameStart, now}});
+        _frameStart = now;
+        _framesCaptured++;
+
+        if (_framesCaptured < _framesRequested) return;
+
+        _recording.store(false, std::memory_order_relaxed);
+        WriteCapture();
+
+        _framesRequested = 0;
+        _pending.store(false, std::memory_order_relaxed);
+        _captured.clear();
+        _captured.shrink_to_fit();
+    }
+
+    void Profiler::SetThreadName(const std::string& name) {
+#ifndef LOWENGINE_PROFILER
+        return;
+#endif
+        auto& buffer = GetThreadBuffer();
+
+        std::lock_guard lock(_mutex);
+        buffer.Name = name;
+    }
+
+    size_t Profiler::GetDroppedZoneCount() {
+        std::lock_guard lock(_mutex);
+        return _droppedZones;
+    }
+
+    void Profiler::Record(const char* name, uint64_t start, uint64_t end) {
+        auto& buffer = GetThreadBuffer();
+
+        size_t position = buffer.WritePosition.load(std::memory_order_relaxed);
+        if (position - buffer.ReadPosition.load(std::memory_order_acquire) > buffer.Mask) {
+            buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.Zones[position & buffer.Mask] = {name, start, end};
+        buffer.WritePosition.store(position + 1, std::memory_order_release);
+    }
+
+    Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+        // buffers outlive their threads - a capture may still need zones of a thread that just ended
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            std::lock_guard lock(_mutex);
+            _buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(_buffers.size() + 1)));
+            buffer = _buffers.back().get();
+        }
+        return *buffer;
+    }
+
+    void Profiler::CollectZones(bool keep) {
+        for (auto& buffer: _buffers) {
+            size_t read = buffer->ReadPosition.load(std::memory_order_relaxed);
+            size_t written = buffer->WritePosition.load(std::memory_order_acquire);
+            if (keep) {
+                for (size_t i = read; i < written; i++) {
+                    _captured.push_back({buffer->ThreadId, buffer->Zones[i & buffer->Mask]});
+                }
+            }
+            buffer->ReadPosition.store(written, std::memory_order_release);
+
+            size_t dropped = buffer->Dropped.exchange(0, std::memory_order_relaxed);
+            if (keep) _droppedZones += dropped;
+        }
+    }
+
+    bool Profiler::WriteCapture() {
+        std::ofstream file(_capturePath);
+        if (!file) {
+            _log->error("Failed to open profiler capture file: {}", _capturePath);
+            return false;
+        }
+
+        uint64_t origin = UINT64_MAX;
+        for (auto& captured: _captured) {
+            origin = std::min(origin, captured.Zone.Start);
+        }
+
+        // ticks per microsecond, measured over the whole capture
+        double elapsedMicroseconds = static_cast<double>(NowNanoseconds() - _captureStartNanoseconds) / 1000.0;
+        double ticksPerMicrosecond = static_cast<double>(Now() - _captureStartTicks) / std::max(elapsedMicroseconds, 1.0);
+
+        // Trace Event Format - times are in microseconds
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        for (auto& buffer: _buffers) {
+            file << (first ? "" : ",\n")
+                 << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->ThreadId
+                 << R"(,"args":{"name":)" << nlohmann::json(buffer->Name).dump() << "}}";
+            first = false;
+        }
+
+        file.setf(std::ios::fixed);
+        file.precision(3);
+        for (auto& [threadId, zone]: _captured) {
+            file << (first ? "" : ",\n")
+                 << R"({"name":)" << nlohmann::json(zone.Name).dump()
+                 << R"(,"ph":"X","pid":1,"tid":)" << threadId
+                 << R"(,"ts":)" << static_cast<double>(zone.Start - origin) / ticksPerMicrosecond
+                 << R"(,"dur":)" << static_cast<double>(zone.End - zone.Start) / ticksPerMicrosecond << "}";
+            first = false;
+        }
+        file << "\n]}\n";
+
+        if (!file) {
+            _log->error("Failed to write profiler capture file: {}", _capturePath);
+            return false;
+        }
+
+        _log->info("Profiler capture of {} frames ({} zones, {} dropped) written to {}",
+                   _framesCaptured, _captured.size(), _droppedZones, _capturePath);
+        return true;
+    }
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86)
+	#include <intrin.h>
+	#define LOWENGINE_PROFILER_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+	#define LOWENGINE_PROFILER_TSC
+#endif
+
+#define LOW_PROFILE_CONCAT_INNER(a, b) a##b
+#define LOW_PROFILE_CONCAT(a, b) LOW_PROFILE_CONCAT_INNER(a, b)
+
+/*
+ * Zones are compiled in only when LOWENGINE_PROFILER is defined (LOW_ENGINE_PROFILER option in CMake).
+ * Otherwise the macros expand to nothing and Profiler::BeginCapture() refuses to start.
+ */
+#ifdef LOWENGINE_PROFILER
+	/**
+	 * @brief Measure time from this line to the end of the enclosing scope.
+	 * @param name String literal shown in the capture. Must outlive the capture.
+	 */
+	#define LOW_PROFILE_ZONE(name) LowEngine::Profiling::ScopedZone LOW_PROFILE_CONCAT(_profileZone, __LINE__)(name)
+#else
+	#define LOW_PROFILE_ZONE(name) do {} while (false)
+#endif
+
+namespace LowEngine::Profiling {
+    /**
+     * @brief Single measured zone. Times are in ticks of Profiler::Now().
+     */
+    struct ZoneEvent {
+        const char* Name = nullptr;
+        uint64_t Start = 0;
+        uint64_t End = 0;
+    };
+
+    /**
+     * @brief Frame profiler capturing zones from all threads into a chrome://tracing / Perfetto JSON file.
+     *
+     * Zones are recorded only during a capture - otherwise a zone costs a single relaxed atomic load.
+     * While capturing, a zone costs two reads of Now() plus a store into the buffer; the reads dominate.
+     * Each thread writes into its own lock-free buffer. Main thread moves buffered zones into the capture
+     * once per frame (MarkFrame()), and writes the file when requested number of frames is captured.
+     */
+    class Profiler {
+    public:
+        /**
+         * @brief Start capturing zones with the next frame.
+         * @param frameCount Number of frames to capture.
+         * @param path Path of the JSON file written when capture ends.
+         * @return False if a capture is already in progress, or profiler is compiled out.
+         */
+        static bool BeginCapture(size_t frameCount, const std::string& path);
+
+        /**
+         * @brief Check if zones are being recorded.
+         */
+        [[nodiscard]] static bool IsCapturing();
+
+        /**
+         * @brief Check if a capture is requested or in progress.
+         */
+        [[nodiscard]] static bool IsCapturePending();
+
+        /**
+         * @brief End a frame. Called by Game once per frame, on the main thread.
+         *
+         * Collects zones recorded by all threads, and writes the capture file after the last captured frame.
+         */
+        static void MarkFrame();
+
+        /**
+         * @brief Name calling thread in captures.
+         */
+        static void SetThreadName(const std::string& name);
+
+        /**
+         * @brief Retrieve number of zones lost in the last capture because thread buffers were full.
+         */
+        [[nodiscard]] static size_t GetDroppedZoneCount();
+
+        /**
+         * @brief Current time, in ticks from an arbitrary point. Never 0.
+         *
+         * On x86 it's the CPU's time-stamp counter - reading it is about half the cost of steady_clock, which matters
+         * when every zone reads it twice. Under some hypervisors a read still takes around 20 ns, putting a captured
+         * zone above 40 ns. Ticks are converted to time when capture is written.
+         */
+        [[nodiscard]] static uint64_t Now() {
+#ifdef LOWENGINE_PROFILER_TSC
+            return __rdtsc();
+#else
+            return NowNanoseconds();
+#endif
+        }
+
+        /**
+         * @brief Current time of steady clock, in nanoseconds. Used to calibrate ticks.
+         */
+        [[nodiscard]] static uint64_t NowNanoseconds() {
+            auto time = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+        }
+
+        /**
+         * @brief INTERNAL: Store a zone in calling thread's buffer. Used by ScopedZone.
+         */
+        static void Record(const char* name, uint64_t start, uint64_t end);
+
+    protected:
+        /**
+         * @brief Zones of a single thread, written only by that thread and read only by the main thread.
+         *
+         * With a single producer, the ring needs no compare-and-swap - each side only advances its own position.
+         */
+        struct ThreadBuffer {
+            explicit ThreadBuffer(uint32_t threadId);
+
+            uint32_t ThreadId;
+            std::string Name;
+            std::unique_ptr<ZoneEvent[]> Zones;
+            size_t Mask;
+            alignas(64) std::atomic<size_t> WritePosition{0};
+            std::atomic<size_t> Dropped{0};
+            alignas(64) std::atomic<size_t> ReadPosition{0};
+        };
+
+        struct CapturedZone {
+            uint32_t ThreadId;
+            ZoneEvent Zone;
+        };
+
+        inline static std::atomic<bool> _recording{false};
+        inline static std::atomic<bool> _pending{false};
+
+        // guards everything below - taken once per frame and when a thread records its first zone
+        inline static std::mutex _mutex;
+        inline static std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+        inline static std::vector<CapturedZone> _captured;
+        inline static std::string _capturePath;
+        inline static size_t _framesRequested = 0;
+        inline static size_t _framesCaptured = 0;
+        inline static size_t _droppedZones = 0;
+        inline static uint64_t _frameStart = 0;
+        inline static uint64_t _captureStartTicks = 0;
+        inline static uint64_t _captureStartNanoseconds = 0;
+
+        static ThreadBuffer& GetThreadBuffer();
+
+        /**
+         * @brief Move zones from thread buffers into the capture, or discard them.
+         */
+        static void CollectZones(bool keep);
+
+        static bool WriteCapture();
+    };
+
+    /**
+     * @brief Zone lasting from construction to destruction. Use LOW_PROFILE_ZONE instead of creating it directly.
+     */
+    class ScopedZone {
+    public:
+        explicit ScopedZone(const char* name) : _name(name) {
+            if (Profiler::IsCapturing()) {
+                _start = Profiler::Now();
+            }
+        }
+
+        ~ScopedZone() {
+            if (_start != 0) {
+                Profiler::Record(_name, _start, Profiler::Now());
+            }
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    protected:
+        const char* _name;
+        uint64_t _start = 0;
+    };
+}
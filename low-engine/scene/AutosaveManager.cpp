@@ -0,0 +1,168 @@
+#include "AutosaveManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "serialization/BinaryWriter.h"
+#include "serialization/Compression.h"
+
+namespace LowEngine {
+    namespace {
+        double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    AutosaveManager::~AutosaveManager() {
+        {
+            std::lock_guard lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+
+        if (_worker.joinable()) {
+            _worker.join();
+        }
+    }
+
+    bool AutosaveManager::Save(const Scene& scene, const std::string& path) {
+        if (IsSaving()) {
+            _log->warn("Autosave: previous save is still in progress, request to save '{}' skipped", path);
+            return false;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        // worker doesn't touch the buffer between saves - memory of the previous save is reused
+        _snapshot.Clear();
+        scene.Save(_snapshot);
+
+        {
+            std::lock_guard lock(_mutex);
+            _status = AutosaveStatus();
+            _status.State = AutosaveState::InProgress;
+            _status.Path = path;
+            _status.UncompressedBytes = _snapshot.Position();
+            _status.SnapshotMs = MillisecondsSince(startTime);
+            _requestTime = startTime;
+            _hasJob = true;
+
+            if (!_worker.joinable()) {
+                _worker = std::thread(&AutosaveManager::WorkerLoop, this);
+            }
+        }
+        _condition.notify_all();
+
+        return true;
+    }
+
+    bool AutosaveManager::IsSaving() const {
+        std::lock_guard lock(_mutex);
+        return _hasJob;
+    }
+
+    AutosaveStatus AutosaveManager::GetStatus() const {
+        std::lock_guard lock(_mutex);
+        return _status;
+    }
+
+    void AutosaveManager::Wait() {
+        std::unique_lock lock(_mutex);
+        _condition.wait(lock, [this] { return !_hasJob; });
+    }
+
+    void AutosaveManager::WorkerLoop() {
+        while (true) {
+            std::string path;
+            {
+                std::unique_lock lock(_mutex);
+                _condition.wait(lock, [this] { return _stop || _hasJob; });
+                if (!_hasJob) return;
+
+                path = _status.Path;
+            }
+
+            bool success = WriteSnapshot(_snapshot.Buffer(), path);
+
+            AutosaveStatus status;
+            {
+                std::lock_guard lock(_mutex);
+                _status.State = success ? AutosaveState::Completed : AutosaveState::Failed;
+                _status.TotalMs = MillisecondsSince(_requestTime);
+                _hasJob = false;
+                status = _status;
+            }
+            _condition.notify_all();
+
+            if (success) {
+                _log->info("Autosave: '{}' saved in {:.2f} ms (snapshot {:.2f} ms, compress {:.2f} ms, write {:.2f} ms), {} -> {} bytes",
+                           status.Path, status.TotalMs, status.SnapshotMs, status.CompressMs, status.WriteMs,
+                           status.UncompressedBytes, status.CompressedBytes);
+            }
+        }
+    }
+
+    bool AutosaveManager::WriteSnapshot(const std::vector<std::byte>& snapshot, const std::string& path) {
+        std::string tempPath = path + ".tmp";
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            _log->error("Autosave: failed to open file '{}' for writing", tempPath);
+            return false;
+        }
+
+        Serialization::CompressedHeader header;
+        header.UncompressedSize = snapshot.size();
+        header.BlockCount = static_cast<uint32_t>((snapshot.size() + header.BlockSize - 1) / header.BlockSize);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::vector<std::byte> compressed;
+        compressed.reserve(Serialization::Lz4CompressBound(header.BlockSize));
+
+        size_t position = 0;
+        while (position < snapshot.size()) {
+            size_t blockSize = std::min<size_t>(header.BlockSize, snapshot.size() - position);
+
+            auto compressStart = std::chrono::steady_clock::now();
+            compressed.clear();
+            Serialization::Lz4Compress(std::span(snapshot).subspan(position, blockSize), compressed);
+            double compressMs = MillisecondsSince(compressStart);
+
+            auto writeStart = std::chrono::steady_clock::now();
+            Serialization::CompressedBlockHeader block{static_cast<uint32_t>(compressed.size()), static_cast<uint32_t>(blockSize)};
+            file.write(reinterpret_cast<const char*>(&block), sizeof(block));
+            file.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+            double writeMs = MillisecondsSince(writeStart);
+
+            position += blockSize;
+
+            std::lock_guard lock(_mutex);
+            _status.Progress = static_cast<float>(position) / static_cast<float>(snapshot.size());
+            _status.CompressedBytes += sizeof(block) + compressed.size();
+            _status.CompressMs += compressMs;
+            _status.WriteMs += writeMs;
+        }
+
+        auto writeStart = std::chrono::steady_clock::now();
+        file.close();
+        if (!file.good()) {
+            _log->error("Autosave: failed to write file '{}'", tempPath);
+            std::error_code ignored;
+            std::filesystem::remove(tempPath, ignored);
+            return false;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error) {
+            _log->error("Autosave: failed to move '{}' to '{}': {}", tempPath, path, error.message());
+            return false;
+        }
+
+        std::lock_guard lock(_mutex);
+        _status.CompressedBytes += sizeof(header);
+        _status.WriteMs += MillisecondsSince(writeStart);
+        return true;
+    }
+}
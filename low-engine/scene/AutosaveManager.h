@@ -0,0 +1,143 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scene/Scene.h"
+#include "serialization/BinaryWriter.h"
+
+namespace LowEngine {
+    /**
+     * @brief State of the autosave.
+     */
+    enum class AutosaveState {
+        /**
+         * @brief No save was requested yet.
+         */
+        Idle,
+        /**
+         * @brief Snapshot is being compressed and written to disk.
+         */
+        InProgress,
+        /**
+         * @brief Last save was written successfully.
+         */
+        Completed,
+        /**
+         * @brief Last save failed. Previous save file, if any, is left untouched.
+         */
+        Failed
+    };
+
+    /**
+     * @brief Progress and timing of the last autosave.
+     */
+    struct AutosaveStatus {
+        AutosaveState State = AutosaveState::Idle;
+        /**
+         * @brief Progress of the save, from 0 to 1.
+         */
+        float Progress = 0.0f;
+        /**
+         * @brief Path of the save file.
+         */
+        std::string Path;
+        size_t UncompressedBytes = 0;
+        size_t CompressedBytes = 0;
+        /**
+         * @brief Time spent on the calling thread, serializing the scene, in milliseconds.
+         */
+        double SnapshotMs = 0.0;
+        /**
+         * @brief Time spent on compression, in milliseconds.
+         */
+        double CompressMs = 0.0;
+        /**
+         * @brief Time spent on writing to disk, in milliseconds.
+         */
+        double WriteMs = 0.0;
+        /**
+         * @brief Time from the request to the moment the file was in place, in milliseconds.
+         */
+        double TotalMs = 0.0;
+    };
+
+    /**
+     * @brief Saves scenes in the background.
+     *
+     * Scene is serialized on the calling thread, into a buffer kept between saves - Records are plain data, so
+     * this costs about as much as copying them, and the Scene can be freely modified right after Save() returns.
+     * Compression and disk I/O happen on a worker thread. File is written under temporary name and moved in place
+     * only when complete, so interrupted save never corrupts the previous one.
+     */
+    class AutosaveManager {
+    public:
+        AutosaveManager() = default;
+
+        /**
+         * @brief Waits for the save in flight, if any, and stops the worker thread.
+         */
+        ~AutosaveManager();
+
+        AutosaveManager(const AutosaveManager&) = delete;
+
+        AutosaveManager& operator=(const AutosaveManager&) = delete;
+
+        /**
+         * @brief Serialize the scene and save it in the background.
+         *
+         * Should be called when game state is consistent, i.e. at the end of a turn. Never waits for compression
+         * or disk I/O.
+         * @param scene Scene to save.
+         * @param path Path to the save file.
+         * @return True if save was started. False if previous save is still in progress.
+         */
+        bool Save(const Scene& scene, const std::string& path);
+
+        /**
+         * @brief Is a save currently in progress?
+         */
+        [[nodiscard]] bool IsSaving() const;
+
+        /**
+         * @brief Retrieve progress and timing of the current or last save.
+         */
+        [[nodiscard]] AutosaveStatus GetStatus() const;
+
+        /**
+         * @brief Block until the save in flight, if any, is finished.
+         */
+        void Wait();
+
+    protected:
+        std::thread _worker;
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _stop = false;
+        bool _hasJob = false;
+
+        AutosaveStatus _status;
+        /**
+         * @brief Serialized scene. Written by Save(), then read only by the worker until the save is finished.
+         */
+        Serialization::BinaryWriter _snapshot;
+        std::chrono::steady_clock::time_point _requestTime;
+
+        void WorkerLoop();
+
+        /**
+         * @brief Compress serialized scene and write it to disk. Runs on the worker thread.
+         * @param snapshot Serialized scene.
+         * @param path Path to the save file.
+         * @return True if successful.
+         */
+        bool WriteSnapshot(const std::vector<std::byte>& snapshot, const std::string& path);
+    };
+}
@@ -1,7 +1,14 @@
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <functional>
 
 #include "Scene.h"
 
+#include "profiling/Profiler.h"
+#include "serialization/Compression.h"
+
 namespace LowEngine {
     Scene::Scene(const std::string& name): Name(name), _memory() {
     }
@@ -12,6 +19,7 @@ namespace LowEngine {
                                       , _cameraEntityId(other._cameraEntityId)
                                       , _spriteSortingMethod(other._spriteSortingMethod)
                                       , _memory(other._memory) // calls Memory(const Memory&) → deep copy!
+                                      , _spriteBatching(other._spriteBatching)
     {
     }
 
@@ -21,19 +29,31 @@ namespace LowEngine {
     }
 
     void Scene::Update(float deltaTime) {
+        LOW_PROFILE_ZONE("Scene::Update");
         _memory.UpdateAllComponents(deltaTime);
     }
 
-    void Scene::Draw(sf::RenderWindow& window) {
+    void Scene::Draw(sf::RenderTarget& target, float alpha) {
+        LOW_PROFILE_ZONE("Scene::Draw");
+        BuildRenderSnapshot(_renderSnapshot, target.getSize());
+        _drawCalls = _renderSnapshot.Draw(target, alpha, &_spriteBatcher);
+    }
+
+    void Scene::BuildRenderSnapshot(RenderSnapshot& snapshot, sf::Vector2u targetSize) {
+        LOW_PROFILE_ZONE("Scene::BuildRenderSnapshot");
+        snapshot.Clear();
+
         if (_cameraEntityId < Config::MAX_SIZE) {
             auto cameraComponent = _memory.GetComponent<ECS::CameraComponent>(_cameraEntityId);
             if (cameraComponent) {
-                cameraComponent->SetView(window);
+                snapshot.HasView = true;
+                snapshot.View = cameraComponent->GetView(targetSize);
+                snapshot.PreviousViewCenter = cameraComponent->GetView(targetSize, 0.0f).getCenter();
             }
         }
 
-        std::vector<Sprite> sprites;
-        _memory.CollectSprites(sprites);
+        auto& sprites = snapshot.Sprites;
+        _memory.CollectSprites(sprites, snapshot.Slot);
 
         switch (_spriteSortingMethod) {
             case SpriteSortingMethod::YAxisIncremental:
@@ -42,17 +62,23 @@ namespace LowEngine {
                 });
                 break;
             case SpriteSortingMethod::Layers:
+                // order within a layer is not defined - keep Sprites with the same texture together
                 std::sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
-                    return a.Layer < b.Layer;
+                    if (a.Layer != b.Layer) return a.Layer < b.Layer;
+                    return std::less<const sf::Texture*>()(&a.getTexture(), &b.getTexture());
                 });
                 break;
             case SpriteSortingMethod::None:
             default: /* no sorting */;
         }
 
-        for (auto& sprite: sprites) {
-            window.draw(sprite);
+        for (size_t i = 1; i < sprites.size(); i++) {
+            if (&sprites[i].getTexture() != &sprites[i - 1].getTexture()) {
+                snapshot.TextureSwitches++;
+            }
         }
+        _textureSwitches = snapshot.TextureSwitches;
+        snapshot.BatchSprites = _spriteBatching;
     }
 
     ECS::Entity* Scene::AddEntity(const std::string& name) {
@@ -62,7 +88,7 @@ namespace LowEngine {
             return nullptr;
         }
 
-        _log->debug("Entity '{}' created with id {}", name, entity->Id);
+        LOW_LOG_DEBUG(Ecs, "Entity '{}' created with id {}", name, entity->Id);
         return entity;
     }
 
@@ -110,6 +136,12 @@ namespace LowEngine {
         }
     }
 
+    void Scene::SetSpriteBatching(bool enabled) {
+        _spriteBatching = enabled;
+
+        _log->debug("Sprite batching for scene '{}' {}", Name, enabled ? "enabled" : "disabled");
+    }
+
     void Scene::SetSpriteSorting(SpriteSortingMethod method) {
         _spriteSortingMethod = method;
 
@@ -119,4 +151,98 @@ namespace LowEngine {
     void Scene::Destroy() {
         _memory.Destroy();
     }
+
+    bool Scene::Save(const std::string& path) const {
+        Serialization::BinaryWriter writer;
+        Save(writer);
+
+        // pending pools may still be mapped from the file at path - it's replaced, never rewritten in place
+        std::string tempPath = path + ".tmp";
+        if (!writer.SaveToFile(tempPath)) {
+            _log->error("Failed to save scene '{}' to file: {}", Name, tempPath);
+            return false;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error) {
+            _log->error("Failed to move scene '{}' save from '{}' to '{}': {}", Name, tempPath, path, error.message());
+            return false;
+        }
+
+        _log->info("Scene '{}' saved to file: {} ({} bytes)", Name, path, writer.Position());
+        return true;
+    }
+
+    bool Scene::Load(const std::string& path, Serialization::LoadMode mode) {
+        auto startTime = std::chrono::steady_clock::now();
+
+        auto mappedFile = std::make_shared<Serialization::MappedFile>();
+        if (!mappedFile->Open(path)) {
+            _log->error("Failed to open scene file: {}", path);
+            return false;
+        }
+
+        bool loaded;
+        if (Serialization::IsCompressedSave(mappedFile->Data())) {
+            // compressed saves (i.e. autosaves) can't be used in-place
+            std::vector<std::byte> data;
+            loaded = Serialization::DecompressSave(mappedFile->Data(), data);
+            if (loaded) {
+                Serialization::BinaryReader reader(data);
+                loaded = Load(reader);
+            }
+        } else {
+            Serialization::BinaryReader reader(mappedFile->Data());
+            loaded = Load(reader, mode == Serialization::LoadMode::Lazy ? mappedFile : nullptr);
+        }
+
+        if (!loaded) {
+            _log->error("Failed to load scene '{}' from file: {}", Name, path);
+            return false;
+        }
+
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+        _log->info("Scene '{}' loaded from file: {} in {:.2f} ms ({} component pools pending)", Name, path, elapsed.count(), _memory.GetPendingPoolCount());
+        return true;
+    }
+
+    void Scene::Save(Serialization::BinaryWriter& writer) const {
+        size_t start = writer.Position();
+
+        Serialization::SceneHeader header;
+        header.CameraEntityId = _cameraEntityId;
+        header.SpriteSortingMethod = static_cast<uint32_t>(_spriteSortingMethod);
+        writer.Write(header);
+
+        writer.Align(Serialization::SAVE_BLOCK_ALIGNMENT);
+        header.MemoryOffset = writer.Position() - start;
+        _memory.Save(writer);
+
+        writer.Patch(start, header);
+    }
+
+    bool Scene::Load(Serialization::BinaryReader& reader, std::shared_ptr<const Serialization::MappedFile> mappedFile) {
+        size_t start = reader.Position();
+
+        auto header = reader.Read<Serialization::SceneHeader>();
+        if (reader.Failed() || std::memcmp(header.Magic, Serialization::SceneHeader().Magic, sizeof(header.Magic)) != 0) {
+            _log->error("Scene save data is corrupted");
+            return false;
+        }
+        if (header.Version != Serialization::SAVE_FORMAT_VERSION) {
+            _log->error("Scene save data has version {}, but version {} is required", header.Version, Serialization::SAVE_FORMAT_VERSION);
+            return false;
+        }
+
+        reader.Seek(start + header.MemoryOffset);
+        if (!_memory.Load(reader, std::move(mappedFile))) {
+            _cameraEntityId = Config::MAX_SIZE;
+            return false;
+        }
+
+        _cameraEntityId = header.CameraEntityId;
+        _spriteSortingMethod = static_cast<SpriteSortingMethod>(header.SpriteSortingMethod);
+        return true;
+    }
 }
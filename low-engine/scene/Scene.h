@@ -2,10 +2,11 @@
 
 #include <string>
 
-#include "SFML/Graphics/RenderWindow.hpp"
+#include "SFML/Graphics/RenderTarget.hpp"
 
 #include "memory/Memory.h"
 #include "ecs/ECSHeaders.h"
+#include "graphics/RenderSnapshot.h"
 
 namespace LowEngine {
     /**
@@ -92,9 +93,49 @@ namespace LowEngine {
 
         /**
          * @brief Draw all sprites for this scene.
-         * @param window Window to draw on.
+         * @param target Window or off-screen texture to draw on.
+         * @param alpha Interpolation factor between previous and current simulation step. 1 draws current state as-is.
          */
-        void Draw(sf::RenderWindow& window);
+        void Draw(sf::RenderTarget& target, float alpha = 1.0f);
+
+        /**
+         * @brief Fill render snapshot with current state of this scene.
+         *
+         * Collects and sorts Sprites and calculates camera's View. Must be called on the simulation thread.
+         * @param[out] snapshot Snapshot to fill. Previous content is cleared, allocated memory is reused.
+         * @param targetSize Size of the render target the snapshot will be drawn on, in pixels.
+         */
+        void BuildRenderSnapshot(RenderSnapshot& snapshot, sf::Vector2u targetSize);
+
+        /**
+         * @brief Retrieve number of texture switches between Sprites in the last built render snapshot.
+         */
+        [[nodiscard]] size_t GetTextureSwitchCount() const { return _textureSwitches; }
+
+        /**
+         * @brief Retrieve number of draw calls issued for Sprites by the last Draw().
+         */
+        [[nodiscard]] size_t GetDrawCallCount() const { return _drawCalls; }
+
+        /**
+         * @brief Retrieve runtime statistics of all Component Pools of this scene.
+         */
+        [[nodiscard]] std::vector<Memory::PoolStatistics> GetPoolStatistics() const { return _memory.GetPoolStatistics(); }
+
+        /**
+         * @brief Reset lookup and reallocation counters and average times of all Component Pools of this scene.
+         */
+        void ResetPoolStatistics() { _memory.ResetPoolStatistics(); }
+
+        /**
+         * @brief Enable or disable drawing Sprites in batches, one draw call per run of Sprites sharing a texture.
+         *
+         * Enabled by default. Disable to draw every Sprite separately, i.e. to compare performance.
+         * @param enabled Should Sprites be batched?
+         */
+        void SetSpriteBatching(bool enabled);
+
+        [[nodiscard]] bool IsSpriteBatchingEnabled() const { return _spriteBatching; }
 
         /**
          * @brief Add new Entity to this scene.
@@ -183,9 +224,51 @@ namespace LowEngine {
          */
         void Destroy();
 
+        /**
+         * @brief Save all Entities and Components of this scene to a binary file.
+         *
+         * Assets are not saved - they're referenced by their Ids and must be loaded in the same order before loading the scene.
+         * Save is written to a temporary file that then replaces the file at path, so a scene loaded lazily from path
+         * keeps reading its original content.
+         * @param path Path to the save file.
+         * @return True if successful. False otherwise.
+         */
+        bool Save(const std::string& path) const;
+
+        /**
+         * @brief Replace all Entities and Components of this scene with content of a binary file.
+         *
+         * File is memory-mapped. In Lazy mode each Component Pool is deserialized only when its type is first accessed,
+         * so large saves don't have to be fully processed before the first frame.
+         * Compressed saves (written by AutosaveManager) are always loaded eagerly.
+         * @param path Path to the save file.
+         * @param mode Should Component Pools be deserialized immediately or on first access?
+         * @return True if successful. False otherwise - scene is left empty in that case.
+         */
+        bool Load(const std::string& path, Serialization::LoadMode mode = Serialization::LoadMode::Lazy);
+
+        /**
+         * @brief Write this scene to binary save.
+         * @param writer Writer that will receive the data.
+         */
+        void Save(Serialization::BinaryWriter& writer) const;
+
+        /**
+         * @brief Replace content of this scene with binary save.
+         * @param reader Reader positioned at the beginning of the save.
+         * @param mappedFile Memory-mapped file the reader points into, for lazy loading. Nullptr to load eagerly.
+         * @return True if successful. False otherwise.
+         */
+        bool Load(Serialization::BinaryReader& reader, std::shared_ptr<const Serialization::MappedFile> mappedFile = nullptr);
+
     protected:
         size_t _cameraEntityId = Config::MAX_SIZE;
         SpriteSortingMethod _spriteSortingMethod = SpriteSortingMethod::None;
         Memory::Memory _memory;
+        RenderSnapshot _renderSnapshot;
+        SpriteBatcher _spriteBatcher;
+        bool _spriteBatching = true;
+        size_t _textureSwitches = 0;
+        size_t _drawCalls = 0;
     };
 }
@@ -0,0 +1,313 @@
+#include "WorldStreamer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+
+#include "assets/Assets.h"
+
+namespace LowEngine {
+    namespace {
+        /**
+         * @brief Integer division rounded towards negative infinity - levels can be placed on negative coordinates.
+         */
+        long long FloorDivide(long long value, long long divisor) {
+            long long result = value / divisor;
+            if (value % divisor != 0 && (value < 0) != (divisor < 0)) {
+                result--;
+            }
+            return result;
+        }
+    }
+
+    WorldStreamer::~WorldStreamer() {
+        UnloadAll();
+        ReleaseLoadingLevels();
+    }
+
+    bool WorldStreamer::Load(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions) {
+        UnloadAll();
+        ReleaseLoadingLevels();
+
+        if (!_index.LoadFromLDTkFile(path)) {
+            _log->error("Failed to load world: {}", path);
+            return false;
+        }
+
+        _definitions = definitions;
+        _levels.clear();
+        _levels.resize(_index.Levels.size());
+        _cellSize = 0;
+
+        _log->info("World '{}' loaded with {} levels", _index.Name, _index.Levels.size());
+        return true;
+    }
+
+    void WorldStreamer::Update(sf::Vector2f focus) {
+        for (size_t i = 0; i < _levels.size(); i++) {
+            auto& level = _levels[i];
+            float distance = DistanceToLevel(_index.Levels[i], focus);
+
+            if (level.State == LevelState::Loading && level.Request.IsReady()) {
+                if (!level.Request.Succeeded()) {
+                    _log->error("Failed to load level '{}' of world '{}'", _index.Levels[i].Identifier, _index.Name);
+                    level.State = LevelState::Failed;
+                } else if (distance > UnloadDistance) {
+                    // focus moved away while the level was loading
+                    Assets::UnloadTileMap(level.Request.Id);
+                    level.State = LevelState::Unloaded;
+                } else if (!AttachLevel(i)) {
+                    Assets::UnloadTileMap(level.Request.Id);
+                    level.State = LevelState::Failed;
+                }
+            }
+
+            if (level.State == LevelState::Unloaded && distance <= LoadDistance) {
+                RequestLevel(i);
+            } else if (level.State == LevelState::Loaded && distance > UnloadDistance) {
+                EvictLevel(i);
+            }
+        }
+
+        if (_navBuild.valid() && _navBuild.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            auto build = _navBuild.get();
+            _navGrid = std::move(build.Grid);
+            _navOrigin = build.Origin;
+            LOW_LOG_DEBUG(Nav, "World navigation grid rebuilt: {}x{} cells", _navGrid.Width, _navGrid.Height);
+        }
+
+        // levels that changed during a rebuild are picked up by the next one
+        if (_navGridDirty && !_navBuild.valid()) {
+            RebuildNavigationGrid();
+        }
+    }
+
+    void WorldStreamer::UnloadAll() {
+        for (size_t i = 0; i < _levels.size(); i++) {
+            if (_levels[i].State == LevelState::Loaded) {
+                EvictLevel(i);
+            }
+        }
+
+        // nothing is loaded - result of a rebuild in progress is stale already
+        _navBuild = {};
+        _navGrid.Resize(0, 0);
+        _navGridDirty = false;
+    }
+
+    std::vector<sf::Vector2f> WorldStreamer::FindPath(sf::Vector2f start, sf::Vector2f end, Terrain::Navigation::MovementType movementType) {
+        Terrain::Navigation::NavigationPath navPath;
+        if (!FindPath(start, end, movementType, navPath)) return {};
+
+        std::vector<sf::Vector2f> result;
+        result.reserve(navPath.GetSize());
+        for (size_t i = 0; i < navPath.GetSize(); i++) {
+            result.emplace_back(navPath.GetPoint(i));
+        }
+        return result;
+    }
+
+    bool WorldStreamer::FindPath(sf::Vector2f start, sf::Vector2f end, Terrain::Navigation::MovementType movementType, Terrain::Navigation::NavigationPath& path) {
+        path.Clear();
+        if (_cellSize == 0 || _navGrid.GetCellCount() == 0) {
+            _log->warn("World Streamer -> FindPath: No levels are loaded.");
+            return false;
+        }
+
+        auto cellSize = static_cast<float>(_cellSize);
+        sf::Vector2f startCell = {std::floor((start.x - _navOrigin.x) / cellSize), std::floor((start.y - _navOrigin.y) / cellSize)};
+        sf::Vector2f endCell = {std::floor((end.x - _navOrigin.x) / cellSize), std::floor((end.y - _navOrigin.y) / cellSize)};
+
+        auto isInside = [this](sf::Vector2f cell) {
+            return cell.x >= 0.0f && cell.y >= 0.0f &&
+                   cell.x < static_cast<float>(_navGrid.Width) && cell.y < static_cast<float>(_navGrid.Height);
+        };
+        if (!isInside(startCell) || !isInside(endCell)) {
+            _log->warn("World Streamer -> FindPath: Start or end position is outside of loaded levels.");
+            return false;
+        }
+
+        path.Origin = _navOrigin;
+        path.CellSize = cellSize;
+        return _navGrid.FindPath(sf::Vector2u(startCell), sf::Vector2u(endCell), movementType, path);
+    }
+
+    LevelState WorldStreamer::GetLevelState(size_t levelIndex) const {
+        if (levelIndex >= _levels.size()) {
+            _log->error("Level index {} is out of range", levelIndex);
+            throw std::runtime_error("Level index is out of range");
+        }
+        return _levels[levelIndex].State;
+    }
+
+    size_t WorldStreamer::GetLoadedLevelCount() const {
+        return std::ranges::count_if(_levels, [](const StreamedLevel& level) {
+            return level.State == LevelState::Loaded;
+        });
+    }
+
+    float WorldStreamer::DistanceToLevel(const Terrain::WorldLevel& level, sf::Vector2f point) {
+        auto bounds = level.GetBounds();
+        float dx = std::max({bounds.position.x - point.x, 0.0f, point.x - (bounds.position.x + bounds.size.x)});
+        float dy = std::max({bounds.position.y - point.y, 0.0f, point.y - (bounds.position.y + bounds.size.y)});
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    void WorldStreamer::RequestLevel(size_t levelIndex) {
+        auto& info = _index.Levels[levelIndex];
+        auto& level = _levels[levelIndex];
+
+        // prefer map cooked by LowMapCooker - it's loaded without parsing
+        auto path = std::filesystem::path(info.Path);
+        auto cookedPath = std::filesystem::path(path).replace_extension(".lowmap");
+        std::error_code error;
+        if (std::filesystem::exists(cookedPath, error)) {
+            path = cookedPath;
+        }
+
+        level.Request = Assets::LoadTileMapAsync(path.string(), _definitions);
+        level.State = LevelState::Loading;
+
+        _log->debug("Streaming in level '{}' from {}", info.Identifier, path.string());
+    }
+
+    bool WorldStreamer::AttachLevel(size_t levelIndex) {
+        auto& info = _index.Levels[levelIndex];
+        auto& level = _levels[levelIndex];
+        auto& map = Assets::GetTileMap(level.Request.Id);
+
+        size_t cellSize = map.TerrainLayer.CellSize;
+        if (cellSize == 0) {
+            _log->error("Level '{}' has no Terrain layer", info.Identifier);
+            return false;
+        }
+        if (_cellSize != 0 && cellSize != _cellSize) {
+            _log->error("Level '{}' has cell size {}, but other levels of the world use {}", info.Identifier, cellSize, _cellSize);
+            return false;
+        }
+        if (info.Position.x % static_cast<int>(cellSize) != 0 || info.Position.y % static_cast<int>(cellSize) != 0) {
+            _log->warn("Level '{}' is not aligned to the grid - its navigation data will be shifted", info.Identifier);
+        }
+        _cellSize = cellSize;
+
+        size_t entityId;
+        if (!_freeEntities.empty()) {
+            entityId = _freeEntities.back();
+            _freeEntities.pop_back();
+        } else {
+            auto entity = _scene.AddEntity(info.Identifier);
+            if (entity == nullptr) return false;
+            if (entity->AddComponent<ECS::TransformComponent>() == nullptr) return false;
+            if (entity->AddComponent<ECS::TileMapComponent>() == nullptr) return false;
+            entityId = entity->Id;
+        }
+
+        auto entity = _scene.GetEntity(entityId);
+        auto transform = _scene.GetComponent<ECS::TransformComponent>(entityId);
+        auto tileMap = _scene.GetComponent<ECS::TileMapComponent>(entityId);
+
+        entity->Name = info.Identifier;
+        transform->Position = sf::Vector2f(info.Position);
+        transform->Active = true;
+        tileMap->Layer = Layer;
+        tileMap->SetMapId(level.Request.Id);
+        tileMap->Active = true;
+
+        // rebuilds run on loader threads - they get a copy, as the map may be unloaded meanwhile
+        auto& mapGrid = map.NavGrid;
+        auto navigation = std::make_shared<LevelNavigation>();
+        navigation->X = FloorDivide(info.Position.x, static_cast<long long>(cellSize));
+        navigation->Y = FloorDivide(info.Position.y, static_cast<long long>(cellSize));
+        navigation->Width = mapGrid.Width;
+        navigation->Height = mapGrid.Height;
+        navigation->Cells.reserve(mapGrid.GetCellCount());
+        for (size_t i = 0; i < mapGrid.GetCellCount(); i++) {
+            navigation->Cells.push_back(mapGrid.GetCell(i));
+        }
+
+        level.MapId = level.Request.Id;
+        level.EntityId = entityId;
+        level.Navigation = std::move(navigation);
+        level.State = LevelState::Loaded;
+        _navGridDirty = true;
+
+        _log->debug("Level '{}' streamed in", info.Identifier);
+        return true;
+    }
+
+    void WorldStreamer::EvictLevel(size_t levelIndex) {
+        auto& level = _levels[levelIndex];
+
+        _scene.GetComponent<ECS::TransformComponent>(level.EntityId)->Active = false;
+        _scene.GetComponent<ECS::TileMapComponent>(level.EntityId)->Active = false;
+        _freeEntities.push_back(level.EntityId);
+
+        Assets::UnloadTileMap(level.MapId);
+
+        level.MapId = Config::MAX_SIZE;
+        level.EntityId = Config::MAX_SIZE;
+        level.Navigation.reset();
+        level.State = LevelState::Unloaded;
+        _navGridDirty = true;
+
+        _log->debug("Level '{}' streamed out", _index.Levels[levelIndex].Identifier);
+    }
+
+    void WorldStreamer::ReleaseLoadingLevels() {
+        for (auto& level: _levels) {
+            if (level.State == LevelState::Loading) {
+                Assets::UnloadTileMapWhenLoaded(level.Request);
+                level.State = LevelState::Unloaded;
+            }
+        }
+    }
+
+    void WorldStreamer::RebuildNavigationGrid() {
+        _navGridDirty = false;
+
+        std::vector<std::shared_ptr<const LevelNavigation>> levels;
+        for (auto& level: _levels) {
+            if (level.State == LevelState::Loaded) levels.push_back(level.Navigation);
+        }
+
+        auto cellSize = static_cast<long long>(_cellSize);
+        _navBuild = Assets::RunInBackground([levels = std::move(levels), cellSize]() {
+            return StitchNavigationGrid(levels, cellSize);
+        });
+    }
+
+    WorldStreamer::NavigationBuild WorldStreamer::StitchNavigationGrid(const std::vector<std::shared_ptr<const LevelNavigation>>& levels,
+                                                                       long long cellSize) {
+        NavigationBuild build;
+        if (levels.empty()) return build;
+
+        // bounds of all loaded levels, in cells
+        long long minX = std::numeric_limits<long long>::max(), minY = std::numeric_limits<long long>::max();
+        long long maxX = std::numeric_limits<long long>::min(), maxY = std::numeric_limits<long long>::min();
+        for (auto& level: levels) {
+            minX = std::min(minX, level->X);
+            minY = std::min(minY, level->Y);
+            maxX = std::max(maxX, level->X + static_cast<long long>(level->Width));
+            maxY = std::max(maxY, level->Y + static_cast<long long>(level->Height));
+        }
+
+        build.Origin = {static_cast<float>(minX * cellSize), static_cast<float>(minY * cellSize)};
+        build.Grid.Resize(static_cast<size_t>(maxX - minX), static_cast<size_t>(maxY - minY));
+
+        for (auto& level: levels) {
+            auto offsetX = static_cast<size_t>(level->X - minX);
+            auto offsetY = static_cast<size_t>(level->Y - minY);
+
+            for (size_t y = 0; y < level->Height; y++) {
+                for (size_t x = 0; x < level->Width; x++) {
+                    build.Grid.SetCell((offsetY + y) * build.Grid.Width + offsetX + x, level->Cells[y * level->Width + x]);
+                }
+            }
+        }
+
+        build.Grid.BuildRegions();
+        return build;
+    }
+}
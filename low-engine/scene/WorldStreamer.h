@@ -0,0 +1,246 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Config.h"
+#include "assets/AssetRequest.h"
+#include "assets/terrain/LayerDefinition.h"
+#include "assets/terrain/WorldIndex.h"
+#include "assets/terrain/navigation/NavigationGrid.h"
+#include "scene/Scene.h"
+
+namespace LowEngine {
+    /**
+     * @brief State of a single level managed by World Streamer.
+     */
+    enum class LevelState {
+        Unloaded,
+        /**
+         * @brief Level file is being read on a loader thread.
+         */
+        Loading,
+        Loaded,
+        /**
+         * @brief Level could not be loaded. It's not requested again.
+         */
+        Failed
+    };
+
+    /**
+     * @brief Streams levels of LDTk world in and out of a scene, around a focus point (usually the camera).
+     *
+     * Levels closer than LoadDistance are requested with Assets::LoadTileMapAsync(), so files are parsed on loader
+     * threads. Loaded levels are attached to Entities with Tile Map Component, placed at level's position in the world.
+     * Levels further than UnloadDistance are evicted - their maps are unloaded and Entities are deactivated and reused
+     * by the next loaded level, so memory use depends only on the area around the focus point.
+     *
+     * Navigation grids of loaded levels are stitched into a single grid in world space, so paths can cross level borders.
+     * Stitching runs on loader threads - until it finishes, paths are searched on the previous grid.
+     * All levels must use the same cell size.
+     *
+     * If a cooked map (*.lowmap) with level's name exists next to the level file, it's loaded instead.
+     */
+    class WorldStreamer {
+    public:
+        /**
+         * @brief Distance, in Units, between the focus point and level's area at which the level is loaded.
+         */
+        float LoadDistance = Config::WORLD_LOAD_DISTANCE;
+
+        /**
+         * @brief Distance, in Units, between the focus point and level's area at which the level is evicted.
+         *
+         * Must be larger than LoadDistance.
+         */
+        float UnloadDistance = Config::WORLD_UNLOAD_DISTANCE;
+
+        /**
+         * @brief Layer of Tile Map Components created for levels.
+         */
+        int Layer = 0;
+
+        /**
+         * @brief Create streamer that places levels in provided scene.
+         * @param scene Scene that receives level Entities. Must outlive the streamer.
+         */
+        explicit WorldStreamer(Scene& scene) : _scene(scene) {
+        }
+
+        /**
+         * @brief Unload all loaded levels. Levels that are still loading are unloaded by Assets once they finish.
+         */
+        ~WorldStreamer();
+
+        WorldStreamer(const WorldStreamer&) = delete;
+
+        WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+        /**
+         * @brief Read world index from LDTk project file (*.ldtk). Levels are not loaded until Update() is called.
+         *
+         * Levels of previous world are unloaded - ones still loading are unloaded by Assets once they finish.
+         * @param path Path to the LDTk project file.
+         * @param definitions Definitions of layers, shared by all levels of the world.
+         * @return True if successful.
+         */
+        bool Load(const std::string& path, const std::vector<Terrain::LayerDefinition>& definitions);
+
+        /**
+         * @brief Request levels around the focus point, attach finished levels and evict distant ones.
+         *
+         * Must be called on the main thread, usually once per frame.
+         * @param focus Point in the world, in Units, that levels are streamed around.
+         */
+        void Update(sf::Vector2f focus);
+
+        /**
+         * @brief Unload all levels and deactivate their Entities.
+         *
+         * Levels that are still loading are attached or dropped by the next Update(), depending on their distance.
+         */
+        void UnloadAll();
+
+        /**
+         * @brief Find a path on stitched navigation grid of loaded levels.
+         * @param start Start position in the world, in Units.
+         * @param end End position in the world, in Units.
+         * @param movementType Type of movement.
+         * @return Positions of top-left corners of path's cells, in Units. Empty if there's no path or position is outside of loaded levels.
+         */
+        std::vector<sf::Vector2f> FindPath(sf::Vector2f start, sf::Vector2f end, Terrain::Navigation::MovementType movementType);
+
+        /**
+         * @brief Find a path on stitched navigation grid of loaded levels, into a path reused between searches.
+         * @param start Start position in the world, in Units.
+         * @param end End position in the world, in Units.
+         * @param movementType Type of movement.
+         * @param path Receives the path. Its Origin and CellSize are set, so GetPoint() gives positions in Units.
+         * @return True if path was found.
+         */
+        bool FindPath(sf::Vector2f start, sf::Vector2f end, Terrain::Navigation::MovementType movementType, Terrain::Navigation::NavigationPath& path);
+
+        /**
+         * @brief Retrieve world index.
+         */
+        [[nodiscard]] const Terrain::WorldIndex& GetIndex() const { return _index; }
+
+        /**
+         * @brief Retrieve state of a level.
+         * @param levelIndex Index of the level in world index.
+         */
+        [[nodiscard]] LevelState GetLevelState(size_t levelIndex) const;
+
+        /**
+         * @brief Retrieve number of levels that are currently loaded.
+         */
+        [[nodiscard]] size_t GetLoadedLevelCount() const;
+
+        /**
+         * @brief Retrieve navigation grid stitched from all loaded levels.
+         *
+         * Cells not covered by any loaded level are not walkable, swimmable nor flyable.
+         * Grid is replaced by Update() once stitching started by level changes finishes.
+         */
+        [[nodiscard]] const Terrain::Navigation::NavigationGrid& GetNavigationGrid() const { return _navGrid; }
+
+        /**
+         * @brief Position of navigation grid's top-left cell in the world, in Units.
+         */
+        [[nodiscard]] sf::Vector2f GetNavigationOrigin() const { return _navOrigin; }
+
+    protected:
+        /**
+         * @brief Navigation cells of a loaded level, placed in the world.
+         */
+        struct LevelNavigation {
+            /**
+             * @brief Position of level's top-left cell, in cells.
+             */
+            long long X = 0;
+            long long Y = 0;
+            size_t Width = 0;
+            size_t Height = 0;
+            std::vector<Terrain::Navigation::NavigationCell> Cells;
+        };
+
+        /**
+         * @brief Stitched navigation grid, built on a loader thread.
+         */
+        struct NavigationBuild {
+            Terrain::Navigation::NavigationGrid Grid;
+            sf::Vector2f Origin;
+        };
+
+        /**
+         * @brief Streaming state of a single level from world index.
+         */
+        struct StreamedLevel {
+            LevelState State = LevelState::Unloaded;
+            AssetRequest Request;
+            /**
+             * @brief Id of the map in Assets. Valid only if level is Loaded.
+             */
+            size_t MapId = Config::MAX_SIZE;
+            /**
+             * @brief Id of the Entity that displays the level. Valid only if level is Loaded.
+             */
+            size_t EntityId = Config::MAX_SIZE;
+            /**
+             * @brief Copy of level's navigation data for stitching. Valid only if level is Loaded.
+             */
+            std::shared_ptr<const LevelNavigation> Navigation;
+        };
+
+        Scene& _scene;
+        Terrain::WorldIndex _index;
+        std::vector<Terrain::LayerDefinition> _definitions;
+        std::vector<StreamedLevel> _levels;
+
+        /**
+         * @brief Entities of evicted levels, ready to be reused.
+         */
+        std::vector<size_t> _freeEntities;
+
+        Terrain::Navigation::NavigationGrid _navGrid;
+        sf::Vector2f _navOrigin;
+        size_t _cellSize = 0;
+        bool _navGridDirty = false;
+        /**
+         * @brief Rebuild of the stitched grid in progress, if any.
+         */
+        std::future<NavigationBuild> _navBuild;
+
+        /**
+         * @brief Distance from a point to level's area, in Units. Zero if point is inside the level.
+         */
+        [[nodiscard]] static float DistanceToLevel(const Terrain::WorldLevel& level, sf::Vector2f point);
+
+        void RequestLevel(size_t levelIndex);
+
+        /**
+         * @brief Attach a level that finished loading to an Entity. Returns false if level could not be used.
+         */
+        bool AttachLevel(size_t levelIndex);
+
+        void EvictLevel(size_t levelIndex);
+
+        /**
+         * @brief Hand maps of levels that are still loading over to Assets, so they are unloaded once they finish.
+         */
+        void ReleaseLoadingLevels();
+
+        /**
+         * @brief Start rebuilding stitched navigation grid from navigation grids of all loaded levels, on a loader thread.
+         */
+        void RebuildNavigationGrid();
+
+        /**
+         * @brief Stitch navigation data of levels into a single grid and label its regions. Runs on a loader thread.
+         */
+        [[nodiscard]] static NavigationBuild StitchNavigationGrid(const std::vector<std::shared_ptr<const LevelNavigation>>& levels,
+                                                                  long long cellSize);
+    };
+}
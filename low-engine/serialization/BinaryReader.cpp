@@ -0,0 +1,57 @@
+#include "BinaryReader.h"
+
+namespace LowEngine::Serialization {
+    void BinaryReader::ReadBlock(void* destination, size_t size) {
+        if (size == 0) return;
+
+        if (!CanRead(size)) {
+            _failed = true;
+            std::memset(destination, 0, size);
+            return;
+        }
+
+        std::memcpy(destination, _data.data() + _position, size);
+        _position += size;
+    }
+
+    std::string BinaryReader::ReadString() {
+        auto length = Read<uint32_t>();
+        if (!CanRead(length)) {
+            _failed = true;
+            return {};
+        }
+
+        std::string value(reinterpret_cast<const char*>(_data.data() + _position), length);
+        _position += length;
+        return value;
+    }
+
+    BinaryReader BinaryReader::Sub(size_t size) {
+        if (!CanRead(size)) {
+            _failed = true;
+            BinaryReader failed;
+            failed._failed = true;
+            return failed;
+        }
+
+        BinaryReader sub(_data.subspan(_position, size));
+        _position += size;
+        return sub;
+    }
+
+    void BinaryReader::Seek(size_t position) {
+        if (position > _data.size()) {
+            _failed = true;
+            return;
+        }
+        _position = position;
+    }
+
+    void BinaryReader::Skip(size_t size) {
+        if (!CanRead(size)) {
+            _failed = true;
+            return;
+        }
+        _position += size;
+    }
+}
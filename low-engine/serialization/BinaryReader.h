@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace LowEngine::Serialization {
+    /**
+     * @brief Bounds-checked reader over a block of binary data.
+     *
+     * Reader does not own the data - it can point to a file loaded into memory or to a memory-mapped file.
+     * Any out-of-range read puts the reader in failed state. All following reads return zeroed values.
+     */
+    class BinaryReader {
+    public:
+        BinaryReader() = default;
+
+        explicit BinaryReader(std::span<const std::byte> data) : _data(data) {
+        }
+
+        /**
+         * @brief Read a single trivially copyable value.
+         * @tparam T Type of the value.
+         * @return Value read. Zero-initialized value if reader failed.
+         */
+        template<typename T>
+        T Read() {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read directly");
+            T value{};
+            ReadBlock(&value, sizeof(T));
+            return value;
+        }
+
+        /**
+         * @brief Read a block of trivially copyable values into pre-sized vector.
+         * @tparam T Type of the values.
+         * @param[out] values Vector that will be resized to count and filled with data.
+         * @param count Number of values to read.
+         */
+        template<typename T>
+        void ReadArray(std::vector<T>& values, size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read directly");
+            if (!CanReadArray<T>(count)) {
+                _failed = true;
+                values.clear();
+                return;
+            }
+            values.resize(count);
+            ReadBlock(values.data(), count * sizeof(T));
+        }
+
+        /**
+         * @brief Get a view on the next count values without copying them.
+         *
+         * Data must be suitably aligned for T. Reader position is advanced past the values.
+         * @tparam T Type of the values.
+         * @param count Number of values.
+         * @return View on the values. Empty view if reader failed.
+         */
+        template<typename T>
+        std::span<const T> View(size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be viewed directly");
+            if (!CanReadArray<T>(count) || reinterpret_cast<uintptr_t>(_data.data() + _position) % alignof(T) != 0) {
+                _failed = true;
+                return {};
+            }
+            auto ptr = reinterpret_cast<const T*>(_data.data() + _position);
+            _position += count * sizeof(T);
+            return {ptr, count};
+        }
+
+        /**
+         * @brief Read raw block of bytes.
+         * @param destination Pointer to memory that will receive the data.
+         * @param size Number of bytes to read.
+         */
+        void ReadBlock(void* destination, size_t size);
+
+        /**
+         * @brief Read length-prefixed string.
+         * @return String read. Empty string if reader failed.
+         */
+        std::string ReadString();
+
+        /**
+         * @brief Sub-reader over next size bytes. Reader position is advanced past the block.
+         * @param size Size of the block, in bytes.
+         * @return Reader limited to the block.
+         */
+        BinaryReader Sub(size_t size);
+
+        /**
+         * @brief Move reader to provided position.
+         * @param position Position from the start of the data, in bytes.
+         */
+        void Seek(size_t position);
+
+        /**
+         * @brief Skip padding, so next read starts at a multiple of alignment.
+         * @param alignment Alignment, in bytes.
+         */
+        void Align(size_t alignment) {
+            Skip((alignment - _position % alignment) % alignment);
+        }
+
+        /**
+         * @brief Skip provided number of bytes.
+         * @param size Number of bytes to skip.
+         */
+        void Skip(size_t size);
+
+        /**
+         * @brief Current read position, in bytes.
+         */
+        [[nodiscard]] size_t Position() const { return _position; }
+
+        /**
+         * @brief Number of bytes left to read.
+         */
+        [[nodiscard]] size_t Remaining() const { return _data.size() - _position; }
+
+        /**
+         * @brief Did any read go out of range?
+         */
+        [[nodiscard]] bool Failed() const { return _failed; }
+
+        /**
+         * @brief Whole data block this reader operates on.
+         */
+        [[nodiscard]] std::span<const std::byte> Data() const { return _data; }
+
+    protected:
+        std::span<const std::byte> _data;
+        size_t _position = 0;
+        bool _failed = false;
+
+        [[nodiscard]] bool CanRead(size_t size) const {
+            return !_failed && size <= _data.size() - _position;
+        }
+
+        /**
+         * @brief Check if count values of type T can be read. Count is checked before multiplying, so it can't wrap.
+         */
+        template<typename T>
+        [[nodiscard]] bool CanReadArray(size_t count) const {
+            return !_failed && count <= (_data.size() - _position) / sizeof(T);
+        }
+    };
+}
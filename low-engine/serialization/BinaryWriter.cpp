@@ -0,0 +1,36 @@
+#include "BinaryWriter.h"
+
+#include <fstream>
+
+#include "Log.h"
+
+namespace LowEngine::Serialization {
+    void BinaryWriter::WriteBlock(const void* data, size_t size) {
+        if (size == 0) return;
+
+        size_t position = _buffer.size();
+        _buffer.resize(position + size);
+        std::memcpy(_buffer.data() + position, data, size);
+    }
+
+    void BinaryWriter::WriteString(std::string_view value) {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBlock(value.data(), value.size());
+    }
+
+    bool BinaryWriter::SaveToFile(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            _log->error("Failed to open file '{}' for writing", path);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+        if (!file.good()) {
+            _log->error("Failed to write {} bytes to file '{}'", _buffer.size(), path);
+            return false;
+        }
+
+        return true;
+    }
+}
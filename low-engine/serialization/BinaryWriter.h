@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace LowEngine::Serialization {
+    /**
+     * @brief Append-only binary buffer used to build save files in memory.
+     *
+     * Values are written in host byte order (little-endian on all supported platforms).
+     * Only trivially copyable types can be written directly - everything else must be converted to a record first.
+     */
+    class BinaryWriter {
+    public:
+        BinaryWriter() = default;
+
+        /**
+         * @brief Create writer with pre-allocated buffer.
+         * @param reserveBytes Number of bytes to reserve up-front.
+         */
+        explicit BinaryWriter(size_t reserveBytes) {
+            _buffer.reserve(reserveBytes);
+        }
+
+        /**
+         * @brief Discard written data, keeping the buffer's memory for the next use.
+         */
+        void Clear() {
+            _buffer.clear();
+        }
+
+        /**
+         * @brief Write a single trivially copyable value.
+         * @tparam T Type of the value.
+         * @param value Value to write.
+         */
+        template<typename T>
+        void Write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written directly");
+            WriteBlock(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Write a contiguous array of trivially copyable values as a single block.
+         * @tparam T Type of the values.
+         * @param values Values to write.
+         */
+        template<typename T>
+        void WriteArray(const std::vector<T>& values) {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written directly");
+            WriteBlock(values.data(), values.size() * sizeof(T));
+        }
+
+        /**
+         * @brief Append zeroed space for an array of trivially copyable values, to be filled in place.
+         *
+         * Saves building a temporary array just to copy it. Pointer is valid only until the next write.
+         * @tparam T Type of the values.
+         * @param count Number of values.
+         * @return Pointer to the first value.
+         */
+        template<typename T>
+        T* AppendArray(size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written directly");
+            size_t position = _buffer.size();
+            _buffer.resize(position + count * sizeof(T));
+            return reinterpret_cast<T*>(_buffer.data() + position);
+        }
+
+        /**
+         * @brief Write raw block of bytes.
+         * @param data Pointer to the data.
+         * @param size Size of the data, in bytes.
+         */
+        void WriteBlock(const void* data, size_t size);
+
+        /**
+         * @brief Write length-prefixed string.
+         * @param value String to write.
+         */
+        void WriteString(std::string_view value);
+
+        /**
+         * @brief Pad the buffer with zeros, so next write starts at a multiple of alignment.
+         * @param alignment Alignment, in bytes.
+         */
+        void Align(size_t alignment) {
+            size_t padding = (alignment - _buffer.size() % alignment) % alignment;
+            _buffer.resize(_buffer.size() + padding, std::byte{0});
+        }
+
+        /**
+         * @brief Overwrite previously written value.
+         *
+         * Used to fill offsets and sizes that are only known after following data was written.
+         * @tparam T Type of the value.
+         * @param position Position in the buffer, in bytes.
+         * @param value New value.
+         */
+        template<typename T>
+        void Patch(size_t position, const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written directly");
+            std::memcpy(_buffer.data() + position, &value, sizeof(T));
+        }
+
+        /**
+         * @brief Current write position, in bytes.
+         */
+        [[nodiscard]] size_t Position() const { return _buffer.size(); }
+
+        /**
+         * @brief Pointer to written data.
+         */
+        [[nodiscard]] const std::byte* Data() const { return _buffer.data(); }
+
+        /**
+         * @brief Access underlying buffer. Can be moved out once writing is done.
+         */
+        std::vector<std::byte>& Buffer() { return _buffer; }
+
+        /**
+         * @brief Write content of the buffer to a file.
+         * @param path Path to the file.
+         * @return True if successful. False otherwise.
+         */
+        [[nodiscard]] bool SaveToFile(const std::string& path) const;
+
+    protected:
+        std::vector<std::byte> _buffer;
+    };
+}
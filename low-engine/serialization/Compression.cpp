@@ -0,0 +1,222 @@
+#include "Compression.h"
+
+#include <cstring>
+
+#include "BinaryReader.h"
+#include "Log.h"
+
+namespace LowEngine::Serialization {
+    namespace {
+        constexpr size_t MIN_MATCH = 4;
+        constexpr size_t LAST_LITERALS = 5; // last bytes of input are always literals
+        constexpr size_t MATCH_FIND_LIMIT = 12; // last match must start this far from the end of input
+        constexpr size_t MAX_OFFSET = 65535;
+        constexpr uint32_t HASH_BITS = 12;
+
+        uint32_t Read32(const uint8_t* ptr) {
+            uint32_t value;
+            std::memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+        uint32_t Hash(uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - HASH_BITS);
+        }
+
+        uint8_t* WriteLength(uint8_t* op, size_t length) {
+            while (length >= 255) {
+                *op++ = 255;
+                length -= 255;
+            }
+            *op++ = static_cast<uint8_t>(length);
+            return op;
+        }
+
+        /**
+         * @brief Write single LZ4 sequence. Match length of 0 writes final literals-only sequence.
+         */
+        uint8_t* WriteSequence(uint8_t* op, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+            uint8_t* token = op++;
+            uint8_t tokenValue;
+
+            if (literalLength >= 15) {
+                tokenValue = 15 << 4;
+                op = WriteLength(op, literalLength - 15);
+            } else {
+                tokenValue = static_cast<uint8_t>(literalLength << 4);
+            }
+            if (literalLength > 0) { // literals of an empty input are a null pointer
+                std::memcpy(op, literals, literalLength);
+            }
+            op += literalLength;
+
+            if (matchLength > 0) {
+                *op++ = static_cast<uint8_t>(offset & 0xFF);
+                *op++ = static_cast<uint8_t>(offset >> 8);
+
+                size_t length = matchLength - MIN_MATCH;
+                if (length >= 15) {
+                    tokenValue |= 15;
+                    op = WriteLength(op, length - 15);
+                } else {
+                    tokenValue |= static_cast<uint8_t>(length);
+                }
+            }
+
+            *token = tokenValue;
+            return op;
+        }
+
+        bool ReadLength(const uint8_t* in, size_t inSize, size_t& ip, size_t& length) {
+            uint8_t value;
+            do {
+                if (ip >= inSize) return false;
+                value = in[ip++];
+                length += value;
+            } while (value == 255);
+            return true;
+        }
+    }
+
+    size_t Lz4Compress(std::span<const std::byte> input, std::vector<std::byte>& output) {
+        const auto* src = reinterpret_cast<const uint8_t*>(input.data());
+        const size_t size = input.size();
+
+        size_t start = output.size();
+        output.resize(start + Lz4CompressBound(size));
+        auto* dst = reinterpret_cast<uint8_t*>(output.data() + start);
+        uint8_t* op = dst;
+
+        size_t anchor = 0;
+        if (size > MATCH_FIND_LIMIT) {
+            std::vector<uint32_t> table(size_t{1} << HASH_BITS, 0);
+            const size_t matchLimit = size - LAST_LITERALS;
+            const size_t searchLimit = size - MATCH_FIND_LIMIT;
+
+            size_t ip = 1;
+            while (ip < searchLimit) {
+                uint32_t sequence = Read32(src + ip);
+                uint32_t hash = Hash(sequence);
+                size_t candidate = table[hash];
+                table[hash] = static_cast<uint32_t>(ip);
+
+                if (ip - candidate > MAX_OFFSET || Read32(src + candidate) != sequence) {
+                    ip++;
+                    continue;
+                }
+
+                // extend match backwards into pending literals
+                while (ip > anchor && candidate > 0 && src[ip - 1] == src[candidate - 1]) {
+                    ip--;
+                    candidate--;
+                }
+
+                size_t matchLength = MIN_MATCH;
+                while (ip + matchLength < matchLimit && src[ip + matchLength] == src[candidate + matchLength]) {
+                    matchLength++;
+                }
+
+                op = WriteSequence(op, src + anchor, ip - anchor, ip - candidate, matchLength);
+                ip += matchLength;
+                anchor = ip;
+            }
+        }
+
+        op = WriteSequence(op, src + anchor, size - anchor, 0, 0);
+
+        size_t compressedSize = static_cast<size_t>(op - dst);
+        output.resize(start + compressedSize);
+        return compressedSize;
+    }
+
+    bool Lz4Decompress(std::span<const std::byte> input, std::span<std::byte> output) {
+        const auto* in = reinterpret_cast<const uint8_t*>(input.data());
+        auto* out = reinterpret_cast<uint8_t*>(output.data());
+        const size_t inSize = input.size();
+        const size_t outSize = output.size();
+
+        size_t ip = 0;
+        size_t op = 0;
+        while (ip < inSize) {
+            uint8_t token = in[ip++];
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !ReadLength(in, inSize, ip, literalLength)) return false;
+            if (literalLength > inSize - ip || literalLength > outSize - op) return false;
+            if (literalLength > 0) {
+                std::memcpy(out + op, in + ip, literalLength);
+            }
+            ip += literalLength;
+            op += literalLength;
+
+            if (ip == inSize) break; // final sequence has no match
+
+            if (inSize - ip < 2) return false;
+            size_t offset = in[ip] | (static_cast<size_t>(in[ip + 1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > op) return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !ReadLength(in, inSize, ip, matchLength)) return false;
+            matchLength += MIN_MATCH;
+            if (matchLength > outSize - op) return false;
+
+            if (offset >= matchLength) {
+                std::memcpy(out + op, out + op - offset, matchLength);
+                op += matchLength;
+            } else {
+                // overlapping match repeats last offset bytes
+                for (size_t i = 0; i < matchLength; i++, op++) {
+                    out[op] = out[op - offset];
+                }
+            }
+        }
+
+        return op == outSize;
+    }
+
+    bool IsCompressedSave(std::span<const std::byte> data) {
+        return data.size() >= sizeof(CompressedHeader) &&
+               std::memcmp(data.data(), CompressedHeader().Magic, sizeof(CompressedHeader::Magic)) == 0;
+    }
+
+    bool DecompressSave(std::span<const std::byte> data, std::vector<std::byte>& output) {
+        BinaryReader reader(data);
+        auto header = reader.Read<CompressedHeader>();
+        if (reader.Failed() || !IsCompressedSave(data) || header.Version != CompressedHeader().Version) {
+            _log->error("Compressed save data is corrupted or has unsupported version");
+            return false;
+        }
+
+        // sizes are checked before the output is allocated - a corrupted header must not commit gigabytes
+        if (header.BlockCount > reader.Remaining() / sizeof(CompressedBlockHeader) ||
+            header.UncompressedSize > static_cast<uint64_t>(header.BlockCount) * COMPRESSED_BLOCK_SIZE) {
+            _log->error("Compressed save data is corrupted: {} blocks can't hold {} bytes", header.BlockCount, header.UncompressedSize);
+            return false;
+        }
+
+        output.resize(header.UncompressedSize);
+        size_t position = 0;
+        for (uint32_t i = 0; i < header.BlockCount; i++) {
+            auto block = reader.Read<CompressedBlockHeader>();
+            auto compressed = reader.View<std::byte>(block.CompressedSize);
+            if (reader.Failed() || block.UncompressedSize > output.size() - position) {
+                _log->error("Compressed save data is corrupted: invalid block {}", i);
+                return false;
+            }
+
+            if (!Lz4Decompress(compressed, std::span(output).subspan(position, block.UncompressedSize))) {
+                _log->error("Compressed save data is corrupted: failed to decompress block {}", i);
+                return false;
+            }
+            position += block.UncompressedSize;
+        }
+
+        if (position != output.size()) {
+            _log->error("Compressed save data is corrupted: expected {} bytes, got {}", output.size(), position);
+            return false;
+        }
+
+        return true;
+    }
+}
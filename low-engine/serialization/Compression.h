@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace LowEngine::Serialization {
+    /**
+     * @brief Size of a single independently compressed block of a save file, in bytes.
+     */
+    inline constexpr uint32_t COMPRESSED_BLOCK_SIZE = 1u << 20;
+
+    /**
+     * @brief Header of compressed save file.
+     *
+     * Followed by BlockCount blocks, each starting with CompressedBlockHeader.
+     */
+    struct CompressedHeader {
+        char Magic[4] = {'L', 'O', 'W', 'Z'};
+        uint32_t Version = 1;
+        uint64_t UncompressedSize = 0;
+        uint32_t BlockSize = COMPRESSED_BLOCK_SIZE;
+        uint32_t BlockCount = 0;
+    };
+
+    /**
+     * @brief Header of a single compressed block.
+     */
+    struct CompressedBlockHeader {
+        uint32_t CompressedSize = 0;
+        uint32_t UncompressedSize = 0;
+    };
+
+    /**
+     * @brief Maximum size of data compressed with Lz4Compress.
+     * @param size Size of input data, in bytes.
+     * @return Worst-case size of compressed data, in bytes.
+     */
+    constexpr size_t Lz4CompressBound(size_t size) {
+        return size + size / 255 + 16;
+    }
+
+    /**
+     * @brief Compress data into LZ4 block format.
+     *
+     * Fast greedy compressor - good ratio on save data that is mostly small integers and repeated records.
+     * @param input Data to compress.
+     * @param[out] output Vector that compressed data will be appended to.
+     * @return Size of compressed data, in bytes.
+     */
+    size_t Lz4Compress(std::span<const std::byte> input, std::vector<std::byte>& output);
+
+    /**
+     * @brief Decompress data in LZ4 block format.
+     * @param input Compressed data.
+     * @param output Memory for decompressed data. Must have exactly the size of original data.
+     * @return True if successful. False if data was corrupted.
+     */
+    bool Lz4Decompress(std::span<const std::byte> input, std::span<std::byte> output);
+
+    /**
+     * @brief Check if data starts with CompressedHeader.
+     * @param data Content of the file.
+     */
+    bool IsCompressedSave(std::span<const std::byte> data);
+
+    /**
+     * @brief Decompress whole compressed save file.
+     * @param data Content of the file, starting with CompressedHeader.
+     * @param[out] output Vector that will receive decompressed data.
+     * @return True if successful. False if data was corrupted.
+     */
+    bool DecompressSave(std::span<const std::byte> data, std::vector<std::byte>& output);
+}
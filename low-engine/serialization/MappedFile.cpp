@@ -0,0 +1,117 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Log.h"
+
+namespace LowEngine::Serialization {
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Open(const std::string& path) {
+        Close();
+
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            _log->error("Failed to open file '{}' for mapping", path);
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            _log->error("Failed to map file '{}': file is empty or its size can't be read", path);
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            _log->error("Failed to create mapping for file '{}'", path);
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr) {
+            _log->error("Failed to map view of file '{}'", path);
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        _fileHandle = file;
+        _mappingHandle = mapping;
+        _data = static_cast<const std::byte*>(view);
+        _size = static_cast<size_t>(size.QuadPart);
+        _path = path;
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (_data != nullptr) UnmapViewOfFile(_data);
+        if (_mappingHandle != nullptr) CloseHandle(_mappingHandle);
+        if (_fileHandle != nullptr) CloseHandle(_fileHandle);
+
+        _data = nullptr;
+        _size = 0;
+        _mappingHandle = nullptr;
+        _fileHandle = nullptr;
+        _path.clear();
+    }
+#else
+    bool MappedFile::Open(const std::string& path) {
+        Close();
+
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            _log->error("Failed to open file '{}' for mapping", path);
+            return false;
+        }
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            _log->error("Failed to map file '{}': file is empty or its size can't be read", path);
+            close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            _log->error("Failed to map file '{}'", path);
+            close(fd);
+            return false;
+        }
+
+        _fileDescriptor = fd;
+        _data = static_cast<const std::byte*>(view);
+        _size = static_cast<size_t>(info.st_size);
+        _path = path;
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (_data != nullptr) munmap(const_cast<std::byte*>(_data), _size);
+        if (_fileDescriptor >= 0) close(_fileDescriptor);
+
+        _data = nullptr;
+        _size = 0;
+        _fileDescriptor = -1;
+        _path.clear();
+    }
+#endif
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace LowEngine::Serialization {
+    /**
+     * @brief Read-only memory-mapped file.
+     *
+     * File content is paged in by the operating system on first access, so opening even a large file is cheap.
+     * Mapping stays valid until the object is destroyed or Close() is called.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Map file into memory. Previously mapped file is closed.
+         * @param path Path to the file.
+         * @return True if successful. False otherwise.
+         */
+        bool Open(const std::string& path);
+
+        /**
+         * @brief Unmap the file.
+         */
+        void Close();
+
+        /**
+         * @brief Is file currently mapped?
+         */
+        [[nodiscard]] bool IsOpen() const { return _data != nullptr; }
+
+        /**
+         * @brief View on the whole content of the file.
+         */
+        [[nodiscard]] std::span<const std::byte> Data() const { return {_data, _size}; }
+
+        /**
+         * @brief Path of the mapped file.
+         */
+        [[nodiscard]] const std::string& Path() const { return _path; }
+
+    protected:
+        const std::byte* _data = nullptr;
+        size_t _size = 0;
+        std::string _path;
+
+#ifdef _WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#else
+        int _fileDescriptor = -1;
+#endif
+    };
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LowEngine::Serialization {
+    /**
+     * @brief Current version of the binary save format.
+     *
+     * Increase when layout of any header or Component's Record changes. Files with different version are rejected.
+     */
+    inline constexpr uint32_t SAVE_FORMAT_VERSION = 1;
+
+    /**
+     * @brief Alignment of every block in the save file, in bytes.
+     *
+     * Keeps record blocks aligned, so they can be used in-place when file is memory-mapped.
+     */
+    inline constexpr size_t SAVE_BLOCK_ALIGNMENT = 16;
+
+    /**
+     * @brief Defines how Component Pools are restored from a save file.
+     */
+    enum class LoadMode {
+        /**
+         * @brief All Component Pools are deserialized during load.
+         */
+        Eager,
+        /**
+         * @brief Save file is memory-mapped and each Component Pool is deserialized on first access.
+         */
+        Lazy
+    };
+
+    /**
+     * @brief Header of the save file written by Scene.
+     *
+     * Memory block follows the header, starting at MemoryOffset.
+     */
+    struct SceneHeader {
+        char Magic[4] = {'L', 'O', 'W', 'S'};
+        uint32_t Version = SAVE_FORMAT_VERSION;
+        uint64_t CameraEntityId = 0;
+        uint32_t SpriteSortingMethod = 0;
+        uint32_t Flags = 0;
+        uint64_t MemoryOffset = 0;
+    };
+
+    /**
+     * @brief Header of the Memory block in save file.
+     *
+     * Offsets are relative to the beginning of this header.
+     */
+    struct MemoryHeader {
+        char Magic[4] = {'L', 'O', 'W', 'M'};
+        uint32_t Version = SAVE_FORMAT_VERSION;
+        uint64_t EntityCount = 0;
+        uint64_t PoolCount = 0;
+        uint64_t EntityTableOffset = 0;
+        uint64_t PoolDirectoryOffset = 0;
+        uint64_t TotalSize = 0;
+    };
+
+    /**
+     * @brief Serialized state of a single Entity.
+     */
+    struct EntityRecord {
+        uint64_t Id = 0;
+        uint32_t NameOffset = 0;
+        uint32_t NameLength = 0;
+        uint8_t Active = 0;
+        uint8_t Padding[7] = {};
+    };
+
+    /**
+     * @brief Entry in the directory of Component Pools.
+     *
+     * Type name is stored as a length-prefixed string right before the entry.
+     */
+    struct PoolDirectoryEntry {
+        uint64_t Offset = 0;
+        uint64_t Size = 0;
+        uint64_t Count = 0;
+        uint32_t RecordSize = 0;
+        uint32_t Flags = 0;
+    };
+
+    /**
+     * @brief Reference to a string stored in StringTable.
+     */
+    struct StringRef {
+        uint32_t Offset = 0;
+        uint32_t Length = 0;
+    };
+
+    /**
+     * @brief Collects strings referenced by records, so records themselves can stay trivially copyable.
+     */
+    class StringTable {
+    public:
+        StringTable() = default;
+
+        /**
+         * @brief Create read-only table over existing data. Data is not copied.
+         * @param data View on the table's content.
+         */
+        explicit StringTable(std::string_view data) : _view(data) {
+        }
+
+        /**
+         * @brief Add string to the table.
+         * @param value String to add.
+         * @return Reference that can be stored in a record.
+         */
+        StringRef Add(std::string_view value) {
+            StringRef ref{static_cast<uint32_t>(_data.size()), static_cast<uint32_t>(value.size())};
+            _data.append(value);
+            return ref;
+        }
+
+        /**
+         * @brief Retrieve string stored in the table.
+         * @param ref Reference to the string.
+         * @return View on the string. Empty view if reference is out of range.
+         */
+        [[nodiscard]] std::string_view Get(StringRef ref) const {
+            std::string_view data = Data();
+            if (static_cast<size_t>(ref.Offset) + ref.Length > data.size()) return {};
+            return data.substr(ref.Offset, ref.Length);
+        }
+
+        /**
+         * @brief Raw content of the table.
+         */
+        [[nodiscard]] std::string_view Data() const { return _data.empty() ? _view : std::string_view(_data); }
+
+    protected:
+        std::string _data;
+        std::string_view _view;
+    };
+
+    /**
+     * @brief Component that can be saved to binary file.
+     *
+     * Component must define a trivially copyable Record type and functions converting its state to and from it.
+     * Every SFML object must be stored as data that can recreate it (i.e. Texture's Id instead of the reference).
+     */
+    template<typename T>
+    concept SerializableComponent = requires(const T& constComponent, T& component, typename T::Record& record, StringTable& strings) {
+        requires std::is_trivially_copyable_v<typename T::Record>;
+        { constComponent.ToRecord(record, strings) } -> std::same_as<void>;
+        { component.FromRecord(std::as_const(record), std::as_const(strings)) } -> std::same_as<void>;
+    };
+}
@@ -0,0 +1,103 @@
+#include "AsyncLogSink.h"
+
+namespace LowEngine::Threading {
+    AsyncLogSink::AsyncLogSink(std::shared_ptr<spdlog::sinks::sink> target, size_t queueSize,
+                               std::chrono::milliseconds flushInterval, LogOverflowPolicy overflowPolicy)
+        : _target(std::move(target)), _queue(queueSize), _flushInterval(flushInterval), _overflowPolicy(overflowPolicy) {
+        _writer = std::thread(&AsyncLogSink::WriterLoop, this);
+    }
+
+    AsyncLogSink::~AsyncLogSink() {
+        _stopping.store(true, std::memory_order_release);
+        if (_writer.joinable()) {
+            _writer.join();
+        }
+    }
+
+    void AsyncLogSink::log(const spdlog::details::log_msg& msg) {
+        // copy owns the payload - original points to the caller's stack
+        spdlog::details::log_msg_buffer buffer(msg);
+        if (_queue.TryPush(std::move(buffer))) return;
+
+        if (_overflowPolicy == LogOverflowPolicy::Drop) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        while (!_queue.TryPush(std::move(buffer))) {
+            std::this_thread::yield();
+        }
+    }
+
+    void AsyncLogSink::flush() {
+        size_t ticket = _flushRequests.fetch_add(1, std::memory_order_acq_rel) + 1;
+        while (_flushesDone.load(std::memory_order_acquire) < ticket && _running.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    void AsyncLogSink::set_pattern(const std::string& pattern) {
+        _target->set_pattern(pattern);
+    }
+
+    void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) {
+        _target->set_formatter(std::move(sinkFormatter));
+    }
+
+    void AsyncLogSink::WriterLoop() {
+        auto lastFlush = std::chrono::steady_clock::now();
+        bool unflushed = false;
+
+        while (true) {
+            bool stopping = _stopping.load(std::memory_order_acquire);
+            size_t requests = _flushRequests.load(std::memory_order_acquire);
+            bool flushRequested = requests > _flushesDone.load(std::memory_order_relaxed);
+
+            size_t written = Drain(flushRequested || stopping);
+            unflushed |= written > 0;
+
+            auto now = std::chrono::steady_clock::now();
+            if (flushRequested || stopping || (unflushed && now - lastFlush >= _flushInterval)) {
+                if (unflushed) {
+                    _target->flush();
+                }
+                unflushed = false;
+                lastFlush = now;
+                _flushesDone.store(requests, std::memory_order_release);
+            }
+
+            if (stopping) break;
+
+            if (written == 0) {
+                // nothing to do - polling keeps producers free of any notification cost
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        _running.store(false, std::memory_order_release);
+    }
+
+    size_t AsyncLogSink::Drain(bool complete) {
+        size_t written = 0;
+        spdlog::details::log_msg_buffer message;
+
+        while (true) {
+            while (_queue.TryPop(message)) {
+                try {
+                    _target->log(message);
+                } catch (const std::exception&) {
+                    // nowhere to report it - counting keeps the failure visible in GetDroppedCount()
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                written++;
+            }
+            _queue.SyncSize();
+
+            // slots claimed, but still being copied into by other threads
+            if (!complete || _queue.GetSize() == 0) break;
+            std::this_thread::yield();
+        }
+
+        return written;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <spdlog/sinks/sink.h>
+#include <spdlog/details/log_msg_buffer.h>
+
+#include "threading/RingBuffer.h"
+
+namespace LowEngine::Threading {
+    /**
+     * @brief What logging thread does when the queue of Async Log Sink is full.
+     */
+    enum class LogOverflowPolicy {
+        /**
+         * @brief Wait until the writer makes room. No message is lost.
+         */
+        Block,
+        /**
+         * @brief Discard the message and count it. Logging never waits.
+         */
+        Drop
+    };
+
+    /**
+     * @brief Sink that moves formatting and file writes off the logging threads.
+     *
+     * Messages are copied into a lock-free ring buffer and written to the target sink by a background thread.
+     * Target is flushed by the writer every flush interval, and whenever a logger asks for it
+     * (e.g. with spdlog::logger::flush_on()) - in which case flush() waits until everything queued so far is written.
+     * Destructor writes all queued messages before joining the writer.
+     */
+    class AsyncLogSink : public spdlog::sinks::sink {
+    public:
+        /**
+         * @brief Start the writer thread.
+         * @param target Sink messages are written to. Only the writer thread logs to it.
+         * @param queueSize Maximum number of queued messages.
+         * @param flushInterval Time between periodic flushes of the target. 0 flushes after every batch of messages.
+         * @param overflowPolicy What to do when the queue is full.
+         */
+        AsyncLogSink(std::shared_ptr<spdlog::sinks::sink> target, size_t queueSize,
+                     std::chrono::milliseconds flushInterval, LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Block);
+
+        ~AsyncLogSink() override;
+
+        AsyncLogSink(const AsyncLogSink&) = delete;
+
+        AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+        void log(const spdlog::details::log_msg& msg) override;
+
+        void flush() override;
+
+        void set_pattern(const std::string& pattern) override;
+
+        void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override;
+
+        /**
+         * @brief Retrieve number of messages discarded because the queue was full.
+         */
+        [[nodiscard]] size_t GetDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Retrieve approximate number of messages waiting for the writer.
+         */
+        [[nodiscard]] size_t GetQueuedCount() const { return _queue.GetSize(); }
+
+    protected:
+        std::shared_ptr<spdlog::sinks::sink> _target;
+        RingBuffer<spdlog::details::log_msg_buffer> _queue;
+        std::chrono::milliseconds _flushInterval;
+        LogOverflowPolicy _overflowPolicy;
+
+        std::atomic<size_t> _dropped{0};
+        std::atomic<size_t> _flushRequests{0};
+        std::atomic<size_t> _flushesDone{0};
+        std::atomic<bool> _stopping{false};
+        std::atomic<bool> _running{true};
+        std::thread _writer;
+
+        void WriterLoop();
+
+        /**
+         * @brief Write all queued messages to the target.
+         * @param complete Also wait for messages that producers are still copying into the queue.
+         * @return Number of written messages.
+         */
+        size_t Drain(bool complete);
+    };
+}
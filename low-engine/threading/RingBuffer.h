@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace LowEngine::Threading {
+    /**
+     * @brief Bounded lock-free queue for many producers and a single consumer.
+     *
+     * Every slot carries a sequence number telling whose turn it is - producers claim slots with a single
+     * compare-and-swap on the write position, the consumer never writes to it. Slots are allocated once and reused,
+     * so elements with inline storage (like spdlog's message buffers) don't allocate after warm-up.
+     * @tparam T Type of the elements. Must be default-constructible and move-assignable.
+     */
+    template<typename T>
+    class RingBuffer {
+    public:
+        /**
+         * @brief Allocate slots for the queue.
+         * @param capacity Maximum number of queued elements. Rounded up to the power of two.
+         */
+        explicit RingBuffer(size_t capacity) {
+            _capacity = 2;
+            while (_capacity < capacity) _capacity <<= 1;
+            _mask = _capacity - 1;
+
+            _slots = std::make_unique<Slot[]>(_capacity);
+            for (size_t i = 0; i < _capacity; i++) {
+                _slots[i].Sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        RingBuffer(const RingBuffer&) = delete;
+
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        /**
+         * @brief Add an element. Safe to call from any thread.
+         * @return False if the queue is full - element is left untouched.
+         */
+        template<typename U>
+        bool TryPush(U&& value) {
+            size_t position = _writePosition.load(std::memory_order_relaxed);
+            while (true) {
+                Slot& slot = _slots[position & _mask];
+                size_t sequence = slot.Sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (difference == 0) {
+                    if (_writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        slot.Value = std::forward<U>(value);
+                        slot.Sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    // slot still holds an element from the previous lap - queue is full
+                    return false;
+                } else {
+                    position = _writePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Take the oldest element. Must be called from one thread only.
+         * @param[out] value Receives the element.
+         * @return False if the queue is empty, or the oldest element is still being written.
+         */
+        bool TryPop(T& value) {
+            Slot& slot = _slots[_readPosition & _mask];
+            size_t sequence = slot.Sequence.load(std::memory_order_acquire);
+            if (sequence != _readPosition + 1) return false;
+
+            value = std::move(slot.Value);
+            slot.Sequence.store(_readPosition + _capacity, std::memory_order_release);
+            _readPosition++;
+            return true;
+        }
+
+        /**
+         * @brief Retrieve maximum number of queued elements.
+         */
+        [[nodiscard]] size_t GetCapacity() const { return _capacity; }
+
+        /**
+         * @brief Approximate number of queued elements. Exact only when no other thread uses the queue.
+         */
+        [[nodiscard]] size_t GetSize() const {
+            size_t write = _writePosition.load(std::memory_order_relaxed);
+            size_t read = _readPositionShared.load(std::memory_order_relaxed);
+            return write > read ? write - read : 0;
+        }
+
+        /**
+         * @brief Publish consumer's position for GetSize(). Called by the consumer after a batch of TryPop().
+         */
+        void SyncSize() {
+            _readPositionShared.store(_readPosition, std::memory_order_relaxed);
+        }
+
+    protected:
+        struct Slot {
+            std::atomic<size_t> Sequence{0};
+            T Value{};
+        };
+
+        // producers and consumer hammer different counters - keep them on separate cache lines
+        static constexpr size_t CACHE_LINE = 64;
+
+        std::unique_ptr<Slot[]> _slots;
+        size_t _capacity = 0;
+        size_t _mask = 0;
+
+        alignas(CACHE_LINE) std::atomic<size_t> _writePosition{0};
+        alignas(CACHE_LINE) size_t _readPosition = 0;
+        std::atomic<size_t> _readPositionShared{0};
+    };
+}
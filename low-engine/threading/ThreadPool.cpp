@@ -0,0 +1,81 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+#include "profiling/Profiler.h"
+
+namespace LowEngine::Threading {
+    ThreadPool::ThreadPool(size_t threadCount) {
+        if (threadCount == 0) {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = std::max(1u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u);
+        }
+
+        _workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; i++) {
+            _workers.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _jobAvailable.notify_all();
+
+        for (auto& worker: _workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::WaitIdle() {
+        std::unique_lock lock(_mutex);
+        _idle.wait(lock, [this]() { return _jobs.empty() && _activeJobs == 0; });
+    }
+
+    size_t ThreadPool::GetPendingJobCount() const {
+        std::lock_guard lock(_mutex);
+        return _jobs.size() + _activeJobs;
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> job) {
+        {
+            std::lock_guard lock(_mutex);
+            _jobs.emplace_back(std::move(job));
+        }
+        _jobAvailable.notify_one();
+    }
+
+    void ThreadPool::WorkerLoop() {
+        Profiling::Profiler::SetThreadName("Worker");
+
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(_mutex);
+                _jobAvailable.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+
+                // queued jobs are drained even when stopping - their futures must be fulfilled
+                if (_jobs.empty()) return;
+
+                job = std::move(_jobs.front());
+                _jobs.pop_front();
+                _activeJobs++;
+            }
+
+            {
+                LOW_PROFILE_ZONE("ThreadPool::Job");
+                job();
+            }
+
+            {
+                std::lock_guard lock(_mutex);
+                _activeJobs--;
+                if (_jobs.empty() && _activeJobs == 0) {
+                    _idle.notify_all();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace LowEngine::Threading {
+    /**
+     * @brief Fixed-size pool of worker threads executing submitted jobs in FIFO order.
+     *
+     * Jobs must not touch OpenGL or OpenAL resources - workers don't own any context.
+     * Destructor finishes all queued jobs before joining the workers.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @brief Start worker threads.
+         * @param threadCount Number of workers. 0 means one less than number of hardware threads (at least one).
+         */
+        explicit ThreadPool(size_t threadCount = 0);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Queue a job for execution on a worker thread.
+         * @param job Callable without arguments.
+         * @return Future with job's result. Exceptions thrown by the job are rethrown by future's get().
+         */
+        template<typename Job>
+        std::future<std::invoke_result_t<Job>> Submit(Job&& job) {
+            using Result = std::invoke_result_t<Job>;
+
+            // std::function requires copyable callables, packaged_task is move-only
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Job>(job));
+            std::future<Result> future = task->get_future();
+            Enqueue([task]() { (*task)(); });
+            return future;
+        }
+
+        /**
+         * @brief Block until the queue is empty and no worker is executing a job.
+         */
+        void WaitIdle();
+
+        /**
+         * @brief Retrieve number of worker threads.
+         */
+        [[nodiscard]] size_t GetThreadCount() const { return _workers.size(); }
+
+        /**
+         * @brief Retrieve number of jobs that are queued or being executed.
+         */
+        [[nodiscard]] size_t GetPendingJobCount() const;
+
+    protected:
+        std::vector<std::thread> _workers;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _jobAvailable;
+        std::condition_variable _idle;
+        std::deque<std::function<void()>> _jobs;
+        size_t _activeJobs = 0;
+        bool _stopping = false;
+
+        void Enqueue(std::function<void()> job);
+
+        void WorkerLoop();
+    };
+}
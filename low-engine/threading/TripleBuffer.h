@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace LowEngine::Threading {
+    /**
+     * @brief Lock-free triple buffer for passing latest state from a single producer to a single consumer.
+     *
+     * Producer always has a buffer to write into and consumer always has a buffer to read from - neither side waits.
+     * If producer publishes faster than consumer reads, older unread states are overwritten.
+     * Buffers are reused, so containers inside them keep their capacity between frames.
+     * @tparam T Type of the state.
+     */
+    template<typename T>
+    class TripleBuffer {
+    public:
+        static constexpr size_t BUFFER_COUNT = 3;
+
+        /**
+         * @brief Buffer owned by producer. Valid until next call to Publish().
+         */
+        T& GetWriteBuffer() {
+            return _buffers[_writeIndex];
+        }
+
+        /**
+         * @brief Index of the buffer owned by producer. Consumer never reads buffer with this index.
+         */
+        [[nodiscard]] size_t GetWriteIndex() const {
+            return _writeIndex;
+        }
+
+        /**
+         * @brief Make write buffer available to consumer and take over a free buffer for writing.
+         * @return True if previously published buffer was never acquired by consumer and got overwritten.
+         */
+        bool Publish() {
+            uint8_t previous = _middle.exchange(static_cast<uint8_t>(_writeIndex | DIRTY_FLAG), std::memory_order_acq_rel);
+            _writeIndex = previous & INDEX_MASK;
+            return (previous & DIRTY_FLAG) != 0;
+        }
+
+        /**
+         * @brief Switch read buffer to the latest published one, if there is a new one.
+         * @return True if read buffer changed. False if nothing new was published since last call.
+         */
+        bool Acquire() {
+            if ((_middle.load(std::memory_order_acquire) & DIRTY_FLAG) == 0) {
+                return false;
+            }
+            uint8_t previous = _middle.exchange(_readIndex, std::memory_order_acq_rel);
+            _readIndex = previous & INDEX_MASK;
+            return true;
+        }
+
+        /**
+         * @brief Buffer owned by consumer. Valid until next successful call to Acquire().
+         */
+        const T& GetReadBuffer() const {
+            return _buffers[_readIndex];
+        }
+
+    protected:
+        static constexpr uint8_t DIRTY_FLAG = 0x4;
+        static constexpr uint8_t INDEX_MASK = 0x3;
+
+        std::array<T, BUFFER_COUNT> _buffers{};
+        uint8_t _writeIndex = 0;
+        std::atomic<uint8_t> _middle{1};
+        uint8_t _readIndex = 2;
+    };
+}
@@ -0,0 +1,204 @@
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Config.h"
+#include "assets/AssetBatch.h"
+#include "assets/Assets.h"
+#include "assets/terrain/MapGenerator.h"
+#include "assets/terrain/TileMap.h"
+
+namespace LowEngine::Bench {
+    /**
+     * @brief Files loaded at startup. Maps use terrain textures of the set, with the same definitions as in the editor.
+     */
+    struct AssetSet {
+        std::string TerrainTexture;
+        std::string FeaturesTexture;
+        std::vector<std::string> Textures;
+        std::vector<std::string> Maps;
+    };
+
+    static std::vector<Terrain::LayerDefinition> GetLayerDefinitions(size_t terrainId, size_t featuresId) {
+        return {
+            {
+                Terrain::LayerType::Terrain,
+                terrainId,
+                std::unordered_map<unsigned, Terrain::CellDefinition>{
+                    {0, {true, false, true, 1.0f, {}}},
+                    {1, {false, true, true, 1.0f, {"water"}}},
+                }
+            },
+            {
+                Terrain::LayerType::Features,
+                featuresId,
+                std::unordered_map<unsigned, Terrain::CellDefinition>{
+                    {0, {true, false, true, 1.0f, {"forest1", "forest2"}}},
+                    {1, {false, false, true, 1.0f, {}}}
+                }
+            }
+        };
+    }
+
+    static void AddAnimationClips(size_t terrainId, size_t featuresId) {
+        Assets::AddAnimationClip(terrainId, "water", 3, 3, 0.5f);
+        Assets::AddAnimationClip(featuresId, "forest1", 0, 2, 0.20f);
+        Assets::AddAnimationClip(featuresId, "forest2", 2, 2, 0.20f);
+    }
+
+    /**
+     * @brief Load the set one file after another, as the editor did before asset batches.
+     */
+    static bool LoadSync(const AssetSet& set) {
+        auto terrainId = Assets::LoadTextureWithSpriteSheet(set.TerrainTexture, 16, 16, 3, 2);
+        auto featuresId = Assets::LoadTextureWithSpriteSheet(set.FeaturesTexture, 16, 16, 4, 2);
+        if (terrainId == Config::MAX_SIZE || featuresId == Config::MAX_SIZE) return false;
+        AddAnimationClips(terrainId, featuresId);
+
+        for (auto& path: set.Textures) {
+            if (Assets::LoadTexture(path) == Config::MAX_SIZE) return false;
+        }
+
+        auto definitions = GetLayerDefinitions(terrainId, featuresId);
+        for (auto& path: set.Maps) {
+            if (Assets::LoadTileMap(path, definitions) == Config::MAX_SIZE) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Load the set through a single batch, as the editor does now.
+     */
+    static bool LoadBatch(const AssetSet& set) {
+        AssetBatch batch;
+        auto terrainId = batch.LoadTextureWithSpriteSheet(set.TerrainTexture, "", 16, 16, 3, 2);
+        auto featuresId = batch.LoadTextureWithSpriteSheet(set.FeaturesTexture, "", 16, 16, 4, 2);
+        AddAnimationClips(terrainId, featuresId);
+
+        for (auto& path: set.Textures) {
+            batch.LoadTexture(path);
+        }
+
+        auto definitions = GetLayerDefinitions(terrainId, featuresId);
+        for (auto& path: set.Maps) {
+            batch.LoadTileMap(path, "", definitions);
+        }
+        return batch.Wait();
+    }
+
+    /**
+     * @brief Cold startup - every sample begins with no assets loaded. Files come from OS cache after the first sample,
+     * so decoding and uploading is what's measured, not the disk.
+     */
+    static void AddStartupBenchmarks(Runner& runner, const std::string& setName, const std::shared_ptr<AssetSet>& set,
+                                     const std::function<std::string()>& prepare, const std::function<void()>& cleanup = {}) {
+        const std::pair<const char*, bool (*)(const AssetSet&)> modes[] = {
+            {"Sync", &LoadSync},
+            {"Batch", &LoadBatch},
+        };
+
+        for (auto& [name, load]: modes) {
+            runner.Add({
+                .Name = std::string("Assets/ColdStartup/") + name + "/" + setName,
+                .Operations = 1,
+                .NeedsGraphics = true,
+                .Prepare = prepare,
+                .Setup = [] { Assets::UnloadAll(); },
+                .Run = [set, load] { DoNotOptimize(load(*set)); },
+                .Teardown = [cleanup] {
+                    Assets::UnloadAll();
+                    if (cleanup) cleanup();
+                },
+                .Counters = [set] {
+                    return std::vector<std::pair<std::string, double>>{
+                        {"textures", static_cast<double>(set->Textures.size() + 2)},
+                        {"maps", static_cast<double>(set->Maps.size())}
+                    };
+                }
+            });
+        }
+    }
+
+    static void AddEditorStartupBenchmarks(Runner& runner) {
+        auto set = std::make_shared<AssetSet>();
+        auto directory = std::filesystem::path(runner.GetSettings().AssetsDirectory);
+        set->TerrainTexture = (directory / "textures/terrain/green_terrain.png").string();
+        set->FeaturesTexture = (directory / "textures/terrain/green_features.png").string();
+        set->Maps.push_back((directory / "maps/terrain_map_01/BasicMap.ldtkl").string());
+
+        AddStartupBenchmarks(runner, "Editor", set, [set] {
+            for (auto& path: {set->TerrainTexture, set->FeaturesTexture, set->Maps.front()}) {
+                if (!std::filesystem::exists(path)) return "asset not found: " + path;
+            }
+            return std::string();
+        });
+    }
+
+    /**
+     * @brief Many textures and several large maps, generated once. Every file has different content, so none of them
+     * is deduplicated.
+     */
+    static void AddSyntheticStartupBenchmarks(Runner& runner, size_t textureCount, size_t mapCount, size_t mapSize) {
+        auto set = std::make_shared<AssetSet>();
+        auto directory = std::filesystem::path(runner.GetSettings().AssetsDirectory);
+        set->TerrainTexture = (directory / "textures/terrain/green_terrain.png").string();
+        set->FeaturesTexture = (directory / "textures/terrain/green_features.png").string();
+
+        auto generatedDirectory = std::filesystem::temp_directory_path() / "low_bench_assets";
+        auto prepare = [set, generatedDirectory, textureCount, mapCount, mapSize] {
+            if (!set->Textures.empty()) return std::string();
+            if (!std::filesystem::exists(set->TerrainTexture)) return "asset not found: " + set->TerrainTexture;
+
+            std::error_code error;
+            std::filesystem::create_directories(generatedDirectory, error);
+            if (error) return "failed to create directory: " + generatedDirectory.string();
+
+            for (size_t i = 0; i < textureCount; i++) {
+                auto path = (generatedDirectory / ("texture_" + std::to_string(i) + ".png")).string();
+                // pattern differs per texture - plain colors would decode faster than any real texture
+                sf::Image image({256, 256});
+                for (unsigned y = 0; y < 256; y++) {
+                    for (unsigned x = 0; x < 256; x++) {
+                        image.setPixel({x, y}, sf::Color(static_cast<uint8_t>(x ^ i), static_cast<uint8_t>(y + i), static_cast<uint8_t>((x * y) >> 4)));
+                    }
+                }
+                if (!image.saveToFile(path)) return "failed to write texture: " + path;
+                set->Textures.push_back(path);
+            }
+
+            auto definitions = GetLayerDefinitions(0, 0);
+            for (size_t i = 0; i < mapCount; i++) {
+                auto path = (generatedDirectory / ("map_" + std::to_string(i) + ".ldtkl")).string();
+                Terrain::MapGeneratorSettings settings;
+                settings.Width = mapSize;
+                settings.Height = mapSize;
+                settings.Seed = static_cast<uint32_t>(i + 1);
+
+                Terrain::TileMap map(Assets::GetDefaultTexture());
+                if (!Terrain::MapGenerator::Generate(settings, definitions, map) || !Terrain::MapGenerator::SaveAsLDTk(map, path)) {
+                    return "failed to generate map: " + path;
+                }
+                set->Maps.push_back(path);
+            }
+            return std::string();
+        };
+
+        // every benchmark generates the files again - any of them can be the only one passing the filter
+        auto cleanup = [set, generatedDirectory] {
+            std::error_code error;
+            std::filesystem::remove_all(generatedDirectory, error);
+            set->Textures.clear();
+            set->Maps.clear();
+        };
+
+        AddStartupBenchmarks(runner, "Synthetic" + std::to_string(textureCount) + "x" + std::to_string(mapCount), set, prepare, cleanup);
+    }
+
+    void RegisterAssetBenchmarks(Runner& runner) {
+        AddEditorStartupBenchmarks(runner);
+        AddSyntheticStartupBenchmarks(runner, 64, 4, 256);
+    }
+}
@@ -0,0 +1,221 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <unordered_map>
+
+#include "Log.h"
+
+namespace LowEngine::Bench {
+    void Runner::Add(Benchmark benchmark) {
+        for (auto& existing: _benchmarks) {
+            if (existing.Name == benchmark.Name) {
+                _log->error("Benchmark '{}' is registered twice", benchmark.Name);
+                return;
+            }
+        }
+        _benchmarks.push_back(std::move(benchmark));
+    }
+
+    std::vector<BenchmarkResult> Runner::RunAll() {
+        std::vector<BenchmarkResult> results;
+
+        for (auto& benchmark: _benchmarks) {
+            if (!_settings.Filter.empty() && benchmark.Name.find(_settings.Filter) == std::string::npos) continue;
+
+            BenchmarkResult result;
+            result.Name = benchmark.Name;
+            result.Operations = benchmark.Operations;
+
+            if (benchmark.NeedsGraphics && !_settings.GraphicsAvailable) {
+                result.Skipped = "no display available";
+            } else if (benchmark.Prepare) {
+                result.Skipped = benchmark.Prepare();
+            }
+
+            if (result.Skipped.empty()) {
+                result = Measure(benchmark);
+                if (benchmark.Counters) result.Counters = benchmark.Counters();
+                if (benchmark.Teardown) benchmark.Teardown();
+                _log->info("{:<48} {:>14.1f} ns/op  (min {:.1f}, max {:.1f})",
+                           result.Name, result.MedianNs, result.MinNs, result.MaxNs);
+                for (auto& [name, value]: result.Counters) {
+                    _log->info("{:<48} {:>14} {}", "", value, name);
+                }
+            } else {
+                _log->warn("{:<48} skipped: {}", result.Name, result.Skipped);
+            }
+
+            results.push_back(std::move(result));
+        }
+
+        return results;
+    }
+
+    BenchmarkResult Runner::Measure(Benchmark& benchmark) const {
+        BenchmarkResult result;
+        result.Name = benchmark.Name;
+        result.Operations = std::max<size_t>(benchmark.Operations, 1);
+        result.Samples = std::max<size_t>(_settings.Samples, 1);
+
+        std::vector<double> samples;
+        samples.reserve(result.Samples);
+
+        for (size_t i = 0; i < _settings.WarmupSamples + result.Samples; i++) {
+            if (benchmark.Setup) benchmark.Setup();
+
+            auto start = std::chrono::steady_clock::now();
+            benchmark.Run();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            if (i < _settings.WarmupSamples) continue;
+            double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+            samples.push_back(nanoseconds / static_cast<double>(result.Operations));
+        }
+
+        std::sort(samples.begin(), samples.end());
+        size_t middle = samples.size() / 2;
+        result.MedianNs = samples.size() % 2 == 1 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0;
+        result.MinNs = samples.front();
+        result.MaxNs = samples.back();
+        result.MeanNs = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+        return result;
+    }
+
+    bool Runner::SaveResults(const std::string& path, const std::vector<BenchmarkResult>& results) const {
+        nlohmann::json jsonData;
+        jsonData["version"] = 1;
+#ifdef NDEBUG
+        jsonData["build"] = "Release";
+#else
+        jsonData["build"] = "Debug";
+#endif
+#ifdef LOWENGINE_PROFILER
+        jsonData["profiler"] = true;
+#else
+        jsonData["profiler"] = false;
+#endif
+        jsonData["warmupSamples"] = _settings.WarmupSamples;
+        jsonData["samples"] = _settings.Samples;
+
+        auto& entries = jsonData["results"] = nlohmann::json::array();
+        for (auto& result: results) {
+            entries.push_back(ToJson(result));
+        }
+
+        std::ofstream file(path);
+        if (!file) {
+            _log->error("Failed to open benchmark results file: {}", path);
+            return false;
+        }
+
+        file << jsonData.dump(2) << "\n";
+        if (!file) {
+            _log->error("Failed to write benchmark results file: {}", path);
+            return false;
+        }
+
+        _log->info("Results of {} benchmarks written to {}", results.size(), path);
+        return true;
+    }
+
+    bool Runner::CompareWithBaseline(const std::string& path, const std::vector<BenchmarkResult>& results,
+                                     double threshold, size_t& regressions) {
+        regressions = 0;
+
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            _log->error("Failed to open benchmark baseline: {}", path);
+            return false;
+        }
+
+        // median time of every benchmark that was measured in the baseline
+        std::unordered_map<std::string, double> baseline;
+        try {
+            nlohmann::json jsonData;
+            file >> jsonData;
+
+            for (auto& entry: jsonData.at("results")) {
+                if (entry.contains("skipped")) continue;
+                baseline[entry.at("name").get<std::string>()] = entry.at("medianNs").get<double>();
+            }
+        } catch (std::exception& ex) {
+            _log->error("Failed to parse benchmark baseline: {}", path);
+            _log->error("Error: {}", ex.what());
+            return false;
+        }
+
+        _log->info("Comparison with {} (threshold {:.1f}%):", path, threshold * 100.0);
+        _log->info("{:<48} {:>14} {:>14} {:>9}", "benchmark", "baseline ns", "current ns", "change");
+
+        for (auto& result: results) {
+            auto it = baseline.find(result.Name);
+            if (!result.Skipped.empty() || it == baseline.end()) {
+                auto baselineText = it == baseline.end() ? std::string("-") : fmt::format("{:.1f}", it->second);
+                auto currentText = result.Skipped.empty() ? fmt::format("{:.1f}", result.MedianNs) : std::string("skipped");
+                _log->info("{:<48} {:>14} {:>14} {:>9}", result.Name, baselineText, currentText, "n/a");
+                continue;
+            }
+
+            double change = it->second > 0.0 ? result.MedianNs / it->second - 1.0 : 0.0;
+            switch (Compare(result.MedianNs, it->second, threshold)) {
+                case Verdict::Regressed:
+                    regressions++;
+                    _log->warn("{:<48} {:>14.1f} {:>14.1f} {:>+8.1f}%  REGRESSION", result.Name, it->second, result.MedianNs, change * 100.0);
+                    break;
+                case Verdict::Improved:
+                    _log->info("{:<48} {:>14.1f} {:>14.1f} {:>+8.1f}%  improved", result.Name, it->second, result.MedianNs, change * 100.0);
+                    break;
+                default:
+                    _log->info("{:<48} {:>14.1f} {:>14.1f} {:>+8.1f}%", result.Name, it->second, result.MedianNs, change * 100.0);
+            }
+        }
+
+        if (regressions > 0) {
+            _log->warn("{} benchmark(s) regressed by more than {:.1f}%", regressions, threshold * 100.0);
+        }
+        return true;
+    }
+
+    bool Runner::DetectGraphics() {
+#if defined(__linux__) || defined(__FreeBSD__)
+        // without a display SFML aborts on the first texture, instead of reporting an error
+        return std::getenv("DISPLAY") != nullptr || std::getenv("WAYLAND_DISPLAY") != nullptr;
+#else
+        return true;
+#endif
+    }
+
+    nlohmann::json Runner::ToJson(const BenchmarkResult& result) {
+        nlohmann::json entry;
+        entry["name"] = result.Name;
+        entry["operations"] = result.Operations;
+        if (!result.Skipped.empty()) {
+            entry["skipped"] = result.Skipped;
+            return entry;
+        }
+
+        entry["samples"] = result.Samples;
+        entry["medianNs"] = result.MedianNs;
+        entry["minNs"] = result.MinNs;
+        entry["meanNs"] = result.MeanNs;
+        entry["maxNs"] = result.MaxNs;
+        if (!result.Counters.empty()) {
+            auto& counters = entry["counters"] = nlohmann::json::object();
+            for (auto& [name, value]: result.Counters) {
+                counters[name] = value;
+            }
+        }
+        return entry;
+    }
+
+    Verdict Runner::Compare(double current, double baseline, double threshold) {
+        if (baseline <= 0.0) return Verdict::NotCompared;
+        if (current > baseline * (1.0 + threshold)) return Verdict::Regressed;
+        if (current < baseline * (1.0 - threshold)) return Verdict::Improved;
+        return Verdict::Unchanged;
+    }
+}
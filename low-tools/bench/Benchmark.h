@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace LowEngine::Bench {
+    /**
+     * @brief Single benchmark - a piece of engine code measured in isolation.
+     *
+     * State shared between the callbacks is usually kept in a fixture captured by all of them.
+     */
+    struct Benchmark {
+        /**
+         * @brief Unique name, in "Group/Case/Size" form. Used by filters and to match results with the baseline.
+         */
+        std::string Name;
+
+        /**
+         * @brief Number of operations done by a single Run call. Results are reported per operation.
+         */
+        size_t Operations = 1;
+
+        /**
+         * @brief Does the benchmark create textures? Such benchmarks are skipped when no display is available.
+         */
+        bool NeedsGraphics = false;
+
+        /**
+         * @brief Called once, before the first sample. Optional.
+         * @return Empty string if successful. Otherwise reason why the benchmark is skipped.
+         */
+        std::function<std::string()> Prepare;
+
+        /**
+         * @brief Called before every sample, not measured. Optional.
+         */
+        std::function<void()> Setup;
+
+        /**
+         * @brief Measured code.
+         */
+        std::function<void()> Run;
+
+        /**
+         * @brief Called once, after the last sample. Optional. Restores anything Prepare or Setup changed globally.
+         */
+        std::function<void()> Teardown;
+
+        /**
+         * @brief Called once, after the last sample and before Teardown. Optional.
+         * @return Values describing the work done besides time, i.e. number of expanded nodes. Saved along with results.
+         */
+        std::function<std::vector<std::pair<std::string, double>>()> Counters;
+    };
+
+    /**
+     * @brief Measurements of a single benchmark. Times are in nanoseconds per operation.
+     */
+    struct BenchmarkResult {
+        std::string Name;
+        size_t Operations = 0;
+        size_t Samples = 0;
+        double MedianNs = 0.0;
+        double MinNs = 0.0;
+        double MeanNs = 0.0;
+        double MaxNs = 0.0;
+        /**
+         * @brief Values reported by the benchmark's Counters callback. Not compared with the baseline.
+         */
+        std::vector<std::pair<std::string, double>> Counters;
+        /**
+         * @brief Reason why the benchmark didn't run. Empty if it did.
+         */
+        std::string Skipped;
+    };
+
+    /**
+     * @brief Result of comparing a benchmark with its baseline.
+     */
+    enum class Verdict {
+        Unchanged,
+        Improved,
+        Regressed,
+        /**
+         * @brief Benchmark is not in the baseline, or was skipped in either run.
+         */
+        NotCompared
+    };
+
+    struct RunnerSettings {
+        /**
+         * @brief Samples done, and discarded, before measuring. Warms caches and lets pools reach their final size.
+         */
+        size_t WarmupSamples = 2;
+
+        /**
+         * @brief Measured samples. Median of them is the reported result.
+         */
+        size_t Samples = 15;
+
+        /**
+         * @brief Only benchmarks with names containing this text are run. Empty runs all.
+         */
+        std::string Filter;
+
+        /**
+         * @brief Can benchmarks create textures?
+         */
+        bool GraphicsAvailable = true;
+
+        /**
+         * @brief Directory with editor's assets, used by benchmarks that load maps and textures.
+         */
+        std::string AssetsDirectory = "assets";
+    };
+
+    /**
+     * @brief Runs registered benchmarks and compares their results with a baseline.
+     */
+    class Runner {
+    public:
+        explicit Runner(RunnerSettings settings) : _settings(std::move(settings)) {
+        }
+
+        /**
+         * @brief Register a benchmark. Names must be unique.
+         */
+        void Add(Benchmark benchmark);
+
+        [[nodiscard]] const RunnerSettings& GetSettings() const { return _settings; }
+
+        /**
+         * @brief Run all benchmarks passing the filter, in order of registration.
+         * @return Results of every benchmark that passed the filter, including skipped ones.
+         */
+        std::vector<BenchmarkResult> RunAll();
+
+        /**
+         * @brief Write results as JSON.
+         * @return False if the file could not be written.
+         */
+        bool SaveResults(const std::string& path, const std::vector<BenchmarkResult>& results) const;
+
+        /**
+         * @brief Compare results with a baseline written by SaveResults() and log a table of changes.
+         * @param threshold Relative change of median time treated as significant, i.e. 0.1 for 10%.
+         * @param[out] regressions Number of benchmarks that got slower by more than the threshold.
+         * @return False if the baseline could not be read.
+         */
+        static bool CompareWithBaseline(const std::string& path, const std::vector<BenchmarkResult>& results,
+                                        double threshold, size_t& regressions);
+
+        /**
+         * @brief Check if textures can be created - i.e. a display is available on Linux.
+         */
+        [[nodiscard]] static bool DetectGraphics();
+
+    protected:
+        RunnerSettings _settings;
+        std::vector<Benchmark> _benchmarks;
+
+        BenchmarkResult Measure(Benchmark& benchmark) const;
+
+        static nlohmann::json ToJson(const BenchmarkResult& result);
+
+        static Verdict Compare(double current, double baseline, double threshold);
+    };
+
+    /**
+     * @brief Keep the compiler from optimizing away a computed value.
+     */
+    template<typename T>
+    void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &value;
+#endif
+    }
+
+    /*
+     * Registration functions of benchmark groups. Defined in *Benchmarks.cpp.
+     */
+    void RegisterEcsBenchmarks(Runner& runner);
+
+    void RegisterNavigationBenchmarks(Runner& runner);
+
+    void RegisterTerrainBenchmarks(Runner& runner);
+
+    void RegisterRenderBenchmarks(Runner& runner);
+
+    void RegisterCoreBenchmarks(Runner& runner);
+
+    void RegisterAssetBenchmarks(Runner& runner);
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include "Benchmark.h"
+#include "Config.h"
+#include "Log.h"
+#include "StringId.h"
+#include "ecs/Components/TransformComponent.h"
+#include "scene/Scene.h"
+#include "threading/AsyncLogSink.h"
+
+namespace LowEngine::Bench {
+    static void AddAliasLookupBenchmarks(Runner& runner, size_t count) {
+        struct Fixture {
+            std::unordered_map<std::string, size_t> ByString;
+            std::unordered_map<StringId, size_t> ById;
+            std::vector<std::string> Queries;
+            std::vector<StringId> QueryIds;
+        };
+        auto fixture = std::make_shared<Fixture>();
+
+        // asset aliases - short, with a common prefix, looked up in random order
+        std::mt19937 gen(3);
+        for (size_t i = 0; i < count; i++) {
+            std::string alias = "textures/terrain/tile_" + std::to_string(i);
+            fixture->ByString[alias] = i;
+            fixture->ById[StringId::Intern(alias)] = i;
+            fixture->Queries.push_back(alias);
+        }
+        std::shuffle(fixture->Queries.begin(), fixture->Queries.end(), gen);
+        for (auto& query: fixture->Queries) {
+            fixture->QueryIds.emplace_back(query);
+        }
+
+        runner.Add({
+            .Name = "Core/AliasLookup/String/" + std::to_string(count),
+            .Operations = count,
+            .Run = [fixture] {
+                for (auto& query: fixture->Queries) {
+                    DoNotOptimize(fixture->ByString.find(query)->second);
+                }
+            }
+        });
+
+        // id hashed once, where the alias is defined - the common case for aliases known in code
+        runner.Add({
+            .Name = "Core/AliasLookup/StringId/" + std::to_string(count),
+            .Operations = count,
+            .Run = [fixture] {
+                for (auto& id: fixture->QueryIds) {
+                    DoNotOptimize(fixture->ById.find(id)->second);
+                }
+            }
+        });
+
+        // id hashed from text on every lookup - i.e. aliases coming from data files
+        runner.Add({
+            .Name = "Core/AliasLookup/StringIdFromText/" + std::to_string(count),
+            .Operations = count,
+            .Run = [fixture] {
+                for (auto& query: fixture->Queries) {
+                    DoNotOptimize(fixture->ById.find(StringId(query))->second);
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Spawning Entities with debug logging going to a file - measures what logging costs the game thread.
+     */
+    static void AddLoggingBenchmark(Runner& runner, const std::string& mode, size_t count) {
+        struct Fixture {
+            std::shared_ptr<spdlog::logger> Previous;
+            std::unique_ptr<Scene> SpawnScene;
+            std::filesystem::path Path;
+        };
+        auto fixture = std::make_shared<Fixture>();
+        fixture->Path = std::filesystem::temp_directory_path() / ("low_bench_" + mode + ".log");
+
+        runner.Add({
+            .Name = "Core/Log/SpawnEntities/" + mode + "/" + std::to_string(count),
+            .Operations = count,
+            .Prepare = [fixture, mode] {
+                std::shared_ptr<spdlog::sinks::sink> sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(fixture->Path.string(), true);
+                if (mode == "Async") {
+                    sink = std::make_shared<Threading::AsyncLogSink>(sink, Config::LOG_QUEUE_SIZE,
+                                                                     std::chrono::milliseconds(Config::LOG_FLUSH_INTERVAL_MS));
+                }
+
+                auto logger = std::make_shared<spdlog::logger>("bench", sink);
+                logger->set_pattern("[%Y-%m-%d %H:%M:%S] [%l] [%n] %v");
+                logger->set_level(mode == "Off" ? spdlog::level::off : spdlog::level::debug);
+
+                fixture->Previous = _log;
+                _log = logger;
+                AttachSubsystemLoggers(_log);
+                return std::string();
+            },
+            .Setup = [fixture] { fixture->SpawnScene = std::make_unique<Scene>("Benchmark scene"); },
+            .Run = [fixture, count] {
+                for (size_t i = 0; i < count; i++) {
+                    auto entity = fixture->SpawnScene->AddEntity("Entity");
+                    entity->AddComponent<ECS::TransformComponent>();
+                }
+            },
+            .Teardown = [fixture] {
+                fixture->SpawnScene.reset();
+                _log->flush();
+                _log = fixture->Previous;
+                AttachSubsystemLoggers(_log);
+
+                std::error_code error;
+                std::filesystem::remove(fixture->Path, error);
+            }
+        });
+    }
+
+    void RegisterCoreBenchmarks(Runner& runner) {
+        AddAliasLookupBenchmarks(runner, 1000);
+        AddLoggingBenchmark(runner, "Off", 10000);
+        AddLoggingBenchmark(runner, "Sync", 10000);
+        AddLoggingBenchmark(runner, "Async", 10000);
+    }
+}
@@ -0,0 +1,441 @@
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ecs/Entity.h"
+#include "ecs/IComponent.h"
+#include "ecs/Components/TransformComponent.h"
+#include "memory/ComponentPool.h"
+#include "graphics/RenderSnapshot.h"
+#include "memory/Memory.h"
+#include "scene/AutosaveManager.h"
+#include "scene/Scene.h"
+#include "serialization/BinaryReader.h"
+#include "serialization/BinaryWriter.h"
+#include "serialization/MappedFile.h"
+
+namespace LowEngine::Bench {
+    /**
+     * @brief Typical game logic Component - reads Transform of its Entity and moves it every Update.
+     */
+    class BenchMoverComponent : public ECS::IComponent {
+    public:
+        sf::Vector2f Velocity = sf::Vector2f(1.0f, 0.5f);
+
+        struct Record {
+            sf::Vector2f Velocity;
+        };
+
+        explicit BenchMoverComponent(Memory::Memory* memory)
+            : IComponent(memory) {
+        }
+
+        BenchMoverComponent(Memory::Memory* memory, BenchMoverComponent const* other)
+            : IComponent(memory, other), Velocity(other->Velocity) {
+        }
+
+        ~BenchMoverComponent() override = default;
+
+        void CloneInto(Memory::Memory* newMemory, void* rawStorage) const override {
+            new(rawStorage) BenchMoverComponent(newMemory, this);
+        }
+
+        static constexpr bool HAS_DRAW = false;
+
+        static const std::vector<std::type_index>& Dependencies() {
+            static std::vector dependencies = {
+                std::type_index(typeid(ECS::TransformComponent))
+            };
+            return dependencies;
+        }
+
+        void Initialize() override {
+        }
+
+        void Update(float deltaTime) override {
+            auto transform = _memory->GetComponent<ECS::TransformComponent>(EntityId);
+            transform->Position += Velocity * deltaTime;
+        }
+
+        void ToRecord(Record& record, Serialization::StringTable& strings) const {
+            record.Velocity = Velocity;
+        }
+
+        void FromRecord(const Record& record, const Serialization::StringTable& strings) {
+            Velocity = record.Velocity;
+        }
+    };
+
+    /**
+     * @brief Typical game data Component - state read by game logic now and then, with nothing to do every Update.
+     */
+    class BenchHealthComponent : public ECS::IComponent {
+    public:
+        float Health = 100.0f;
+        float MaxHealth = 100.0f;
+        uint32_t Team = 0;
+
+        struct Record {
+            float Health = 0.0f;
+            float MaxHealth = 0.0f;
+            uint32_t Team = 0;
+        };
+
+        explicit BenchHealthComponent(Memory::Memory* memory)
+            : IComponent(memory) {
+        }
+
+        BenchHealthComponent(Memory::Memory* memory, BenchHealthComponent const* other)
+            : IComponent(memory, other), Health(other->Health), MaxHealth(other->MaxHealth), Team(other->Team) {
+        }
+
+        ~BenchHealthComponent() override = default;
+
+        void CloneInto(Memory::Memory* newMemory, void* rawStorage) const override {
+            new(rawStorage) BenchHealthComponent(newMemory, this);
+        }
+
+        static constexpr bool HAS_UPDATE = false;
+        static constexpr bool HAS_DRAW = false;
+
+        static const std::vector<std::type_index>& Dependencies() {
+            static std::vector<std::type_index> dependencies = {};
+            return dependencies;
+        }
+
+        void Initialize() override {
+        }
+
+        void ToRecord(Record& record, Serialization::StringTable& strings) const {
+            record.Health = Health;
+            record.MaxHealth = MaxHealth;
+            record.Team = Team;
+        }
+
+        void FromRecord(const Record& record, const Serialization::StringTable& strings) {
+            Health = record.Health;
+            MaxHealth = record.MaxHealth;
+            Team = record.Team;
+        }
+    };
+
+    /**
+     * @brief Entity ids 0..count-1 in random, but repeatable, order.
+     */
+    static std::vector<size_t> ShuffledIds(size_t count, uint32_t seed) {
+        std::vector<size_t> ids(count);
+        std::iota(ids.begin(), ids.end(), 0);
+        std::mt19937 gen(seed);
+        std::shuffle(ids.begin(), ids.end(), gen);
+        return ids;
+    }
+
+    static void AddPoolBenchmarks(Runner& runner, size_t count) {
+        using Pool = Memory::ComponentPool<ECS::TransformComponent>;
+
+        struct Fixture {
+            Memory::Memory Owner;
+            std::unique_ptr<Pool> Components;
+            std::vector<size_t> Order;
+        };
+        auto fixture = std::make_shared<Fixture>();
+        fixture->Order = ShuffledIds(count, 1);
+
+        auto fill = [fixture, count] {
+            fixture->Components = std::make_unique<Pool>();
+            for (size_t id = 0; id < count; id++) {
+                fixture->Components->CreateComponent(&fixture->Owner, id);
+            }
+        };
+
+        // pool starts with default capacity, so growing it is part of the measurement
+        runner.Add({
+            .Name = "Ecs/ComponentPool/Create/" + std::to_string(count),
+            .Operations = count,
+            .Setup = [fixture] { fixture->Components = std::make_unique<Pool>(); },
+            .Run = [fixture, count] {
+                for (size_t id = 0; id < count; id++) {
+                    fixture->Components->CreateComponent(&fixture->Owner, id);
+                }
+            },
+            .Teardown = [fixture] { fixture->Components.reset(); }
+        });
+
+        runner.Add({
+            .Name = "Ecs/ComponentPool/Get/" + std::to_string(count),
+            .Operations = count,
+            .Prepare = [fill] {
+                fill();
+                return std::string();
+            },
+            .Run = [fixture] {
+                for (size_t id: fixture->Order) {
+                    DoNotOptimize(fixture->Components->GetComponentPtr(id));
+                }
+            },
+            .Teardown = [fixture] { fixture->Components.reset(); }
+        });
+
+        // removal order is random - every removal moves the last Component into the freed slot
+        runner.Add({
+            .Name = "Ecs/ComponentPool/Destroy/" + std::to_string(count),
+            .Operations = count,
+            .Setup = fill,
+            .Run = [fixture] {
+                for (size_t id: fixture->Order) {
+                    fixture->Components->DestroyComponent(id);
+                }
+            },
+            .Teardown = [fixture] { fixture->Components.reset(); }
+        });
+    }
+
+    static void AddUpdateBenchmark(Runner& runner, size_t count) {
+        auto memory = std::make_shared<std::unique_ptr<Memory::Memory> >();
+
+        runner.Add({
+            .Name = "Ecs/UpdateAllComponents/TransformMover/" + std::to_string(count),
+            .Operations = count,
+            .Prepare = [memory, count] {
+                *memory = std::make_unique<Memory::Memory>();
+                for (size_t i = 0; i < count; i++) {
+                    auto entity = (*memory)->CreateEntity<ECS::Entity>("Entity");
+                    entity->AddComponent<ECS::TransformComponent>();
+                    entity->AddComponent<BenchMoverComponent>();
+                }
+                return std::string();
+            },
+            .Run = [memory] { (*memory)->UpdateAllComponents(1.0f / 60.0f); },
+            .Teardown = [memory] { memory->reset(); }
+        });
+    }
+
+    /**
+     * @brief Saved scene of Entities with Transform and Health, every tenth one also moving.
+     */
+    struct SaveFixture {
+        size_t EntityCount = 0;
+        std::unique_ptr<Scene> SavedScene;
+        std::unique_ptr<Scene> LoadedScene;
+        RenderSnapshot Snapshot;
+        std::vector<std::byte> Saved;
+        std::filesystem::path Path;
+
+        std::string Prepare() {
+            if (SavedScene) return {};
+
+            std::mt19937 gen(11);
+            std::uniform_real_distribution<float> position(0.0f, 4096.0f);
+            std::uniform_real_distribution<float> health(1.0f, 100.0f);
+
+            SavedScene = std::make_unique<Scene>("Benchmark scene");
+            for (size_t i = 0; i < EntityCount; i++) {
+                auto entity = SavedScene->AddEntity("Entity");
+                auto transform = entity->AddComponent<ECS::TransformComponent>();
+                transform->Position = {position(gen), position(gen)};
+
+                auto stats = entity->AddComponent<BenchHealthComponent>();
+                stats->Health = health(gen);
+                stats->Team = static_cast<uint32_t>(i % 4);
+
+                if (i % 10 == 0) entity->AddComponent<BenchMoverComponent>();
+            }
+
+            Serialization::BinaryWriter writer;
+            SavedScene->Save(writer);
+            Saved = std::move(writer.Buffer());
+
+            if (!SavedScene->Save(Path.string())) return "failed to write save file";
+            return {};
+        }
+
+        void Teardown() {
+            SavedScene.reset();
+            LoadedScene.reset();
+            Saved.clear();
+
+            std::error_code error;
+            std::filesystem::remove(Path, error);
+        }
+    };
+
+    static void AddSaveLoadBenchmarks(Runner& runner, size_t count) {
+        auto fixture = std::make_shared<SaveFixture>();
+        fixture->EntityCount = count;
+        fixture->Path = std::filesystem::temp_directory_path() / ("low_bench_save_" + std::to_string(count) + ".bin");
+
+        // serialization only - writing the file is left out, it depends on the disk more than on the engine
+        runner.Add({
+            .Name = "Ecs/Save/" + std::to_string(count),
+            .Operations = count,
+            .Prepare = [fixture] { return fixture->Prepare(); },
+            .Run = [fixture] {
+                Serialization::BinaryWriter writer(fixture->Saved.size());
+                fixture->SavedScene->Save(writer);
+                DoNotOptimize(writer.Position());
+            },
+            .Teardown = [fixture] { fixture->Teardown(); }
+        });
+
+        // previous content is destroyed in Setup, so only the load itself is measured
+        runner.Add({
+            .Name = "Ecs/Load/Eager/" + std::to_string(count),
+            .Operations = count,
+            .Prepare = [fixture] { return fixture->Prepare(); },
+            .Setup = [fixture] { fixture->LoadedScene = std::make_unique<Scene>("Loaded scene"); },
+            .Run = [fixture] {
+                Serialization::BinaryReader reader(fixture->Saved);
+                DoNotOptimize(fixture->LoadedScene->Load(reader));
+            },
+            .Teardown = [fixture] { fixture->Teardown(); }
+        });
+
+        // same as Scene::Load(path) in Lazy mode, without its logging - pools stay in the mapping
+        runner.Add({
+            .Name = "Ecs/Load/Mapped/" + std::to_string(count),
+            .Operations = count,
+            .Prepare = [fixture] { return fixture->Prepare(); },
+            .Setup = [fixture] { fixture->LoadedScene = std::make_unique<Scene>("Loaded scene"); },
+            .Run = [fixture] {
+                auto mappedFile = std::make_shared<Serialization::MappedFile>();
+                if (!mappedFile->Open(fixture->Path.string())) return;
+                Serialization::BinaryReader reader(mappedFile->Data());
+                DoNotOptimize(fixture->LoadedScene->Load(reader, mappedFile));
+            },
+            .Teardown = [fixture] { fixture->Teardown(); }
+        });
+    }
+
+    /**
+     * @brief Time from opening the save file to the end of the first frame's Update and Sprite collection.
+     */
+    static void AddFirstFrameBenchmarks(Runner& runner, size_t count) {
+        auto fixture = std::make_shared<SaveFixture>();
+        fixture->EntityCount = count;
+        fixture->Path = std::filesystem::temp_directory_path() / ("low_bench_first_frame_" + std::to_string(count) + ".bin");
+
+        const std::pair<const char*, Serialization::LoadMode> modes[] = {
+            {"Eager", Serialization::LoadMode::Eager},
+            {"Lazy", Serialization::LoadMode::Lazy},
+        };
+
+        for (auto& [name, mode]: modes) {
+            runner.Add({
+                .Name = std::string("Ecs/FirstFrame/") + name + "/" + std::to_string(count),
+                .Operations = count,
+                .Prepare = [fixture] { return fixture->Prepare(); },
+                .Setup = [fixture] { fixture->LoadedScene = std::make_unique<Scene>("Loaded scene"); },
+                .Run = [fixture, mode] {
+                    auto mappedFile = std::make_shared<Serialization::MappedFile>();
+                    if (!mappedFile->Open(fixture->Path.string())) return;
+                    Serialization::BinaryReader reader(mappedFile->Data());
+                    if (!fixture->LoadedScene->Load(reader, mode == Serialization::LoadMode::Lazy ? mappedFile : nullptr)) return;
+
+                    fixture->LoadedScene->Update(1.0f / 60.0f);
+                    fixture->LoadedScene->BuildRenderSnapshot(fixture->Snapshot, {1280, 720});
+                },
+                .Teardown = [fixture] { fixture->Teardown(); },
+                .Counters = [fixture] {
+                    double pending = 0.0;
+                    for (auto& pool: fixture->LoadedScene->GetPoolStatistics()) {
+                        if (pool.Pending) pending++;
+                    }
+                    return std::vector<std::pair<std::string, double>>{{"pendingPools", pending}};
+                }
+            });
+        }
+    }
+
+    /**
+     * @brief Single frame's Update, with and without an autosave in flight, and the part of a save that runs on the
+     * main thread.
+     *
+     * While saving, a new save is started as soon as the previous one finishes - the frame that starts it pays for
+     * serializing the scene and shows up as the max, all others run alongside compression and disk I/O.
+     */
+    static void AddAutosaveFrameBenchmarks(Runner& runner, size_t count) {
+        struct Fixture : SaveFixture {
+            std::unique_ptr<AutosaveManager> Autosave;
+            std::filesystem::path AutosavePath;
+            size_t SavesStarted = 0;
+        };
+        auto fixture = std::make_shared<Fixture>();
+        fixture->EntityCount = count;
+        fixture->Path = std::filesystem::temp_directory_path() / ("low_bench_autosave_source_" + std::to_string(count) + ".bin");
+        fixture->AutosavePath = std::filesystem::temp_directory_path() / ("low_bench_autosave_" + std::to_string(count) + ".bin");
+
+        for (bool saving: {false, true}) {
+            runner.Add({
+                .Name = std::string("Ecs/Autosave/Frame/") + (saving ? "Saving" : "Idle") + "/" + std::to_string(count),
+                .Prepare = [fixture] {
+                    fixture->Autosave = std::make_unique<AutosaveManager>();
+                    fixture->SavesStarted = 0;
+                    return fixture->Prepare();
+                },
+                .Run = [fixture, saving] {
+                    if (saving && !fixture->Autosave->IsSaving()) {
+                        fixture->Autosave->Save(*fixture->SavedScene, fixture->AutosavePath.string());
+                        fixture->SavesStarted++;
+                    }
+                    fixture->SavedScene->Update(1.0f / 60.0f);
+                },
+                .Teardown = [fixture] {
+                    fixture->Autosave.reset(); // waits for the save in flight
+                    fixture->Teardown();
+
+                    std::error_code error;
+                    std::filesystem::remove(fixture->AutosavePath, error);
+                },
+                .Counters = [fixture] {
+                    fixture->Autosave->Wait();
+                    auto status = fixture->Autosave->GetStatus();
+                    return std::vector<std::pair<std::string, double>>{
+                        {"savesStarted", static_cast<double>(fixture->SavesStarted)},
+                        {"snapshotMs", status.SnapshotMs},
+                        {"totalSaveMs", status.TotalMs}
+                    };
+                }
+            });
+        }
+
+        runner.Add({
+            .Name = "Ecs/Autosave/Snapshot/" + std::to_string(count),
+            .Prepare = [fixture] {
+                fixture->Autosave = std::make_unique<AutosaveManager>();
+                return fixture->Prepare();
+            },
+            // previous save must be finished, or the request is rejected without taking a snapshot
+            .Setup = [fixture] { fixture->Autosave->Wait(); },
+            .Run = [fixture] { DoNotOptimize(fixture->Autosave->Save(*fixture->SavedScene, fixture->AutosavePath.string())); },
+            .Teardown = [fixture] {
+                fixture->Autosave.reset();
+                fixture->Teardown();
+
+                std::error_code error;
+                std::filesystem::remove(fixture->AutosavePath, error);
+            },
+            .Counters = [fixture] {
+                fixture->Autosave->Wait();
+                auto status = fixture->Autosave->GetStatus();
+                return std::vector<std::pair<std::string, double>>{
+                    {"uncompressedBytes", static_cast<double>(status.UncompressedBytes)},
+                    {"totalSaveMs", status.TotalMs}
+                };
+            }
+        });
+    }
+
+    void RegisterEcsBenchmarks(Runner& runner) {
+        AddPoolBenchmarks(runner, 10000);
+        AddUpdateBenchmark(runner, 10000);
+        AddUpdateBenchmark(runner, 100000);
+        AddSaveLoadBenchmarks(runner, 100000);
+        AddFirstFrameBenchmarks(runner, 100000);
+        AddAutosaveFrameBenchmarks(runner, 100000);
+    }
+}
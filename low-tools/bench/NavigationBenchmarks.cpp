@@ -0,0 +1,240 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "assets/terrain/navigation/NavigationGrid.h"
+
+namespace LowEngine::Bench {
+    using namespace LowEngine::Terrain::Navigation;
+
+    /**
+     * @brief Generate square grid with randomly placed obstacles. Same seed always gives the same grid.
+     *
+     * Corners are always walkable, so searches between them have a start and an end - a path between them
+     * may still not exist, which makes the search visit every reachable cell.
+     * @param size Number of cells along each side.
+     * @param obstacleRatio Chance of a cell being blocked for walking.
+     * @param seed Seed of the generator.
+     * @param uniformCost Should every cell cost 1? Otherwise costs vary from 1 to 3.
+     */
+    static NavigationGrid GenerateGrid(size_t size, float obstacleRatio, uint32_t seed, bool uniformCost = false) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+        std::uniform_int_distribution<int> cost(1, 3);
+
+        NavigationGrid grid;
+        grid.Resize(size, size);
+
+        for (size_t i = 0; i < size * size; i++) {
+            bool isWalkable = chance(gen) >= obstacleRatio || i == 0 || i == size * size - 1;
+            grid.SetCell(i, {isWalkable, !isWalkable, true, uniformCost ? 1.0f : static_cast<float>(cost(gen))});
+        }
+        return grid;
+    }
+
+    /**
+     * @brief Block cells around the end corner, so it can't be reached from anywhere - the worst case of a search.
+     */
+    static void WallOffEnd(NavigationGrid& grid) {
+        size_t size = grid.Width;
+        for (size_t index: {(size - 2) + (size - 1) * size, (size - 1) + (size - 2) * size, (size - 2) + (size - 2) * size}) {
+            auto cell = grid.GetCell(index);
+            cell.IsWalkable = false;
+            grid.SetCell(index, cell);
+        }
+    }
+
+    static void AddFindPathBenchmark(Runner& runner, const std::string& layout, size_t size, float obstacleRatio,
+                                     bool walledOff = false, bool withRegions = false) {
+        struct Fixture {
+            NavigationGrid Grid;
+            NavigationPath Path;
+        };
+        auto fixture = std::make_shared<Fixture>();
+
+        runner.Add({
+            .Name = "Navigation/FindPath/" + layout + "/" + std::to_string(size),
+            .Operations = 1,
+            .Prepare = [fixture, size, obstacleRatio, walledOff, withRegions] {
+                fixture->Grid = GenerateGrid(size, obstacleRatio, 42);
+                if (walledOff) WallOffEnd(fixture->Grid);
+                if (withRegions) fixture->Grid.BuildRegions();
+                // every sample repeats the same search - cache would answer all but the first
+                fixture->Grid.GetPathCache().SetCapacity(0);
+                return std::string();
+            },
+            .Run = [fixture, size] {
+                auto corner = static_cast<unsigned>(size - 1);
+                DoNotOptimize(fixture->Grid.FindPath({0, 0}, {corner, corner}, MovementType::Walk, fixture->Path));
+            },
+            .Counters = [fixture] {
+                return std::vector<std::pair<std::string, double>>{
+                    {"expandedNodes", fixture->Grid.GetExpandedNodeCount()},
+                    {"pathCells", fixture->Path.GetSize()}
+                };
+            }
+        });
+    }
+
+    /**
+     * @brief A* and Jump Point Search on the same field where every cell costs the same.
+     *
+     * Search state is allocated in the first, warmup sample - searches don't change the grid afterwards.
+     */
+    static void AddPathfindingMethodBenchmarks(Runner& runner, const std::string& layout, size_t size, float obstacleRatio) {
+        const std::pair<const char*, NavigationGrid::PathfindingMethod> methods[] = {
+            {"AStar", NavigationGrid::PathfindingMethod::AStar},
+            {"JPS", NavigationGrid::PathfindingMethod::JumpPointSearch},
+        };
+
+        for (auto& [name, method]: methods) {
+            struct Fixture {
+                NavigationGrid Grid;
+                NavigationPath Path;
+            };
+            auto fixture = std::make_shared<Fixture>();
+
+            runner.Add({
+                .Name = std::string("Navigation/FindPath/") + name + "/" + layout + "/" + std::to_string(size),
+                .Operations = 1,
+                .Prepare = [fixture, size, obstacleRatio, method] {
+                    fixture->Grid = GenerateGrid(size, obstacleRatio, 42, true);
+                    fixture->Grid.BuildRegions();
+                    fixture->Grid.SetPathfindingMethod(method);
+                    fixture->Grid.GetPathCache().SetCapacity(0);
+                    return std::string();
+                },
+                .Run = [fixture, size] {
+                    auto corner = static_cast<unsigned>(size - 1);
+                    DoNotOptimize(fixture->Grid.FindPath({0, 0}, {corner, corner}, MovementType::Walk, fixture->Path));
+                },
+                .Counters = [fixture] {
+                    return std::vector<std::pair<std::string, double>>{
+                        {"expandedNodes", fixture->Grid.GetExpandedNodeCount()},
+                        {"pathCells", fixture->Path.GetSize()},
+                        {"gridBytes", fixture->Grid.GetMemorySize()}
+                    };
+                }
+            });
+        }
+    }
+
+    static void AddRegionBenchmarks(Runner& runner, size_t size) {
+        struct Fixture {
+            NavigationGrid Grid;
+            std::vector<sf::Vector2u> Toggled;
+        };
+        auto fixture = std::make_shared<Fixture>();
+        auto prepare = [fixture, size] {
+            if (fixture->Grid.GetCellCount() != 0) return std::string();
+
+            fixture->Grid = GenerateGrid(size, 0.25f, 42);
+            fixture->Grid.BuildRegions();
+
+            std::mt19937 gen(11);
+            std::uniform_int_distribution<unsigned> position(0, static_cast<unsigned>(size - 1));
+            for (size_t i = 0; i < 1000; i++) {
+                fixture->Toggled.emplace_back(position(gen), position(gen));
+            }
+            return std::string();
+        };
+
+        // labelling done when a map is loaded, for all types of movement
+        runner.Add({
+            .Name = "Navigation/BuildRegions/" + std::to_string(size),
+            .Operations = size * size,
+            .Prepare = prepare,
+            .Run = [fixture] { fixture->Grid.BuildRegions(); }
+        });
+
+        // cells opened and closed during gameplay, i.e. doors and bridges - every cell is toggled twice, so the grid ends as it started
+        runner.Add({
+            .Name = "Navigation/SetCellNavigation/" + std::to_string(size),
+            .Operations = 2000,
+            .Prepare = prepare,
+            .Run = [fixture] {
+                auto& grid = fixture->Grid;
+                for (int pass = 0; pass < 2; pass++) {
+                    for (auto& position: fixture->Toggled) {
+                        auto cell = grid.GetCell(position.x + position.y * grid.Width);
+                        grid.SetCellNavigation(position, !cell.IsWalkable, cell.IsWalkable, cell.IsFlyable, cell.MoveCost);
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Searches answered from path cache - the same route asked again, and asked again from cells along it.
+     */
+    static void AddPathCacheBenchmarks(Runner& runner, size_t size) {
+        struct Fixture {
+            NavigationGrid Grid;
+            NavigationPath Route;
+            NavigationPath Path;
+        };
+        auto fixture = std::make_shared<Fixture>();
+        auto corner = static_cast<unsigned>(size - 1);
+        auto prepare = [fixture, size, corner] {
+            if (fixture->Grid.GetCellCount() == 0) {
+                fixture->Grid = GenerateGrid(size, 0.1f, 42, true);
+                fixture->Grid.BuildRegions();
+                fixture->Grid.FindPath({0, 0}, {corner, corner}, MovementType::Walk, fixture->Route);
+            }
+            fixture->Grid.GetPathCache().ResetStats();
+            return std::string();
+        };
+        auto counters = [fixture] {
+            auto& stats = fixture->Grid.GetPathCache().GetStats();
+            return std::vector<std::pair<std::string, double>>{
+                {"hits", stats.Hits},
+                {"suffixHits", stats.SuffixHits},
+                {"misses", stats.Misses}
+            };
+        };
+
+        runner.Add({
+            .Name = "Navigation/PathCache/Hit/" + std::to_string(size),
+            .Operations = 1,
+            .Prepare = prepare,
+            .Run = [fixture, corner] {
+                DoNotOptimize(fixture->Grid.FindPath({0, 0}, {corner, corner}, MovementType::Walk, fixture->Path));
+            },
+            .Counters = counters
+        });
+
+        // unit moving along its route, asking for the rest of it every step
+        runner.Add({
+            .Name = "Navigation/PathCache/Suffix/" + std::to_string(size),
+            .Operations = 64,
+            .Prepare = prepare,
+            .Run = [fixture, corner] {
+                auto& route = fixture->Route;
+                for (size_t i = 1; i <= 64; i++) {
+                    auto start = route.GetCell(i * (route.GetSize() - 1) / 65);
+                    DoNotOptimize(fixture->Grid.FindPath(start, {corner, corner}, MovementType::Walk, fixture->Path));
+                }
+            },
+            .Counters = counters
+        });
+    }
+
+    void RegisterNavigationBenchmarks(Runner& runner) {
+        AddFindPathBenchmark(runner, "Open", 32, 0.0f);
+        AddFindPathBenchmark(runner, "Open", 64, 0.0f);
+        AddFindPathBenchmark(runner, "Obstacles25", 32, 0.25f);
+        AddFindPathBenchmark(runner, "Obstacles25", 64, 0.25f);
+        AddFindPathBenchmark(runner, "Unreachable", 64, 0.25f, true);
+        AddFindPathBenchmark(runner, "Unreachable/Regions", 64, 0.25f, true, true);
+        AddRegionBenchmarks(runner, 256);
+        AddRegionBenchmarks(runner, 1024);
+        AddPathfindingMethodBenchmarks(runner, "UniformOpen", 64, 0.0f);
+        AddPathfindingMethodBenchmarks(runner, "UniformObstacles10", 64, 0.1f);
+        AddPathfindingMethodBenchmarks(runner, "UniformOpen", 1024, 0.0f);
+        AddPathfindingMethodBenchmarks(runner, "UniformObstacles10", 1024, 0.1f);
+        AddPathCacheBenchmarks(runner, 1024);
+    }
+}
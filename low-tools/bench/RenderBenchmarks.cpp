@@ -0,0 +1,166 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics/RenderTexture.hpp>
+
+#include "Benchmark.h"
+#include "ecs/Components/SpriteComponent.h"
+#include "ecs/Components/TransformComponent.h"
+#include "graphics/RenderSnapshot.h"
+#include "graphics/SpriteBatcher.h"
+#include "scene/Scene.h"
+
+namespace LowEngine::Bench {
+    /**
+     * @brief Scene full of Sprites spread over a few textures and layers, as in a busy game frame.
+     */
+    struct SpriteSceneFixture {
+        static constexpr size_t TEXTURE_COUNT = 4;
+        static constexpr int LAYER_COUNT = 4;
+
+        size_t SpriteCount = 0;
+        // created in Prepare() - a texture can't exist before it's known that a display is available
+        std::vector<sf::Texture> Textures;
+        std::unique_ptr<Scene> SpriteScene;
+        RenderSnapshot Snapshot;
+        SpriteBatcher Batcher;
+        // off-screen, so draw calls can be issued without a window
+        std::unique_ptr<sf::RenderTexture> Target;
+
+        std::string Prepare() {
+            if (SpriteScene) return {};
+
+            // Sprites keep references to textures - the vector must not reallocate
+            Textures.reserve(TEXTURE_COUNT);
+            for (size_t i = 0; i < TEXTURE_COUNT; i++) {
+                sf::Image image({32, 32}, sf::Color(static_cast<uint8_t>(i * 60), 128, 128));
+                if (!Textures.emplace_back().loadFromImage(image)) return "failed to create textures";
+            }
+
+            std::mt19937 gen(7);
+            std::uniform_real_distribution<float> x(0.0f, 1280.0f);
+            std::uniform_real_distribution<float> y(0.0f, 720.0f);
+            std::uniform_int_distribution<size_t> texture(0, TEXTURE_COUNT - 1);
+            std::uniform_int_distribution<int> layer(0, LAYER_COUNT - 1);
+
+            SpriteScene = std::make_unique<Scene>("Benchmark scene");
+            for (size_t i = 0; i < SpriteCount; i++) {
+                auto entity = SpriteScene->AddEntity("Sprite");
+                auto transform = entity->AddComponent<ECS::TransformComponent>();
+                transform->Position = {x(gen), y(gen)};
+
+                auto sprite = entity->AddComponent<ECS::SpriteComponent>();
+                sprite->Sprite.setTexture(Textures[texture(gen)], true);
+                sprite->Layer = layer(gen);
+            }
+
+            // copy positions and layers into Sprites
+            SpriteScene->Update(1.0f / 60.0f);
+            return {};
+        }
+
+        std::string PrepareTarget() {
+            if (Target) return {};
+
+            Target = std::make_unique<sf::RenderTexture>();
+            if (!Target->resize({1280, 720})) {
+                Target.reset();
+                return "failed to create render texture";
+            }
+            return {};
+        }
+    };
+
+    static void AddSnapshotBenchmarks(Runner& runner, size_t count) {
+        auto fixture = std::make_shared<SpriteSceneFixture>();
+        fixture->SpriteCount = count;
+
+        const std::pair<const char*, Scene::SpriteSortingMethod> methods[] = {
+            {"None", Scene::SpriteSortingMethod::None},
+            {"YAxis", Scene::SpriteSortingMethod::YAxisIncremental},
+            {"Layers", Scene::SpriteSortingMethod::Layers},
+        };
+
+        // collection and sorting part of Scene::Draw - the part that doesn't need a render target
+        for (auto& [name, method]: methods) {
+            runner.Add({
+                .Name = std::string("Render/BuildRenderSnapshot/") + name + "/" + std::to_string(count),
+                .Operations = count,
+                .NeedsGraphics = true,
+                .Prepare = [fixture, method] {
+                    auto skipReason = fixture->Prepare();
+                    if (skipReason.empty()) fixture->SpriteScene->SetSpriteSorting(method);
+                    return skipReason;
+                },
+                .Run = [fixture] { fixture->SpriteScene->BuildRenderSnapshot(fixture->Snapshot, {1280, 720}); }
+            });
+        }
+
+        runner.Add({
+            .Name = "Render/SpriteBatcher/BuildVertices/" + std::to_string(count),
+            .Operations = count,
+            .NeedsGraphics = true,
+            .Prepare = [fixture] {
+                auto skipReason = fixture->Prepare();
+                if (skipReason.empty()) {
+                    fixture->SpriteScene->SetSpriteSorting(Scene::SpriteSortingMethod::Layers);
+                    fixture->SpriteScene->BuildRenderSnapshot(fixture->Snapshot, {1280, 720});
+                }
+                return skipReason;
+            },
+            .Run = [fixture] {
+                auto& sprites = fixture->Snapshot.Sprites;
+                DoNotOptimize(fixture->Batcher.BuildVertices(sprites, 0, sprites.size()));
+            }
+        });
+    }
+
+    /**
+     * @brief Whole Scene::Draw into an off-screen target - collection, sorting and issuing draw calls.
+     *
+     * Only CPU time is measured - the GPU may still be drawing when a sample ends.
+     */
+    static void AddDrawBenchmarks(Runner& runner, size_t count) {
+        auto fixture = std::make_shared<SpriteSceneFixture>();
+        fixture->SpriteCount = count;
+
+        for (bool batching: {true, false}) {
+            runner.Add({
+                .Name = std::string("Render/Scene/Draw/") + (batching ? "Batched" : "Unbatched") + "/" + std::to_string(count),
+                .Operations = count,
+                .NeedsGraphics = true,
+                .Prepare = [fixture, batching] {
+                    auto skipReason = fixture->Prepare();
+                    if (skipReason.empty()) skipReason = fixture->PrepareTarget();
+                    if (skipReason.empty()) {
+                        fixture->SpriteScene->SetSpriteSorting(Scene::SpriteSortingMethod::Layers);
+                        fixture->SpriteScene->SetSpriteBatching(batching);
+                    }
+                    return skipReason;
+                },
+                .Run = [fixture] {
+                    fixture->Target->clear();
+                    fixture->SpriteScene->Draw(*fixture->Target);
+                    fixture->Target->display();
+                },
+                .Counters = [fixture] {
+                    return std::vector<std::pair<std::string, double>>{
+                        {"drawCalls", static_cast<double>(fixture->SpriteScene->GetDrawCallCount())},
+                        {"textureSwitches", static_cast<double>(fixture->SpriteScene->GetTextureSwitchCount())}
+                    };
+                }
+            });
+        }
+    }
+
+    void RegisterRenderBenchmarks(Runner& runner) {
+        AddSnapshotBenchmarks(runner, 1000);
+        AddSnapshotBenchmarks(runner, 10000);
+        AddSnapshotBenchmarks(runner, 50000);
+        AddDrawBenchmarks(runner, 1000);
+        AddDrawBenchmarks(runner, 10000);
+        AddDrawBenchmarks(runner, 50000);
+    }
+}
@@ -0,0 +1,192 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "Benchmark.h"
+#include "Config.h"
+#include "assets/Assets.h"
+#include "assets/terrain/MapGenerator.h"
+#include "assets/terrain/TileMap.h"
+#include "threading/ThreadPool.h"
+
+namespace LowEngine::Bench {
+    static const char* MAP_PATH = "maps/terrain_map_01/BasicMap.ldtkl";
+
+    static void AddLoadBenchmark(Runner& runner) {
+        struct Fixture {
+            std::string Path;
+            std::unique_ptr<Terrain::TileMap> Map;
+        };
+        auto fixture = std::make_shared<Fixture>();
+        fixture->Path = (std::filesystem::path(runner.GetSettings().AssetsDirectory) / MAP_PATH).string();
+
+        // file is read from disk every sample - after the first one it comes from OS cache
+        runner.Add({
+            .Name = "Terrain/LoadFromLDTkFile/BasicMap",
+            .Operations = 1,
+            // layers of a map hold a Sprite, which can't exist without a texture
+            .NeedsGraphics = true,
+            .Prepare = [fixture] {
+                if (!std::filesystem::exists(fixture->Path)) return "map not found: " + fixture->Path;
+                return std::string();
+            },
+            .Setup = [fixture] { fixture->Map = std::make_unique<Terrain::TileMap>(Assets::GetDefaultTexture()); },
+            .Run = [fixture] { DoNotOptimize(fixture->Map->LoadFromLDTkFile(fixture->Path)); },
+            .Teardown = [fixture] { fixture->Map.reset(); }
+        });
+    }
+
+    static void AddDrawableBenchmarks(Runner& runner) {
+        struct Fixture {
+            std::string Directory;
+            size_t MapId = Config::MAX_SIZE;
+        };
+        auto fixture = std::make_shared<Fixture>();
+        fixture->Directory = runner.GetSettings().AssetsDirectory;
+
+        // same textures and layer definitions as the editor's sample map
+        auto prepare = [fixture] {
+            if (fixture->MapId != Config::MAX_SIZE) return std::string();
+
+            auto directory = std::filesystem::path(fixture->Directory);
+            auto terrainId = Assets::LoadTextureWithSpriteSheet((directory / "textures/terrain/green_terrain.png").string(), 16, 16, 3, 2);
+            auto featuresId = Assets::LoadTextureWithSpriteSheet((directory / "textures/terrain/green_features.png").string(), 16, 16, 4, 2);
+            if (terrainId == Config::MAX_SIZE || featuresId == Config::MAX_SIZE) return std::string("failed to load terrain textures");
+
+            Assets::AddAnimationClip(terrainId, "water", 3, 3, 0.5f);
+            Assets::AddAnimationClip(featuresId, "forest1", 0, 2, 0.20f);
+            Assets::AddAnimationClip(featuresId, "forest2", 2, 2, 0.20f);
+
+            fixture->MapId = Assets::LoadTileMap((directory / MAP_PATH).string(), std::vector<Terrain::LayerDefinition>{
+                                                     {
+                                                         Terrain::LayerType::Terrain,
+                                                         terrainId,
+                                                         std::unordered_map<unsigned, Terrain::CellDefinition>{
+                                                             {0, {true, false, true, 1.0f, {}}},
+                                                             {1, {false, true, true, 1.0f, {"water"}}},
+                                                         }
+                                                     },
+                                                     {
+                                                         Terrain::LayerType::Features,
+                                                         featuresId,
+                                                         std::unordered_map<unsigned, Terrain::CellDefinition>{
+                                                             {0, {true, false, true, 1.0f, {"forest1", "forest2"}}},
+                                                             {1, {false, false, true, 1.0f, {}}}
+                                                         }
+                                                     }
+                                                 });
+            if (fixture->MapId == Config::MAX_SIZE) return std::string("failed to load map");
+            return std::string();
+        };
+
+        // the whole layer is repainted and uploaded every call - that's what TileMapComponent does every frame
+        runner.Add({
+            .Name = "Terrain/Layer/GetDrawable/Terrain",
+            .Operations = 1,
+            .NeedsGraphics = true,
+            .Prepare = prepare,
+            .Run = [fixture] { DoNotOptimize(Assets::GetTileMap(fixture->MapId).TerrainLayer.GetDrawable()); }
+        });
+
+        runner.Add({
+            .Name = "Terrain/Layer/GetDrawable/Features",
+            .Operations = 1,
+            .NeedsGraphics = true,
+            .Prepare = prepare,
+            .Run = [fixture] { DoNotOptimize(Assets::GetTileMap(fixture->MapId).FeaturesLayer.GetDrawable()); }
+        });
+    }
+
+    /**
+     * @brief Generating a map, saving it and loading it back - the path large stress-test maps take into the engine.
+     */
+    static void AddGeneratorBenchmarks(Runner& runner, size_t size) {
+        struct Fixture {
+            Terrain::MapGeneratorSettings Settings;
+            // navigation properties are all the generator reads - texture ids don't matter
+            std::vector<Terrain::LayerDefinition> Definitions{
+                {
+                    Terrain::LayerType::Terrain,
+                    0,
+                    std::unordered_map<unsigned, Terrain::CellDefinition>{
+                        {0, {true, false, true, 1.0f, {}}},
+                        {1, {false, true, true, 1.0f, {"water"}}},
+                    }
+                },
+                {
+                    Terrain::LayerType::Features,
+                    0,
+                    std::unordered_map<unsigned, Terrain::CellDefinition>{
+                        {0, {true, false, true, 1.0f, {"forest1", "forest2"}}},
+                        {1, {false, false, true, 1.0f, {}}}
+                    }
+                }
+            };
+            std::unique_ptr<Threading::ThreadPool> Pool;
+            std::unique_ptr<Terrain::TileMap> Map;
+            std::filesystem::path Path;
+        };
+        auto fixture = std::make_shared<Fixture>();
+        fixture->Settings.Width = size;
+        fixture->Settings.Height = size;
+        fixture->Path = std::filesystem::temp_directory_path() / ("low_bench_generated_" + std::to_string(size) + ".ldtkl");
+
+        // one pool for all samples - starting threads is not what's measured
+        auto prepare = [fixture] {
+            if (fixture->Map) return std::string();
+
+            fixture->Pool = std::make_unique<Threading::ThreadPool>();
+            fixture->Map = std::make_unique<Terrain::TileMap>(Assets::GetDefaultTexture());
+            if (!Terrain::MapGenerator::Generate(fixture->Settings, fixture->Definitions, *fixture->Map, fixture->Pool.get()) ||
+                !Terrain::MapGenerator::SaveAsLDTk(*fixture->Map, fixture->Path.string(), fixture->Pool.get())) {
+                return std::string("failed to generate map");
+            }
+            return std::string();
+        };
+
+        // every benchmark generates the map again - any of them can be the only one passing the filter
+        auto cleanup = [fixture] {
+            fixture->Map.reset();
+            fixture->Pool.reset();
+
+            std::error_code error;
+            std::filesystem::remove(fixture->Path, error);
+        };
+
+        runner.Add({
+            .Name = "Terrain/MapGenerator/Generate/" + std::to_string(size),
+            .Operations = size * size,
+            .NeedsGraphics = true,
+            .Prepare = prepare,
+            .Run = [fixture] {
+                DoNotOptimize(Terrain::MapGenerator::Generate(fixture->Settings, fixture->Definitions, *fixture->Map, fixture->Pool.get()));
+            },
+            .Teardown = cleanup
+        });
+
+        runner.Add({
+            .Name = "Terrain/MapGenerator/SaveAsLDTk/" + std::to_string(size),
+            .Operations = size * size,
+            .NeedsGraphics = true,
+            .Prepare = prepare,
+            .Run = [fixture] { DoNotOptimize(Terrain::MapGenerator::SaveAsLDTk(*fixture->Map, fixture->Path.string(), fixture->Pool.get())); },
+            .Teardown = cleanup
+        });
+
+        runner.Add({
+            .Name = "Terrain/LoadFromLDTkFile/Generated/" + std::to_string(size),
+            .Operations = size * size,
+            .NeedsGraphics = true,
+            .Prepare = prepare,
+            .Run = [fixture] { DoNotOptimize(fixture->Map->LoadFromLDTkFile(fixture->Path.string())); },
+            .Teardown = cleanup
+        });
+    }
+
+    void RegisterTerrainBenchmarks(Runner& runner) {
+        AddLoadBenchmark(runner);
+        AddDrawableBenchmarks(runner);
+        AddGeneratorBenchmarks(runner, 256);
+        AddGeneratorBenchmarks(runner, 1024);
+    }
+}
@@ -0,0 +1,102 @@
+#include <exception>
+#include <string>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include "Benchmark.h"
+#include "Log.h"
+
+#ifndef LOW_BENCH_ASSETS_DIR
+	#define LOW_BENCH_ASSETS_DIR "assets"
+#endif
+
+/**
+ * Runs engine benchmarks without opening a window, writes results as JSON and compares them with a baseline.
+ *
+ * Usage: LowEngineBench [options]
+ *   --output <results.json>    Write results to file.
+ *   --baseline <results.json>  Compare results with earlier run. Exit code is 2 if any benchmark regressed.
+ *   --threshold <percent>      Change of median time treated as a regression. Default: 10.
+ *   --filter <text>            Run only benchmarks with names containing the text, i.e. "Navigation/".
+ *   --samples <count>          Number of measured samples per benchmark. Default: 15.
+ *   --assets <directory>       Editor's assets directory. Default: set by CMake.
+ *   --no-graphics              Skip benchmarks that create textures, even if a display is available.
+ *
+ * Benchmarks use fixed seeds, so every run measures the same work. Compare only results from the same machine
+ * and build configuration - Release builds are the only ones worth comparing.
+ */
+
+int main(int argc, char* argv[]) {
+    LowEngine::_log = spdlog::stdout_color_mt("low_bench");
+    LowEngine::_log->set_pattern("[%l] %v");
+    // engine's debug messages would be measured along with the code that logs them
+    LowEngine::_log->set_level(spdlog::level::info);
+    LowEngine::AttachSubsystemLoggers(LowEngine::_log);
+
+    LowEngine::Bench::RunnerSettings settings;
+    settings.AssetsDirectory = LOW_BENCH_ASSETS_DIR;
+    settings.GraphicsAvailable = LowEngine::Bench::Runner::DetectGraphics();
+
+    std::string outputPath;
+    std::string baselinePath;
+    double threshold = 0.1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        try {
+            if (option == "--output" && hasValue) {
+                outputPath = argv[++i];
+            } else if (option == "--baseline" && hasValue) {
+                baselinePath = argv[++i];
+            } else if (option == "--threshold" && hasValue) {
+                threshold = std::stod(argv[++i]) / 100.0;
+            } else if (option == "--filter" && hasValue) {
+                settings.Filter = argv[++i];
+            } else if (option == "--samples" && hasValue) {
+                settings.Samples = std::stoul(argv[++i]);
+            } else if (option == "--assets" && hasValue) {
+                settings.AssetsDirectory = argv[++i];
+            } else if (option == "--no-graphics") {
+                settings.GraphicsAvailable = false;
+            } else {
+                LowEngine::_log->error("Unknown option or missing value: {}", option);
+                LowEngine::_log->error("Usage: LowEngineBench [--output <file>] [--baseline <file>] [--threshold <percent>] "
+                                       "[--filter <text>] [--samples <count>] [--assets <directory>] [--no-graphics]");
+                return 1;
+            }
+        } catch (std::exception& ex) {
+            LowEngine::_log->error("Invalid value of {}: {}", option, ex.what());
+            return 1;
+        }
+    }
+
+#ifndef NDEBUG
+    LowEngine::_log->warn("Benchmarks are built in Debug - results are not representative");
+#endif
+    if (!settings.GraphicsAvailable) {
+        LowEngine::_log->warn("No display - benchmarks that need textures will be skipped");
+    }
+
+    LowEngine::Bench::Runner runner(settings);
+    LowEngine::Bench::RegisterCoreBenchmarks(runner);
+    LowEngine::Bench::RegisterEcsBenchmarks(runner);
+    LowEngine::Bench::RegisterNavigationBenchmarks(runner);
+    LowEngine::Bench::RegisterTerrainBenchmarks(runner);
+    LowEngine::Bench::RegisterRenderBenchmarks(runner);
+    // last - unloads all assets between samples
+    LowEngine::Bench::RegisterAssetBenchmarks(runner);
+
+    auto results = runner.RunAll();
+
+    if (!outputPath.empty() && !runner.SaveResults(outputPath, results)) return 1;
+
+    if (!baselinePath.empty()) {
+        size_t regressions = 0;
+        if (!LowEngine::Bench::Runner::CompareWithBaseline(baselinePath, results, threshold, regressions)) return 1;
+        if (regressions > 0) return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include "Log.h"
+#include "SFML/System/Clock.hpp"
+#include "assets/terrain/CookedMap.h"
+#include "assets/terrain/TileMap.h"
+
+/**
+ * Converts LDTk level and its layer definitions into cooked map (*.lowmap), that engine loads without any parsing.
+ *
+ * Usage: LowMapCooker <level.ldtkl> <definitions.json> <output.lowmap>
+ *
+ * Definitions file describes the same layers as LayerDefinitions passed to Assets::LoadTileMap():
+ * {
+ *   "layers": [
+ *     { "type": "Terrain", "cells": { "0": { "walkable": true, "swimmable": false, "flyable": true, "moveCost": 1.0, "clips": ["water"] } } }
+ *   ]
+ * }
+ */
+
+bool ReadDefinitions(const std::string& path, std::vector<LowEngine::Terrain::LayerDefinition>& definitions) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        LowEngine::_log->error("Failed to open definitions file: {}", path);
+        return false;
+    }
+
+    try {
+        nlohmann::json jsonData;
+        file >> jsonData;
+
+        for (auto& layer: jsonData.at("layers")) {
+            auto typeName = layer.at("type").get<std::string>();
+            LowEngine::Terrain::LayerType type;
+            if (typeName == "Terrain") {
+                type = LowEngine::Terrain::Terrain;
+            } else if (typeName == "Features") {
+                type = LowEngine::Terrain::Features;
+            } else {
+                LowEngine::_log->error("Invalid layer type: '{}'", typeName);
+                return false;
+            }
+
+            std::unordered_map<unsigned, LowEngine::Terrain::CellDefinition> cellDefinitions;
+            for (auto& [cellType, cell]: layer.at("cells").items()) {
+                cellDefinitions.emplace(std::stoul(cellType), LowEngine::Terrain::CellDefinition(
+                                            cell.value("walkable", false),
+                                            cell.value("swimmable", false),
+                                            cell.value("flyable", false),
+                                            cell.value("moveCost", 1.0f),
+                                            cell.value("clips", std::vector<std::string>{})));
+            }
+
+            // textures exist only at runtime - cooked data doesn't depend on them
+            definitions.emplace_back(type, 0, std::move(cellDefinitions));
+        }
+    } catch (std::exception& ex) {
+        LowEngine::_log->error("Failed to parse definitions file: {}", path);
+        LowEngine::_log->error("Error: {}", ex.what());
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    LowEngine::_log = spdlog::stdout_color_mt("low_map_cooker");
+    LowEngine::_log->set_pattern("[%l] %v");
+    LowEngine::AttachSubsystemLoggers(LowEngine::_log);
+
+    if (argc != 4) {
+        LowEngine::_log->error("Usage: LowMapCooker <level.ldtkl> <definitions.json> <output.lowmap>");
+        return 1;
+    }
+
+    const std::string levelPath = argv[1];
+    const std::string definitionsPath = argv[2];
+    const std::string outputPath = argv[3];
+
+    std::vector<LowEngine::Terrain::LayerDefinition> definitions;
+    if (!ReadDefinitions(definitionsPath, definitions)) return 1;
+
+    sf::Clock clock;
+
+    sf::Texture placeholder;
+    LowEngine::Terrain::TileMap map(placeholder);
+    if (!map.LoadFromLDTkFile(levelPath)) return 1;
+
+    sf::Time parseTime = clock.restart();
+
+    LowEngine::Serialization::BinaryWriter writer;
+    if (!LowEngine::Terrain::CookedMap::Cook(map, definitions, writer)) {
+        LowEngine::_log->error("Failed to cook map: {}", levelPath);
+        return 1;
+    }
+    if (!writer.SaveToFile(outputPath)) {
+        LowEngine::_log->error("Failed to write cooked map: {}", outputPath);
+        return 1;
+    }
+
+    LowEngine::_log->info("Cooked '{}' ({}x{} cells) into {} ({} bytes). Parsing took {:.2f} ms, cooking {:.2f} ms",
+                          map.Name, map.NavGrid.Width, map.NavGrid.Height, outputPath, writer.Position(),
+                          parseTime.asSeconds() * 1000.0f, clock.getElapsedTime().asSeconds() * 1000.0f);
+    return 0;
+}